@@ -0,0 +1,59 @@
+#!/usr/bin/env bash
+
+set -eux
+set -o pipefail
+
+# Write a chunked archive holding several image arrays and contours.
+"${DCMA_BIN}" \
+  "${TEST_FILES_ROOT}"/MR_continents.dcm \
+  \
+  -o CopyImages:ImageSelection=first \
+  -o CopyImages:ImageSelection=first \
+  -o ContourWholeImages:ImageSelection=first \
+  -o Boost_Serialize_Drover:Filename=chunked.bin:Format=chunked-binary
+
+# Round-trip the whole archive.
+"${DCMA_BIN}" \
+  chunked.bin \
+  -o DroverDebug |
+  tee -a fullstdout |
+  grep -i "3 Image_Arrays loaded" | 
+  `# Ensure the output stream is not empty. ` \
+  grep .
+
+"${DCMA_BIN}" \
+  chunked.bin \
+  -o DroverDebug |
+  tee -a fullstdout |
+  grep -i "1 contour_collections loaded" | 
+  grep .
+
+# Load only some of the objects.
+"${DCMA_BIN}" \
+  -o LoadFiles:FileName=chunked.bin:ArchiveSelection='images@0,-1' \
+  -o DroverDebug |
+  tee -a fullstdout |
+  grep -i "2 Image_Arrays loaded" | 
+  grep .
+
+"${DCMA_BIN}" \
+  -o LoadFiles:FileName=chunked.bin:ArchiveSelection='images@0,-1' \
+  -o DroverDebug |
+  tee -a fullstdout |
+  grep -i "0 contour_collections loaded" | 
+  grep .
+
+"${DCMA_BIN}" \
+  -o LoadFiles:FileName=chunked.bin:ArchiveSelection='contours' \
+  -o DroverDebug |
+  tee -a fullstdout |
+  grep -i "0 Image_Arrays loaded" | 
+  grep .
+
+# A truncated archive must be rejected.
+head -c 100 chunked.bin > truncated.bin
+if "${DCMA_BIN}" -o LoadFiles:FileName=truncated.bin ; then
+    printf 'Truncated archive was not rejected.\n' 1>&2
+    exit 1
+fi
+
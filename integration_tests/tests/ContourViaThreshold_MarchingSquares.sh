@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+
+set -eux
+set -o pipefail
+
+# Test that marching-squares contours enclose exactly the voxels that satisfy the thresholds.
+#
+# Note: voxel centres are the corners of the marching-squares cells, so isocontours always pass between voxels that
+#       are inside and outside the thresholds (even for ambiguous saddle cells). Holes are oriented opposite to their
+#       enclosing contours, so honouring opposite orientations should select exactly the voxels within the thresholds.
+#       Thresholds are chosen so no voxel lies exactly on a threshold.
+for thresholds in 'Lower=10.5:Upper=200.5' 'Lower=-inf:Upper=100.5' 'Lower=50.5:Upper=inf' ; do
+    printf 'Test %s\n' "${thresholds}" |
+      tee -a fullstdout
+    rm -f marching.csv whole.csv
+    "${DCMA_BIN}" \
+      "${TEST_FILES_ROOT}"/MR_continents.dcm \
+      \
+      -o ContourWholeImages:ROILabel=whole \
+      -o ContourViaThreshold:ROILabel=marching:"${thresholds}":Method=marching-squares \
+      \
+      -o CountVoxels:ROILabelRegex='^marching$':"${thresholds}" \
+         -p ContourOverlap=honour_opposite_orientations \
+         -p ResultsSummaryFileName=marching.csv \
+      -o CountVoxels:ROILabelRegex='^whole$':"${thresholds}" \
+         -p ResultsSummaryFileName=whole.csv |
+      tee -a fullstdout
+
+    # Columns: patient ID, voxels within range, (rel), voxels outside of range, (rel), ...
+    marching_inside="$(tail -n 1 marching.csv | cut -d ',' -f 2)"
+    marching_outside="$(tail -n 1 marching.csv | cut -d ',' -f 4)"
+    whole_inside="$(tail -n 1 whole.csv | cut -d ',' -f 2)"
+    [ "${marching_outside}" -eq 0 ]
+    [ "${marching_inside}" -eq "${whole_inside}" ]
+    [ "${whole_inside}" -gt 0 ]
+done
+
@@ -0,0 +1,51 @@
+#!/usr/bin/env bash
+
+set -eux
+set -o pipefail
+
+# Test that separable kernels applied as dense 1D passes agree with direct evaluation of each voxel's neighbourhood.
+#
+# Note: the kernel is a 3x5 checkerboard, which factors into row and column components.
+# Note: voxels along the image boundary are NaN for both methods, so NaNs in the difference are zeroed.
+for operation in convolution correlation ; do
+    printf 'Test %s\n' "${operation}" |
+      tee -a fullstdout
+    "${DCMA_BIN}" \
+      "${TEST_FILES_ROOT}"/MR_continents.dcm \
+      \
+      -o ContourWholeImages:ImageSelection=last \
+      \
+      -o GenerateSyntheticImages \
+         -p NumberOfImages=1 \
+         -p NumberOfRows=3 \
+         -p NumberOfColumns=5 \
+         -p VoxelValue=0.1 \
+         -p StipleValue=-0.1 \
+      \
+      -o CopyImages:ImageSelection=first \
+      -o ConvolveImages:ImageSelection=last:ReferenceImageSelection='#1' \
+         -p Operation="${operation}" \
+         -p SeparablePasses=true \
+      \
+      -o CopyImages:ImageSelection=first \
+      -o ConvolveImages:ImageSelection=last:ReferenceImageSelection='#1' \
+         -p Operation="${operation}" \
+         -p SeparablePasses=false \
+      \
+      -o SubtractImages:ImageSelection=last:ReferenceImageSelection='#-1' \
+      -o ConvertNaNsToZeros \
+      -o DeleteImages:ImageSelection='!last' \
+      \
+      -o DroverDebug |
+      tee -a fullstdout |
+      tee output
+
+    # Ensure the separable passes were actually used, and every voxel difference is within floating-point tolerance.
+    grep -i 'kernel is separable' output
+    grep 'pixel value range' output |
+      tee ranges |
+      grep .
+    sed -e 's/.*\[\(.*\),\(.*\)\].*/\1 \2/' ranges |
+      awk '{ if( ($1 < -1.0E-3) || (1.0E-3 < $2) ) exit 1 }'
+done
+
@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+
+set -eux
+set -o pipefail
+
+# Test that the randomized method recovers the leading singular values computed by the exact method.
+#
+# Note: the perfusion phantom has only a handful of independent temporal components, so the randomized sketch spans
+#       them all and the leading singular values should agree to within single-precision accumulation error.
+# Note: the randomized method works with squared singular values, so errors scale with the largest singular value.
+#       The tolerance is therefore relative to the largest singular value (~1750 here, with the third ~15).
+for method in exact randomized ; do
+    printf 'Test %s\n' "${method}" |
+      tee -a fullstdout
+    "${DCMA_BIN}" \
+      -o GenerateVirtualDataPerfusionV1 \
+      -o DecomposeImagesSVD:ImageSelection=last \
+         -p Method="${method}" \
+         -p Rank=3 |
+      tee -a fullstdout |
+      grep 'has singular value' |
+      sed -e 's/.*has singular value //' |
+      tee "${method}_values" |
+      grep .
+done
+
+# Ensure all three leading singular values were produced and agree to within a tolerance.
+test "$(wc -l < exact_values)" -eq 3
+test "$(wc -l < randomized_values)" -eq 3
+paste exact_values randomized_values |
+  awk 'NR == 1 { s_max = $1 }
+       { d = $1 - $2; if(d < 0) d = -d; if( !(0 < $1) || (5.0E-4 * s_max < d) ) exit 1 }'
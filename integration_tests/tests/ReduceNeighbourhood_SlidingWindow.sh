@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+
+set -eux
+set -o pipefail
+
+# Test that reducing neighbourhoods with the sliding window reproduces direct evaluation of each neighbourhood
+# voxel-by-voxel.
+#
+# Note: MR_continents is a single 128x128 slice with 1 mm voxels, so a cubic neighbourhood with MaxDistance=5 spans
+#       11x11 voxels, which is large enough for the sliding window to be used.
+for reduction in min median max percentile01 ; do
+    printf 'Test %s\n' "${reduction}" |
+      tee -a fullstdout
+    "${DCMA_BIN}" \
+      "${TEST_FILES_ROOT}"/MR_continents.dcm \
+      \
+      -o ContourWholeImages:ImageSelection=last \
+      \
+      -o CopyImages:ImageSelection=first \
+      -o ReduceNeighbourhood:ImageSelection=last \
+         -p Reduction="${reduction}" \
+         -p Neighbourhood=cubic \
+         -p MaxDistance=5 \
+         -p SlidingWindow=true \
+      \
+      -o CopyImages:ImageSelection=first \
+      -o ReduceNeighbourhood:ImageSelection=last \
+         -p Reduction="${reduction}" \
+         -p Neighbourhood=cubic \
+         -p MaxDistance=5 \
+         -p SlidingWindow=false \
+      \
+      -o SubtractImages:ImageSelection=last:ReferenceImageSelection='#-1' \
+      -o DeleteImages:ImageSelection='!last' \
+      \
+      -o DroverDebug |
+      tee -a fullstdout |
+      grep 'pixel value range' |
+      tee ranges
+    
+    # Ensure the output stream is not empty and every voxel difference is exactly zero.
+    grep . ranges
+    if grep -v 'range = \[0,0\]' ranges ; then
+        printf 'Sliding window and direct reductions differ.\n' 1>&2
+        exit 1
+    fi
+done
+
@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+
+set -eux
+set -o pipefail
+
+# Test that exact voxel traversal recovers the known path length through a uniform volume.
+#
+# Note: voxels are 0 HU, so the attenuation coefficient is 1 and each radiograph pixel holds the path length (in mm)
+#       within the volume. The volume is a 16 mm cube and the source is far away, so the longest path is ~16 mm.
+printf 'Test 1\n' |
+  tee -a fullstdout
+"${DCMA_BIN}" \
+  -o GenerateSyntheticImages \
+     -p NumberOfImages=16 \
+     -p NumberOfRows=16 \
+     -p NumberOfColumns=16 \
+     -p VoxelValue=0.0 \
+  \
+  -o SimulateRadiograph:ImageSelection=first \
+     -p Filename=exact.fits \
+     -p RayTraversal=exact \
+     -p Rows=32 \
+     -p Columns=32 \
+  -o DeleteImages:ImageSelection=first \
+  \
+  -o DroverDebug |
+  tee -a fullstdout |
+  grep 'pixel value range' |
+  tee ranges |
+  grep .
+sed -e 's/.*\[\(.*\),\(.*\)\].*/\1 \2/' ranges |
+  awk '{ if( ($1 < 0.0) || ($2 < 15.9) || (16.5 < $2) ) exit 1 }'
+
+
+# Test that exact voxel traversal agrees with the original nearest-step ray walk.
+#
+# Note: the nearest-step walk credits whole steps rather than the exact length within each voxel, so each ray can
+#       differ by up to about one voxel diagonal at either end of the volume.
+printf 'Test 2\n' |
+  tee -a fullstdout
+"${DCMA_BIN}" \
+  -o GenerateSyntheticImages \
+     -p NumberOfImages=16 \
+     -p NumberOfRows=16 \
+     -p NumberOfColumns=16 \
+     -p VoxelValue=0.0 \
+  \
+  -o SimulateRadiograph:ImageSelection=first \
+     -p Filename=exact.fits \
+     -p RayTraversal=exact \
+     -p Rows=32 \
+     -p Columns=32 \
+  -o SimulateRadiograph:ImageSelection=first \
+     -p Filename=nearest.fits \
+     -p RayTraversal=nearest-step \
+     -p Rows=32 \
+     -p Columns=32 \
+  \
+  -o SubtractImages:ImageSelection=last:ReferenceImageSelection='#-1' \
+  -o DeleteImages:ImageSelection='!last' \
+  \
+  -o DroverDebug |
+  tee -a fullstdout |
+  grep 'pixel value range' |
+  tee ranges |
+  grep .
+sed -e 's/.*\[\(.*\),\(.*\)\].*/\1 \2/' ranges |
+  awk '{ if( ($1 < -4.0) || (4.0 < $2) ) exit 1 }'
@@ -0,0 +1,54 @@
+#!/usr/bin/env bash
+
+set -eux
+set -o pipefail
+
+# Test that ray-surface intersections found using the BVH agree with the original AABB tree.
+#
+# Note: the ROI and reference ROI are disjoint boxes offset along the COM-COM line, so some rays that
+#       intersect the ROI also intersect the reference ROI.
+# Note: only the first intersection is used, so the intersection count maps can be compared exactly. Dose and depth
+#       maps depend on the precise intersection points, which differ in the last few bits between methods.
+for method in bvh aabb-tree ; do
+    printf 'Test %s\n' "${method}" |
+      tee -a fullstdout
+    "${DCMA_BIN}" \
+      -o GenerateSyntheticImages \
+         -p NumberOfImages=10 \
+         -p NumberOfRows=20 \
+         -p NumberOfColumns=20 \
+         -p VoxelValue=1.0 \
+         -p StipleValue=2.0 \
+         -p Metadata='Modality@RTDOSE' \
+      -o ContourWholeImages:ImageSelection=last:ROILabel=target \
+      \
+      -o GenerateSyntheticImages \
+         -p NumberOfImages=10 \
+         -p NumberOfRows=8 \
+         -p NumberOfColumns=8 \
+         -p ImagePosition='30.0, 0.0, 0.0' \
+      -o ContourWholeImages:ImageSelection=last:ROILabel=reference \
+      \
+      -o SurfaceBasedRayCastDoseAccumulate \
+         -p ROILabelRegex=target \
+         -p ReferenceROILabelRegex=reference \
+         -p SourceDetectorRows=32 \
+         -p SourceDetectorColumns=32 \
+         -p MaxRaySurfaceIntersections=1 \
+         -p IntersectionMethod="${method}" \
+         -p TotalDoseMapFileName="${method}_dose.fits" \
+         -p RefCroppedTotalDoseMapFileName="${method}_ref_cropped_dose.fits" \
+         -p IntersectionCountMapFileName="${method}_counts.fits" \
+         -p RefIntersectionCountMapFileName="${method}_ref_counts.fits" |
+      tee -a fullstdout |
+      grep 'Number of rays intersecting' |
+      sed -e 's/.*: //' |
+      tee "${method}_summary" |
+      grep .
+done
+
+# Ensure rays intersect both ROIs, and that both methods agree ray-for-ray.
+awk '{ if($1 < 1) exit 1 }' bvh_summary
+diff bvh_summary aabb-tree_summary
+cmp bvh_counts.fits aabb-tree_counts.fits
+cmp bvh_ref_counts.fits aabb-tree_ref_counts.fits
@@ -182,7 +182,7 @@ void IFGT::compute_constant_series() {
 
 // computes [(y_j-c_k)/h]^{alpha} or [(x_i-c_k)/h]^{alpha}
 // where y_j is target point, x_i is point inside cluster
-Eigen::VectorXf IFGT::compute_monomials(const Eigen::MatrixXf & delta) {
+Eigen::VectorXf IFGT::compute_monomials(const Eigen::MatrixXf & delta) const {
     int *heads = new int[dim];
 
     Eigen::VectorXf monomials = Eigen::VectorXf::Ones(p_max_total);
@@ -207,7 +207,7 @@ Eigen::VectorXf IFGT::compute_monomials(const Eigen::MatrixXf & delta) {
 }
 
 
-Eigen::MatrixXf IFGT::compute_ck(const Eigen::ArrayXf & weights){
+Eigen::MatrixXf IFGT::compute_ck(const Eigen::ArrayXf & weights) const {
 
     int N_source_pts = source_pts.rows();
     double h_square = bandwidth * bandwidth;
@@ -264,7 +264,7 @@ Eigen::MatrixXf IFGT::compute_ck(const Eigen::ArrayXf & weights){
 } 
 
 Eigen::MatrixXf IFGT::compute_gaussian(const Eigen::MatrixXf & target_pts,
-                                       const Eigen::MatrixXf & C_k) {
+                                       const Eigen::MatrixXf & C_k) const {
 
     int M_target_pts = target_pts.rows();
     double h_square = bandwidth * bandwidth;
@@ -380,12 +380,21 @@ Eigen::MatrixXf IFGT::compute_ifgt(const Eigen::MatrixXf & target_pts, const Eig
     }
     return G_y;
 }
-double IFGT::compute_complexity(int M_target_pts) {
+double IFGT::compute_complexity(int M_target_pts) const {
     int N_source_pts = source_pts.rows();
     return (double(N_source_pts) + M_target_pts * double(n_clusters)) * p_max_total
                 + double(dim) * N_source_pts * n_clusters;
 }
 
+bool IFGT::prefers_ifgt(int M_target_pts) const {
+    const double naive_complexity = dim * double(M_target_pts) * source_pts.rows();
+    return compute_complexity(M_target_pts) < naive_complexity;
+}
+
+Eigen::MatrixXf IFGT::compute_naive(const Eigen::MatrixXf & target_pts, const Eigen::ArrayXf & weights) const {
+    return compute_naive_gt(target_pts, source_pts, weights, bandwidth);
+}
+
 double rescale_points(const Eigen::MatrixXf & fixed_pts,
                         const Eigen::MatrixXf & moving_pts,
                         Eigen::MatrixXf & fixed_pts_scaled,
@@ -460,8 +469,9 @@ Cluster k_center_clustering(const Eigen::MatrixXf & points, int num_clusters) {
         }
     }
     for(long int i = 0; i < points.rows(); ++i) {
-        if(distances(i) > radii(assignments(i))) {
-            radii(assignments(i)) = distances(i);
+        const auto c = static_cast<Eigen::Index>(assignments(i));
+        if(distances(i) > radii(c)) {
+            radii(c) = distances(i);
         }
     }
  
@@ -83,6 +83,23 @@ class IFGT {
         
         int get_nclusters() const { return n_clusters; }
 
+        // The steps of compute_ifgt(), exposed so the cluster coefficients can be computed once and then shared
+        // (read-only) by concurrent evaluations over disjoint subsets of the target points.
+        //
+        // whether the IFGT is expected to be cheaper than direct evaluation for the given number of target points
+        bool prefers_ifgt(int M_target_pts) const;
+
+        // computes constant ck for each cluster with the given weights
+        Eigen::MatrixXf compute_ck(const Eigen::ArrayXf & weights) const;
+
+        // computes G(yj) - the actual gaussian
+        Eigen::MatrixXf compute_gaussian(const Eigen::MatrixXf & target_pts,
+                                         const Eigen::MatrixXf & C_k) const;
+
+        // computes the gauss transform directly
+        Eigen::MatrixXf compute_naive(const Eigen::MatrixXf & target_pts,
+                                      const Eigen::ArrayXf & weights) const;
+
     private: 
         const Eigen::MatrixXf source_pts;
         const double bandwidth; 
@@ -107,20 +124,14 @@ class IFGT {
 
         // computes [(y_j-c_k)/h]^{alpha} or [(x_i-c_k)/h]^{alpha}
         // where y_j is target point, x_i is point inside cluster
-        Eigen::VectorXf compute_monomials(const Eigen::MatrixXf & delta);
-
-        // computes constant ck for each cluster with constant weights
-        Eigen::MatrixXf compute_ck(const Eigen::ArrayXf & weights);
+        Eigen::VectorXf compute_monomials(const Eigen::MatrixXf & delta) const;
 
-        // computes G(yj) - the actual gaussian
-        Eigen::MatrixXf compute_gaussian(const Eigen::MatrixXf & target_pts,
-                                            const Eigen::MatrixXf & C_k);
         // // computes gauss transform naively if the estimated computational complexity
         // // is lower than IFGT
         // Eigen::MatrixXf compute_naive(const Eigen::MatrixXf & target_pts, 
         //                                     const Eigen::ArrayXf & weights);
         // estimates complexity of IFGT and naive implementations
-        double compute_complexity(int M_target_pts);
+        double compute_complexity(int M_target_pts) const;
 
 };
 
@@ -0,0 +1,772 @@
+//Alignment_CPD.cc - A part of DICOMautomaton 2024. Written by hal clark.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef DCMA_USE_EIGEN
+    #include <eigen3/Eigen/Dense>
+    #include <eigen3/Eigen/Eigenvalues>
+    #include <eigen3/Eigen/SVD>
+    #include <eigen3/Eigen/Cholesky>
+#endif
+
+#include "YgorImages.h"
+#include "YgorMath.h"         //Needed for vec3 class.
+#include "YgorMisc.h"         //Needed for FUNCINFO, FUNCWARN, FUNCERR macros.
+#include "YgorLog.h"
+
+#include "Thread_Pool.h"
+
+#include "Alignment_Field.h"
+#include "Alignment_Gauss_Transform.h"
+#include "Alignment_CPD.h"
+
+
+#ifdef DCMA_USE_EIGEN
+namespace {
+
+using dcma_gauss_transform::point_grid;
+using dcma_gauss_transform::farthest_point_sample;
+
+const double pi = 3.14159265358979323846;
+
+// Both point clouds are centred on their respective centroids and scaled by a common factor.
+struct normalization_t {
+    vec3<double> moving_centre;
+    vec3<double> stationary_centre;
+    double scale = 1.0;
+};
+
+normalization_t
+normalize(const point_set<double> & moving,
+          const point_set<double> & stationary,
+          std::vector<vec3<double>> & Y,
+          std::vector<vec3<double>> & X){
+    if( moving.points.empty() || stationary.points.empty() ){
+        throw std::invalid_argument("Both point clouds must contain points. Cannot continue.");
+    }
+
+    normalization_t out;
+    out.moving_centre = moving.Centroid();
+    out.stationary_centre = stationary.Centroid();
+
+    double sq_rad_Y = 0.0;
+    for(const auto &p : moving.points) sq_rad_Y += p.sq_dist(out.moving_centre);
+    sq_rad_Y /= static_cast<double>(moving.points.size());
+    double sq_rad_X = 0.0;
+    for(const auto &p : stationary.points) sq_rad_X += p.sq_dist(out.stationary_centre);
+    sq_rad_X /= static_cast<double>(stationary.points.size());
+
+    out.scale = std::sqrt( std::max(sq_rad_X, sq_rad_Y) );
+    if( !std::isfinite(out.scale) || (out.scale <= 0.0) ){
+        throw std::invalid_argument("Point clouds are degenerate. Cannot continue.");
+    }
+
+    Y.clear();
+    for(const auto &p : moving.points) Y.emplace_back( (p - out.moving_centre) / out.scale );
+    X.clear();
+    for(const auto &p : stationary.points) X.emplace_back( (p - out.stationary_centre) / out.scale );
+    return out;
+}
+
+// Returns the number of points to use at each coarse-to-fine level. The last level uses all points.
+std::vector<int64_t>
+level_sizes(const AlignViaCPDParams & params, int64_t N_max){
+    std::vector<int64_t> out;
+    if(params.coarse_to_fine){
+        if( (params.coarsest_level_points <= 0) || !(1.0 < params.level_point_factor) ){
+            throw std::invalid_argument("Coarse-to-fine schedule is invalid. Cannot continue.");
+        }
+        double n = static_cast<double>(params.coarsest_level_points);
+        while(n < static_cast<double>(N_max)){
+            out.push_back( static_cast<int64_t>(n) );
+            n *= params.level_point_factor;
+        }
+    }
+    out.push_back( std::numeric_limits<int64_t>::max() );
+    return out;
+}
+
+// A random (but reproducible) permutation, so that taking the first n points of each level produces nested subsets.
+std::vector<int64_t>
+subsampling_order(int64_t N){
+    std::vector<int64_t> out(N);
+    std::iota(std::begin(out), std::end(out), static_cast<int64_t>(0));
+    std::mt19937_64 re(12345);
+    std::shuffle(std::begin(out), std::end(out), re);
+    return out;
+}
+
+std::vector<vec3<double>>
+subsample(const std::vector<vec3<double>> & points,
+          const std::vector<int64_t> & order,
+          int64_t n){
+    const auto N = static_cast<int64_t>(points.size());
+    if(N <= n) return points;
+    std::vector<vec3<double>> out;
+    out.reserve(n);
+    for(int64_t i = 0; i < n; ++i) out.emplace_back( points[ order[i] ] );
+    return out;
+}
+
+double
+initial_sigma_sq(const std::vector<vec3<double>> & X,
+                 const std::vector<vec3<double>> & Y){
+    // Mean square distance between all pairs, evaluated in linear time.
+    const auto N = static_cast<double>(X.size());
+    const auto M = static_cast<double>(Y.size());
+    vec3<double> sum_X(0.0, 0.0, 0.0);
+    vec3<double> sum_Y(0.0, 0.0, 0.0);
+    double sq_X = 0.0;
+    double sq_Y = 0.0;
+    for(const auto &p : X){
+        sum_X = sum_X + p;
+        sq_X += p.Dot(p);
+    }
+    for(const auto &p : Y){
+        sum_Y = sum_Y + p;
+        sq_Y += p.Dot(p);
+    }
+    return (M * sq_X + N * sq_Y - 2.0 * sum_X.Dot(sum_Y)) / (3.0 * M * N);
+}
+
+// Sums over the posterior correspondence probabilities, which are all that is needed from the expectation step.
+struct e_step_t {
+    std::vector<double> P1;        // Row sums (i.e., for each moving point).
+    std::vector<double> Pt1;       // Column sums (i.e., for each stationary point).
+    std::vector<vec3<double>> PX;  // Probability-weighted stationary points (i.e., for each moving point).
+    double N_P = 0.0;              // Sum of all probabilities.
+    double neg_log_lik = 0.0;      // Negative log-likelihood, neglecting constants and the sigma_sq term.
+    AlignViaCPDParams::Engine engine = AlignViaCPDParams::Engine::Direct;
+};
+
+e_step_t
+e_step(const AlignViaCPDParams & params,
+       const std::vector<vec3<double>> & X,
+       const std::vector<vec3<double>> & TY,
+       double sigma_sq){
+    const auto N = static_cast<int64_t>(X.size());
+    const auto M = static_cast<int64_t>(TY.size());
+    const double w = params.outlier_weight;
+    const double c = std::pow(2.0 * pi * sigma_sq, 1.5)
+                   * (w / (1.0 - w))
+                   * (static_cast<double>(M) / static_cast<double>(N));
+    const double k_scale = -1.0 / (2.0 * sigma_sq);
+
+    e_step_t out;
+    out.P1.assign(M, 0.0);
+    out.Pt1.assign(N, 0.0);
+    out.PX.assign(M, vec3<double>(0.0, 0.0, 0.0));
+
+    // Select the engine.
+    using engine_t = AlignViaCPDParams::Engine;
+    out.engine = params.engine;
+    const double cutoff = std::sqrt( 2.0 * sigma_sq * std::log(1.0 / params.kernel_truncation) );
+    std::optional<point_grid> grid_TY;
+    if( (out.engine == engine_t::Automatic)
+    &&  (static_cast<double>(M) * static_cast<double>(N) <= static_cast<double>(params.max_direct_pairs)) ){
+        out.engine = engine_t::Direct;
+    }
+    if( (out.engine == engine_t::Automatic)
+    ||  (out.engine == engine_t::Truncated) ){
+        grid_TY.emplace(TY, cutoff);
+    }
+    if(out.engine == engine_t::Automatic){
+        // Estimate the number of nearby pairs by sampling.
+        const int64_t N_samples = std::min<int64_t>(N, 64);
+        int64_t count = 0;
+        for(int64_t n = 0; n < N_samples; ++n){
+            grid_TY->for_each_within(X[(n * N) / N_samples], cutoff, [&](int64_t, double){ ++count; });
+        }
+        const auto est_pairs = static_cast<double>(count) * static_cast<double>(N) / static_cast<double>(N_samples);
+        out.engine = (est_pairs <= static_cast<double>(params.max_truncated_pairs)) ? engine_t::Truncated
+                                                                                  : engine_t::FastGauss;
+    }
+
+    // Evaluate the mixture density (i.e., the normalization) for each stationary point, and then the probability sums
+    // for each moving point.
+    std::vector<double> den(N, c);
+    if(out.engine == engine_t::Direct){
+        parallel_for(0, N, [&](int64_t n){
+            double s = 0.0;
+            for(int64_t m = 0; m < M; ++m) s += std::exp(k_scale * X[n].sq_dist(TY[m]));
+            den[n] += s;
+        });
+        parallel_for(0, M, [&](int64_t m){
+            double p1 = 0.0;
+            vec3<double> px(0.0, 0.0, 0.0);
+            for(int64_t n = 0; n < N; ++n){
+                const auto p = std::exp(k_scale * X[n].sq_dist(TY[m])) / den[n];
+                p1 += p;
+                px = px + X[n] * p;
+            }
+            out.P1[m] = p1;
+            out.PX[m] = px;
+        });
+
+    }else if(out.engine == engine_t::Truncated){
+        const point_grid grid_X(X, cutoff);
+        parallel_for(0, N, [&](int64_t n){
+            double s = 0.0;
+            grid_TY->for_each_within(X[n], cutoff, [&](int64_t, double sq_dist){
+                s += std::exp(k_scale * sq_dist);
+            });
+            den[n] += s;
+        });
+        parallel_for(0, M, [&](int64_t m){
+            double p1 = 0.0;
+            vec3<double> px(0.0, 0.0, 0.0);
+            grid_X.for_each_within(TY[m], cutoff, [&](int64_t n, double sq_dist){
+                if(den[n] <= 0.0) return;
+                const auto p = std::exp(k_scale * sq_dist) / den[n];
+                p1 += p;
+                px = px + X[n] * p;
+            });
+            out.P1[m] = p1;
+            out.PX[m] = px;
+        });
+
+    }else if(out.engine == engine_t::FastGauss){
+        Eigen::MatrixXf X_s;
+        Eigen::MatrixXf TY_s;
+        // Note: the IFGT kernel is exp(-d^2 / h^2).
+        const auto h = rescale_points(dcma_gauss_transform::to_matrix(X), dcma_gauss_transform::to_matrix(TY),
+                                      X_s, TY_s, std::sqrt(2.0 * sigma_sq));
+        IFGT ifgt_TY(TY_s, h, params.fast_gauss_transform_epsilon);
+        IFGT ifgt_X(X_s, h, params.fast_gauss_transform_epsilon);
+
+        const auto s = dcma_gauss_transform::parallel_ifgt(ifgt_TY, X_s, std::vector<double>(M, 1.0));
+        for(int64_t n = 0; n < N; ++n) den[n] += std::max(0.0, s[n]);
+
+        // Stationary points are centred to reduce the magnitude of the weights.
+        vec3<double> X_c(0.0, 0.0, 0.0);
+        for(const auto &p : X) X_c = X_c + p;
+        X_c = X_c / static_cast<double>(N);
+
+        std::vector<double> inv_den(N, 0.0);
+        for(int64_t n = 0; n < N; ++n) inv_den[n] = (0.0 < den[n]) ? 1.0 / den[n] : 0.0;
+        const auto P1 = dcma_gauss_transform::parallel_ifgt(ifgt_X, TY_s, inv_den);
+        std::array<std::vector<double>, 3> PX;
+        for(size_t d = 0; d < 3; ++d){
+            std::vector<double> wx(N, 0.0);
+            for(int64_t n = 0; n < N; ++n){
+                const auto dX = X[n] - X_c;
+                wx[n] = inv_den[n] * ((d == 0) ? dX.x : ((d == 1) ? dX.y : dX.z));
+            }
+            PX[d] = dcma_gauss_transform::parallel_ifgt(ifgt_X, TY_s, wx);
+        }
+        for(int64_t m = 0; m < M; ++m){
+            out.P1[m] = std::max(0.0, P1[m]);
+            out.PX[m] = vec3<double>(PX[0][m], PX[1][m], PX[2][m]) + X_c * out.P1[m];
+        }
+
+    }else{
+        throw std::logic_error("Expectation step engine not understood. Cannot continue.");
+    }
+
+    for(int64_t n = 0; n < N; ++n){
+        const auto d = std::max(den[n], std::numeric_limits<double>::min());
+        out.Pt1[n] = 1.0 - c / d;
+        out.neg_log_lik -= std::log(d);
+    }
+    for(const auto &p1 : out.P1) out.N_P += p1;
+    if( !std::isfinite(out.N_P) || (out.N_P <= 0.0) ){
+        throw std::runtime_error("Correspondence probabilities vanished. Is the outlier weight too large?");
+    }
+    return out;
+}
+
+const char *
+engine_name(AlignViaCPDParams::Engine e){
+    if(e == AlignViaCPDParams::Engine::Direct) return "direct";
+    if(e == AlignViaCPDParams::Engine::Truncated) return "truncated";
+    if(e == AlignViaCPDParams::Engine::FastGauss) return "fast Gauss transform";
+    return "automatic";
+}
+
+void
+validate(const AlignViaCPDParams & params){
+    if( !(0.0 <= params.outlier_weight) || !(params.outlier_weight < 1.0) ){
+        throw std::invalid_argument("Outlier weight must be within [0:1). Cannot continue.");
+    }
+    if( !(0.0 < params.kernel_truncation) || !(params.kernel_truncation < 1.0) ){
+        throw std::invalid_argument("Kernel truncation parameter is invalid. Cannot continue.");
+    }
+    if( !(0.0 < params.fast_gauss_transform_epsilon) || !(params.fast_gauss_transform_epsilon < 1.0) ){
+        throw std::invalid_argument("Fast Gauss transform accuracy parameter is invalid. Cannot continue.");
+    }
+    if(params.max_iterations <= 0){
+        throw std::invalid_argument("At least one iteration is required. Cannot continue.");
+    }
+    return;
+}
+
+// The minimum permitted sigma_sq, relative to the normalized point cloud size.
+const double min_sigma_sq = 1.0E-10;
+
+bool
+has_converged(const AlignViaCPDParams & params, double L, double L_last){
+    return std::isfinite(L_last)
+        && (std::abs(L - L_last) <= params.tolerance * std::abs(L));
+}
+
+// Rigid and affine registration, both of which yield x = A y + t in normalized coordinates.
+std::pair<Eigen::Matrix3d, Eigen::Vector3d>
+register_linear(const AlignViaCPDParams & params,
+                const std::vector<vec3<double>> & X_all,
+                const std::vector<vec3<double>> & Y_all,
+                bool is_affine){
+    validate(params);
+
+    Eigen::Matrix3d A = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d t = Eigen::Vector3d::Zero();
+    double sigma_sq = std::numeric_limits<double>::quiet_NaN();
+
+    const auto X_order = subsampling_order(static_cast<int64_t>(X_all.size()));
+    const auto Y_order = subsampling_order(static_cast<int64_t>(Y_all.size()));
+    const auto levels = level_sizes(params, static_cast<int64_t>(std::max(X_all.size(), Y_all.size())));
+    for(const auto &level_size : levels){
+        const auto X = subsample(X_all, X_order, level_size);
+        const auto Y = subsample(Y_all, Y_order, level_size);
+        const auto N = static_cast<int64_t>(X.size());
+        const auto M = static_cast<int64_t>(Y.size());
+
+        std::vector<vec3<double>> TY(M);
+        const auto transform_Y = [&](){
+            parallel_for(0, M, [&](int64_t m){
+                const Eigen::Vector3d y(Y[m].x, Y[m].y, Y[m].z);
+                const Eigen::Vector3d ty = A * y + t;
+                TY[m] = vec3<double>(ty(0), ty(1), ty(2));
+            });
+        };
+        transform_Y();
+        if(!std::isfinite(sigma_sq)) sigma_sq = initial_sigma_sq(X, TY);
+
+        double L_last = std::numeric_limits<double>::quiet_NaN();
+        int64_t iter = 0;
+        AlignViaCPDParams::Engine engine = AlignViaCPDParams::Engine::Automatic;
+        for(iter = 0; iter < params.max_iterations; ++iter){
+            const auto E = e_step(params, X, TY, sigma_sq);
+            engine = E.engine;
+            const auto L = E.neg_log_lik + 1.5 * static_cast<double>(N) * std::log(sigma_sq);
+
+            // Weighted centroids and (co)variances.
+            Eigen::Vector3d mu_x = Eigen::Vector3d::Zero();
+            Eigen::Vector3d mu_y = Eigen::Vector3d::Zero();
+            double xx = 0.0;
+            for(int64_t n = 0; n < N; ++n){
+                const Eigen::Vector3d x(X[n].x, X[n].y, X[n].z);
+                mu_x += E.Pt1[n] * x;
+                xx += E.Pt1[n] * x.squaredNorm();
+            }
+            Eigen::Matrix3d PXtY = Eigen::Matrix3d::Zero();
+            Eigen::Matrix3d YtPY = Eigen::Matrix3d::Zero();
+            for(int64_t m = 0; m < M; ++m){
+                const Eigen::Vector3d y(Y[m].x, Y[m].y, Y[m].z);
+                const Eigen::Vector3d px(E.PX[m].x, E.PX[m].y, E.PX[m].z);
+                mu_y += E.P1[m] * y;
+                PXtY += px * y.transpose();
+                YtPY += E.P1[m] * y * y.transpose();
+            }
+            mu_x /= E.N_P;
+            mu_y /= E.N_P;
+            xx -= E.N_P * mu_x.squaredNorm();
+            const Eigen::Matrix3d A_xy = PXtY - E.N_P * mu_x * mu_y.transpose();
+            const Eigen::Matrix3d A_yy = YtPY - E.N_P * mu_y * mu_y.transpose();
+
+            if(is_affine){
+                A = A_xy * A_yy.inverse();
+                sigma_sq = (xx - (A_xy * A.transpose()).trace()) / (3.0 * E.N_P);
+            }else{
+                Eigen::JacobiSVD<Eigen::Matrix3d> SVD(A_xy, Eigen::ComputeFullU | Eigen::ComputeFullV );
+                Eigen::Matrix3d C = Eigen::Matrix3d::Identity();
+                if(!params.permit_mirroring){
+                    C(2,2) = (SVD.matrixU() * SVD.matrixV().transpose()).determinant();
+                }
+                const Eigen::Matrix3d R = SVD.matrixU() * C * SVD.matrixV().transpose();
+                const double tr_AR = (A_xy.transpose() * R).trace();
+                const double yy = A_yy.trace();
+                const double s = params.permit_scaling ? tr_AR / yy : 1.0;
+                A = s * R;
+                sigma_sq = (xx - 2.0 * s * tr_AR + s * s * yy) / (3.0 * E.N_P);
+            }
+            t = mu_x - A * mu_y;
+            if( !A.allFinite() || !t.allFinite() ){
+                throw std::runtime_error("Failed to update transformation. Cannot continue.");
+            }
+            sigma_sq = std::max(sigma_sq, min_sigma_sq);
+            transform_Y();
+
+            if(has_converged(params, L, L_last)) break;
+            L_last = L;
+        }
+        YLOGINFO("CPD level with " << N << " stationary and " << M << " moving points completed after "
+                 << std::min(iter + 1, params.max_iterations) << " iterations (sigma^2 = " << sigma_sq
+                 << ", engine = " << engine_name(engine) << ")");
+    }
+    return { A, t };
+}
+
+affine_transform<double>
+to_affine(const std::pair<Eigen::Matrix3d, Eigen::Vector3d> & A_t,
+          const normalization_t & norm){
+    // In normalized coordinates x' = A y' + t where y' = (y - c_y) / s and x' = (x - c_x) / s, so
+    // x = A y + (c_x - A c_y + s t).
+    const auto &A = A_t.first;
+    const Eigen::Vector3d c_y(norm.moving_centre.x, norm.moving_centre.y, norm.moving_centre.z);
+    const Eigen::Vector3d c_x(norm.stationary_centre.x, norm.stationary_centre.y, norm.stationary_centre.z);
+    const Eigen::Vector3d b = c_x - A * c_y + norm.scale * A_t.second;
+
+    affine_transform<double> out;
+    for(int r = 0; r < 3; ++r){
+        for(int c = 0; c < 3; ++c){
+            out.coeff(r, c) = A(r, c);
+        }
+        out.coeff(r, 3) = b(r);
+    }
+    return out;
+}
+
+// A displacement field composed of Gaussian radial basis functions, i.e., v(u) = sum_k exp(-|u - c_k|^2 / 2 beta^2) a_k.
+struct gaussian_rbf_t {
+    std::vector<vec3<double>> centres;
+    std::vector<vec3<double>> coeffs;
+};
+
+vec3<double>
+evaluate_displacement(const std::vector<gaussian_rbf_t> & terms,
+                      double beta,
+                      const vec3<double> & u){
+    const double k_scale = -1.0 / (2.0 * beta * beta);
+    vec3<double> out(0.0, 0.0, 0.0);
+    for(const auto &term : terms){
+        const auto N = term.centres.size();
+        for(size_t k = 0; k < N; ++k){
+            out = out + term.coeffs[k] * std::exp(k_scale * u.sq_dist(term.centres[k]));
+        }
+    }
+    return out;
+}
+
+// Computes Q^T diag(d) Q block-wise in parallel.
+Eigen::MatrixXd
+weighted_gram(const Eigen::MatrixXd & Q, const Eigen::VectorXd & d){
+    const int64_t block_rows = 1024;
+    const auto N_rows = static_cast<int64_t>(Q.rows());
+    const auto N_blocks = (N_rows + block_rows - 1) / block_rows;
+    return parallel_reduce(0, N_blocks, Eigen::MatrixXd(Eigen::MatrixXd::Zero(Q.cols(), Q.cols())),
+        [&](int64_t b, int64_t e, Eigen::MatrixXd acc) -> Eigen::MatrixXd {
+            for(int64_t n = b; n < e; ++n){
+                const auto row_b = n * block_rows;
+                const auto N_r = std::min(N_rows, row_b + block_rows) - row_b;
+                const auto Q_b = Q.middleRows(row_b, N_r);
+                acc.noalias() += Q_b.transpose() * d.segment(row_b, N_r).asDiagonal() * Q_b;
+            }
+            return acc;
+        },
+        [](const Eigen::MatrixXd &A, const Eigen::MatrixXd &B) -> Eigen::MatrixXd {
+            return A + B;
+        });
+}
+
+} // namespace
+
+
+std::optional<affine_transform<double>>
+AlignViaRigidCPD(const AlignViaCPDParams & params,
+                 const point_set<double> & moving,
+                 const point_set<double> & stationary ){
+    std::vector<vec3<double>> Y;
+    std::vector<vec3<double>> X;
+    try{
+        const auto norm = normalize(moving, stationary, Y, X);
+        return to_affine( register_linear(params, X, Y, false), norm );
+    }catch(const std::exception &e){
+        YLOGWARN("Rigid CPD registration failed: " << e.what());
+    }
+    return std::nullopt;
+}
+
+
+std::optional<affine_transform<double>>
+AlignViaAffineCPD(const AlignViaCPDParams & params,
+                  const point_set<double> & moving,
+                  const point_set<double> & stationary ){
+    std::vector<vec3<double>> Y;
+    std::vector<vec3<double>> X;
+    try{
+        const auto norm = normalize(moving, stationary, Y, X);
+        return to_affine( register_linear(params, X, Y, true), norm );
+    }catch(const std::exception &e){
+        YLOGWARN("Affine CPD registration failed: " << e.what());
+    }
+    return std::nullopt;
+}
+
+
+std::optional<deformation_field>
+AlignViaNonRigidCPD(const AlignViaCPDParams & params,
+                    const point_set<double> & moving,
+                    const point_set<double> & stationary ){
+    std::vector<vec3<double>> Y_all;
+    std::vector<vec3<double>> X_all;
+    normalization_t norm;
+    std::vector<gaussian_rbf_t> terms;
+    try{
+        validate(params);
+        if( !(0.0 < params.beta) || !(0.0 < params.lambda) ){
+            throw std::invalid_argument("Kernel width and regularization parameters must be positive. Cannot continue.");
+        }
+        norm = normalize(moving, stationary, Y_all, X_all);
+
+        const double beta = params.beta;
+        const double g_scale = -1.0 / (2.0 * beta * beta);
+        double sigma_sq = std::numeric_limits<double>::quiet_NaN();
+
+        // Each level refines the displacement found by the preceding levels, so the total displacement is the sum of
+        // the fields from all levels.
+        const auto X_order = subsampling_order(static_cast<int64_t>(X_all.size()));
+        const auto Y_order = subsampling_order(static_cast<int64_t>(Y_all.size()));
+        const auto levels = level_sizes(params, static_cast<int64_t>(std::max(X_all.size(), Y_all.size())));
+        for(const auto &level_size : levels){
+            const auto X = subsample(X_all, X_order, level_size);
+            const auto Y = subsample(Y_all, Y_order, level_size);
+            const auto N = static_cast<int64_t>(X.size());
+            const auto M = static_cast<int64_t>(Y.size());
+
+            // Points displaced by the preceding levels.
+            Eigen::MatrixXd Y0(M, 3);
+            parallel_for(0, M, [&](int64_t m){
+                const auto p = Y[m] + evaluate_displacement(terms, beta, Y[m]);
+                Y0(m, 0) = p.x;
+                Y0(m, 1) = p.y;
+                Y0(m, 2) = p.z;
+            });
+            std::vector<vec3<double>> TY(M);
+            const auto update_TY = [&](const Eigen::MatrixXd &GW){
+                for(int64_t m = 0; m < M; ++m){
+                    TY[m] = vec3<double>( Y0(m, 0) + GW(m, 0), Y0(m, 1) + GW(m, 1), Y0(m, 2) + GW(m, 2) );
+                }
+            };
+            update_TY(Eigen::MatrixXd::Zero(M, 3));
+            if(!std::isfinite(sigma_sq)) sigma_sq = initial_sigma_sq(X, TY);
+
+            const bool use_exact = (params.solver == AlignViaCPDParams::Solver::Exact)
+                                || ( (params.solver == AlignViaCPDParams::Solver::Automatic)
+                                     && (M <= params.max_exact_points) );
+
+            // Kernel matrix (exact solver) or its Nystrom approximation G ~ Q diag(1/S) Q^T (low-rank solver).
+            Eigen::MatrixXd G;
+            Eigen::MatrixXd Q;
+            Eigen::VectorXd S;
+            Eigen::MatrixXd V;
+            std::vector<vec3<double>> landmarks;
+            if(use_exact){
+                G.resize(M, M);
+                parallel_for(0, M, [&](int64_t i){
+                    for(int64_t j = 0; j < M; ++j) G(i, j) = std::exp(g_scale * Y[i].sq_dist(Y[j]));
+                });
+            }else{
+                if(params.low_rank <= 0){
+                    throw std::invalid_argument("Low-rank approximation rank must be positive. Cannot continue.");
+                }
+                for(const auto &i : farthest_point_sample(Y, params.low_rank)) landmarks.emplace_back(Y[i]);
+                const auto K = static_cast<int64_t>(landmarks.size());
+                Eigen::MatrixXd C(M, K);
+                parallel_for(0, M, [&](int64_t i){
+                    for(int64_t k = 0; k < K; ++k) C(i, k) = std::exp(g_scale * Y[i].sq_dist(landmarks[k]));
+                });
+                Eigen::MatrixXd G_LL(K, K);
+                for(int64_t i = 0; i < K; ++i){
+                    for(int64_t j = 0; j < K; ++j) G_LL(i, j) = std::exp(g_scale * landmarks[i].sq_dist(landmarks[j]));
+                }
+
+                // Discard numerically insignificant components.
+                Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(G_LL);
+                if(eig.info() != Eigen::Success){
+                    throw std::runtime_error("Unable to decompose landmark kernel matrix. Cannot continue.");
+                }
+                const auto &evals = eig.eigenvalues();
+                const double max_eval = evals.maxCoeff();
+                std::vector<Eigen::Index> keep;
+                for(Eigen::Index k = 0; k < evals.size(); ++k){
+                    if(1.0E-10 * max_eval < evals(k)) keep.push_back(k);
+                }
+                const auto r = static_cast<Eigen::Index>(keep.size());
+                V.resize(K, r);
+                S.resize(r);
+                for(Eigen::Index k = 0; k < r; ++k){
+                    V.col(k) = eig.eigenvectors().col(keep[k]);
+                    S(k) = evals(keep[k]);
+                }
+                Q = C * V;
+                YLOGINFO("Using a rank-" << r << " approximation of the kernel matrix");
+            }
+
+            Eigen::MatrixXd W = Eigen::MatrixXd::Zero(M, 3);
+            Eigen::MatrixXd U; // Q^T W for the low-rank solver.
+            Eigen::MatrixXd GW = Eigen::MatrixXd::Zero(M, 3);
+            double L_last = std::numeric_limits<double>::quiet_NaN();
+            int64_t iter = 0;
+            AlignViaCPDParams::Engine engine = AlignViaCPDParams::Engine::Automatic;
+            for(iter = 0; iter < params.max_iterations; ++iter){
+                const auto E = e_step(params, X, TY, sigma_sq);
+                engine = E.engine;
+
+                double reg = 0.0;
+                if(use_exact){
+                    reg = (W.transpose() * GW).trace();
+                }else if(U.size() != 0){
+                    reg = (U.transpose() * S.cwiseInverse().asDiagonal() * U).trace();
+                }
+                const auto L = E.neg_log_lik
+                             + 1.5 * static_cast<double>(N) * std::log(sigma_sq)
+                             + 0.5 * params.lambda * reg;
+
+                // Solve (d(P1) G + lambda sigma_sq I) W = PX - d(P1) Y0 for the displacement coefficients.
+                const double s = params.lambda * sigma_sq;
+                Eigen::VectorXd P1(M);
+                Eigen::MatrixXd b(M, 3);
+                for(int64_t m = 0; m < M; ++m){
+                    P1(m) = E.P1[m];
+                    b(m, 0) = E.PX[m].x - P1(m) * Y0(m, 0);
+                    b(m, 1) = E.PX[m].y - P1(m) * Y0(m, 1);
+                    b(m, 2) = E.PX[m].z - P1(m) * Y0(m, 2);
+                }
+                if(use_exact){
+                    // With W = d(P1)^{1/2} Z, the system becomes symmetric positive definite:
+                    // (d(P1)^{1/2} G d(P1)^{1/2} + s I) Z = d(P1)^{-1/2} b. Rows with P1 = 0 have W = 0 and b = 0.
+                    const Eigen::VectorXd sqrt_P1 = P1.cwiseSqrt();
+                    Eigen::MatrixXd H = sqrt_P1.asDiagonal() * G * sqrt_P1.asDiagonal();
+                    H.diagonal().array() += s;
+                    Eigen::MatrixXd b_z(M, 3);
+                    for(int64_t m = 0; m < M; ++m){
+                        b_z.row(m) = (0.0 < sqrt_P1(m)) ? Eigen::RowVector3d(b.row(m) / sqrt_P1(m))
+                                                        : Eigen::RowVector3d::Zero();
+                    }
+                    Eigen::LLT<Eigen::MatrixXd> LLT(H);
+                    if(LLT.info() != Eigen::Success){
+                        throw std::runtime_error("Unable to factor non-rigid system. Cannot continue.");
+                    }
+                    W = sqrt_P1.asDiagonal() * LLT.solve(b_z);
+                    GW = G * W;
+                }else{
+                    // Woodbury identity: W = (b - d(P1) Q (s diag(S) + Q^T d(P1) Q)^{-1} Q^T b) / s.
+                    Eigen::MatrixXd H = weighted_gram(Q, P1);
+                    H.diagonal() += s * S;
+                    Eigen::LDLT<Eigen::MatrixXd> LDLT(H);
+                    if(LDLT.info() != Eigen::Success){
+                        throw std::runtime_error("Unable to factor low-rank non-rigid system. Cannot continue.");
+                    }
+                    const Eigen::MatrixXd z = LDLT.solve(Q.transpose() * b);
+                    W = (b - P1.asDiagonal() * (Q * z)) / s;
+                    U = Q.transpose() * W;
+                    GW = Q * (S.cwiseInverse().asDiagonal() * U);
+                }
+                if(!W.allFinite()){
+                    throw std::runtime_error("Failed to update transformation. Cannot continue.");
+                }
+                update_TY(GW);
+
+                // Update sigma_sq.
+                double xx = 0.0;
+                for(int64_t n = 0; n < N; ++n) xx += E.Pt1[n] * X[n].Dot(X[n]);
+                double xty = 0.0;
+                double tyty = 0.0;
+                for(int64_t m = 0; m < M; ++m){
+                    xty += E.PX[m].Dot(TY[m]);
+                    tyty += E.P1[m] * TY[m].Dot(TY[m]);
+                }
+                sigma_sq = std::max( (xx - 2.0 * xty + tyty) / (3.0 * E.N_P), min_sigma_sq );
+
+                if(has_converged(params, L, L_last)) break;
+                L_last = L;
+            }
+            YLOGINFO("CPD level with " << N << " stationary and " << M << " moving points completed after "
+                     << std::min(iter + 1, params.max_iterations) << " iterations (sigma^2 = " << sigma_sq
+                     << ", engine = " << engine_name(engine) << ")");
+
+            // Record this level's displacement field.
+            gaussian_rbf_t term;
+            if(use_exact){
+                term.centres = Y;
+                for(int64_t m = 0; m < M; ++m) term.coeffs.emplace_back( W(m, 0), W(m, 1), W(m, 2) );
+            }else{
+                // G(u, Y) W ~ g(u, landmarks) V diag(1/S) Q^T W.
+                const Eigen::MatrixXd alpha = V * (S.cwiseInverse().asDiagonal() * U);
+                term.centres = landmarks;
+                for(Eigen::Index k = 0; k < alpha.rows(); ++k) term.coeffs.emplace_back( alpha(k, 0), alpha(k, 1), alpha(k, 2) );
+            }
+            terms.emplace_back(std::move(term));
+        }
+    }catch(const std::exception &e){
+        YLOGWARN("Non-rigid CPD registration failed: " << e.what());
+        return std::nullopt;
+    }
+
+    // Sample the displacement field onto a regular grid covering the moving points.
+    const auto inf = std::numeric_limits<double>::infinity();
+    vec3<double> lo(inf, inf, inf);
+    vec3<double> hi(-inf, -inf, -inf);
+    for(const auto &p : moving.points){
+        lo = vec3<double>( std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z) );
+        hi = vec3<double>( std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z) );
+    }
+    const double margin = (0.0 < params.field_margin) ? params.field_margin : params.beta * norm.scale;
+    lo = lo - vec3<double>(margin, margin, margin);
+    hi = hi + vec3<double>(margin, margin, margin);
+    const auto extent = hi - lo;
+    const double max_extent = std::max({ extent.x, extent.y, extent.z });
+    const double voxel = (0.0 < params.field_voxel_size) ? params.field_voxel_size : max_extent / 63.0;
+    const auto N_cols = std::max<int64_t>(2, static_cast<int64_t>(std::ceil(extent.x / voxel)) + 1);
+    const auto N_rows = std::max<int64_t>(2, static_cast<int64_t>(std::ceil(extent.y / voxel)) + 1);
+    const auto N_imgs = std::max<int64_t>(2, static_cast<int64_t>(std::ceil(extent.z / voxel)) + 1);
+    YLOGINFO("Sampling displacement field onto a " << N_cols << "x" << N_rows << "x" << N_imgs << " grid");
+
+    const vec3<double> row_unit(0.0, 1.0, 0.0);
+    const vec3<double> col_unit(1.0, 0.0, 0.0);
+    const vec3<double> zero(0.0, 0.0, 0.0);
+    const auto shift = norm.stationary_centre - norm.moving_centre;
+
+    planar_image_collection<double,double> field;
+    for(int64_t k = 0; k < N_imgs; ++k){
+        field.images.emplace_back();
+        auto &img = field.images.back();
+        img.init_buffer(N_rows, N_cols, 3);
+        img.init_spatial(voxel, voxel, voxel, zero, lo + vec3<double>(0.0, 0.0, voxel * static_cast<double>(k)));
+        img.init_orientation(row_unit, col_unit);
+    }
+    std::vector<planar_image<double,double>*> img_ptrs;
+    for(auto &img : field.images) img_ptrs.push_back(&img);
+    parallel_for(0, N_imgs * N_rows, [&](int64_t n){
+        auto &img = *(img_ptrs[n / N_rows]);
+        const auto r = n % N_rows;
+        for(int64_t c = 0; c < N_cols; ++c){
+            const auto p = img.position(r, c);
+            const auto u = (p - norm.moving_centre) / norm.scale;
+            const auto d = shift + evaluate_displacement(terms, params.beta, u) * norm.scale;
+            img.reference(r, c, 0) = d.x;
+            img.reference(r, c, 1) = d.y;
+            img.reference(r, c, 2) = d.z;
+        }
+    });
+
+    try{
+        return deformation_field(std::move(field));
+    }catch(const std::exception &e){
+        YLOGWARN("Unable to create deformation field: " << e.what());
+    }
+    return std::nullopt;
+}
+#endif // DCMA_USE_EIGEN
+
@@ -0,0 +1,118 @@
+//Alignment_CPD.h - A part of DICOMautomaton 2024. Written by hal clark.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "YgorMisc.h"         //Needed for FUNCINFO, FUNCWARN, FUNCERR macros.
+#include "YgorLog.h"
+#include "YgorMath.h"         //Needed for vec3 class.
+
+#include "Alignment_Field.h"
+
+
+#ifdef DCMA_USE_EIGEN
+// These routines find an alignment using the 'coherent point drift' (CPD) algorithm of Myronenko and Song (2010).
+//
+// The moving points are treated as the centroids of a Gaussian mixture model, which is fit to the stationary points
+// using expectation maximization. A uniform distribution is included to account for noise and outliers. Point sets can
+// differ in number of points and need not correspond.
+//
+// Both point sets are centred and scaled to unit size before registration, so the smoothness and kernel width
+// parameters are independent of the point cloud size.
+//
+// Note that these routines only identify a transform, they do not implement it by altering the inputs.
+//
+struct AlignViaCPDParams {
+    // The (prior) weight of the uniform distribution, which accounts for noise and outliers. Must be within [0:1).
+    double outlier_weight = 0.2;
+
+    // The maximum number of expectation maximization iterations performed at each coarse-to-fine level.
+    int64_t max_iterations = 100;
+
+    // Iteration stops when the relative change in the negative log-likelihood falls below this threshold.
+    double tolerance = 1.0E-5;
+
+    // Rigid registration parameters.
+    //
+    // Whether an isotropic scale factor is permitted, and whether the rotation may include a reflection.
+    bool permit_scaling = true;
+    bool permit_mirroring = false;
+
+    // Non-rigid registration parameters.
+    //
+    // The width of the Gaussian kernel used to regularize the displacement field, and the trade-off between goodness of
+    // fit and regularization. Both are relative to the (unit) normalized point cloud size.
+    double beta = 2.0;
+    double lambda = 2.0;
+
+    // Expectation step engine.
+    //
+    // The expectation step requires sums over a Gaussian kernel between all pairs of moving and stationary points.
+    // The 'direct' engine evaluates every pair, the 'truncated' engine only evaluates pairs that are close enough to
+    // contribute meaningfully, and the 'fast Gauss transform' engine approximates the sums using the improved fast
+    // Gauss transform. None of these require storing the correspondence probability matrix.
+    //
+    // The automatic option selects the direct engine for small problems. Otherwise the truncated engine is used if the
+    // estimated number of nearby pairs is reasonable, and the fast Gauss transform is used if not. Since the kernel
+    // width shrinks as the algorithm progresses, the selection is re-evaluated every iteration.
+    enum class Engine {
+        Automatic,
+        Direct,
+        Truncated,
+        FastGauss
+    };
+    Engine engine = Engine::Automatic;
+    int64_t max_direct_pairs = 1'000'000;
+    int64_t max_truncated_pairs = 50'000'000;
+    double kernel_truncation = 1.0E-8; // Kernel values smaller than this are neglected by the truncated engine.
+    double fast_gauss_transform_epsilon = 1.0E-4;
+
+    // Non-rigid solver.
+    //
+    // The exact solver factors a dense (N_moving x N_moving) system every iteration. The low-rank solver approximates
+    // the Gaussian kernel matrix using the Nystrom method with a subset of the moving points as landmarks, so the
+    // displacement field is represented by (at most) low_rank Gaussian basis functions. The automatic option selects
+    // the exact solver when there are no more than max_exact_points moving points.
+    enum class Solver {
+        Automatic,
+        Exact,
+        LowRank
+    };
+    Solver solver = Solver::Automatic;
+    int64_t max_exact_points = 1500;
+    int64_t low_rank = 250;
+
+    // Coarse-to-fine schedule.
+    //
+    // If enabled, registration is first performed with randomly subsampled point clouds with (at most)
+    // coarsest_level_points points each. The result seeds the next level, which has level_point_factor times as many
+    // points, and so on until the full point clouds are used.
+    bool coarse_to_fine = true;
+    int64_t coarsest_level_points = 2000;
+    double level_point_factor = 4.0;
+
+    // Non-rigid transformations are sampled onto a regular grid covering the moving point cloud, which is expanded
+    // by the margin on all sides. If non-positive, the margin defaults to the (physical) kernel width and the voxel size
+    // is selected so the largest grid dimension has 64 voxels.
+    double field_margin = -1.0;
+    double field_voxel_size = -1.0;
+};
+
+std::optional<affine_transform<double>>
+AlignViaRigidCPD(const AlignViaCPDParams & params,
+                 const point_set<double> & moving,
+                 const point_set<double> & stationary );
+
+std::optional<affine_transform<double>>
+AlignViaAffineCPD(const AlignViaCPDParams & params,
+                  const point_set<double> & moving,
+                  const point_set<double> & stationary );
+
+std::optional<deformation_field>
+AlignViaNonRigidCPD(const AlignViaCPDParams & params,
+                    const point_set<double> & moving,
+                    const point_set<double> & stationary );
+#endif // DCMA_USE_EIGEN
+
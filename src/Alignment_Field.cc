@@ -1,6 +1,10 @@
 //Alignment_Field.cc - A part of DICOMautomaton 2021. Written by hal clark.
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <fstream>
 #include <iterator>
@@ -41,6 +45,19 @@ deformation_field::deformation_field(planar_image_collection<double,double> &&in
     this->swap_and_rebuild(in);
 }
 
+deformation_field::deformation_field(const deformation_field &rhs){
+    *this = rhs;
+}
+
+deformation_field &
+deformation_field::operator=(const deformation_field &rhs){
+    if(this != &rhs){
+        auto field_copy = rhs.field;
+        this->swap_and_rebuild(field_copy);
+    }
+    return *this;
+}
+
 void
 deformation_field::swap_and_rebuild(planar_image_collection<double,double> &in){
 
@@ -59,12 +76,7 @@ deformation_field::swap_and_rebuild(planar_image_collection<double,double> &in){
             throw std::invalid_argument("Images do not form a rectilinear grid. Cannot continue");
         }
 
-        const auto row_unit = this->field.images.front().row_unit.unit();
-        const auto col_unit = this->field.images.front().col_unit.unit();
-        const auto img_unit = col_unit.Cross(row_unit).unit();
-
-        planar_image_adjacency<double,double> img_adj( {}, { { std::ref(this->field) } }, img_unit );
-        this->adj = img_adj;
+        this->interp.emplace(this->field);
         
     }catch(const std::exception &){
         this->field.Swap(in);
@@ -80,16 +92,18 @@ deformation_field::get_imagecoll_crefw() const {
 
 vec3<double> 
 deformation_field::transform(const vec3<double> &v) const {
-    const double oob = 0.0;
-    const auto dx = this->adj.value().trilinearly_interpolate(v, 0, 0.0);
-    const auto dy = this->adj.value().trilinearly_interpolate(v, 1, 0.0);
-    const auto dz = this->adj.value().trilinearly_interpolate(v, 2, 0.0);
-    return v + vec3<double>(dx, dy, dz);
+    // Displacement outside the field is taken to be zero.
+    std::array<double, 3> d = {{ 0.0, 0.0, 0.0 }};
+    const auto &interp = this->interp.value();
+    interp.interpolate(interp.to_voxel_coords(v), 0, 3, d.data());
+    return v + vec3<double>(d[0], d[1], d[2]);
 }
 
 void
 deformation_field::apply_to(point_set<double> &ps) const {
-    for(auto &p : ps.points) p = this->transform(p);
+    parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(ps.points.size()), [&](int64_t i){
+        ps.points[i] = this->transform(ps.points[i]);
+    });
     return;
 }
 
@@ -100,14 +114,89 @@ deformation_field::apply_to(vec3<double> &v) const {
 }
 
 void
-deformation_field::apply_to(planar_image<float, double> &img) const {
-    throw std::logic_error("Not yet implemented");
+deformation_field::apply_to(planar_image<float, double> &img, float oob) const {
+    planar_image_collection<float, double> imgs;
+    imgs.images.emplace_back(img);
+    this->apply_to(imgs, oob);
+    img = imgs.images.front();
     return;
 }
 
 void
-deformation_field::apply_to(planar_image_collection<float, double> &img) const {
-    throw std::logic_error("Not yet implemented");
+deformation_field::apply_to(planar_image_collection<float, double> &imgs, float oob) const {
+    if(imgs.images.empty()) return;
+
+    // The original images are sampled, so a copy is needed.
+    auto orig = imgs;
+
+    // Regular image arrays, which are the most common, are interpolated directly using a flattened index.
+    // Otherwise an adjacency index is used, which is slower but handles irregular image spacing.
+    std::optional<regular_grid_interpolator<float,double>> orig_interp;
+    std::optional<planar_image_adjacency<float,double>> orig_adj;
+    try{
+        orig_interp.emplace(orig);
+    }catch(const std::exception &e){
+        YLOGINFO("Unable to use regular grid interpolation (" << e.what() << "), falling back to adjacency index");
+        const auto row_unit = orig.images.front().row_unit.unit();
+        const auto col_unit = orig.images.front().col_unit.unit();
+        const auto img_unit = col_unit.Cross(row_unit).unit();
+        orig_adj.emplace( std::list<std::reference_wrapper<planar_image<float,double>>>{},
+                          std::list<std::reference_wrapper<planar_image_collection<float,double>>>{
+                              { std::ref(orig) } },
+                          img_unit );
+    }
+
+    // Content moves by the forward displacement, so each voxel pulls from the inverse-transformed position.
+    const auto inv = Invert_Deformation_Field(*this);
+    const auto &f_interp = inv.interp.value();
+    std::vector<planar_image<float,double>*> img_ptrs;
+    for(auto &img : imgs.images) img_ptrs.push_back(&img);
+
+    // Each image is processed independently. Along each row, voxel positions (and the corresponding continuous
+    // coordinates in the field) advance by a constant step, so they are evaluated incrementally.
+    parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(img_ptrs.size()), [&](int64_t n){
+        auto &img = *(img_ptrs[n]);
+        const auto N_rows = static_cast<int64_t>(img.rows);
+        const auto N_cols = static_cast<int64_t>(img.columns);
+        const auto N_chns = static_cast<int64_t>(img.channels);
+        if( (N_rows <= 0) || (N_cols <= 0) || (N_chns <= 0) ) return;
+
+        const auto col_step = img.col_unit.unit() * img.pxl_dy;
+        const auto f_origin = f_interp.to_voxel_coords(vec3<double>(0.0, 0.0, 0.0));
+        const auto f_step = f_interp.to_voxel_coords(col_step);
+        std::array<double, 3> f_du;
+        for(size_t a = 0; a < 3; ++a) f_du[a] = f_step[a] - f_origin[a];
+
+        std::vector<vec3<double>> row_pos(N_cols);
+        std::vector<double> vals(N_chns);
+        for(int64_t r = 0; r < N_rows; ++r){
+            // Inverse-transform the voxel positions along the row.
+            const auto p0 = img.position(r, 0);
+            const auto u0 = f_interp.to_voxel_coords(p0);
+            for(int64_t c = 0; c < N_cols; ++c){
+                const auto x = static_cast<double>(c);
+                const std::array<double, 3> u = {{ u0[0] + f_du[0] * x, u0[1] + f_du[1] * x, u0[2] + f_du[2] * x }};
+                std::array<double, 3> d = {{ 0.0, 0.0, 0.0 }};
+                f_interp.interpolate(u, 0, 3, d.data());
+                row_pos[c] = p0 + col_step * x + vec3<double>(d[0], d[1], d[2]);
+            }
+
+            // Sample the original images.
+            for(int64_t c = 0; c < N_cols; ++c){
+                if(orig_interp){
+                    if(orig_interp->interpolate(orig_interp->to_voxel_coords(row_pos[c]), 0, N_chns, vals.data())){
+                        for(int64_t h = 0; h < N_chns; ++h) img.reference(r, c, h) = static_cast<float>(vals[h]);
+                    }else{
+                        for(int64_t h = 0; h < N_chns; ++h) img.reference(r, c, h) = oob;
+                    }
+                }else{
+                    for(int64_t h = 0; h < N_chns; ++h){
+                        img.reference(r, c, h) = orig_adj->trilinearly_interpolate(row_pos[c], h, oob);
+                    }
+                }
+            }
+        }
+    });
     return;
 }
 
@@ -131,3 +220,82 @@ deformation_field::read_from( std::istream &is ){
     return (!is.fail());
 }
 
+
+deformation_field
+Compose_Deformation_Fields(const std::list<std::reference_wrapper<const deformation_field>> &fields){
+    if(fields.empty()){
+        throw std::invalid_argument("No deformation fields provided. Cannot continue.");
+    }
+
+    // The composed displacement is sampled at the voxels of the first field.
+    auto out = fields.front().get().get_imagecoll_crefw().get();
+    std::vector<planar_image<double,double>*> img_ptrs;
+    for(auto &img : out.images) img_ptrs.push_back(&img);
+
+    parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(img_ptrs.size()), [&](int64_t n){
+        auto &img = *(img_ptrs[n]);
+        for(int64_t r = 0; r < img.rows; ++r){
+            for(int64_t c = 0; c < img.columns; ++c){
+                const auto p = img.position(r, c);
+                auto v = p;
+                for(const auto &f : fields) v = f.get().transform(v);
+                const auto d = v - p;
+                img.reference(r, c, 0) = d.x;
+                img.reference(r, c, 1) = d.y;
+                img.reference(r, c, 2) = d.z;
+            }
+        }
+    });
+    return deformation_field(std::move(out));
+}
+
+deformation_field
+Invert_Deformation_Field(const deformation_field &in){
+    const auto &in_field = in.get_imagecoll_crefw().get();
+    if(in_field.images.empty()){
+        throw std::invalid_argument("Deformation field contains no images. Cannot continue.");
+    }
+
+    // Iteration stops once the update is small compared to the field's voxel dimensions.
+    const auto &img0 = in_field.images.front();
+    const double tol = 1.0E-3 * std::min({ img0.pxl_dx, img0.pxl_dy, img0.pxl_dz });
+    const int64_t max_iters = 50;
+
+    // The inverse displacement is sampled at the voxels of the input field.
+    auto out = in_field;
+    std::vector<planar_image<double,double>*> img_ptrs;
+    for(auto &img : out.images) img_ptrs.push_back(&img);
+
+    std::atomic<int64_t> N_unconverged = 0;
+    parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(img_ptrs.size()), [&](int64_t n){
+        auto &img = *(img_ptrs[n]);
+        for(int64_t r = 0; r < img.rows; ++r){
+            for(int64_t c = 0; c < img.columns; ++c){
+                // Find q such that q + d(q) = p by iterating q <- p - d(q).
+                const auto p = img.position(r, c);
+                auto q = p;
+                bool converged = false;
+                for(int64_t i = 0; i < max_iters; ++i){
+                    const auto q_next = p - (in.transform(q) - q);
+                    const auto dq = q_next.distance(q);
+                    q = q_next;
+                    if(dq < tol){
+                        converged = true;
+                        break;
+                    }
+                }
+                if(!converged) ++N_unconverged;
+
+                const auto d = q - p;
+                img.reference(r, c, 0) = d.x;
+                img.reference(r, c, 1) = d.y;
+                img.reference(r, c, 2) = d.z;
+            }
+        }
+    });
+    if(0 < N_unconverged){
+        YLOGWARN("Deformation field inversion did not converge for " << N_unconverged.load() << " voxels");
+    }
+    return deformation_field(std::move(out));
+}
+
@@ -2,10 +2,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <optional>
 #include <list>
 #include <functional>
 #include <iosfwd>
+#include <stdexcept>
+#include <vector>
 
 #include "YgorMisc.h"         //Needed for FUNCINFO, FUNCWARN, FUNCERR macros.
 #include "YgorLog.h"
@@ -13,17 +19,164 @@
 #include "YgorImages.h"       //Needed for vec3 class.
 
 
+// An index over a regular grid of images (i.e., rectilinear, uniformly spaced, and with identical row, column, and
+// channel counts) that provides fast voxel look-up and trilinear interpolation.
+//
+// Continuous voxel coordinates are used, where the centre of voxel (row, column, image) = (i, j, k) is at (i, j, k).
+// Interpolation is performed between voxel centres. Positions within half a voxel of the outermost voxel centres are
+// clamped to the outermost voxels, and positions beyond are out-of-bounds.
+//
+// The index refers to the image data, which must outlive the index and must not be resized.
+template <class T, class R>
+class regular_grid_interpolator {
+    public:
+        vec3<R> zero; // Centre of voxel (0,0,0).
+        vec3<R> row_unit;
+        vec3<R> col_unit;
+        vec3<R> img_unit;
+        R pxl_dx = 1.0;
+        R pxl_dy = 1.0;
+        R pxl_dz = 1.0; // Separation between image centres, or the image thickness if there is a single image.
+        int64_t N_rows = 0;
+        int64_t N_cols = 0;
+        int64_t N_imgs = 0;
+        int64_t N_chns = 0;
+
+        // Offsets between adjacent rows, columns, and channels within each image's data buffer.
+        int64_t row_stride = 0;
+        int64_t col_stride = 0;
+        int64_t chn_stride = 0;
+
+        std::vector<const T*> slices; // Image data, ordered along img_unit.
+
+        // Throws if the images do not form a regular grid.
+        explicit regular_grid_interpolator(const planar_image_collection<T,R> &imgs);
+
+        std::array<R,3> to_voxel_coords(const vec3<R> &p) const {
+            const auto d = p - this->zero;
+            return {{ d.Dot(this->row_unit) / this->pxl_dx,
+                      d.Dot(this->col_unit) / this->pxl_dy,
+                      d.Dot(this->img_unit) / this->pxl_dz }};
+        }
+
+        // Interpolates channels [chn, chn + N) at the given continuous voxel coordinates, writing the results to 'out'.
+        // Returns false, leaving 'out' unaltered, if the coordinates are out-of-bounds.
+        bool interpolate(const std::array<R,3> &u, int64_t chn, int64_t N, R *out) const {
+            const std::array<int64_t,3> dims = {{ this->N_rows, this->N_cols, this->N_imgs }};
+            std::array<int64_t,3> i0;
+            std::array<int64_t,3> i1;
+            std::array<R,3> f;
+            for(size_t a = 0; a < 3; ++a){
+                const auto n = static_cast<R>(dims[a]);
+                if( !(static_cast<R>(-0.5) <= u[a]) || !(u[a] <= n - static_cast<R>(0.5)) ) return false;
+                const auto x = std::clamp<R>(u[a], static_cast<R>(0), n - static_cast<R>(1));
+                i0[a] = std::min<int64_t>(static_cast<int64_t>(x), dims[a] - 1);
+                i1[a] = std::min<int64_t>(i0[a] + 1, dims[a] - 1);
+                f[a] = x - static_cast<R>(i0[a]);
+            }
+            const T *s0 = this->slices[i0[2]];
+            const T *s1 = this->slices[i1[2]];
+            const int64_t o00 = i0[0] * this->row_stride + i0[1] * this->col_stride;
+            const int64_t o01 = i0[0] * this->row_stride + i1[1] * this->col_stride;
+            const int64_t o10 = i1[0] * this->row_stride + i0[1] * this->col_stride;
+            const int64_t o11 = i1[0] * this->row_stride + i1[1] * this->col_stride;
+            const R w000 = (1 - f[0]) * (1 - f[1]) * (1 - f[2]);
+            const R w010 = (1 - f[0]) * f[1] * (1 - f[2]);
+            const R w100 = f[0] * (1 - f[1]) * (1 - f[2]);
+            const R w110 = f[0] * f[1] * (1 - f[2]);
+            const R w001 = (1 - f[0]) * (1 - f[1]) * f[2];
+            const R w011 = (1 - f[0]) * f[1] * f[2];
+            const R w101 = f[0] * (1 - f[1]) * f[2];
+            const R w111 = f[0] * f[1] * f[2];
+            for(int64_t c = 0; c < N; ++c){
+                const int64_t oc = (chn + c) * this->chn_stride;
+                out[c] = w000 * static_cast<R>(s0[o00 + oc]) + w010 * static_cast<R>(s0[o01 + oc])
+                       + w100 * static_cast<R>(s0[o10 + oc]) + w110 * static_cast<R>(s0[o11 + oc])
+                       + w001 * static_cast<R>(s1[o00 + oc]) + w011 * static_cast<R>(s1[o01 + oc])
+                       + w101 * static_cast<R>(s1[o10 + oc]) + w111 * static_cast<R>(s1[o11 + oc]);
+            }
+            return true;
+        }
+};
+
+template <class T, class R>
+regular_grid_interpolator<T,R>::regular_grid_interpolator(const planar_image_collection<T,R> &imgs){
+    if(imgs.images.empty()){
+        throw std::invalid_argument("No images provided");
+    }
+    const auto &front = imgs.images.front();
+    this->row_unit = front.row_unit.unit();
+    this->col_unit = front.col_unit.unit();
+    this->img_unit = this->col_unit.Cross(this->row_unit).unit();
+    this->pxl_dx = front.pxl_dx;
+    this->pxl_dy = front.pxl_dy;
+    this->N_rows = front.rows;
+    this->N_cols = front.columns;
+    this->N_chns = front.channels;
+    if( (this->N_rows <= 0) || (this->N_cols <= 0) || (this->N_chns <= 0) ){
+        throw std::invalid_argument("Encountered an empty image");
+    }
+
+    // Order the images along the image axis and confirm they are uniformly spaced and aligned.
+    std::vector<const planar_image<T,R>*> ordered;
+    for(const auto &img : imgs.images) ordered.push_back(&img);
+    std::sort(std::begin(ordered), std::end(ordered), [&](const auto *A, const auto *B){
+        return (A->position(0,0).Dot(this->img_unit) < B->position(0,0).Dot(this->img_unit));
+    });
+    this->zero = ordered.front()->position(0,0);
+    this->N_imgs = static_cast<int64_t>(ordered.size());
+    this->pxl_dz = (1 < this->N_imgs) ? (ordered[1]->position(0,0) - this->zero).Dot(this->img_unit)
+                                      : front.pxl_dz;
+    if( !std::isfinite(this->pxl_dx) || !std::isfinite(this->pxl_dy) || !std::isfinite(this->pxl_dz)
+    ||  (this->pxl_dx <= 0) || (this->pxl_dy <= 0) || (this->pxl_dz <= 0) ){
+        throw std::invalid_argument("Images have invalid voxel dimensions");
+    }
+
+    const auto tol = static_cast<R>(1.0E-3) * std::min({ this->pxl_dx, this->pxl_dy, this->pxl_dz });
+    for(int64_t k = 0; k < this->N_imgs; ++k){
+        const auto &img = *(ordered[k]);
+        if( (img.rows != front.rows) || (img.columns != front.columns) || (img.channels != front.channels)
+        ||  (tol < std::abs(img.pxl_dx - this->pxl_dx)) || (tol < std::abs(img.pxl_dy - this->pxl_dy))
+        ||  (static_cast<R>(1.0E-6) < (img.row_unit.unit() - this->row_unit).length())
+        ||  (static_cast<R>(1.0E-6) < (img.col_unit.unit() - this->col_unit).length()) ){
+            throw std::invalid_argument("Images do not have consistent geometry");
+        }
+        const auto expected = this->zero + this->img_unit * (this->pxl_dz * static_cast<R>(k));
+        if(tol < img.position(0,0).distance(expected)){
+            throw std::invalid_argument("Images are not uniformly spaced");
+        }
+
+        const auto i00 = img.index(0,0,0);
+        const int64_t row_stride = (1 < this->N_rows) ? img.index(1,0,0) - i00 : 0;
+        const int64_t col_stride = (1 < this->N_cols) ? img.index(0,1,0) - i00 : 0;
+        const int64_t chn_stride = (1 < this->N_chns) ? img.index(0,0,1) - i00 : 0;
+        if(k == 0){
+            this->row_stride = row_stride;
+            this->col_stride = col_stride;
+            this->chn_stride = chn_stride;
+        }else if( (row_stride != this->row_stride) || (col_stride != this->col_stride) || (chn_stride != this->chn_stride) ){
+            throw std::invalid_argument("Images do not have consistent memory layouts");
+        }
+        this->slices.push_back( img.data.data() + i00 );
+    }
+}
+
+
 class deformation_field {
     private:
-        // These are private so they stay synchronized. The adjacency index is rebuilt when the field is altered.
+        // These are private so they stay synchronized. The interpolation index is rebuilt when the field is altered.
         planar_image_collection<double,double> field; // Vector displacement field. 3 channels required.
-        std::optional<planar_image_adjacency<double,double>> adj; // Index used to provide faster look-up and 3D interpolation.
+        std::optional<regular_grid_interpolator<double,double>> interp; // Index used to provide fast 3D interpolation.
 
     public:
         // Constructor.
         deformation_field() = delete; // Ensures field always valid -- use optional for empty transform.
         deformation_field(std::istream &is); // Defers to read_from(), but throws on errors.
         deformation_field(planar_image_collection<double,double> &&);
+        deformation_field(const deformation_field &); // Rebuilds the index so it refers to the copied field.
+        deformation_field(deformation_field &&) = default;
+        deformation_field & operator=(const deformation_field &);
+        deformation_field & operator=(deformation_field &&) = default;
 
         // Re-constructor.
         void swap_and_rebuild(planar_image_collection<double,double> &);
@@ -36,11 +189,26 @@ class deformation_field {
         void apply_to(point_set<double> &ps) const; // Included for parity with affine_transform class.
         void apply_to(vec3<double> &v) const;       // Included for parity with affine_transform class.
 
-        void apply_to(planar_image<float, double> &img) const;
-        void apply_to(planar_image_collection<float, double> &img) const;
+        // Resample images in-place so that image content moves the same way points do, i.e., content at position v
+        // moves to transform(v). The field is inverted (see Invert_Deformation_Field()) and each voxel then pulls its
+        // value from the original images at the inverse-transformed voxel position. Voxels that map outside of the
+        // original images are assigned the out-of-bounds value.
+        void apply_to(planar_image<float, double> &img, float oob = 0.0f) const;
+        void apply_to(planar_image_collection<float, double> &img, float oob = 0.0f) const;
 
         // Serialize and deserialize to a human- and machine-readable format.
         bool write_to( std::ostream &os ) const;
         bool read_from( std::istream &is );
 };
 
+// Composes a sequence of deformation fields into a single field, sampled on the grid of the first field, so that
+// out.transform(v) approximates fields.back().transform( ... fields.front().transform(v) ... ).
+deformation_field
+Compose_Deformation_Fields(const std::list<std::reference_wrapper<const deformation_field>> &fields);
+
+// Inverts a deformation field, sampling the inverse on the same grid, so that out.transform(in.transform(v)) is
+// approximately v. The inverse is found by fixed-point iteration, which converges when the field is smooth relative to
+// its magnitude (i.e., the field does not fold). Where iteration fails to converge the last iterate is used.
+deformation_field
+Invert_Deformation_Field(const deformation_field &in);
+
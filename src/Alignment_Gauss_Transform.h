@@ -0,0 +1,218 @@
+//Alignment_Gauss_Transform.h - A part of DICOMautomaton 2024. Written by hal clark.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#ifdef DCMA_USE_EIGEN
+    #include <eigen3/Eigen/Dense>
+
+    #include "../pc_registration/src/IFGT.h"
+#endif
+
+#include "YgorMath.h"
+
+#include "Thread_Pool.h"
+
+// This file provides helpers for evaluating sums over Gaussian kernels between two point clouds, which are needed by
+// probabilistic point set registration algorithms (e.g., TPS-RPM and CPD).
+//
+// Truncated sums, which only consider nearby pairs of points, are evaluated with a uniform grid. Sums over all pairs
+// can be approximated with the improved fast Gauss transform.
+
+namespace dcma_gauss_transform {
+
+// A uniform grid for locating points near a query point.
+//
+// The grid refers to the points, which must outlive it.
+class point_grid {
+    private:
+        const std::vector<vec3<double>> *pts = nullptr;
+        vec3<double> lo;
+        double cell = 1.0;
+        std::array<int64_t, 3> dims = {{ 1, 1, 1 }};
+        std::vector<int64_t> cell_start; // Offsets into 'indices' for each cell, plus one past the end.
+        std::vector<int64_t> indices;
+
+        int64_t cell_index(double x, int64_t n) const {
+            const auto i = std::clamp(std::floor(x / this->cell), 0.0, static_cast<double>(n - 1));
+            return static_cast<int64_t>(i);
+        }
+
+    public:
+        point_grid(const std::vector<vec3<double>> &points, double cell_size) : pts(&points) {
+            const auto N = static_cast<int64_t>(points.size());
+            const auto inf = std::numeric_limits<double>::infinity();
+            this->lo = vec3<double>(inf, inf, inf);
+            vec3<double> hi(-inf, -inf, -inf);
+            for(const auto &p : points){
+                this->lo.x = std::min(this->lo.x, p.x);
+                this->lo.y = std::min(this->lo.y, p.y);
+                this->lo.z = std::min(this->lo.z, p.z);
+                hi.x = std::max(hi.x, p.x);
+                hi.y = std::max(hi.y, p.y);
+                hi.z = std::max(hi.z, p.z);
+            }
+            if(N == 0){
+                this->lo = vec3<double>(0.0, 0.0, 0.0);
+                this->cell_start.assign(2, 0);
+                return;
+            }
+            const std::array<double, 3> extent = {{ hi.x - this->lo.x, hi.y - this->lo.y, hi.z - this->lo.z }};
+
+            // Limit the number of cells to a small multiple of the number of points.
+            // If no cell size is provided, aim for a handful of points per cell.
+            const auto max_extent = std::max({ extent[0], extent[1], extent[2] });
+            const auto default_cell = (0.0 < max_extent) ? max_extent / std::cbrt(static_cast<double>(N)) : 1.0;
+            this->cell = (std::isfinite(cell_size) && (0.0 < cell_size)) ? cell_size : default_cell;
+            const double max_cells = 4.0 * static_cast<double>(N) + 64.0;
+            while(true){
+                double n = 1.0;
+                for(const auto &e : extent) n *= std::floor(e / this->cell) + 1.0;
+                if(n <= max_cells) break;
+                this->cell *= std::max(1.01, std::cbrt(n / max_cells));
+            }
+            for(size_t a = 0; a < 3; ++a) this->dims[a] = static_cast<int64_t>(std::floor(extent[a] / this->cell)) + 1;
+
+            // Counting sort the points into cells.
+            const auto N_cells = this->dims[0] * this->dims[1] * this->dims[2];
+            std::vector<int64_t> point_cell(N);
+            this->cell_start.assign(N_cells + 1, 0);
+            for(int64_t i = 0; i < N; ++i){
+                const auto rel = points[i] - this->lo;
+                const auto c = ( this->cell_index(rel.z, this->dims[2]) * this->dims[1]
+                               + this->cell_index(rel.y, this->dims[1]) ) * this->dims[0]
+                               + this->cell_index(rel.x, this->dims[0]);
+                point_cell[i] = c;
+                ++(this->cell_start[c + 1]);
+            }
+            for(int64_t c = 0; c < N_cells; ++c) this->cell_start[c + 1] += this->cell_start[c];
+            auto fill = this->cell_start;
+            this->indices.resize(N);
+            for(int64_t i = 0; i < N; ++i) this->indices[ fill[point_cell[i]]++ ] = i;
+        }
+
+        // Invokes f(index, sq_dist) for every point within distance r of p.
+        template <class F>
+        void for_each_within(const vec3<double> &p, double r, F &&f) const {
+            if(this->indices.empty()) return;
+            const auto r_sq = r * r;
+            const auto rel = p - this->lo;
+            const auto i_lo = this->cell_index(rel.x - r, this->dims[0]);
+            const auto i_hi = this->cell_index(rel.x + r, this->dims[0]);
+            const auto j_lo = this->cell_index(rel.y - r, this->dims[1]);
+            const auto j_hi = this->cell_index(rel.y + r, this->dims[1]);
+            const auto k_lo = this->cell_index(rel.z - r, this->dims[2]);
+            const auto k_hi = this->cell_index(rel.z + r, this->dims[2]);
+            for(int64_t k = k_lo; k <= k_hi; ++k){
+                for(int64_t j = j_lo; j <= j_hi; ++j){
+                    const auto row = (k * this->dims[1] + j) * this->dims[0];
+                    const auto b = this->cell_start[row + i_lo];
+                    const auto e = this->cell_start[row + i_hi + 1];
+                    for(int64_t n = b; n < e; ++n){
+                        const auto idx = this->indices[n];
+                        const auto sq_dist = p.sq_dist( (*(this->pts))[idx] );
+                        if(sq_dist <= r_sq) f(idx, sq_dist);
+                    }
+                }
+            }
+            return;
+        }
+
+        // Returns the squared distance to the nearest point, ignoring the point with index 'ignore' (if any).
+        double nearest_sq_dist(const vec3<double> &p, int64_t ignore = -1) const {
+            double r = this->cell;
+            double best = std::numeric_limits<double>::infinity();
+            for(long int n = 0; n < 128; ++n){
+                this->for_each_within(p, r, [&](int64_t idx, double sq_dist){
+                    if( (idx != ignore) && (sq_dist < best) ) best = sq_dist;
+                });
+                if(best <= r * r) break;
+                r *= 2.0;
+            }
+            return best;
+        }
+};
+
+// Selects a well-spread subset of points by repeatedly choosing the point farthest from those already selected.
+inline std::vector<int64_t>
+farthest_point_sample(const std::vector<vec3<double>> &points, int64_t N_samples){
+    const auto N = static_cast<int64_t>(points.size());
+    std::vector<int64_t> out;
+    if(N <= N_samples){
+        for(int64_t i = 0; i < N; ++i) out.push_back(i);
+        return out;
+    }
+
+    std::vector<double> sq_dists(N, std::numeric_limits<double>::infinity());
+    using farthest_t = std::pair<double, int64_t>;
+    int64_t next = 0;
+    while(static_cast<int64_t>(out.size()) < N_samples){
+        out.push_back(next);
+        const auto P = points[next];
+        const auto farthest = parallel_reduce(0, N, farthest_t{ -1.0, -1 },
+            [&](int64_t b, int64_t e, farthest_t f) -> farthest_t {
+                for(int64_t i = b; i < e; ++i){
+                    sq_dists[i] = std::min(sq_dists[i], P.sq_dist(points[i]));
+                    if(f.first < sq_dists[i]) f = { sq_dists[i], i };
+                }
+                return f;
+            },
+            [](const farthest_t &A, const farthest_t &B) -> farthest_t {
+                return (A.first < B.first) ? B : A;
+            });
+        if(farthest.second < 0) break;
+        next = farthest.second;
+    }
+    return out;
+}
+
+#ifdef DCMA_USE_EIGEN
+// Copies points into an N x 3 matrix, which is the format expected by the fast Gauss transform.
+inline Eigen::MatrixXf
+to_matrix(const std::vector<vec3<double>> &points){
+    Eigen::MatrixXf out(static_cast<Eigen::Index>(points.size()), 3);
+    for(size_t i = 0; i < points.size(); ++i){
+        out(i, 0) = static_cast<float>(points[i].x);
+        out(i, 1) = static_cast<float>(points[i].y);
+        out(i, 2) = static_cast<float>(points[i].z);
+    }
+    return out;
+}
+
+// Evaluates a weighted fast Gauss transform at the target points, splitting the targets into contiguous blocks that
+// are processed concurrently. The cluster expansion coefficients are computed once and shared by all blocks.
+inline std::vector<double>
+parallel_ifgt(const IFGT &ifgt,
+              const Eigen::MatrixXf &targets,
+              const std::vector<double> &w){
+    Eigen::ArrayXf w_f(static_cast<Eigen::Index>(w.size()));
+    for(size_t i = 0; i < w.size(); ++i) w_f(i) = static_cast<float>(w[i]);
+
+    const auto N = static_cast<int64_t>(targets.rows());
+    const bool use_ifgt = ifgt.prefers_ifgt(static_cast<int>(N));
+    const Eigen::MatrixXf C_k = use_ifgt ? ifgt.compute_ck(w_f) : Eigen::MatrixXf();
+
+    const auto N_blocks = std::clamp<int64_t>(static_cast<int64_t>(work_stealing_scheduler::global().concurrency()), 1, std::max<int64_t>(1, N));
+    std::vector<double> out(N, 0.0);
+    parallel_for(0, N_blocks, [&](int64_t n){
+        const auto b = (N * n) / N_blocks;
+        const auto e = (N * (n + 1)) / N_blocks;
+        if(e <= b) return;
+        const Eigen::MatrixXf block = targets.middleRows(b, e - b);
+        const Eigen::MatrixXf G = use_ifgt ? ifgt.compute_gaussian(block, C_k)
+                                           : ifgt.compute_naive(block, w_f);
+        for(int64_t i = b; i < e; ++i) out[i] = static_cast<double>(G(i - b, 0));
+    }, 1);
+    return out;
+}
+#endif // DCMA_USE_EIGEN
+
+} // namespace dcma_gauss_transform
+
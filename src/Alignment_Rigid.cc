@@ -539,7 +539,7 @@ AlignViaExhaustiveICP( const point_set<double> & moving,
         const auto N_working_points = working.points.size();
         if(N_working_points != corresp.points.size()) throw std::logic_error("Encountered inconsistent working buffers. Cannot continue.");
         {
-            asio_thread_pool tp;
+            task_group tp;
             for(size_t i = 0; i < N_working_points; ++i){
                 tp.submit_task([&,i]() -> void {
                     const auto w_p = working.points[i];
@@ -553,6 +553,7 @@ AlignViaExhaustiveICP( const point_set<double> & moving,
                     }
                 }); // thread pool task closure.
             }
+            tp.wait();
         } // Wait until all threads are done.
 
 
@@ -2,9 +2,14 @@
 
 #include <asio.hpp>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <optional>
 #include <fstream>
+#include <iomanip>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
@@ -37,6 +42,7 @@
 
 #include "Alignment_Rigid.h"
 #include "Alignment_TPSRPM.h"
+#include "Alignment_Gauss_Transform.h"
 
 thin_plate_spline::thin_plate_spline(std::istream &is){
     if(!this->read_from(is)){
@@ -320,6 +326,641 @@ AlignViaTPS(AlignViaTPSParams & params,
 
 
 
+#ifdef DCMA_USE_EIGEN
+namespace {
+
+using dcma_gauss_transform::point_grid;
+using dcma_gauss_transform::farthest_point_sample;
+
+// Sums over the softassign correspondence kernel K_ij = exp(-|y_i - x_j|^2 / T) between moving points y_i and
+// stationary points x_j. Kernel coefficients are either stored sparsely, omitting negligible coefficients, or
+// approximated using the improved fast Gauss transform.
+class correspondence_kernel {
+    private:
+        bool use_ifgt = false;
+        int64_t N_rows = 0;
+        int64_t N_cols = 0;
+
+        // Sparse coefficients, stored both by row and by column.
+        std::vector<int64_t> row_start;
+        std::vector<int64_t> row_cols;
+        std::vector<double> row_vals;
+        std::vector<int64_t> col_start;
+        std::vector<int64_t> col_rows;
+        std::vector<double> col_vals;
+
+        // Fast Gauss transforms with the stationary and moving points as sources, respectively.
+        Eigen::MatrixXf scaled_moving;
+        Eigen::MatrixXf scaled_stationary;
+        std::unique_ptr<IFGT> ifgt_stationary;
+        std::unique_ptr<IFGT> ifgt_moving;
+
+    public:
+        correspondence_kernel(const std::vector<vec3<double>> &moving,
+                              const std::vector<vec3<double>> &stationary,
+                              double T,
+                              double truncation,
+                              int64_t max_sparse_coeffs,
+                              double ifgt_epsilon)
+          : N_rows(static_cast<int64_t>(moving.size())),
+            N_cols(static_cast<int64_t>(stationary.size())) {
+
+            const auto cutoff = std::sqrt( T * std::log(1.0 / truncation) );
+            const point_grid grid(stationary, cutoff);
+
+            // Estimate the number of coefficients by sampling, and only use sparse storage if it would be reasonable.
+            if( (0 < this->N_rows) && (0 < this->N_cols) ){
+                const int64_t N_samples = std::min<int64_t>(this->N_rows, 64);
+                const auto sample_count = parallel_reduce(0, N_samples, static_cast<int64_t>(0),
+                    [&](int64_t b, int64_t e, int64_t count) -> int64_t {
+                        for(int64_t n = b; n < e; ++n){
+                            grid.for_each_within(moving[(n * this->N_rows) / N_samples], cutoff, [&](int64_t, double){ ++count; });
+                        }
+                        return count;
+                    },
+                    [](int64_t A, int64_t B) -> int64_t { return A + B; }, 1);
+                const auto est_coeffs = static_cast<double>(sample_count) * static_cast<double>(this->N_rows)
+                                      / static_cast<double>(N_samples);
+                this->use_ifgt = (static_cast<double>(max_sparse_coeffs) < est_coeffs);
+            }
+
+            if(this->use_ifgt){
+                const auto m = dcma_gauss_transform::to_matrix(moving);
+                const auto s = dcma_gauss_transform::to_matrix(stationary);
+                // Note: the IFGT kernel is exp(-d^2 / h^2), so the bandwidth is sqrt(T).
+                const auto h = rescale_points(s, m, this->scaled_stationary, this->scaled_moving, std::sqrt(T));
+                this->ifgt_stationary = std::make_unique<IFGT>(this->scaled_stationary, h, ifgt_epsilon);
+                this->ifgt_moving = std::make_unique<IFGT>(this->scaled_moving, h, ifgt_epsilon);
+                return;
+            }
+
+            // Gather the coefficients for each row.
+            std::vector<std::vector<std::pair<int64_t, double>>> rows(this->N_rows);
+            parallel_for(0, this->N_rows, [&](int64_t i){
+                auto &r = rows[i];
+                grid.for_each_within(moving[i], cutoff, [&](int64_t j, double sq_dist){
+                    r.emplace_back(j, std::exp(-sq_dist / T));
+                });
+                std::sort(std::begin(r), std::end(r));
+            });
+
+            this->row_start.assign(this->N_rows + 1, 0);
+            this->col_start.assign(this->N_cols + 1, 0);
+            for(int64_t i = 0; i < this->N_rows; ++i){
+                this->row_start[i + 1] = this->row_start[i] + static_cast<int64_t>(rows[i].size());
+                for(const auto &c : rows[i]) ++(this->col_start[c.first + 1]);
+            }
+            for(int64_t j = 0; j < this->N_cols; ++j) this->col_start[j + 1] += this->col_start[j];
+
+            const auto N_coeffs = this->row_start.back();
+            this->row_cols.resize(N_coeffs);
+            this->row_vals.resize(N_coeffs);
+            this->col_rows.resize(N_coeffs);
+            this->col_vals.resize(N_coeffs);
+            auto col_fill = this->col_start;
+            for(int64_t i = 0; i < this->N_rows; ++i){
+                auto n = this->row_start[i];
+                for(const auto &c : rows[i]){
+                    this->row_cols[n] = c.first;
+                    this->row_vals[n] = c.second;
+                    ++n;
+
+                    auto &m = col_fill[c.first];
+                    this->col_rows[m] = i;
+                    this->col_vals[m] = c.second;
+                    ++m;
+                }
+                rows[i] = {};
+            }
+        }
+
+        bool is_sparse() const {
+            return !this->use_ifgt;
+        }
+
+        int64_t coefficient_count() const {
+            return this->use_ifgt ? this->N_rows * this->N_cols : this->row_start.back();
+        }
+
+        // Returns (K w)_i = sum_j K_ij w_j.
+        std::vector<double> row_sums(const std::vector<double> &w) const {
+            if(this->use_ifgt) return dcma_gauss_transform::parallel_ifgt(*(this->ifgt_stationary), this->scaled_moving, w);
+
+            std::vector<double> out(this->N_rows, 0.0);
+            parallel_for(0, this->N_rows, [&](int64_t i){
+                double s = 0.0;
+                for(int64_t n = this->row_start[i]; n < this->row_start[i + 1]; ++n){
+                    s += this->row_vals[n] * w[ this->row_cols[n] ];
+                }
+                out[i] = s;
+            });
+            return out;
+        }
+
+        // Returns (K^T v)_j = sum_i K_ij v_i.
+        std::vector<double> col_sums(const std::vector<double> &v) const {
+            if(this->use_ifgt) return dcma_gauss_transform::parallel_ifgt(*(this->ifgt_moving), this->scaled_stationary, v);
+
+            std::vector<double> out(this->N_cols, 0.0);
+            parallel_for(0, this->N_cols, [&](int64_t j){
+                double s = 0.0;
+                for(int64_t n = this->col_start[j]; n < this->col_start[j + 1]; ++n){
+                    s += this->col_vals[n] * v[ this->col_rows[n] ];
+                }
+                out[j] = s;
+            });
+            return out;
+        }
+};
+
+// The scalable variant of AlignViaTPSRPM(). See the description of the scalable engine in AlignViaTPSRPMParams.
+//
+// The correspondence matrix is represented implicitly as
+//
+//     M_ij = a_i * c * K_ij * b_j                for non-outlier coefficients,
+//     M_i,gutter = a_i * h_i                     for the moving point outlier coefficients, and
+//     M_gutter,j = g_j * b_j                     for the stationary point outlier coefficients,
+//
+// where c is a constant factor, h and g are the outlier ('gutter') coefficients, and a and b are the row and column
+// scaling factors found by the Sinkhorn procedure. Forced correspondences are exact, so they are excluded from the
+// kernel and handled explicitly.
+//
+// The thin plate spline is approximated by restricting the warp to a set of control points, and fitting
+// (in a least-squares sense) the correspondence-weighted targets, i.e.,
+//
+//     min_{W,A}  sum_i omega_i |Y_i - f(x_i)|^2 + lambda * tr(W^T K_cc W)   subject to P_c^T W = 0,
+//
+// which is equivalent to the dense formulation when all moving points are control points and omega_i = 1.
+std::optional<thin_plate_spline>
+AlignViaTPSRPM_Scalable(AlignViaTPSRPMParams & params,
+                        const point_set<double> & moving,
+                        const point_set<double> & stationary,
+                        double T_start,
+                        double T_end,
+                        double L_1_start,
+                        double L_2_start ){
+
+    const auto N_move_points = static_cast<long int>(moving.points.size());
+    const auto N_stat_points = static_cast<long int>(stationary.points.size());
+    const auto com_stat = stationary.Centroid();
+
+    if( !(0.0 < params.correspondence_truncation) || !(params.correspondence_truncation < 1.0) ){
+        throw std::invalid_argument("Correspondence truncation parameter is invalid. Cannot continue.");
+    }
+    if( !(0.0 < params.fast_gauss_transform_epsilon) || !(params.fast_gauss_transform_epsilon < 1.0) ){
+        throw std::invalid_argument("Fast Gauss transform accuracy parameter is invalid. Cannot continue.");
+    }
+    if(params.max_control_points < 5){
+        throw std::invalid_argument("At least five control points are required. Cannot continue.");
+    }
+
+    // Select the control points.
+    const auto cp_indices = farthest_point_sample(moving.points, params.max_control_points);
+    point_set<double> control_points;
+    for(const auto &i : cp_indices) control_points.points.emplace_back( moving.points[i] );
+    const auto N_ctrl = static_cast<long int>(control_points.points.size());
+    const auto N_coeffs = N_ctrl + 4;
+    YLOGINFO("Using " << N_ctrl << " of " << N_move_points << " moving points as control points");
+
+    thin_plate_spline t(control_points, params.kernel_dimension);
+    Eigen::Map<Eigen::Matrix< double,
+                              Eigen::Dynamic,
+                              Eigen::Dynamic,
+                              Eigen::ColMajor >> W_A(&(*(t.W_A.begin())), N_coeffs, 3);
+    if( (t.W_A.num_rows() != W_A.rows())
+    ||  (t.W_A.num_cols() != W_A.cols()) ){
+        throw std::logic_error("TPS coefficient matrix dimesions do not match. Refusing to continue.");
+    }
+
+    if(params.seed_with_centroid_shift){
+        auto t_com = AlignViaCentroid(moving, stationary);
+        if(!t_com){
+            YLOGWARN("Unable to compute centroid seed transformation");
+            return std::nullopt;
+        }
+        W_A(N_ctrl + 0, 0) = t_com.value().read_coeff(3,0);
+        W_A(N_ctrl + 0, 1) = t_com.value().read_coeff(3,1);
+        W_A(N_ctrl + 0, 2) = t_com.value().read_coeff(3,2);
+    }
+
+    // Control point kernel and polynomial matrices.
+    Eigen::MatrixXd K_cc(N_ctrl, N_ctrl);
+    for(long int i = 0; i < N_ctrl; ++i){
+        K_cc(i, i) = t.eval_kernel(0.0);
+        for(long int j = i + 1; j < N_ctrl; ++j){
+            const auto kij = t.eval_kernel( control_points.points[i].distance(control_points.points[j]) );
+            K_cc(i, j) = kij;
+            K_cc(j, i) = kij;
+        }
+    }
+
+    // Evaluates the basis functions (i.e., a row of the system matrix) for a single moving point.
+    const auto basis_row = [&](long int i, double *out) -> void {
+        const auto &P = moving.points[i];
+        for(long int c = 0; c < N_ctrl; ++c){
+            out[c] = t.eval_kernel( control_points.points[c].distance(P) );
+        }
+        out[N_ctrl + 0] = 1.0;
+        out[N_ctrl + 1] = P.x;
+        out[N_ctrl + 2] = P.y;
+        out[N_ctrl + 3] = P.z;
+        return;
+    };
+
+    // The basis matrix is cached when it is reasonably small. Otherwise it is re-evaluated block-wise as needed, so the
+    // full N x N_ctrl basis matrix is never stored.
+    using row_major_mat_t = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    const int64_t max_cached_basis_coeffs = 32'000'000;
+    row_major_mat_t Phi_cache;
+    if(static_cast<int64_t>(N_move_points) * static_cast<int64_t>(N_coeffs) <= max_cached_basis_coeffs){
+        Phi_cache.resize(N_move_points, N_coeffs);
+        parallel_for(0, N_move_points, [&](int64_t i){
+            basis_row(i, &(Phi_cache(i, 0)));
+        });
+    }
+
+    // Accumulates the normal equations (Phi^T Omega Phi and Phi^T Omega Y) block-wise.
+    const long int block_rows = 512;
+    const auto N_blocks = (N_move_points + block_rows - 1) / block_rows;
+    const auto N_tasks = std::max<int64_t>(1, static_cast<int64_t>(work_stealing_scheduler::global().concurrency()));
+    const auto task_grain = std::max<int64_t>(1, (N_blocks + N_tasks - 1) / N_tasks);
+    const auto accumulate_normal_equations = [&](const std::vector<double> &omega,
+                                                 const Eigen::MatrixXd *Y,
+                                                 Eigen::MatrixXd *PtP,
+                                                 Eigen::MatrixXd *PtY) -> void {
+        using partial_t = std::pair<Eigen::MatrixXd, Eigen::MatrixXd>;
+        const partial_t init = { (PtP == nullptr) ? Eigen::MatrixXd() : Eigen::MatrixXd::Zero(N_coeffs, N_coeffs),
+                                 (PtY == nullptr) ? Eigen::MatrixXd() : Eigen::MatrixXd::Zero(N_coeffs, 3) };
+        const auto sum = parallel_reduce(0, N_blocks, init,
+            [&](int64_t b, int64_t e, partial_t acc) -> partial_t {
+                for(int64_t n = b; n < e; ++n){
+                    const auto row_b = n * block_rows;
+                    const auto row_e = std::min<long int>(N_move_points, row_b + block_rows);
+                    const auto N_r = row_e - row_b;
+                    row_major_mat_t Phi_b;
+                    if(Phi_cache.size() != 0){
+                        Phi_b = Phi_cache.middleRows(row_b, N_r);
+                    }else{
+                        Phi_b.resize(N_r, N_coeffs);
+                        for(long int i = row_b; i < row_e; ++i) basis_row(i, &(Phi_b(i - row_b, 0)));
+                    }
+                    Eigen::VectorXd w(N_r);
+                    for(long int i = row_b; i < row_e; ++i) w(i - row_b) = omega[i];
+
+                    if(PtP != nullptr){
+                        acc.first.noalias() += Phi_b.transpose() * w.asDiagonal() * Phi_b;
+                    }
+                    if(PtY != nullptr){
+                        acc.second.noalias() += Phi_b.transpose() * w.asDiagonal() * Y->middleRows(row_b, N_r);
+                    }
+                }
+                return acc;
+            },
+            [](const partial_t &A, const partial_t &B) -> partial_t {
+                return { (A.first.size() == 0) ? A.first : Eigen::MatrixXd(A.first + B.first),
+                         (A.second.size() == 0) ? A.second : Eigen::MatrixXd(A.second + B.second) };
+            }, task_grain);
+        if(PtP != nullptr) *PtP = sum.first;
+        if(PtY != nullptr) *PtY = sum.second;
+        return;
+    };
+
+    // Partition the points into those with forced correspondence and those that are free.
+    std::vector<long int> move_forced_to(N_move_points, -2); // -2 = free, -1 = forced outlier, otherwise stat index.
+    std::vector<long int> stat_forced_to(N_stat_points, -2);
+    for(const auto &apair : params.forced_correspondence){
+        const auto i_is_valid = isininc(0, apair.first, N_move_points - 1);
+        const auto j_is_valid = isininc(0, apair.second, N_stat_points - 1);
+        if(i_is_valid) move_forced_to[apair.first] = j_is_valid ? apair.second : -1;
+        if(j_is_valid) stat_forced_to[apair.second] = i_is_valid ? apair.first : -1;
+    }
+    std::vector<long int> free_move;
+    std::vector<long int> free_stat;
+    for(long int i = 0; i < N_move_points; ++i) if(move_forced_to[i] == -2) free_move.push_back(i);
+    for(long int j = 0; j < N_stat_points; ++j) if(stat_forced_to[j] == -2) free_stat.push_back(j);
+    const auto N_free_move = static_cast<int64_t>(free_move.size());
+    const auto N_free_stat = static_cast<int64_t>(free_stat.size());
+
+    std::vector<vec3<double>> free_stat_points;
+    for(const auto &j : free_stat) free_stat_points.emplace_back( stationary.points[j] );
+
+    std::vector<vec3<double>> moved(N_move_points);
+    const auto update_moved_points = [&]() -> void {
+        if(Phi_cache.size() != 0){
+            parallel_for(0, N_move_points, [&](int64_t i){
+                const Eigen::RowVector3d P = Phi_cache.row(i) * W_A;
+                moved[i] = vec3<double>(P(0), P(1), P(2));
+            });
+        }else{
+            parallel_for(0, N_move_points, [&](int64_t i){
+                moved[i] = t.transform(moving.points[i]);
+            });
+        }
+        return;
+    };
+
+    // State of the most recent correspondence update.
+    std::vector<double> a(N_free_move, 1.0);
+    std::vector<double> b(N_free_stat, 1.0);
+    std::vector<double> h(N_free_move, 0.0);
+    std::vector<double> g(N_free_stat, 0.0);
+    double c = 1.0;
+    std::unique_ptr<correspondence_kernel> kernel;
+    std::vector<vec3<double>> free_moved_points(N_free_move);
+
+    // Update the correspondence. See the dense implementation for details.
+    const auto update_correspondence = [&](double T_now, double s_reg) -> void {
+        update_moved_points();
+        Stats::Running_Sum<double> com_moved_x;
+        Stats::Running_Sum<double> com_moved_y;
+        Stats::Running_Sum<double> com_moved_z;
+        for(const auto &P_moved : moved){
+            com_moved_x.Digest(P_moved.x);
+            com_moved_y.Digest(P_moved.y);
+            com_moved_z.Digest(P_moved.z);
+        }
+        const vec3<double> com_moved( com_moved_x.Current_Sum() / static_cast<double>(N_move_points),
+                                      com_moved_y.Current_Sum() / static_cast<double>(N_move_points),
+                                      com_moved_z.Current_Sum() / static_cast<double>(N_move_points) );
+
+        for(int64_t n = 0; n < N_free_move; ++n) free_moved_points[n] = moved[ free_move[n] ];
+        kernel = std::make_unique<correspondence_kernel>(free_moved_points, free_stat_points, T_now,
+                                                         params.correspondence_truncation,
+                                                         params.max_sparse_correspondences,
+                                                         params.fast_gauss_transform_epsilon);
+
+        c = (1.0 / T_now) * std::exp(s_reg / T_now);
+        for(int64_t n = 0; n < N_free_move; ++n){
+            const auto dP = com_stat - free_moved_points[n];
+            h[n] = params.permit_move_outliers ? (1.0 / T_start) * std::exp( -dP.Dot(dP) / T_start) : 0.0;
+        }
+        for(int64_t n = 0; n < N_free_stat; ++n){
+            const auto dP = free_stat_points[n] - com_moved; // Note: intentionally not transformed.
+            g[n] = params.permit_stat_outliers ? (1.0 / T_start) * std::exp( -dP.Dot(dP) / T_start) : 0.0;
+        }
+
+        // Normalize the rows and columns iteratively using the Sinkhorn procedure.
+        std::fill(std::begin(a), std::end(a), 1.0);
+        std::fill(std::begin(b), std::end(b), 1.0);
+        auto Kb = kernel->row_sums(b);
+        std::vector<double> KTa;
+        const auto machine_eps = 100.0 * std::sqrt( std::numeric_limits<double>::epsilon() );
+        double w = std::numeric_limits<double>::infinity();
+        double w_last = -1.0;
+        for(long int norm_iter = 0; norm_iter < params.N_Sinkhorn_iters; ++norm_iter){
+            for(int64_t n = 0; n < N_free_move; ++n){
+                const auto s = a[n] * (c * Kb[n] + h[n]);
+                if(machine_eps <= s) a[n] /= s;
+            }
+            KTa = kernel->col_sums(a);
+            for(int64_t n = 0; n < N_free_stat; ++n){
+                const auto s = b[n] * (c * KTa[n] + g[n]);
+                if(machine_eps <= s) b[n] /= s;
+            }
+            Kb = kernel->row_sums(b);
+
+            w = 0.0;
+            for(int64_t n = 0; n < N_free_move; ++n){
+                w = std::max(w, std::abs(a[n] * (c * Kb[n] + h[n]) - 1.0));
+            }
+            for(int64_t n = 0; n < N_free_stat; ++n){
+                w = std::max(w, std::abs(b[n] * (c * KTa[n] + g[n]) - 1.0));
+            }
+            if(w < params.Sinkhorn_tolerance) break;
+
+            if(w == w_last){
+                throw std::runtime_error("Sinkhorn technique stalled. Unable to normalize correspondence matrix. Cannot continue.");
+            }
+            w_last = w;
+        }
+        if(!(w <= params.Sinkhorn_tolerance)){
+            throw std::runtime_error("Sinkhorn technique failed to normalize correspondence matrix. Consider more Sinkhorn iterations.");
+        }
+        return;
+    };
+
+    // Update the transformation.
+    Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(N_move_points, 3);
+    std::vector<double> omega(N_move_points, 1.0);
+    std::vector<double> unit_omega(N_move_points, 1.0);
+    Eigen::MatrixXd PtP_unit;
+    Eigen::MatrixXd PtP;
+    Eigen::MatrixXd PtY;
+    double factorized_lambda = std::numeric_limits<double>::quiet_NaN();
+    Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd> COD;
+    Eigen::LDLT<Eigen::MatrixXd> LDLT;
+    Eigen::MatrixXd H;
+
+    // The side condition P_c^T W = 0 is eliminated by parameterizing the warp coefficients with a basis for the null
+    // space of P_c^T, i.e., [W; A] = G [z; A] where G = blkdiag(N, I_4). The reduced normal equations are then
+    // symmetric positive semi-definite.
+    Eigen::MatrixXd G = Eigen::MatrixXd::Zero(N_coeffs, N_coeffs - 4);
+    {
+        Eigen::MatrixXd P_c(N_ctrl, 4);
+        for(long int i = 0; i < N_ctrl; ++i){
+            const auto &P = control_points.points[i];
+            P_c(i, 0) = 1.0;
+            P_c(i, 1) = P.x;
+            P_c(i, 2) = P.y;
+            P_c(i, 3) = P.z;
+        }
+        const Eigen::HouseholderQR<Eigen::MatrixXd> QR(P_c);
+        const Eigen::MatrixXd Q = QR.householderQ();
+        G.topLeftCorner(N_ctrl, N_ctrl - 4) = Q.rightCols(N_ctrl - 4);
+        G.bottomRightCorner(4, 4) = Eigen::MatrixXd::Identity(4, 4);
+    }
+
+    const auto update_transformation = [&](double lambda) -> void {
+        // Correspondence-weighted targets. Stationary points are centred to reduce the magnitude of the weights used
+        // with the fast Gauss transform.
+        std::vector<double> m(N_free_move, 0.0);
+        {
+            const auto Kb = kernel->row_sums(b);
+            std::array<std::vector<double>, 3> Kbx;
+            for(size_t d = 0; d < 3; ++d){
+                std::vector<double> bx(N_free_stat);
+                for(int64_t n = 0; n < N_free_stat; ++n){
+                    const auto dP = free_stat_points[n] - com_stat;
+                    bx[n] = b[n] * ((d == 0) ? dP.x : ((d == 1) ? dP.y : dP.z));
+                }
+                Kbx[d] = kernel->row_sums(bx);
+            }
+            for(int64_t n = 0; n < N_free_move; ++n){
+                const auto i = free_move[n];
+                const auto scale = a[n] * c;
+                m[n] = scale * Kb[n];
+                Y(i, 0) = scale * (Kbx[0][n] + com_stat.x * Kb[n]);
+                Y(i, 1) = scale * (Kbx[1][n] + com_stat.y * Kb[n]);
+                Y(i, 2) = scale * (Kbx[2][n] + com_stat.z * Kb[n]);
+            }
+        }
+        for(long int i = 0; i < N_move_points; ++i){
+            const auto j = move_forced_to[i];
+            if(j == -2) continue;
+            const auto P = (0 <= j) ? stationary.points[j] : vec3<double>(0.0, 0.0, 0.0);
+            Y(i, 0) = P.x;
+            Y(i, 1) = P.y;
+            Y(i, 2) = P.z;
+        }
+
+        // Assemble the normal equations. With double-sided outlier handling, targets are normalized and points are
+        // weighted by their total (non-outlier) correspondence, so the normal matrix must be recomputed.
+        const std::vector<double> *w = &unit_omega;
+        if(params.double_sided_outliers){
+            for(long int i = 0; i < N_move_points; ++i){
+                omega[i] = (move_forced_to[i] == -2) ? 0.0 : ((0 <= move_forced_to[i]) ? 1.0 : 0.0);
+            }
+            for(int64_t n = 0; n < N_free_move; ++n){
+                const auto i = free_move[n];
+                omega[i] = m[n];
+                if(0.0 < m[n]) Y.row(i) /= m[n];
+            }
+            w = &omega;
+            accumulate_normal_equations(*w, &Y, &PtP, &PtY);
+            factorized_lambda = std::numeric_limits<double>::quiet_NaN();
+        }else{
+            if(PtP_unit.size() == 0) accumulate_normal_equations(*w, nullptr, &PtP_unit, nullptr);
+            accumulate_normal_equations(*w, &Y, nullptr, &PtY);
+        }
+
+        // Solve the reduced (unconstrained) least-squares problem.
+        if( !(factorized_lambda == lambda) ){
+            const auto &A = params.double_sided_outliers ? PtP : PtP_unit;
+            Eigen::MatrixXd R = A;
+            R.topLeftCorner(N_ctrl, N_ctrl) += K_cc * lambda;
+            H = G.transpose() * R * G;
+
+            if(params.solution_method == AlignViaTPSRPMParams::SolutionMethod::PseudoInverse){
+                COD.compute(H);
+            }else if(params.solution_method == AlignViaTPSRPMParams::SolutionMethod::LDLT){
+                LDLT.compute(H);
+                if(LDLT.info() != Eigen::Success){
+                    throw std::runtime_error("Unable to update transformation: LDLT decomposition failed.");
+                }
+            }else{
+                throw std::logic_error("Solution method not understood. Cannot continue.");
+            }
+            factorized_lambda = params.double_sided_outliers ? std::numeric_limits<double>::quiet_NaN() : lambda;
+        }
+
+        const Eigen::MatrixXd rhs = G.transpose() * PtY;
+        Eigen::MatrixXd sol;
+        if(params.solution_method == AlignViaTPSRPMParams::SolutionMethod::PseudoInverse){
+            sol = COD.solve(rhs);
+        }else{
+            sol = LDLT.solve(rhs);
+            if(LDLT.info() != Eigen::Success){
+                throw std::runtime_error("Unable to update transformation: LDLT solve failed.");
+            }
+        }
+        W_A = G * sol;
+
+        if(!W_A.allFinite()){
+            throw std::runtime_error("Failed to update transformation.");
+        }
+        return;
+    };
+
+    // Estimates how the correspondence matrix will binarize when T -> 0.
+    const auto update_final_correspondence = [&](double T_now) -> void {
+        update_moved_points();
+        for(int64_t n = 0; n < N_free_move; ++n) free_moved_points[n] = moved[ free_move[n] ];
+        const auto cutoff = std::sqrt( T_now * std::log(1.0 / params.correspondence_truncation) );
+        const point_grid stat_grid(free_stat_points, cutoff);
+        const point_grid move_grid(free_moved_points, cutoff);
+
+        std::vector<std::pair<long int, long int>> move_corr(N_move_points);
+        parallel_for(0, N_free_move, [&](int64_t n){
+            const auto &P = free_moved_points[n];
+            double max_coeff = h[n];
+            long int max_j = N_stat_points;
+            stat_grid.for_each_within(P, cutoff, [&](int64_t k, double sq_dist){
+                const auto coeff = c * std::exp(-sq_dist / T_now) * b[k];
+                if(max_coeff < coeff){
+                    max_coeff = coeff;
+                    max_j = free_stat[k];
+                }
+            });
+            if( (max_j == N_stat_points) && !params.permit_move_outliers && (0 < N_free_stat) ){
+                const auto nn_sq_dist = stat_grid.nearest_sq_dist(P);
+                stat_grid.for_each_within(P, std::sqrt(nn_sq_dist), [&](int64_t k, double){ max_j = free_stat[k]; });
+            }
+            move_corr[ free_move[n] ] = std::make_pair(free_move[n], max_j);
+        });
+        for(long int i = 0; i < N_move_points; ++i){
+            const auto j = move_forced_to[i];
+            if(j != -2) move_corr[i] = std::make_pair(i, (0 <= j) ? j : N_stat_points);
+        }
+
+        std::vector<std::pair<long int, long int>> stat_corr(N_stat_points);
+        parallel_for(0, N_free_stat, [&](int64_t n){
+            const auto &P = free_stat_points[n];
+            double max_coeff = g[n];
+            long int max_i = N_move_points;
+            move_grid.for_each_within(P, cutoff, [&](int64_t k, double sq_dist){
+                const auto coeff = a[k] * c * std::exp(-sq_dist / T_now);
+                if(max_coeff < coeff){
+                    max_coeff = coeff;
+                    max_i = free_move[k];
+                }
+            });
+            if( (max_i == N_move_points) && !params.permit_stat_outliers && (0 < N_free_move) ){
+                const auto nn_sq_dist = move_grid.nearest_sq_dist(P);
+                move_grid.for_each_within(P, std::sqrt(nn_sq_dist), [&](int64_t k, double){ max_i = free_move[k]; });
+            }
+            stat_corr[ free_stat[n] ] = std::make_pair(max_i, free_stat[n]);
+        });
+        for(long int j = 0; j < N_stat_points; ++j){
+            const auto i = stat_forced_to[j];
+            if(i != -2) stat_corr[j] = std::make_pair((0 <= i) ? i : N_move_points, j);
+        }
+
+        params.final_move_correspondence.insert( std::end(params.final_move_correspondence),
+                                                 std::begin(move_corr), std::end(move_corr) );
+        params.final_stat_correspondence.insert( std::end(params.final_stat_correspondence),
+                                                 std::begin(stat_corr), std::end(stat_corr) );
+        return;
+    };
+
+    // Anneal deterministically.
+    double T_last = T_start;
+    for(double T_now = T_start; T_now >= T_end; T_now *= params.T_step){
+        const double L_1 = T_now * L_1_start;
+        const double L_2 = T_now * L_2_start;
+
+        for(long int iter_at_fixed_T = 0; iter_at_fixed_T < params.N_iters_at_fixed_T; ++iter_at_fixed_T){
+            update_correspondence(T_now, L_2);
+            update_transformation(L_1);
+        }
+        T_last = T_now;
+
+        if(kernel != nullptr){
+            YLOGINFO("Optimizer state: T = " << std::setw(12) << T_now
+                       << ", correspondence coefficients = " << std::setw(12) << kernel->coefficient_count()
+                       << " (" << (kernel->is_sparse() ? "sparse" : "fast Gauss transform") << ")");
+        }
+    }
+
+    if(params.report_final_correspondence){
+        if(kernel == nullptr) update_correspondence(T_last, T_last * L_2_start);
+        update_final_correspondence(T_last);
+    }
+
+    // Report final fit parameters to the user.
+    {
+        const auto E_x = (W_A.block(0,0, N_ctrl,1).transpose() * K_cc * W_A.block(0,0, N_ctrl,1)).sum();
+        const auto E_y = (W_A.block(0,1, N_ctrl,1).transpose() * K_cc * W_A.block(0,1, N_ctrl,1)).sum();
+        const auto E_z = (W_A.block(0,2, N_ctrl,1).transpose() * K_cc * W_A.block(0,2, N_ctrl,1)).sum();
+        YLOGINFO("Final bending energy is propto " << (E_x + E_y + E_z) << " with " << E_x << " from x, " << E_y << " from y, and " << E_z << " from z");
+    }
+
+    return t;
+}
+
+} // namespace
+#endif // DCMA_USE_EIGEN
+
+
 #ifdef DCMA_USE_EIGEN
 // This routine finds a non-rigid alignment using the 'robust point matching: thin plate spline' algorithm.
 //
@@ -345,48 +986,71 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
     // (in the moving cloud). This info is needed to tune the annealing energy to ensure (1) deformations can initially
     // 'reach' across the point cloud, and (2) deformations are not considered much below the nearest-neighbour spacing
     // (i.e., overfitting).
+    const bool use_scalable_engine = (params.engine == AlignViaTPSRPMParams::Engine::Scalable)
+                                  || ( (params.engine == AlignViaTPSRPMParams::Engine::Automatic)
+                                       && ( (params.automatic_engine_threshold < N_move_points)
+                                         || (params.automatic_engine_threshold < N_stat_points) ) );
+    YLOGINFO("Using the " << (use_scalable_engine ? "scalable" : "dense") << " engine");
+
     double mean_nn_sq_dist = std::numeric_limits<double>::quiet_NaN();
     double max_sq_dist = 0.0;
     {
         YLOGINFO("Locating mean nearest-neighbour separation in moving point cloud");
-        Stats::Running_Sum<double> rs;
-        {
-            //asio_thread_pool tp;
-            for(long int i = 0; i < N_move_points; ++i){
-                //tp.submit_task([&,i](void) -> void {
+        std::vector<double> min_sq_dists(N_move_points, std::numeric_limits<double>::infinity());
+        if(use_scalable_engine){
+            const point_grid grid(moving.points, 0.0);
+            parallel_for(0, N_move_points, [&](int64_t i){
+                min_sq_dists[i] = grid.nearest_sq_dist(moving.points[i], i);
+            });
+        }else{
+            parallel_for(0, N_move_points, [&](int64_t i){
                 double min_sq_dist = std::numeric_limits<double>::infinity();
                 for(long int j = 0; j < N_move_points; ++j){
                     if(i == j) continue;
                     const auto sq_dist = (moving.points[i]).sq_dist( moving.points[j] );
                     if(sq_dist < min_sq_dist) min_sq_dist = sq_dist;
                 }
-                if(!std::isfinite(min_sq_dist)){
-                    throw std::runtime_error("Unable to estimate nearest neighbour distance.");
-                }
-                rs.Digest(min_sq_dist);
-                //}); // thread pool task closure.
+                min_sq_dists[i] = min_sq_dist;
+            });
+        }
+        Stats::Running_Sum<double> rs;
+        for(const auto &min_sq_dist : min_sq_dists){
+            if(!std::isfinite(min_sq_dist)){
+                throw std::runtime_error("Unable to estimate nearest neighbour distance.");
             }
+            rs.Digest(min_sq_dist);
         }
         mean_nn_sq_dist = rs.Current_Sum() / static_cast<double>( N_move_points );
 
         YLOGINFO("Locating max square-distance between all points");
-        {
-            //asio_thread_pool tp;
-            //std::mutex saver_printer;
-            for(long int i = 0; i < (N_move_points + N_stat_points); ++i){
-                //tp.submit_task([&,i](void) -> void {
-                    for(long int j = 0; j < i; ++j){
-                        const auto A = (i < N_move_points) ? moving.points[i] : stationary.points[i - N_move_points];
-                        const auto B = (j < N_move_points) ? moving.points[j] : stationary.points[j - N_move_points];
-                        const auto sq_dist = A.sq_dist(B);
-                        if(max_sq_dist < sq_dist){
-                            //std::lock_guard<std::mutex> lock(saver_printer);
-                            max_sq_dist = sq_dist;
+        const auto N_all_points = N_move_points + N_stat_points;
+        const auto get_point = [&](long int i) -> vec3<double> {
+            return (i < N_move_points) ? moving.points[i] : stationary.points[i - N_move_points];
+        };
+        if(use_scalable_engine){
+            // The bounding box diagonal bounds the maximum separation from above, and is at most sqrt(3) times larger.
+            const auto inf = std::numeric_limits<double>::infinity();
+            vec3<double> lo(inf, inf, inf);
+            vec3<double> hi(-inf, -inf, -inf);
+            for(long int i = 0; i < N_all_points; ++i){
+                const auto P = get_point(i);
+                lo = vec3<double>( std::min(lo.x, P.x), std::min(lo.y, P.y), std::min(lo.z, P.z) );
+                hi = vec3<double>( std::max(hi.x, P.x), std::max(hi.y, P.y), std::max(hi.z, P.z) );
+            }
+            if(0 < N_all_points) max_sq_dist = lo.sq_dist(hi);
+        }else{
+            max_sq_dist = parallel_reduce(0, N_all_points, 0.0,
+                [&](int64_t b, int64_t e, double max_sq) -> double {
+                    for(int64_t i = b; i < e; ++i){
+                        const auto A = get_point(i);
+                        for(long int j = 0; j < i; ++j){
+                            max_sq = std::max(max_sq, A.sq_dist(get_point(j)));
                         }
                     }
-                //}); // thread pool task closure.
-            }
-        } // Wait until all threads are done.
+                    return max_sq;
+                },
+                [](double A, double B) -> double { return std::max(A, B); });
+        }
     }
 
     const double T_start = params.T_start_scale * max_sq_dist;
@@ -457,6 +1121,10 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
         }
     }
 
+    if(use_scalable_engine){
+        return AlignViaTPSRPM_Scalable(params, moving, stationary, T_start, T_end, L_1_start, L_2_start);
+    }
+
     // Prepare working buffers.
     //
     // Main system matrix.
@@ -474,6 +1142,9 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
     // Corresponence matrix.
     Eigen::MatrixXd M = Eigen::MatrixXd::Zero(N_move_points + 1, N_stat_points + 1);
 
+    // Moved point buffer.
+    std::vector<vec3<double>> moved(N_move_points);
+
     // TPS model parameters.
     //
     // Will contain the 'warp' component (W) and an affine component (A) coefficients.
@@ -670,15 +1341,10 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
     //       It supports outliers in either point cloud set.
     const auto update_correspondence = [&](double T_now, double s_reg) -> void {
         // Non-outlier coefficients.
-        Stats::Running_Sum<double> com_moved_x;
-        Stats::Running_Sum<double> com_moved_y;
-        Stats::Running_Sum<double> com_moved_z;
-        for(long int i = 0; i < N_move_points; ++i){ // row
+        parallel_for(0, N_move_points, [&](int64_t i){ // row
             const auto P_moving = moving.points[i];
             const auto P_moved = t.transform(P_moving); // Transform the point.
-            com_moved_x.Digest(P_moved.x);
-            com_moved_y.Digest(P_moved.y);
-            com_moved_z.Digest(P_moved.z);
+            moved[i] = P_moved;
             for(long int j = 0; j < N_stat_points; ++j){ // column
                 const auto P_stationary = stationary.points[j];
                 const auto dP = P_stationary - P_moved;
@@ -686,6 +1352,14 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
                         * std::exp(s_reg / T_now)
                         * std::exp( -dP.Dot(dP) / T_now);
             }
+        });
+        Stats::Running_Sum<double> com_moved_x;
+        Stats::Running_Sum<double> com_moved_y;
+        Stats::Running_Sum<double> com_moved_z;
+        for(const auto &P_moved : moved){
+            com_moved_x.Digest(P_moved.x);
+            com_moved_y.Digest(P_moved.y);
+            com_moved_z.Digest(P_moved.z);
         }
         const vec3<double> com_moved( com_moved_x.Current_Sum() / static_cast<double>(N_move_points), 
                                       com_moved_y.Current_Sum() / static_cast<double>(N_move_points), 
@@ -705,8 +1379,7 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
 
         // Stationary outlier coefficients.
         for(long int i = 0; i < N_move_points; ++i){ // row
-            const auto P_moving = moving.points[i];
-            const auto P_moved = t.transform(P_moving); // Transform the point.
+            const auto P_moved = moved[i];
             const auto j = N_stat_points; // column
             const auto& P_stationary = com_stat;
             const auto dP = P_stationary - P_moved;
@@ -730,7 +1403,9 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
             for(long int norm_iter = 0; norm_iter < params.N_Sinkhorn_iters; ++norm_iter){
 
                 // Tally the current row sums and re-scale the correspondence coefficients.
-                for(long int i = 0; i < N_move_points; ++i){ // row
+                //
+                // Note: rows (and then columns) are independent, so they are normalized concurrently.
+                parallel_for(0, N_move_points, [&](int64_t i){ // row
                     Stats::Running_Sum<double> rs;
                     for(long int j = 0; j < (N_stat_points+1); ++j){ // column
                         rs.Digest( M(i,j) );
@@ -741,7 +1416,7 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
                         //throw std::runtime_error("Unable to normalize column");
                         // Option B: forgo normalization.
                         // This might ruin the transform scaling, but it might also self-correct (n.b. verified below!).
-                        continue;
+                        return;
                         // Option C: nominate this point as an outlier.
                         // This may work, but I can't say for sure...
                         //row_sums[i] += 1.0;
@@ -750,10 +1425,10 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
                     for(long int j = 0; j < (N_stat_points+1); ++j){ // column, intentionally ignoring the outlier coeff.
                         M(i,j) /= s;
                     }
-                }
+                });
 
                 // Tally the current column sums and re-scale the correspondence coefficients.
-                for(long int j = 0; j < N_stat_points; ++j){ // column
+                parallel_for(0, N_stat_points, [&](int64_t j){ // column
                     Stats::Running_Sum<double> rs;
                     for(long int i = 0; i < (N_move_points+1); ++i){ // row
                         rs.Digest( M(i,j) );
@@ -764,7 +1439,7 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
                         //throw std::runtime_error("Unable to normalize row");
                         // Option B: forgo normalization.
                         // This might ruin the transform scaling, but it might also self-correct (n.b. verified below!).
-                        continue;
+                        return;
                         // Option C: nominate this point as an outlier.
                         // This may work, but I can't say for sure...
                         //col_sums[j] += 1.0;
@@ -773,7 +1448,7 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
                     for(long int i = 0; i < (N_move_points+1); ++i){ // row, intentionally ignoring the outlier coeff.
                         M(i,j) /= s;
                     }
-                }
+                });
                 
                 // Determine whether convergence has been reached and we can break early.
                 const auto w = worst_row_col_sum_deviation();
@@ -855,7 +1530,7 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
     const auto update_transformation = [&](double lambda) -> void {
 
         // Fill the Y vector with the corresponding points.
-        for(long int i = 0; i < N_move_points; ++i){
+        parallel_for(0, N_move_points, [&](int64_t i){
             double col_sum_inv = std::numeric_limits<double>::quiet_NaN();
             if(params.double_sided_outliers){
                 // This column sum is only needed for the 'double-sided outlier handling' approach described by Yang et al (2011).
@@ -905,7 +1580,7 @@ AlignViaTPSRPM(AlignViaTPSRPMParams & params,
             Y(i, 0) = c_x.Current_Sum();
             Y(i, 1) = c_y.Current_Sum();
             Y(i, 2) = c_z.Current_Sum();
-        }
+        });
 
         // Use pseudo-inverse method.
         if(params.solution_method == AlignViaTPSRPMParams::SolutionMethod::PseudoInverse){
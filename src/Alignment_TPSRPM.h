@@ -151,6 +151,43 @@ struct AlignViaTPSRPMParams {
     };
     SolutionMethod solution_method = SolutionMethod::LDLT;
 
+    // Engine parameters.
+    //
+    // The dense engine stores the full correspondence and system matrices. It requires O(N^2) memory and O(N^3) time,
+    // so it is only practical for up to a few thousand points.
+    //
+    // The scalable engine never forms the correspondence matrix. Instead, the Sinkhorn procedure is carried out on
+    // row and column scaling factors, which only requires sums over the Gaussian correspondence kernel. Kernel sums are
+    // evaluated over truncated neighbourhoods (i.e., a sparse correspondence matrix) when the temperature is low, and
+    // using the improved fast Gauss transform when the temperature is high and neighbourhoods are large. The thin plate
+    // spline is approximated using a subset of the moving points as control points, so the system matrix is (at most)
+    // (max_control_points + 4)^2.
+    //
+    // Note that the scalable engine approximates the maximum separation between points using the bounding box, so the
+    // starting temperature may be slightly higher than with the dense engine.
+    enum class Engine {
+        Automatic, // Selects the scalable engine when either point cloud has more than automatic_engine_threshold points.
+        Dense,
+        Scalable
+    };
+    Engine engine = Engine::Dense; // The scalable engine approximates the dense engine, so it must be requested.
+    long int automatic_engine_threshold = 2500;
+
+    // The maximum number of control points used by the scalable engine. Control points are selected from the moving
+    // set by farthest-point sampling. If the moving set has no more than this many points, all are used.
+    long int max_control_points = 1000;
+
+    // Correspondence kernel coefficients smaller than this factor (relative to the largest possible coefficient) are
+    // truncated by the scalable engine.
+    double correspondence_truncation = 1.0E-6;
+
+    // The maximum number of non-zero correspondence coefficients the scalable engine will store. If more would be
+    // needed, the fast Gauss transform is used instead.
+    long int max_sparse_correspondences = 20'000'000;
+
+    // The requested accuracy of the fast Gauss transform, relative to the sum of (absolute) weights.
+    double fast_gauss_transform_epsilon = 1.0E-5;
+
     // Algorithm-altering parameters.
     //
     // Seed the initial transformation with the result of a rigid centroid-to-centroid shift transformation. The default
@@ -53,6 +53,8 @@ int main(int argc, char* argv[]){
     drover_serial_func_name_mapping["txt"] = Common_Boost_Serialize_Drover_to_Simple_Text;
     drover_serial_func_name_mapping["xml"] = Common_Boost_Serialize_Drover_to_XML;
 
+    drover_serial_func_name_mapping["chunked-binary"] = Common_Boost_Serialize_Drover_to_Chunked_Binary;
+
     Drover DICOM_data;
 
     
@@ -76,7 +78,9 @@ int main(int argc, char* argv[]){
                        { "-i file.xml.gz -o file.bin -t 'binary'",
                          "Convert to a binary file." },
                        { "-i file.xml.gz -o file.bin.gz -t 'gzip-binary'",
-                         "Convert to a gzipped binary file." }
+                         "Convert to a gzipped binary file." },
+                       { "-i file.xml.gz -o file.bin -t 'chunked-binary'",
+                         "Convert to a chunked binary file, which supports loading individual objects." }
                      };
     arger.description = "A program for converting Boost.Serialization archives types which DICOMautomaton can read.";
 
@@ -106,7 +110,7 @@ int main(int argc, char* argv[]){
     );
 
     arger.push_back( ygor_arg_handlr_t(2, 't', "output-type", true, ConvertTo,
-      "The format to convert to. Supported: gzip-binary, gzip-txt, gzip-xml, binary, txt, xml.",
+      "The format to convert to. Supported: gzip-binary, gzip-txt, gzip-xml, binary, txt, xml, chunked-binary.",
       [&](const std::string &optarg) -> void {
         ConvertTo = optarg;
         return;
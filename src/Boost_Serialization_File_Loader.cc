@@ -13,7 +13,7 @@
 
 
 bool Load_From_Boost_Serialization_Files( Drover &DICOM_data,
-                                          std::map<std::string,std::string> & /* InvocationMetadata */,
+                                          std::map<std::string,std::string> &InvocationMetadata,
                                           const std::string & /* FilenameLex */,
                                           std::list<std::filesystem::path> &Filenames ){
 
@@ -23,13 +23,33 @@ bool Load_From_Boost_Serialization_Files( Drover &DICOM_data,
     // Note: This routine returns false only iff a file is suspected of being suited for this loader, but could not be
     //       loaded (e.g., the file seems appropriate, but a parsing failure was encountered).
     //
+    // Note: Objects can be selectively loaded from chunked archives by providing a selection via the
+    //       'ArchiveSelection' metadata key. See Common_Boost_Deserialize_Chunked_Drover() for the syntax.
+    //
     if(Filenames.empty()) return true;
 
+    std::string selection;
+    if(InvocationMetadata.count("ArchiveSelection") != 0){
+        selection = InvocationMetadata.at("ArchiveSelection");
+    }
+
+    bool all_suitable_loaded = true;
     std::list<std::filesystem::path> Filenames_Copy(Filenames);
     Filenames.clear();
     for(const auto &fn : Filenames_Copy){
 
         Drover A;
+        if(Is_Chunked_Drover_Archive(fn)){
+            if(!Common_Boost_Deserialize_Chunked_Drover(A, fn, selection)){
+                // The file is suited for this loader, but could not be loaded.
+                Filenames.emplace_back(fn);
+                all_suitable_loaded = false;
+                continue;
+            }
+            DICOM_data.Consume(A);
+            continue;
+        }
+
         const bool res = Common_Boost_Deserialize_Drover(A, fn);
         if(res){
 
@@ -45,5 +65,5 @@ bool Load_From_Boost_Serialization_Files( Drover &DICOM_data,
         continue;
     }
 
-    return true;
+    return all_suitable_loaded;
 }
@@ -5,6 +5,11 @@
 
 #include <string>
 #include <list>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 #include <numeric>
 #include <initializer_list>
 #include <functional>
@@ -41,6 +46,23 @@ void aa_bbox::digest(const vec3<double>& r){
     this->max.z = std::max( this->max.z, r.z );
 };
 
+void node::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    const auto N = pos.size();
+    sdf.resize(N);
+    for(size_t i = 0; i < N; ++i){
+        sdf[i] = this->evaluate_sdf(pos[i]);
+    }
+    return;
+}
+
+double node::evaluate_lipschitz_bound() const {
+    double bound = 1.0;
+    for(const auto& c_it : this->children){
+        bound = std::max(bound, c_it->evaluate_lipschitz_bound());
+    }
+    return bound;
+}
+
 
 // -------------------------------- 3D Shapes -------------------------------------
 namespace shape {
@@ -60,6 +82,15 @@ aa_bbox sphere::evaluate_aa_bbox() const {
     return bb;
 }
 
+void sphere::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    const auto N = pos.size();
+    sdf.resize(N);
+    for(size_t i = 0; i < N; ++i){
+        sdf[i] = this->sphere::evaluate_sdf(pos[i]);
+    }
+    return;
+}
+
 // Axis-aligned box centred at (0,0,0).
 aa_box::aa_box(const vec3<double>& r) : radii(r) {};
 
@@ -81,6 +112,15 @@ aa_bbox aa_box::evaluate_aa_bbox() const {
     return bb;
 }
 
+void aa_box::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    const auto N = pos.size();
+    sdf.resize(N);
+    for(size_t i = 0; i < N; ++i){
+        sdf[i] = this->aa_box::evaluate_sdf(pos[i]);
+    }
+    return;
+}
+
 // Infinite plane.
 plane::plane(const vec3<double>& p,
              const vec3<double>& n,
@@ -98,6 +138,15 @@ aa_bbox plane::evaluate_aa_bbox() const {
     return bb;
 }
 
+void plane::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    const auto N = pos.size();
+    sdf.resize(N);
+    for(size_t i = 0; i < N; ++i){
+        sdf[i] = this->plane::evaluate_sdf(pos[i]);
+    }
+    return;
+}
+
 // Connected line segments with rounded edges.
 poly_chain::poly_chain(double r, const std::vector<vec3<double>> &v) : radius(r), vertices(v) {};
 poly_chain::poly_chain(double r, const std::list<vec3<double>> &v) : radius(r), vertices(std::begin(v), std::end(v)) {};
@@ -136,6 +185,36 @@ aa_bbox poly_chain::evaluate_aa_bbox() const {
     return bb;
 }
 
+void poly_chain::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    if(this->vertices.size() < 2UL){
+        throw std::runtime_error("poly_chain: this operation requires at least two vertices");
+    }
+
+    // Segments are visited in the outer loop so per-segment quantities are only computed once.
+    const auto N = pos.size();
+    sdf.assign(N, std::numeric_limits<double>::infinity());
+    const auto end = std::cend(this->vertices);
+    auto A_it = std::cbegin(this->vertices);
+    auto B_it = std::next(A_it);
+    for( ; B_it != end; ++A_it, ++B_it){
+        const auto dBA = *B_it - *A_it;
+        const auto dBA_sq = dBA.Dot(dBA);
+        for(size_t i = 0; i < N; ++i){
+            const auto dPA = pos[i] - *A_it;
+            const auto t = std::clamp( dPA.Dot(dBA) / dBA_sq, 0.0, 1.0 );
+            const auto l_sdf = (dPA - dBA * t).length() - this->radius;
+            sdf[i] = std::min( sdf[i], l_sdf );
+        }
+    }
+
+    for(const auto &l_sdf : sdf){
+        if(!std::isfinite(l_sdf)){
+            throw std::runtime_error("poly_chain: computed non-finite SDF");
+        }
+    }
+    return;
+}
+
 } // namespace shape
 
 // -------------------------------- Operations ------------------------------------
@@ -163,6 +242,17 @@ aa_bbox translate::evaluate_aa_bbox() const {
     return bb;
 }
 
+void translate::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    if(this->children.size() != 1UL){
+        throw std::runtime_error("translate: this operation requires a single child node");
+    }
+    std::vector<vec3<double>> l_pos;
+    l_pos.reserve(pos.size());
+    for(const auto& p : pos) l_pos.emplace_back(p - this->dR);
+    this->children[0]->evaluate_sdf_batch(l_pos, sdf);
+    return;
+}
+
 // Rotate.
 rotate::rotate(const vec3<double>& axis, double theta) : rot(affine_rotate(vec3<double>(0,0,0), axis, -theta)) {};
 
@@ -210,6 +300,16 @@ aa_bbox rotate::evaluate_aa_bbox() const {
     return bb;
 }
 
+void rotate::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    if(this->children.size() != 1UL){
+        throw std::runtime_error("rotate: this operation requires a single child node");
+    }
+    auto l_pos = pos;
+    for(auto& p : l_pos) this->rot.apply_to(p);
+    this->children[0]->evaluate_sdf_batch(l_pos, sdf);
+    return;
+}
+
 // Boolean 'AND' or 'add' or 'union' or 'join.'
 join::join(){};
 
@@ -250,6 +350,23 @@ aa_bbox join::evaluate_aa_bbox() const {
     return join_aa_bbox_impl(this->children);
 }
 
+void join::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    if(this->children.empty()){
+        throw std::runtime_error("join: no children present");
+    }
+
+    this->children[0]->evaluate_sdf_batch(pos, sdf);
+    std::vector<double> l_sdf;
+    const auto N = pos.size();
+    for(auto c_it = std::next(std::begin(this->children)); c_it != std::end(this->children); ++c_it){
+        (*c_it)->evaluate_sdf_batch(pos, l_sdf);
+        for(size_t i = 0; i < N; ++i){
+            if(!std::isfinite(sdf[i]) || (l_sdf[i] < sdf[i])) sdf[i] = l_sdf[i];
+        }
+    }
+    return;
+}
+
 // Boolean 'difference' or 'subtract.'
 subtract::subtract(){};
 
@@ -288,6 +405,21 @@ aa_bbox subtract::evaluate_aa_bbox() const {
     return subtract_aa_bbox_impl(this->children);
 }
 
+void subtract::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    if(this->children.size() != 2UL){
+        throw std::runtime_error("subtract: incorrect number of children present, subtraction requires exactly two");
+    }
+
+    std::vector<double> cB_sdf;
+    this->children[0]->evaluate_sdf_batch(pos, sdf);
+    this->children[1]->evaluate_sdf_batch(pos, cB_sdf);
+    const auto N = pos.size();
+    for(size_t i = 0; i < N; ++i){
+        sdf[i] = std::max( sdf[i], -cB_sdf[i] );
+    }
+    return;
+}
+
 // Boolean 'OR' or 'intersect.'
 intersect::intersect(){};
 
@@ -316,6 +448,23 @@ aa_bbox intersect::evaluate_aa_bbox() const {
     return join_aa_bbox_impl(this->children);
 }
 
+void intersect::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    if(this->children.size() < 2UL){
+        throw std::runtime_error("intersect: insufficient children present, cannot compute intersect");
+    }
+
+    this->children[0]->evaluate_sdf_batch(pos, sdf);
+    std::vector<double> l_sdf;
+    const auto N = pos.size();
+    for(auto c_it = std::next(std::begin(this->children)); c_it != std::end(this->children); ++c_it){
+        (*c_it)->evaluate_sdf_batch(pos, l_sdf);
+        for(size_t i = 0; i < N; ++i){
+            if(!std::isfinite(sdf[i]) || (sdf[i] < l_sdf[i])) sdf[i] = l_sdf[i];
+        }
+    }
+    return;
+}
+
 // Chamfer-Booleans.
 chamfer_join::chamfer_join(double t) : thickness(t) {};
 
@@ -348,6 +497,11 @@ aa_bbox chamfer_join::evaluate_aa_bbox() const {
     return join_aa_bbox_impl(this->children);
 }
 
+double chamfer_join::evaluate_lipschitz_bound() const {
+    // The chamfer term sums two children and scales by sqrt(1/2).
+    return std::sqrt(2.0) * this->node::evaluate_lipschitz_bound();
+}
+
 
 chamfer_subtract::chamfer_subtract(double t) : thickness(t) {};
 
@@ -373,6 +527,11 @@ aa_bbox chamfer_subtract::evaluate_aa_bbox() const {
     return subtract_aa_bbox_impl(this->children);
 }
 
+double chamfer_subtract::evaluate_lipschitz_bound() const {
+    // The chamfer term sums two children and scales by sqrt(1/2).
+    return std::sqrt(2.0) * this->node::evaluate_lipschitz_bound();
+}
+
 
 chamfer_intersect::chamfer_intersect(double t) : thickness(t) {};
 
@@ -408,6 +567,11 @@ aa_bbox chamfer_intersect::evaluate_aa_bbox() const {
     return join_aa_bbox_impl(this->children);
 }
 
+double chamfer_intersect::evaluate_lipschitz_bound() const {
+    // The chamfer term sums two children and scales by sqrt(1/2).
+    return std::sqrt(2.0) * this->node::evaluate_lipschitz_bound();
+}
+
 
 // Dilation and erosion.
 dilate::dilate(double dist) : offset(dist) {};
@@ -433,6 +597,15 @@ aa_bbox dilate::evaluate_aa_bbox() const {
     return bb;
 }
 
+void dilate::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    if(this->children.size() != 1UL){
+        throw std::runtime_error("dilate: this operation requires a single child node");
+    }
+    this->children[0]->evaluate_sdf_batch(pos, sdf);
+    for(auto& l_sdf : sdf) l_sdf -= this->offset;
+    return;
+}
+
 
 erode::erode(double dist) : offset(dist) {};
 
@@ -465,6 +638,15 @@ aa_bbox erode::evaluate_aa_bbox() const {
     return bb;
 }
 
+void erode::evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const {
+    if(this->children.size() != 1UL){
+        throw std::runtime_error("erode: this operation requires a single child node");
+    }
+    this->children[0]->evaluate_sdf_batch(pos, sdf);
+    for(auto& l_sdf : sdf) l_sdf += this->offset;
+    return;
+}
+
 
 // Extrude.
 extrude::extrude(double dist, const plane<double> &p) : distance(dist), cut_plane(p) {};
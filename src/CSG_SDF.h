@@ -11,6 +11,7 @@
 #include <functional>
 #include <regex>
 #include <memory>
+#include <vector>
 
 #include "YgorString.h"
 #include "YgorMath.h"
@@ -39,6 +40,14 @@ struct node {
     virtual double evaluate_sdf(const vec3<double>&) const = 0;
     virtual aa_bbox evaluate_aa_bbox() const = 0;
     virtual ~node(){};
+
+    // Evaluates the SDF at many positions, overwriting 'sdf'. Nodes override this to evaluate children once per batch
+    // and use tight loops, which amortizes the per-position virtual call overhead.
+    virtual void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const;
+
+    // An upper bound on how quickly the SDF can change with position (i.e., a Lipschitz constant). Exact SDFs have a
+    // bound of 1, but approximations can change more quickly. The default is the larger of 1 and the children's bounds.
+    virtual double evaluate_lipschitz_bound() const;
 };
 
 // -------------------------------- 3D Shapes -------------------------------------
@@ -52,6 +61,7 @@ struct sphere : public node {
     sphere(double);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 // Axis-aligned box centred at (0,0,0).
@@ -61,6 +71,7 @@ struct aa_box : public node {
     aa_box(const vec3<double>& dR);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 // Infinite plane.
@@ -77,6 +88,7 @@ struct plane : public node {
           double bbox_width);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 // Connected line segments with rounded edges.
@@ -88,6 +100,7 @@ struct poly_chain : public node {
     poly_chain(double r, const std::list<vec3<double>> &pc);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 } // namespace shape
@@ -104,6 +117,7 @@ struct translate : public node {
     translate(const vec3<double>& dR);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 
@@ -114,6 +128,7 @@ struct rotate : public node {
     rotate(const vec3<double>& axis, double angle_rad);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 
@@ -122,6 +137,7 @@ struct join : public node {
     join();
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 // Boolean 'difference' or 'subtract.'
@@ -129,6 +145,7 @@ struct subtract : public node {
     subtract();
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 // Boolean 'OR' or 'intersect.'
@@ -136,6 +153,7 @@ struct intersect : public node {
     intersect();
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 
@@ -146,6 +164,7 @@ struct chamfer_join : public node {
     chamfer_join(double thickness);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    double evaluate_lipschitz_bound() const override;
 };
 
 struct chamfer_subtract : public node {
@@ -154,6 +173,7 @@ struct chamfer_subtract : public node {
     chamfer_subtract(double thickness);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    double evaluate_lipschitz_bound() const override;
 };
 
 struct chamfer_intersect : public node {
@@ -162,6 +182,7 @@ struct chamfer_intersect : public node {
     chamfer_intersect(double thickness);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    double evaluate_lipschitz_bound() const override;
 };
 
 
@@ -179,6 +200,7 @@ struct dilate : public node {
     dilate(double);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 struct erode : public node {
@@ -187,6 +209,7 @@ struct erode : public node {
     erode(double);
     double evaluate_sdf(const vec3<double>& pos) const override;
     aa_bbox evaluate_aa_bbox() const override;
+    void evaluate_sdf_batch(const std::vector<vec3<double>>& pos, std::vector<double>& sdf) const override;
 };
 
 
@@ -18,16 +18,33 @@
 #include <boost/archive/xml_iarchive.hpp>
 #include <boost/archive/xml_oarchive.hpp>
 #include <filesystem>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
-//#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
 #include <boost/math/special_functions/nonfinite_num_facets.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <exception>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
 #include <string>    
 #include <utility>
+#include <vector>
+
+#ifdef DCMA_USE_ZSTD
+    #include <zstd.h>
+#endif
+
+#include "YgorLog.h"
+#include "YgorString.h"
 
 #include "Common_Boost_Serialization.h"
 //#include "YgorMathChebyshevIOBoostSerialization.h"
@@ -40,6 +57,7 @@
 
 #include "Structs.h"
 #include "StructsIOBoostSerialization.h"
+#include "Thread_Pool.h"
 
 namespace boost {
 namespace iostreams {
@@ -98,6 +116,11 @@ Common_Boost_Deserialize_Drover(Drover &out,
         if(length == 0) return false;
     }
 
+    //Chunked binary archives are identified by their signature.
+    if(Is_Chunked_Drover_Archive(Filename)){
+        return Common_Boost_Deserialize_Chunked_Drover(out, Filename);
+    }
+
     //XML, gzip compression.
     try{
         std::ifstream ifs(Filename.string(), std::ios::in | std::ios::binary);
@@ -320,6 +343,383 @@ Common_Boost_Serialize_Drover_to_XML(const Drover &in,
 }
 
 
+//------------------
+// Chunked binary archives.
+//
+// Layout (all integers are little-endian):
+//   - signature,
+//   - compressed blocks, each holding a binary archive of a Drover with a single object,
+//   - table of contents,
+//   - footer: table of contents offset (u64), table of contents size (u64), and the signature again.
+//
+namespace {
+
+const std::string chunked_archive_signature("DCMACHK1");
+
+enum chunked_archive_codec : uint8_t {
+    codec_none = 0,
+    codec_zlib = 1,
+    codec_zstd = 2,
+};
+
+void write_u64(std::string &out, uint64_t v){
+    for(int i = 0; i < 8; ++i) out.push_back( static_cast<char>((v >> (8 * i)) & 0xFF) );
+    return;
+}
+
+uint64_t read_u64(const char *&p, const char *end){
+    if((end - p) < 8) throw std::runtime_error("Chunked archive is truncated");
+    uint64_t v = 0;
+    for(int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    p += 8;
+    return v;
+}
+
+std::string compress_block(const std::string &in, uint8_t &codec){
+    std::string out;
+#ifdef DCMA_USE_ZSTD
+    codec = codec_zstd;
+    out.resize(ZSTD_compressBound(in.size()));
+    const auto n = ZSTD_compress(out.data(), out.size(), in.data(), in.size(), 3);
+    if(ZSTD_isError(n)){
+        throw std::runtime_error("Unable to compress block: "_s + ZSTD_getErrorName(n));
+    }
+    out.resize(n);
+#else
+    codec = codec_zlib;
+    {
+        boost::iostreams::filtering_ostream os;
+        os.push(boost::iostreams::zlib_compressor(boost::iostreams::zlib::best_speed));
+        os.push(boost::iostreams::back_inserter(out));
+        os.write(in.data(), static_cast<std::streamsize>(in.size()));
+        boost::iostreams::close(os);
+    }
+#endif
+    return out;
+}
+
+// Block sizes come from the table of contents, which is not trusted. Output is grown in chunks and decompression stops as
+// soon as the recorded size is exceeded, so a malicious block cannot force an arbitrarily large allocation.
+std::string decompress_block(const char *in, const chunked_drover_archive_entry_t &e){
+    const std::size_t chunk = 1024 * 1024;
+    std::string out;
+    if(e.codec == codec_none){
+        if(e.compressed_size != e.uncompressed_size){
+            throw std::runtime_error("Uncompressed block size does not match the table of contents");
+        }
+        out.assign(in, e.compressed_size);
+
+    }else if(e.codec == codec_zlib){
+        boost::iostreams::filtering_istream is;
+        is.push(boost::iostreams::zlib_decompressor());
+        is.push(boost::iostreams::array_source(in, e.compressed_size));
+        while(is && (out.size() <= e.uncompressed_size)){
+            const auto n = out.size();
+            out.resize(n + chunk);
+            is.read(out.data() + n, static_cast<std::streamsize>(chunk));
+            out.resize(n + static_cast<std::size_t>(is.gcount()));
+        }
+        if(is.bad()){
+            throw std::runtime_error("Unable to decompress block");
+        }
+
+    }else if(e.codec == codec_zstd){
+#ifdef DCMA_USE_ZSTD
+        std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+        if(dctx == nullptr){
+            throw std::runtime_error("Unable to create zstd decompression context");
+        }
+        ZSTD_inBuffer ib = { in, static_cast<std::size_t>(e.compressed_size), 0 };
+        while(out.size() <= e.uncompressed_size){
+            const auto n = out.size();
+            out.resize(n + chunk);
+            ZSTD_outBuffer ob = { out.data() + n, chunk, 0 };
+            const auto r = ZSTD_decompressStream(dctx.get(), &ob, &ib);
+            if(ZSTD_isError(r)){
+                throw std::runtime_error("Unable to decompress block: "_s + ZSTD_getErrorName(r));
+            }
+            out.resize(n + ob.pos);
+            if((r == 0) && (ib.pos == ib.size)) break; // All frames are complete.
+            if((ob.pos == 0) && (ib.pos == ib.size)){
+                throw std::runtime_error("Compressed block is truncated");
+            }
+        }
+#else
+        throw std::runtime_error("Block is compressed with zstd, but zstd support is not available");
+#endif
+    }else{
+        throw std::runtime_error("Block compression method not understood");
+    }
+    if(out.size() != e.uncompressed_size){
+        throw std::runtime_error("Decompressed block size does not match the table of contents");
+    }
+    return out;
+}
+
+// Splits a Drover into single-object Drovers, labelled for the table of contents.
+//
+// Note: The Drover class holds everything as shared_ptrs, so these copies are superficial (aside from contours).
+std::vector<std::pair<chunked_drover_archive_entry_t, Drover>> split_drover(const Drover &in){
+    std::vector<std::pair<chunked_drover_archive_entry_t, Drover>> out;
+    const auto add = [&](const std::string &category, int64_t index) -> Drover & {
+        out.emplace_back();
+        out.back().first.category = category;
+        out.back().first.index = index;
+        return out.back().second;
+    };
+
+    int64_t i = 0;
+    if(in.contour_data != nullptr){
+        for(const auto &cc : in.contour_data->ccs){
+            auto &d = add("contours", i++);
+            d.contour_data = std::make_shared<Contour_Data>();
+            d.contour_data->ccs.push_back(cc);
+        }
+    }
+    i = 0;
+    for(const auto &p : in.image_data) add("images", i++).image_data.push_back(p);
+    i = 0;
+    for(const auto &p : in.point_data) add("pointclouds", i++).point_data.push_back(p);
+    i = 0;
+    for(const auto &p : in.smesh_data) add("surfacemeshes", i++).smesh_data.push_back(p);
+    i = 0;
+    for(const auto &p : in.rtplan_data) add("rtplans", i++).rtplan_data.push_back(p);
+    i = 0;
+    for(const auto &p : in.lsamp_data) add("linesamples", i++).lsamp_data.push_back(p);
+    return out;
+}
+
+// Parses the selection into a map from category to indices. An empty set of indices selects the whole category.
+std::map<std::string, std::set<int64_t>> parse_chunked_selection(const std::string &selection){
+    std::map<std::string, std::set<int64_t>> out;
+    for(const auto &clause : SplitStringToVector(selection, ';', 'd')){
+        const auto c = Canonicalize_String2(clause, CANONICALIZE::TRIM_ENDS);
+        if(c.empty()) continue;
+
+        const auto at = c.find('@');
+        const auto category = Canonicalize_String2(c.substr(0, at), CANONICALIZE::TRIM_ENDS);
+        auto &indices = out[category];
+        if(at == std::string::npos) continue;
+        for(const auto &n : SplitStringToVector(c.substr(at + 1), ',', 'd')){
+            const auto t = Canonicalize_String2(n, CANONICALIZE::TRIM_ENDS);
+            if(!t.empty()) indices.insert( std::stoll(t) );
+        }
+        if(indices.empty()){
+            throw std::invalid_argument("No indices provided for category '"_s + category + "'");
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+
+bool
+Common_Boost_Serialize_Drover_to_Chunked_Binary(const Drover &in,
+                                                const std::filesystem::path& Filename){
+
+    try{
+        auto objs = split_drover(in);
+
+        std::ofstream ofs(Filename.string(), std::ios::trunc | std::ios::binary);
+        if(!ofs) return false;
+        ofs.write(chunked_archive_signature.data(), static_cast<std::streamsize>(chunked_archive_signature.size()));
+        uint64_t offset = chunked_archive_signature.size();
+
+        // Compress a window of objects in parallel, then write them in order. The window bounds memory usage.
+        const auto N_objs = static_cast<int64_t>(objs.size());
+        const auto window = std::max<int64_t>(2, 2 * static_cast<int64_t>(work_stealing_scheduler::global().concurrency()));
+        for(int64_t w_begin = 0; w_begin < N_objs; w_begin += window){
+            const auto w_end = std::min(N_objs, w_begin + window);
+            std::vector<std::string> blocks(static_cast<size_t>(w_end - w_begin));
+            {
+                task_group tg;
+                for(int64_t n = w_begin; n < w_end; ++n){
+                    tg.submit_task([&,n](){
+                        std::string raw;
+                        {
+                            boost::iostreams::filtering_ostream os;
+                            os.push(boost::iostreams::back_inserter(raw));
+                            {
+                                boost::archive::binary_oarchive ar(os);
+                                ar & boost::serialization::make_nvp("dicom_data", objs[n].second);
+                            }
+                            boost::iostreams::close(os);
+                        }
+                        objs[n].first.uncompressed_size = raw.size();
+                        blocks[n - w_begin] = compress_block(raw, objs[n].first.codec);
+                        objs[n].first.compressed_size = blocks[n - w_begin].size();
+                        objs[n].second = Drover(); // Release references as early as possible.
+                    });
+                }
+                tg.wait();
+            }
+            for(int64_t n = w_begin; n < w_end; ++n){
+                const auto &b = blocks[n - w_begin];
+                objs[n].first.offset = offset;
+                ofs.write(b.data(), static_cast<std::streamsize>(b.size()));
+                offset += b.size();
+            }
+            if(!ofs) return false;
+        }
+
+        std::string toc;
+        write_u64(toc, objs.size());
+        for(const auto &o : objs){
+            const auto &e = o.first;
+            write_u64(toc, e.category.size());
+            toc += e.category;
+            write_u64(toc, static_cast<uint64_t>(e.index));
+            toc.push_back(static_cast<char>(e.codec));
+            write_u64(toc, e.offset);
+            write_u64(toc, e.compressed_size);
+            write_u64(toc, e.uncompressed_size);
+        }
+        std::string footer;
+        write_u64(footer, offset);
+        write_u64(footer, toc.size());
+        footer += chunked_archive_signature;
+
+        ofs.write(toc.data(), static_cast<std::streamsize>(toc.size()));
+        ofs.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+        ofs.flush();
+        if(!ofs) return false;
+    }catch(const std::exception &e){
+        YLOGWARN("Unable to write chunked archive: " << e.what());
+        return false;
+    }
+
+    return true;
+}
+
+
+bool
+Is_Chunked_Drover_Archive(const std::filesystem::path& Filename){
+    std::ifstream ifs(Filename.string(), std::ios::in | std::ios::binary);
+    std::string sig(chunked_archive_signature.size(), '\0');
+    if(!ifs.read(sig.data(), static_cast<std::streamsize>(sig.size()))) return false;
+    return (sig == chunked_archive_signature);
+}
+
+
+namespace {
+
+std::vector<chunked_drover_archive_entry_t>
+parse_chunked_contents(const char *begin, const char *end){
+    const auto N_sig = static_cast<int64_t>(chunked_archive_signature.size());
+    const auto N_file = static_cast<int64_t>(end - begin);
+    if( (N_file < (2 * N_sig + 16))
+    ||  (std::string(begin, N_sig) != chunked_archive_signature)
+    ||  (std::string(end - N_sig, N_sig) != chunked_archive_signature) ){
+        throw std::runtime_error("File is not a chunked archive, or is truncated");
+    }
+
+    // Offsets and sizes are untrusted, so range checks are arranged to avoid wrapping.
+    const char *f = end - N_sig - 16;
+    const auto toc_offset = read_u64(f, end);
+    const auto toc_size = read_u64(f, end);
+    const auto toc_limit = static_cast<uint64_t>(N_file - N_sig - 16);
+    if( (toc_offset < static_cast<uint64_t>(N_sig))
+    ||  (toc_limit < toc_offset)
+    ||  ((toc_limit - toc_offset) < toc_size) ){
+        throw std::runtime_error("Chunked archive table of contents is invalid");
+    }
+
+    const char *p = begin + toc_offset;
+    const char *toc_end = p + toc_size;
+    const auto N_entries = read_u64(p, toc_end);
+    std::vector<chunked_drover_archive_entry_t> out;
+    for(uint64_t n = 0; n < N_entries; ++n){
+        chunked_drover_archive_entry_t e;
+        const auto N_cat = read_u64(p, toc_end);
+        if(static_cast<uint64_t>(toc_end - p) < N_cat) throw std::runtime_error("Chunked archive is truncated");
+        e.category.assign(p, N_cat);
+        p += N_cat;
+        e.index = static_cast<int64_t>(read_u64(p, toc_end));
+        if(p == toc_end) throw std::runtime_error("Chunked archive is truncated");
+        e.codec = static_cast<uint8_t>(*(p++));
+        e.offset = read_u64(p, toc_end);
+        e.compressed_size = read_u64(p, toc_end);
+        e.uncompressed_size = read_u64(p, toc_end);
+        if( (e.offset < static_cast<uint64_t>(N_sig))
+        ||  (toc_offset < e.offset)
+        ||  ((toc_offset - e.offset) < e.compressed_size) ){
+            throw std::runtime_error("Chunked archive block extends beyond the data region");
+        }
+        out.push_back(e);
+    }
+    return out;
+}
+
+} // namespace
+
+
+std::vector<chunked_drover_archive_entry_t>
+Read_Chunked_Drover_Archive_Contents(const std::filesystem::path& Filename){
+    boost::iostreams::mapped_file_source mf(Filename.string());
+    return parse_chunked_contents(mf.data(), mf.data() + mf.size());
+}
+
+
+bool
+Common_Boost_Deserialize_Chunked_Drover(Drover &out,
+                                        const std::filesystem::path& Filename,
+                                        const std::string &Selection){
+    try{
+        if(!Is_Chunked_Drover_Archive(Filename)) return false;
+        boost::iostreams::mapped_file_source mf(Filename.string());
+        const auto entries = parse_chunked_contents(mf.data(), mf.data() + mf.size());
+
+        // Identify the selected entries.
+        const auto selection = parse_chunked_selection(Selection);
+        std::map<std::string, int64_t> category_counts;
+        for(const auto &e : entries) ++category_counts[e.category];
+        for(const auto &s : selection){
+            if(category_counts.count(s.first) == 0){
+                YLOGWARN("Chunked archive contains no objects in category '" << s.first << "'");
+            }
+        }
+
+        std::vector<const chunked_drover_archive_entry_t *> selected;
+        for(const auto &e : entries){
+            if(!selection.empty()){
+                const auto s_it = selection.find(e.category);
+                if(s_it == std::end(selection)) continue;
+                const auto N = category_counts[e.category];
+                if( !s_it->second.empty()
+                &&  (s_it->second.count(e.index) == 0)
+                &&  (s_it->second.count(e.index - N) == 0) ) continue;
+            }
+            selected.push_back(&e);
+        }
+
+        // Decompress and deserialize in parallel, then merge in archive order.
+        std::vector<Drover> parts(selected.size());
+        {
+            task_group tg;
+            for(size_t n = 0; n < selected.size(); ++n){
+                tg.submit_task([&,n](){
+                    const auto &e = *(selected[n]);
+                    const auto raw = decompress_block(mf.data() + e.offset, e);
+                    boost::iostreams::filtering_istream is;
+                    is.push(boost::iostreams::array_source(raw.data(), raw.size()));
+                    boost::archive::binary_iarchive ar(is);
+                    ar & boost::serialization::make_nvp("dicom_data", parts[n]);
+                });
+            }
+            tg.wait();
+        }
+        for(auto &d : parts) out.Consume(d);
+
+    }catch(const std::exception &e){
+        YLOGWARN("Unable to read chunked archive: " << e.what());
+        return false;
+    }
+
+    return true;
+}
+
+
 //=====================================================================================================================
 
 #ifdef DCMA_USE_GNU_GSL
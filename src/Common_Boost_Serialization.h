@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <boost/filesystem/fstream.hpp>
 #include <string>    
+#include <vector>
 
 #ifdef DCMA_USE_GNU_GSL
     #include "KineticModel_1Compartment2Input_5Param_Chebyshev_Common.h"
@@ -50,6 +52,44 @@ bool
 Common_Boost_Serialize_Drover_to_XML(const Drover &in, const std::filesystem::path& Filename);
 
 
+// --- Chunked binary archives ---
+// Each object (i.e., contour collection, image array, point cloud, surface mesh, treatment plan, and line sample) is
+// serialized to a binary archive and compressed independently, and a table of contents is appended. Objects are
+// compressed and decompressed in parallel, and individual objects can be loaded without decoding the others.
+//
+// Objects are compressed with zstd when available, otherwise with zlib. Like other binary archives, chunked archives
+// are not portable across architectures.
+
+struct chunked_drover_archive_entry_t {
+    std::string category;       // One of "contours", "images", "pointclouds", "surfacemeshes", "rtplans", "linesamples".
+    int64_t index = 0;          // Position within the category, in the order objects were held by the Drover.
+    uint8_t codec = 0;          // Compression method.
+    uint64_t offset = 0;        // Location of the compressed block, in bytes from the start of the file.
+    uint64_t compressed_size = 0;
+    uint64_t uncompressed_size = 0;
+};
+
+bool
+Common_Boost_Serialize_Drover_to_Chunked_Binary(const Drover &in, const std::filesystem::path& Filename);
+
+// Checks the file signature. Does not validate the contents.
+bool
+Is_Chunked_Drover_Archive(const std::filesystem::path& Filename);
+
+// Throws if the file is not a valid chunked archive.
+std::vector<chunked_drover_archive_entry_t>
+Read_Chunked_Drover_Archive_Contents(const std::filesystem::path& Filename);
+
+// Loads the selected objects. The selection is a semicolon-separated list of categories, each optionally followed by an
+// '@' and comma-separated indices within the category. Negative indices count from the end. For example,
+// "images@0,-1;contours" selects the first and last image arrays and all contours. An empty selection loads
+// everything. Colons are avoided so the selection can be passed as an operation argument.
+bool
+Common_Boost_Deserialize_Chunked_Drover(Drover &out,
+                                        const std::filesystem::path& Filename,
+                                        const std::string &Selection = "");
+
+
 
 #ifdef DCMA_USE_GNU_GSL
 // --- Pharmacokinetic model state ---
@@ -10,8 +10,13 @@
 //#include <utility>
 #include <tuple>
 #include <functional>
+#include <stdexcept>
 #include <utility>
 
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
 #include <YgorMisc.h>
 #include "YgorLog.h"
 #include <YgorString.h>
@@ -644,5 +649,167 @@ uint64_t Node::emit_DICOM(std::ostream &os,
     return cumulative_length;
 }
 
+
+//////////////
+
+static void append_LE(std::string &out, uint64_t x, int64_t bytes){
+    for(int64_t i = 0; i < bytes; ++i){
+        out.push_back(static_cast<char>((x >> (8 * i)) & 0xFF));
+    }
+    return;
+}
+
+void append_pixel_data_header(std::string &file,
+                              Encoding enc,
+                              uint64_t length){
+    if((length % 2) != 0){
+        throw std::invalid_argument("Pixel data must have an even length. Cannot continue.");
+    }
+    if(static_cast<uint64_t>(0xFFFFFFFEULL) < length){
+        throw std::invalid_argument("Pixel data is too long. Cannot continue.");
+    }
+
+    append_LE(file, 0x7FE0, 2);
+    append_LE(file, 0x0010, 2);
+    if(enc == Encoding::ELE){
+        file.append("OB");
+        append_LE(file, 0, 2); // "Reserved" space.
+    }else if(enc != Encoding::ILE){
+        throw std::runtime_error("Unsupported encoding specified. Refusing to continue.");
+    }
+    append_LE(file, length, 4);
+    return;
+}
+
+// Encodes a single row of bytes using the PackBits scheme.
+static void encode_RLE_row(const unsigned char *p, int64_t n, std::string &out){
+    int64_t i = 0;
+    while(i < n){
+        // Replicate runs, which are worthwhile for two or more identical bytes.
+        int64_t run = 1;
+        while((i + run < n) && (run < 128) && (p[i + run] == p[i])) ++run;
+        if(2 <= run){
+            out.push_back(static_cast<char>(static_cast<int8_t>(1 - run)));
+            out.push_back(static_cast<char>(p[i]));
+            i += run;
+            continue;
+        }
+
+        // Literal runs, which stop just before the next replicate run.
+        int64_t lit = 1;
+        while( (i + lit < n)
+           &&  (lit < 128)
+           &&  !((i + lit + 1 < n) && (p[i + lit] == p[i + lit + 1])) ) ++lit;
+        out.push_back(static_cast<char>(lit - 1));
+        out.append(reinterpret_cast<const char *>(p + i), static_cast<size_t>(lit));
+        i += lit;
+    }
+    return;
+}
+
+std::string encode_RLE_frame(const unsigned char *samples,
+                             int64_t rows,
+                             int64_t columns,
+                             int64_t samples_per_pixel,
+                             int64_t bytes_per_sample){
+    const auto N_segments = samples_per_pixel * bytes_per_sample;
+    if( (rows <= 0) || (columns <= 0) || (samples_per_pixel <= 0) || (bytes_per_sample <= 0) ){
+        throw std::invalid_argument("Invalid frame dimensions. Cannot continue.");
+    }
+    if(15 < N_segments){
+        throw std::invalid_argument("Too many RLE segments are required. Cannot continue.");
+    }
+    const auto stride = samples_per_pixel * bytes_per_sample;
+
+    // The header holds the number of segments and the offset of each, measured from the start of the frame.
+    std::string out(64, '\0');
+    std::vector<unsigned char> row_bytes(static_cast<size_t>(columns));
+    for(int64_t seg = 0; seg < N_segments; ++seg){
+        const auto sample = seg / bytes_per_sample;
+        const auto byte = (bytes_per_sample - 1) - (seg % bytes_per_sample); // Most significant first.
+
+        std::string header;
+        append_LE(header, static_cast<uint64_t>(out.size()), 4);
+        out.replace(static_cast<size_t>(4 * (seg + 1)), 4, header);
+
+        // Each row is encoded separately.
+        for(int64_t row = 0; row < rows; ++row){
+            const unsigned char *p = samples + (row * columns * stride) + (sample * bytes_per_sample) + byte;
+            for(int64_t col = 0; col < columns; ++col) row_bytes[col] = p[col * stride];
+            encode_RLE_row(row_bytes.data(), columns, out);
+        }
+        if((out.size() % 2) != 0) out.push_back('\0'); // Segments have even length.
+    }
+
+    std::string header;
+    append_LE(header, static_cast<uint64_t>(N_segments), 4);
+    out.replace(0, 4, header);
+    return out;
+}
+
+void append_encapsulated_pixel_data(std::string &file,
+                                    const std::vector<std::string> &frames){
+    append_LE(file, 0x7FE0, 2);
+    append_LE(file, 0x0010, 2);
+    file.append("OB");
+    append_LE(file, 0, 2); // "Reserved" space.
+    append_LE(file, 0xFFFFFFFFULL, 4); // Undefined length.
+
+    // Basic offset table, which is optional and left empty.
+    append_LE(file, 0xFFFE, 2);
+    append_LE(file, 0xE000, 2);
+    append_LE(file, 0, 4);
+
+    for(const auto &f : frames){
+        const auto pad = static_cast<uint64_t>(f.size() % 2);
+        append_LE(file, 0xFFFE, 2);
+        append_LE(file, 0xE000, 2);
+        append_LE(file, static_cast<uint64_t>(f.size()) + pad, 4);
+        file.append(f);
+        if(0 < pad) file.push_back('\0');
+    }
+
+    // Sequence delimiter.
+    append_LE(file, 0xFFFE, 2);
+    append_LE(file, 0xE0DD, 2);
+    append_LE(file, 0, 4);
+    return;
+}
+
+void deflate_data_set(std::string &file){
+    // The meta information header begins with its group length, which locates the start of the data set.
+    const size_t header_length = 132 + 12;
+    if( (file.size() < header_length)
+    ||  (file.compare(128, 4, "DICM") != 0)
+    ||  (file.compare(132, 6, std::string("\x02\x00\x00\x00UL", 6)) != 0) ){
+        throw std::invalid_argument("File does not begin with a meta information header. Cannot continue.");
+    }
+    uint64_t group_length = 0;
+    for(size_t i = 0; i < 4; ++i){
+        group_length |= static_cast<uint64_t>(static_cast<unsigned char>(file[140 + i])) << (8 * i);
+    }
+    const auto data_set_offset = header_length + group_length;
+    if(file.size() < data_set_offset){
+        throw std::invalid_argument("Meta information header is truncated. Cannot continue.");
+    }
+
+    std::string compressed;
+    {
+        boost::iostreams::zlib_params params(boost::iostreams::zlib::best_speed);
+        params.noheader = true; // The data set is a raw deflate stream, without a zlib header or checksum.
+
+        boost::iostreams::filtering_ostream os;
+        os.push(boost::iostreams::zlib_compressor(params));
+        os.push(boost::iostreams::back_inserter(compressed));
+        os.write(file.data() + data_set_offset, static_cast<std::streamsize>(file.size() - data_set_offset));
+        boost::iostreams::close(os);
+    }
+    if((compressed.size() % 2) != 0) compressed.push_back('\0'); // Padded to even length.
+
+    file.resize(data_set_offset);
+    file.append(compressed);
+    return;
+}
+
 } // namespace DCMA_DICOM
 
@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iosfwd>
 #include <functional>
+#include <string>
+#include <vector>
 
 #include <list>
 
@@ -59,6 +62,34 @@ struct Node {
 
 };
 
+//////////////
+
+// Helpers for writing pixel data and compressed transfer syntaxes. These operate on fully emitted files so that bulk
+// pixel data can be written directly, without first being copied into a Node.
+
+// Appends the header of a native (i.e., uncompressed) pixel data element (7FE0,0010). The caller must then append
+// exactly 'length' bytes, which must be even. Pixel data must be the final element in the file.
+void append_pixel_data_header(std::string &file,
+                              Encoding enc,
+                              uint64_t length);
+
+// Encodes a single frame of interleaved little-endian samples using the RLE lossless transfer syntax
+// (1.2.840.10008.1.2.5). Each byte of each sample becomes a separate segment, most significant byte first.
+std::string encode_RLE_frame(const unsigned char *samples,
+                             int64_t rows,
+                             int64_t columns,
+                             int64_t samples_per_pixel,
+                             int64_t bytes_per_sample);
+
+// Appends an encapsulated pixel data element (7FE0,0010) with an empty basic offset table and one fragment per frame.
+// Encapsulated pixel data requires explicit encoding. Pixel data must be the final element in the file.
+void append_encapsulated_pixel_data(std::string &file,
+                                    const std::vector<std::string> &frames);
+
+// Compresses the data set (i.e., everything following the meta information header) of an emitted file, as required
+// by the deflated explicit little-endian transfer syntax (1.2.840.10008.1.2.1.99). The file must have been emitted
+// with explicit encoding and must declare this transfer syntax.
+void deflate_data_set(std::string &file);
 
 } // namespace DCMA_DICOM
 
@@ -0,0 +1,616 @@
+// DCMA_DICOM_Reader.cc - A part of DICOMautomaton 2024. Written by hal clark.
+//
+// This file contains routines for reading DICOM files natively, without Imebra.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "YgorImages.h"
+#include "YgorMisc.h"
+#include "YgorLog.h"
+#include "YgorString.h"
+
+#include "DCMA_DICOM.h"
+#include "DCMA_DICOM_Reader.h"
+
+namespace DCMA_DICOM {
+
+struct MappedFile::Impl {
+    boost::iostreams::mapped_file_source mf;
+};
+
+MappedFile::MappedFile(const std::filesystem::path &filename) : pimpl(std::make_unique<Impl>()) {
+    // Note: empty files cannot be mapped.
+    if(std::filesystem::file_size(filename) == 0){
+        throw std::runtime_error("File '"_s + filename.string() + "' is empty");
+    }
+    this->pimpl->mf.open(filename.string());
+    if(!this->pimpl->mf.is_open()){
+        throw std::runtime_error("Unable to map file '"_s + filename.string() + "'");
+    }
+}
+
+MappedFile::~MappedFile() = default;
+
+const unsigned char * MappedFile::data() const {
+    return reinterpret_cast<const unsigned char *>(this->pimpl->mf.data());
+}
+
+uint64_t MappedFile::size() const {
+    return static_cast<uint64_t>(this->pimpl->mf.size());
+}
+
+
+namespace {
+
+const uint32_t undefined_length = 0xFFFF'FFFF;
+
+// Sequences are parsed recursively, so nesting is limited to avoid exhausting the stack on malicious files.
+// Legitimate files rarely nest sequences more than a handful of levels deep.
+const int64_t max_sequence_depth = 64;
+
+// Deflated data sets are inflated into memory, so the inflated size is limited to guard against decompression bombs.
+// The limit scales with the deflated size, within fixed bounds, so that only pathological ratios are rejected.
+uint64_t max_inflated_size(uint64_t deflated_size){
+    const uint64_t lo    = 64ULL * 1024ULL * 1024ULL;         // 64 MiB.
+    const uint64_t hi    = 4ULL * 1024ULL * 1024ULL * 1024ULL; // 4 GiB.
+    const uint64_t ratio = 128ULL;
+    const uint64_t scaled = (deflated_size < (hi / ratio)) ? deflated_size * ratio : hi;
+    return std::clamp(scaled, lo, hi);
+}
+
+template <class T>
+T load_le(const unsigned char *p){
+    T x;
+    std::memcpy(&x, p, sizeof(T));
+    return x;
+}
+
+bool is_VR(const unsigned char *p){
+    return ('A' <= p[0]) && (p[0] <= 'Z')
+        && ('A' <= p[1]) && (p[1] <= 'Z');
+}
+
+// VRs that use a 4-byte length (preceded by 2 reserved bytes) with explicit encoding.
+bool has_long_length(const std::string &VR){
+    return (VR == "OB") || (VR == "OD") || (VR == "OF") || (VR == "OL") || (VR == "OV") || (VR == "OW")
+        || (VR == "SQ") || (VR == "SV") || (VR == "UC") || (VR == "UN") || (VR == "UR") || (VR == "UT")
+        || (VR == "UV");
+}
+
+// With implicit encoding the VR must be inferred. Only binary VRs need to be known, since text is stored as-is and
+// sequences are detected from their content.
+std::string implicit_VR(uint16_t group, uint16_t tag){
+    static const std::map<uint32_t, std::string> dict = {
+        { 0x0018'1310, "US" }, // AcquisitionMatrix
+        { 0x0018'9087, "FD" }, // DiffusionBValue
+        { 0x0018'9089, "FD" }, // DiffusionGradientOrientation
+        { 0x0028'0002, "US" }, // SamplesPerPixel
+        { 0x0028'0006, "US" }, // PlanarConfiguration
+        { 0x0028'0010, "US" }, // Rows
+        { 0x0028'0011, "US" }, // Columns
+        { 0x0028'0100, "US" }, // BitsAllocated
+        { 0x0028'0101, "US" }, // BitsStored
+        { 0x0028'0102, "US" }, // HighBit
+        { 0x0028'0103, "US" }, // PixelRepresentation
+        { 0x0028'0106, "US" }, // SmallestImagePixelValue
+        { 0x0028'0107, "US" }, // LargestImagePixelValue
+        { 0x0028'0108, "US" }, // SmallestPixelValueInSeries
+        { 0x0028'0109, "US" }, // LargestPixelValueInSeries
+        { 0x0028'1101, "US" }, // RedPaletteColorLookupTableDescriptor
+        { 0x0028'1102, "US" }, // GreenPaletteColorLookupTableDescriptor
+        { 0x0028'1103, "US" }, // BluePaletteColorLookupTableDescriptor
+        { 0x0028'3002, "US" }, // LUTDescriptor
+        { 0x0028'3006, "US" }, // LUTData
+        { 0x0040'9211, "US" }, // RealWorldValueLastValueMapped
+        { 0x0040'9212, "FD" }, // RealWorldValueLUTData
+        { 0x0040'9213, "FD" }, // DoubleFloatRealWorldValueLastValueMapped
+        { 0x0040'9214, "FD" }, // DoubleFloatRealWorldValueFirstValueMapped
+        { 0x0040'9216, "US" }, // RealWorldValueFirstValueMapped
+        { 0x0040'9224, "FD" }, // RealWorldValueIntercept
+        { 0x0040'9225, "FD" }, // RealWorldValueSlope
+        { 0x0054'0081, "US" }, // NumberOfSlices
+        { 0x7FE0'0010, "OW" }, // PixelData
+    };
+    const auto it = dict.find( (static_cast<uint32_t>(group) << 16) | static_cast<uint32_t>(tag) );
+    return (it == std::end(dict)) ? std::string("UN") : it->second;
+}
+
+template <class T>
+void append_binary_as_text(std::ostringstream &ss, const unsigned char *p, uint64_t length){
+    const auto N = length / sizeof(T);
+    for(uint64_t i = 0; i < N; ++i){
+        if(i != 0) ss << '\\';
+        const auto x = load_le<T>(p + i * sizeof(T));
+        if constexpr (std::is_floating_point_v<T>){
+            ss << std::setprecision(std::numeric_limits<T>::max_digits10) << x;
+        }else{
+            ss << static_cast<int64_t>(x);
+        }
+    }
+    return;
+}
+
+// Converts a value to the representation used by the writer.
+std::string decode_value(const std::string &VR, const unsigned char *p, uint64_t length){
+    std::ostringstream ss;
+    if((VR == "US") || (VR == "OW") || (VR == "AT")){
+        append_binary_as_text<uint16_t>(ss, p, length);
+    }else if(VR == "SS"){
+        append_binary_as_text<int16_t>(ss, p, length);
+    }else if((VR == "UL") || (VR == "OL")){
+        append_binary_as_text<uint32_t>(ss, p, length);
+    }else if(VR == "SL"){
+        append_binary_as_text<int32_t>(ss, p, length);
+    }else if((VR == "SV") || (VR == "UV") || (VR == "OV")){
+        append_binary_as_text<int64_t>(ss, p, length);
+    }else if((VR == "FL") || (VR == "OF")){
+        append_binary_as_text<float>(ss, p, length);
+    }else if((VR == "FD") || (VR == "OD")){
+        append_binary_as_text<double>(ss, p, length);
+    }else if((VR == "OB") || (VR == "UN")){
+        return std::string(reinterpret_cast<const char *>(p), length);
+    }else{
+        // Text. Trailing padding is removed.
+        auto l = length;
+        while((0 < l) && ((p[l-1] == ' ') || (p[l-1] == '\0'))) --l;
+        return std::string(reinterpret_cast<const char *>(p), l);
+    }
+    return ss.str();
+}
+
+class parser_t {
+    private:
+        const unsigned char *data;
+        const ReadOptions &opts;
+        ParsedDataset &out;
+
+        size_t N_wanted_found = 0;
+
+        void require(uint64_t pos, uint64_t end, uint64_t n) const {
+            if( (end < pos) || ((end - pos) < n) ){
+                throw std::runtime_error("DICOM data is truncated or malformed");
+            }
+        }
+
+        // Determines whether a value with implicit encoding and unknown VR is a sequence.
+        bool looks_like_sequence(uint64_t pos, uint64_t end, uint32_t len) const {
+            if( (len < 8U) || ((end - pos) < 8U) ) return false;
+            if( (load_le<uint16_t>(this->data + pos) != 0xFFFE)
+            ||  (load_le<uint16_t>(this->data + pos + 2) != 0xE000) ) return false;
+            const auto item_len = load_le<uint32_t>(this->data + pos + 4);
+            return (item_len == undefined_length) || (static_cast<uint64_t>(item_len) + 8U <= len);
+        }
+
+        // Skips encapsulated pixel data, i.e., a sequence of fragments terminated by a sequence delimiter.
+        uint64_t skip_encapsulated(uint64_t pos, uint64_t end) const {
+            while(true){
+                require(pos, end, 8);
+                const auto g = load_le<uint16_t>(this->data + pos);
+                const auto t = load_le<uint16_t>(this->data + pos + 2);
+                const auto l = load_le<uint32_t>(this->data + pos + 4);
+                pos += 8;
+                if((g == 0xFFFE) && (t == 0xE0DD)) return pos;
+                if((g != 0xFFFE) || (t != 0xE000) || (l == undefined_length)){
+                    throw std::runtime_error("Encapsulated pixel data is malformed");
+                }
+                require(pos, end, l);
+                pos += l;
+            }
+        }
+
+        uint64_t parse_sequence(uint64_t pos, uint64_t end, uint32_t len, Node &seq, int64_t depth, Encoding enc){
+            if(max_sequence_depth <= depth){
+                throw std::runtime_error("DICOM sequences are nested too deeply");
+            }
+            const bool undefined = (len == undefined_length);
+            if(!undefined){
+                require(pos, end, len);
+                end = pos + len;
+            }
+
+            uint32_t item_n = 0;
+            while(pos < end){
+                require(pos, end, 8);
+                const auto g = load_le<uint16_t>(this->data + pos);
+                const auto t = load_le<uint16_t>(this->data + pos + 2);
+                const auto l = load_le<uint32_t>(this->data + pos + 4);
+                pos += 8;
+                if(undefined && (g == 0xFFFE) && (t == 0xE0DD)) return pos;
+                if((g != 0xFFFE) || (t != 0xE000)){
+                    throw std::runtime_error("Expected a sequence item");
+                }
+
+                Node &item = seq.children.emplace_back(NodeKey{0x0000, 0x0000, item_n++, 0}, "MULTI", "");
+                if(l == undefined_length){
+                    pos = this->parse_elements(pos, end, item, depth + 1, true, enc);
+                }else{
+                    require(pos, end, l);
+                    this->parse_elements(pos, pos + l, item, depth + 1, false, enc);
+                    pos += l;
+                }
+            }
+            if(undefined) throw std::runtime_error("Sequence is not terminated");
+            return pos;
+        }
+
+    public:
+        bool stopped = false;
+
+        parser_t(const unsigned char *data, const ReadOptions &opts, ParsedDataset &out)
+            : data(data), opts(opts), out(out) {}
+
+        // Parses a single element, adding it to the parent. Returns the position following the element.
+        uint64_t parse_element(uint64_t pos, uint64_t end, Node &parent, int64_t depth, Encoding enc){
+            require(pos, end, 8);
+            const auto group = load_le<uint16_t>(this->data + pos);
+            const auto tag   = load_le<uint16_t>(this->data + pos + 2);
+            pos += 4;
+
+            std::string VR;
+            uint32_t len = 0;
+            if(enc == Encoding::ELE){
+                if(!is_VR(this->data + pos)){
+                    throw std::runtime_error("Invalid VR encountered");
+                }
+                VR.assign(reinterpret_cast<const char *>(this->data + pos), 2);
+                pos += 2;
+                if(has_long_length(VR)){
+                    require(pos, end, 6);
+                    len = load_le<uint32_t>(this->data + pos + 2);
+                    pos += 6;
+                }else{
+                    require(pos, end, 2);
+                    len = load_le<uint16_t>(this->data + pos);
+                    pos += 2;
+                }
+            }else{
+                len = load_le<uint32_t>(this->data + pos);
+                pos += 4;
+                VR = implicit_VR(group, tag);
+            }
+
+            const bool is_top_level = (depth == 0);
+            const bool is_pixel_data = is_top_level && (group == 0x7FE0) && (tag == 0x0010);
+            const bool is_wanted = this->opts.wanted.empty()
+                                || !is_top_level
+                                || (this->opts.wanted.count({ group, tag }) != 0);
+
+            if(is_pixel_data){
+                Node &n = parent.children.emplace_back(NodeKey{group, tag, 0, 0}, VR, "");
+                if(len == undefined_length){
+                    this->out.pixel_data_encapsulated = true;
+                    pos = this->skip_encapsulated(pos, end);
+                }else{
+                    require(pos, end, len);
+                    this->out.pixel_data = this->data + pos;
+                    this->out.pixel_data_length = len;
+                    if(this->opts.copy_pixel_data){
+                        n.val.assign(reinterpret_cast<const char *>(this->data + pos), len);
+                    }
+                    pos += len;
+                }
+
+            }else if( (VR == "SQ")
+                  ||  (len == undefined_length)
+                  ||  ((enc == Encoding::ILE) && (VR == "UN") && this->looks_like_sequence(pos, end, len)) ){
+                // Items of 'UN' elements with undefined length are always implicitly encoded.
+                const auto seq_enc = ((VR == "UN") && (len == undefined_length)) ? Encoding::ILE : enc;
+                if(is_wanted){
+                    Node &n = parent.children.emplace_back(NodeKey{group, tag, 0, 0}, "SQ", "");
+                    pos = this->parse_sequence(pos, end, len, n, depth, seq_enc);
+                }else if(len != undefined_length){
+                    require(pos, end, len);
+                    pos += len;
+                }else{
+                    // The extent is only known after parsing.
+                    Node discard;
+                    pos = this->parse_sequence(pos, end, len, discard, depth, seq_enc);
+                }
+
+            }else{
+                require(pos, end, len);
+                if(is_wanted){
+                    parent.children.emplace_back(NodeKey{group, tag, 0, 0}, VR, decode_value(VR, this->data + pos, len));
+                }
+                pos += len;
+            }
+
+            if(is_top_level && is_wanted && !this->opts.wanted.empty()){
+                ++(this->N_wanted_found);
+                if(this->opts.wanted.size() <= this->N_wanted_found) this->stopped = true;
+            }
+            return pos;
+        }
+
+        // Parses elements in [pos, end). Items with undefined length are terminated by an item delimiter.
+        uint64_t parse_elements(uint64_t pos, uint64_t end, Node &parent, int64_t depth, bool undefined_item, Encoding enc){
+            while(pos < end){
+                require(pos, end, 4);
+                const auto group = load_le<uint16_t>(this->data + pos);
+                const auto tag   = load_le<uint16_t>(this->data + pos + 2);
+                if((group == 0xFFFE) && (tag == 0xE00D)){
+                    if(!undefined_item) throw std::runtime_error("Unexpected item delimiter");
+                    require(pos, end, 8);
+                    return pos + 8;
+                }
+
+                if( (depth == 0) && !this->opts.wanted.empty()
+                &&  (*std::rbegin(this->opts.wanted) < std::make_pair(group, tag)) ){
+                    this->stopped = true;
+                }
+                if(this->stopped) return pos;
+
+                pos = this->parse_element(pos, end, parent, depth, enc);
+                if(this->stopped) return pos;
+            }
+            if(undefined_item) throw std::runtime_error("Item is not terminated");
+            return pos;
+        }
+};
+
+std::optional<std::string> get_value(const ParsedDataset &ds, uint16_t group, uint16_t tag, uint32_t element){
+    const auto *n = ds.find(group, tag);
+    if( (n == nullptr) || (n->VR == "SQ") ) return {};
+
+    auto tokens = SplitStringToVector(n->val, '\\', 'd');
+    if(tokens.size() <= element) return {};
+    auto v = Canonicalize_String2(tokens[element], CANONICALIZE::TRIM_ENDS);
+    while(!v.empty() && (v.back() == '\0')) v.pop_back();
+    return v;
+}
+
+} // namespace
+
+
+const Node * ParsedDataset::find(uint16_t group, uint16_t tag) const {
+    for(const auto &n : this->root.children){
+        if((n.key.group == group) && (n.key.tag == tag)) return &n;
+    }
+    return nullptr;
+}
+
+std::optional<std::string> ParsedDataset::get_string(uint16_t group, uint16_t tag, uint32_t element) const {
+    return get_value(*this, group, tag, element);
+}
+
+std::optional<double> ParsedDataset::get_double(uint16_t group, uint16_t tag, uint32_t element) const {
+    const auto v = get_value(*this, group, tag, element);
+    if(!v || v->empty()) return {};
+    try{
+        return std::stod(v.value());
+    }catch(const std::exception &){}
+    return {};
+}
+
+std::optional<int64_t> ParsedDataset::get_integer(uint16_t group, uint16_t tag, uint32_t element) const {
+    const auto v = get_value(*this, group, tag, element);
+    if(!v || v->empty()) return {};
+    try{
+        return static_cast<int64_t>(std::stoll(v.value()));
+    }catch(const std::exception &){}
+    return {};
+}
+
+
+ParsedDataset read_DICOM(const unsigned char *data,
+                         uint64_t length,
+                         const ReadOptions &opts){
+    // Values are loaded directly, so this must be a little-endian machine.
+    {
+        const uint16_t test = 0x01;
+        if(*reinterpret_cast<const unsigned char *>(&test) != 0x01){
+            throw std::runtime_error("This computer is not little-endian. This is not supported.");
+        }
+    }
+
+    ParsedDataset out;
+    parser_t parser(data, opts, out);
+
+    // The preamble and signature are optional, but without them the data must start with a plausible group.
+    uint64_t pos = 0;
+    if( (132U <= length)
+    &&  (std::memcmp(data + 128, "DICM", 4) == 0) ){
+        pos = 132;
+    }else{
+        if(length < 8U) throw std::runtime_error("Data is too short to be DICOM");
+        const auto group = load_le<uint16_t>(data);
+        if( (group != 0x0002) && (group != 0x0008) ){
+            throw std::runtime_error("Data does not appear to be DICOM");
+        }
+    }
+
+    // The meta information header is always explicit little-endian.
+    while( (pos + 4U <= length)
+       &&  (load_le<uint16_t>(data + pos) == 0x0002) ){
+        pos = parser.parse_element(pos, length, out.root, 1, Encoding::ELE);
+    }
+    for(const auto &n : out.root.children){
+        if((n.key.group == 0x0002) && (n.key.tag == 0x0010)){
+            out.transfer_syntax = Canonicalize_String2(n.val, CANONICALIZE::TRIM_ENDS);
+            while(!out.transfer_syntax.empty() && (out.transfer_syntax.back() == '\0')) out.transfer_syntax.pop_back();
+        }
+    }
+
+    if(out.transfer_syntax == "1.2.840.10008.1.2"){
+        out.enc = Encoding::ILE;
+    }else if(out.transfer_syntax == "1.2.840.10008.1.2.2"){
+        throw std::runtime_error("Explicit big-endian transfer syntax is not supported");
+    }else if(out.transfer_syntax == "1.2.840.10008.1.2.1.99"){
+        // Deflated explicit little-endian. The data set is a raw deflate stream, which is inflated into a buffer owned
+        // by the dataset and parsed from there.
+        auto inflated = std::make_shared<std::string>();
+        {
+            boost::iostreams::zlib_params params;
+            params.noheader = true;
+
+            boost::iostreams::filtering_istream is;
+            is.push(boost::iostreams::zlib_decompressor(params));
+            is.push(boost::iostreams::array_source(reinterpret_cast<const char *>(data + pos),
+                                                   static_cast<std::size_t>(length - pos)));
+
+            // Inflate in chunks, stopping as soon as the limit is exceeded.
+            const auto limit = max_inflated_size(length - pos);
+            const std::size_t chunk = 1024 * 1024;
+            while(is){
+                const auto n = inflated->size();
+                inflated->resize(n + chunk);
+                is.read(inflated->data() + n, static_cast<std::streamsize>(chunk));
+                inflated->resize(n + static_cast<std::size_t>(is.gcount()));
+                if(limit < inflated->size()){
+                    throw std::runtime_error("Deflated data set inflates beyond the permitted size");
+                }
+            }
+            if(is.bad()){
+                throw std::runtime_error("Unable to inflate deflated data set");
+            }
+        }
+        out.enc = Encoding::ELE;
+        out.inflated = inflated;
+
+        parser_t inflated_parser(reinterpret_cast<const unsigned char *>(inflated->data()), opts, out);
+        inflated_parser.parse_elements(0, inflated->size(), out.root, 0, false, out.enc);
+        out.complete = !inflated_parser.stopped;
+        return out;
+
+    }else if(out.transfer_syntax == "1.2.840.10008.1.2.8.1"){
+        throw std::runtime_error("Deflated image frame compression is not supported");
+    }else if(!out.transfer_syntax.empty()){
+        // Explicit little-endian, possibly with encapsulated (compressed) pixel data.
+        out.enc = Encoding::ELE;
+    }else{
+        // Without a meta information header, guess the encoding from the first element.
+        out.enc = ( (pos + 6U <= length) && is_VR(data + pos + 4) ) ? Encoding::ELE : Encoding::ILE;
+    }
+
+    pos = parser.parse_elements(pos, length, out.root, 0, false, out.enc);
+    out.complete = !parser.stopped;
+    return out;
+}
+
+
+namespace {
+
+template <class T>
+void decode_stored_values(const unsigned char *p,
+                          int64_t N,
+                          int64_t bits_stored,
+                          int64_t high_bit,
+                          bool is_signed,
+                          float *out){
+    const auto shift = high_bit + 1 - bits_stored;
+    const auto bits_allocated = static_cast<int64_t>(8 * sizeof(T));
+
+    // Common case: all bits are used, so values can be converted directly.
+    if( (shift == 0) && (bits_stored == bits_allocated) ){
+        using S = std::make_signed_t<T>;
+        if(is_signed){
+            for(int64_t i = 0; i < N; ++i) out[i] = static_cast<float>(load_le<S>(p + i * sizeof(T)));
+        }else{
+            for(int64_t i = 0; i < N; ++i) out[i] = static_cast<float>(load_le<T>(p + i * sizeof(T)));
+        }
+        return;
+    }
+
+    const uint64_t mask = (static_cast<uint64_t>(1) << bits_stored) - 1;
+    const uint64_t sign_bit = static_cast<uint64_t>(1) << (bits_stored - 1);
+    for(int64_t i = 0; i < N; ++i){
+        const uint64_t u = (static_cast<uint64_t>(load_le<T>(p + i * sizeof(T))) >> shift) & mask;
+        const int64_t v = (is_signed && ((u & sign_bit) != 0)) ? static_cast<int64_t>(u) - static_cast<int64_t>(mask) - 1
+                                                               : static_cast<int64_t>(u);
+        out[i] = static_cast<float>(v);
+    }
+    return;
+}
+
+// Multiplies non-negative values, returning false on overflow.
+bool checked_multiply(uint64_t a, uint64_t b, uint64_t &out){
+    if( (a != 0U) && ((std::numeric_limits<uint64_t>::max() / a) < b) ) return false;
+    out = a * b;
+    return true;
+}
+
+} // namespace
+
+bool decode_pixel_frame(const ParsedDataset &ds,
+                        int64_t frame,
+                        planar_image<float,double> &img){
+    if( (ds.pixel_data == nullptr)
+    ||  ds.pixel_data_encapsulated ) return false;
+
+    const auto rows           = ds.get_integer(0x0028, 0x0010);
+    const auto columns        = ds.get_integer(0x0028, 0x0011);
+    const auto bits_allocated = ds.get_integer(0x0028, 0x0100);
+    if(!rows || !columns || !bits_allocated) return false;
+
+    const auto samples        = ds.get_integer(0x0028, 0x0002).value_or(1);
+    const auto planar_config  = ds.get_integer(0x0028, 0x0006).value_or(0);
+    const auto bits_stored    = ds.get_integer(0x0028, 0x0101).value_or(bits_allocated.value());
+    const auto high_bit       = ds.get_integer(0x0028, 0x0102).value_or(bits_stored - 1);
+    const auto pixel_rep      = ds.get_integer(0x0028, 0x0103).value_or(0);
+    const auto frames         = ds.get_integer(0x0028, 0x0008).value_or(1);
+
+    // Rows and columns are unsigned 16-bit values, and at most four samples per pixel are defined.
+    if( (rows.value() <= 0) || (columns.value() <= 0) || (samples <= 0)
+    ||  (0xFFFF < rows.value()) || (0xFFFF < columns.value()) || (4 < samples)
+    ||  ((bits_allocated.value() != 8) && (bits_allocated.value() != 16) && (bits_allocated.value() != 32))
+    ||  (bits_stored <= 0) || (bits_allocated.value() < bits_stored)
+    ||  (high_bit < (bits_stored - 1)) || (bits_allocated.value() <= high_bit)
+    ||  ((1 < samples) && (planar_config != 0))
+    ||  ((pixel_rep != 0) && (pixel_rep != 1))
+    ||  (frame < 0) || (frames <= frame) ){
+        return false;
+    }
+
+    // Sizes are computed in unsigned arithmetic with overflow checks, since the frame number is unbounded.
+    const auto bytes_per_sample = static_cast<uint64_t>(bits_allocated.value() / 8);
+    uint64_t N_u = 0;
+    uint64_t frame_bytes = 0;
+    uint64_t frame_offset = 0;
+    if( !checked_multiply(static_cast<uint64_t>(rows.value()), static_cast<uint64_t>(columns.value()), N_u)
+    ||  !checked_multiply(N_u, static_cast<uint64_t>(samples), N_u)
+    ||  !checked_multiply(N_u, bytes_per_sample, frame_bytes)
+    ||  !checked_multiply(static_cast<uint64_t>(frame), frame_bytes, frame_offset)
+    ||  (ds.pixel_data_length < frame_bytes)
+    ||  ((ds.pixel_data_length - frame_bytes) < frame_offset) ){
+        return false;
+    }
+    const auto N = static_cast<int64_t>(N_u);
+
+    img.rows = rows.value();
+    img.columns = columns.value();
+    img.channels = samples;
+    img.data.resize(static_cast<size_t>(N));
+
+    const auto *p = ds.pixel_data + frame_offset;
+    const bool is_signed = (pixel_rep == 1);
+    if(bytes_per_sample == 1){
+        decode_stored_values<uint8_t>(p, N, bits_stored, high_bit, is_signed, img.data.data());
+    }else if(bytes_per_sample == 2){
+        decode_stored_values<uint16_t>(p, N, bits_stored, high_bit, is_signed, img.data.data());
+    }else{
+        decode_stored_values<uint32_t>(p, N, bits_stored, high_bit, is_signed, img.data.data());
+    }
+    return true;
+}
+
+} // namespace DCMA_DICOM
+
@@ -0,0 +1,90 @@
+// DCMA_DICOM_Reader.h.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "YgorImages.h"
+
+#include "DCMA_DICOM.h"
+
+namespace DCMA_DICOM {
+
+// A read-only view of a file's contents, memory-mapped where possible.
+class MappedFile {
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pimpl;
+
+    public:
+        explicit MappedFile(const std::filesystem::path &filename);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile & operator=(const MappedFile &) = delete;
+
+        const unsigned char * data() const;
+        uint64_t size() const;
+};
+
+struct ReadOptions {
+    // If non-empty, parsing stops as soon as all of these top-level tags (group, tag) have been read, or when a later
+    // top-level tag is encountered, since tags are stored in ascending order. Other top-level tags with a defined
+    // length are skipped without being decoded.
+    std::set<std::pair<uint16_t, uint16_t>> wanted;
+
+    // Whether to copy the pixel data (7FE0,0010) into the tree. If false, only its location is recorded.
+    bool copy_pixel_data = false;
+};
+
+// A parsed dataset using the same Node model as the writer. Top-level tags are children of the root. Sequence ('SQ')
+// nodes have one 'MULTI' child per item, which holds the item's tags.
+//
+// Values are stored as they would be provided to the writer: text VRs hold the text (minus trailing padding) and binary
+// numeric VRs (e.g., 'US', 'FD', 'AT', 'OW') are converted to backslash-separated text. 'OB' and 'UN' hold raw bytes.
+// With implicit encoding, tags not in a small built-in dictionary of binary and sequence tags are treated as 'UN'.
+struct ParsedDataset {
+    Node root;
+    Encoding enc = Encoding::Other;     // Encoding of the dataset. (The meta information header is always ELE.)
+    std::string transfer_syntax;
+    bool complete = false;              // False if parsing stopped early.
+
+    // Holds the inflated data set for the deflated explicit little-endian transfer syntax, in which case it (rather
+    // than the parsed buffer) holds the pixel data.
+    std::shared_ptr<const std::string> inflated;
+
+    // Pixel data location within the parsed buffer, which must outlive any use of it.
+    const unsigned char *pixel_data = nullptr;
+    uint64_t pixel_data_length = 0;
+    bool pixel_data_encapsulated = false; // Compressed pixel data, which is not located or decoded.
+
+    // Accessors for top-level tags. Strings are trimmed and only the given element (i.e., value multiplicity index)
+    // is returned.
+    const Node * find(uint16_t group, uint16_t tag) const;
+    std::optional<std::string> get_string(uint16_t group, uint16_t tag, uint32_t element = 0) const;
+    std::optional<double> get_double(uint16_t group, uint16_t tag, uint32_t element = 0) const;
+    std::optional<int64_t> get_integer(uint16_t group, uint16_t tag, uint32_t element = 0) const;
+};
+
+// Parses implicit, explicit, or deflated explicit little-endian DICOM from a buffer. The 128 byte preamble and 'DICM'
+// signature are optional. Big-endian transfer syntaxes and deflated image frames are rejected. Throws on malformed or truncated input.
+ParsedDataset read_DICOM(const unsigned char *data,
+                         uint64_t length,
+                         const ReadOptions &opts = ReadOptions());
+
+// Decodes a single frame of uncompressed, native pixel data directly into the image's pixel buffer, setting the rows,
+// columns, and channels (i.e., samples per pixel). Stored values are returned unaltered: no rescaling, LUT, or colour
+// space transformations are applied. Returns false if the pixel data cannot be decoded natively, in which case the
+// image is not altered.
+bool decode_pixel_frame(const ParsedDataset &ds,
+                        int64_t frame,
+                        planar_image<float,double> &img);
+
+} // namespace DCMA_DICOM
+
@@ -14,11 +14,15 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <filesystem>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include <cstdlib>            //Needed for exit() calls.
 
 #include "Explicator.h"       //Needed for Explicator class.
 #include "Imebra_Shim.h"      //Wrapper for Imebra library. Black-boxed to speed up compilation.
 #include "Structs.h"
+#include "Thread_Pool.h"
 #include "YgorImages.h"
 #include "YgorMath.h"         //Needed for vec3 class.
 #include "YgorMisc.h"         //Needed for FUNCINFO, FUNCWARN, FUNCERR macros.
@@ -26,24 +30,98 @@
 
 
 static
-std::unique_ptr<Contour_Data>
-Concatenate_Contour_Data(std::unique_ptr<Contour_Data> A,
-                         std::unique_ptr<Contour_Data> B){
-    //This routine concatenates A and B's contour collections. No internal checking is performed.
-    // No copying is performed, but A and B are consumed. A is returned as if it were a new pointer.
-    A->ccs.splice( A->ccs.end(), std::move(B->ccs) );
-    return A;
+void
+Splice_Contour_Data(Contour_Data &A,
+                    Contour_Data &B){
+    //This routine moves B's contour collections onto the end of A's. No internal checking is performed.
+    // No copying is performed; B is left empty.
+    A.ccs.splice( A.ccs.end(), B.ccs );
+    return;
+}
+
+
+// The number of worker threads used to parse and decode files. Zero defers to the available hardware concurrency.
+static std::atomic<long int> dicom_loader_thread_count = 0;
+
+void Set_DICOM_Loader_Thread_Count(long int n){
+    dicom_loader_thread_count.store( std::max<long int>(0, n) );
+    return;
+}
+
+long int Get_DICOM_Loader_Thread_Count(){
+    return dicom_loader_thread_count.load();
+}
+
+// The outcome of parsing and decoding a single file. Only the member matching the modality is populated.
+struct decoded_dicom_file_t {
+    std::string modality;
+    std::unique_ptr<Transform3> transform;
+    std::unique_ptr<RTPlan> rtplan;
+    std::unique_ptr<Contour_Data> contours;
+    std::unique_ptr<Image_Array> dose;
+    std::unique_ptr<Image_Array> imgs;
+
+    bool decode_failed = false;
+    std::string decode_error;
+};
+
+static
+decoded_dicom_file_t
+Decode_DICOM_File(const std::filesystem::path &Filename, bool defer_pixels){
+    // Parse the file once and reuse the parsed representation for both classification and decoding.
+    decoded_dicom_file_t out;
+
+    std::shared_ptr<Parsed_DICOM_File> pf;
+    try{
+        pf = Parse_DICOM_File(Filename);
+        out.modality = get_modality(*pf);
+    }catch(const std::exception &e){
+        YLOGWARN("Unable to extract modality ('" << e.what() << "')");
+        out.modality = "";
+        return out;
+    };
+
+    try{
+        if(boost::iequals(out.modality,"REG")){
+            out.transform = Load_Transform(*pf);
+
+        }else if(boost::iequals(out.modality,"RTPLAN")){
+            out.rtplan = Load_RTPlan(*pf);
+
+        }else if(boost::iequals(out.modality,"RTSTRUCT")){
+            out.contours = get_Contour_Data(*pf);
+
+        }else if(boost::iequals(out.modality,"RTDOSE")){
+            out.dose = Load_Dose_Array(*pf);
+
+        }else if(  boost::iequals(out.modality,"CT")
+                || boost::iequals(out.modality,"OT")
+                || boost::iequals(out.modality,"US")
+                || boost::iequals(out.modality,"MR")
+                || boost::iequals(out.modality,"RTIMAGE")
+                || boost::iequals(out.modality,"PT") ){
+            out.imgs = Load_Image_Array(*pf, !defer_pixels);
+        }
+    }catch(const std::exception &e){
+        out.decode_failed = true;
+        out.decode_error = e.what();
+    }
+    return out;
 }
 
 
 bool Load_From_DICOM_Files( Drover &DICOM_data,
                             std::map<std::string,std::string> & /* InvocationMetadata */,
                             const std::string &FilenameLex,
-                            std::list<std::filesystem::path> &Filenames ){
+                            std::list<std::filesystem::path> &Filenames,
+                            bool defer_pixels ){
 
     //This routine will attempt to load DICOM files on an individual file basis. Files that are not successfully loaded
     // are not consumed so that they can be passed on to the next loading stage as needed. 
     //
+    // Files are parsed and decoded concurrently, but the results are consumed in the order the files were provided
+    // so that the loaded data does not depend on thread scheduling.
+    //
     // Note: This routine returns false only iff a file is suspected of being suited for this loader, but could not be
     //       loaded (e.g., the file seems appropriate, but a parsing failure was encountered).
     //
@@ -60,23 +138,40 @@ bool Load_From_DICOM_Files( Drover &DICOM_data,
     loaded_imgs_storage.emplace_back();
     loaded_dose_storage.emplace_back();
 
-    size_t i = 0;
     const size_t N = Filenames.size();
 
-    auto bfit = Filenames.begin();
-    while(bfit != Filenames.end()){
-        YLOGINFO("Parsing file #" << i+1 << "/" << N << " = " << 100*(i+1)/N << "% \t" << *bfit);
-        ++i;
-
-        const auto Filename = *bfit;
-        std::string Modality;
-        try{
-            Modality = get_modality(Filename);
-        }catch(const std::exception &e){
-            YLOGWARN("Unable to extract modality ('" << e.what() << "')");
-            Modality = "";
+    // Parse and decode all files.
+    std::vector<decoded_dicom_file_t> decoded(N);
+    {
+        std::vector<std::filesystem::path> l_Filenames( std::begin(Filenames), std::end(Filenames) );
+        std::mutex printer;
+        size_t completed = 0;
+
+        const auto decode = [&](size_t i) -> void {
+            decoded[i] = Decode_DICOM_File(l_Filenames[i], defer_pixels);
+
+            std::lock_guard<std::mutex> lock(printer);
+            ++completed;
+            YLOGINFO("Parsed file #" << completed << "/" << N << " = " << 100*completed/N << "% \t" << l_Filenames[i]);
         };
 
+        const auto thread_count = Get_DICOM_Loader_Thread_Count();
+        if( (thread_count == 1) || (N == 1) ){
+            for(size_t i = 0; i < N; ++i) decode(i);
+        }else{
+            task_group tp(thread_count);
+            for(size_t i = 0; i < N; ++i){
+                tp.submit_task([&,i]() -> void { decode(i); });
+            }
+            tp.wait();
+        } // Joins the thread pool.
+    }
+
+    // Consume the decoded files in order.
+    auto bfit = Filenames.begin();
+    for(auto &d : decoded){
+        const auto &Modality = d.modality;
+
         if(boost::iequals(Modality,"RTRECORD")){
             YLOGWARN("RTRECORD file encountered. "
                      "DICOMautomaton currently is not equipped to read RTRECORD-modality DICOM files. "
@@ -88,9 +183,10 @@ bool Load_From_DICOM_Files( Drover &DICOM_data,
             YLOGWARN("REG file support is experimental");
 
             try{
-                auto t = Load_Transform(Filename);
-if(t == nullptr) YLOGWARN("(t == nullptr)");
-if(std::get_if<std::monostate>(&(t->transform)) != nullptr) YLOGWARN("(std::get_if<std::monostate>(&(t->transform)) != nullptr)");
+                if(d.decode_failed){
+                    throw std::runtime_error(d.decode_error);
+                }
+                auto t = std::move(d.transform);
                 if( (t == nullptr)
                 ||  (std::get_if<std::monostate>(&(t->transform)) != nullptr) ){
                     throw std::runtime_error("unable to extract transformation");
@@ -102,8 +198,6 @@ if(std::get_if<std::monostate>(&(t->transform)) != nullptr) YLOGWARN("(std::get_
                 YLOGWARN("Difficulty encountered during registration transform loading: '" << e.what() << "'. Refusing to continue");
 
                 return false;
-                //bfit = Filenames.erase( bfit ); 
-                //continue;
             }
 
             bfit = Filenames.erase( bfit );  // Consume the file; we know what it is, but cannot make use of it.
@@ -111,21 +205,26 @@ if(std::get_if<std::monostate>(&(t->transform)) != nullptr) YLOGWARN("(std::get_
         }else if(boost::iequals(Modality,"RTPLAN")){
             YLOGWARN("RTPLAN file support is experimental");
 
-            auto rtplan = Load_RTPlan(Filename);
-            DICOM_data.rtplan_data.emplace_back( std::move(rtplan) );
+            if(d.decode_failed){
+                throw std::runtime_error(d.decode_error);
+            }
+            DICOM_data.rtplan_data.emplace_back( std::move(d.rtplan) );
 
             bfit = Filenames.erase( bfit ); 
 
         }else if(boost::iequals(Modality,"RTSTRUCT")){
             const auto preloadcount = loaded_contour_data_storage->ccs.size();
             try{
-                auto combined = Concatenate_Contour_Data( loaded_contour_data_storage->Duplicate(),
-                                                          get_Contour_Data(Filename));
-                loaded_contour_data_storage = std::move(combined);
+                if(d.decode_failed){
+                    throw std::runtime_error(d.decode_error);
+                }
+                if(d.contours == nullptr){
+                    throw std::runtime_error("No contour data was decoded");
+                }
+                Splice_Contour_Data(*loaded_contour_data_storage, *(d.contours));
 
             }catch(const std::exception &e){
                 YLOGWARN("Difficulty encountered during contour data loading: '" << e.what() << "'. Ignoring file and continuing");
-                //loaded_contour_data_storage.back().pop_back();
                 bfit = Filenames.erase( bfit ); 
                 continue;
             }
@@ -142,14 +241,12 @@ if(std::get_if<std::monostate>(&(t->transform)) != nullptr) YLOGWARN("(std::get_
             bfit = Filenames.erase( bfit ); 
 
         }else if(boost::iequals(Modality,"RTDOSE")){
-            try{
-                loaded_dose_storage.back().push_back( Load_Dose_Array(Filename));
-            }catch(const std::exception &e){
-                YLOGWARN("Difficulty encountered during dose array loading: '" << e.what() << "'. Ignoring file and continuing");
-                //loaded_dose_storage.back().pop_back();
+            if(d.decode_failed){
+                YLOGWARN("Difficulty encountered during dose array loading: '" << d.decode_error << "'. Ignoring file and continuing");
                 bfit = Filenames.erase( bfit ); 
                 continue;
             }
+            loaded_dose_storage.back().push_back( std::move(d.dose) );
 
             bfit = Filenames.erase( bfit ); 
 
@@ -160,14 +257,12 @@ if(std::get_if<std::monostate>(&(t->transform)) != nullptr) YLOGWARN("(std::get_
                 || boost::iequals(Modality,"RTIMAGE")
                 || boost::iequals(Modality,"PT") ){
 
-            try{
-                loaded_imgs_storage.back().push_back( Load_Image_Array(Filename));
-            }catch(const std::exception &e){
-                YLOGWARN("Difficulty encountered during image array loading: '" << e.what() << "'. Ignoring file and continuing");
-                //loaded_imgs_storage.back().pop_back();
+            if(d.decode_failed){
+                YLOGWARN("Difficulty encountered during image array loading: '" << d.decode_error << "'. Ignoring file and continuing");
                 bfit = Filenames.erase( bfit ); 
                 continue;
             }
+            loaded_imgs_storage.back().push_back( std::move(d.imgs) );
 
             bfit = Filenames.erase( bfit ); 
 
@@ -187,20 +282,31 @@ if(std::get_if<std::monostate>(&(t->transform)) != nullptr) YLOGWARN("(std::get_
     //Attempt contour name normalization using the selected lexicon.
     {
         Explicator X(FilenameLex);
+        std::map<std::string, std::string> normalized_cache; // Contours within a collection typically share a name.
         for(auto & cc : loaded_contour_data_storage->ccs){
              for(auto & c : cc.contours){
-                 const auto NormalizedROIName = X(c.metadata["ROIName"]); //Could be cached, externally or internally.
-                 c.metadata["NormalizedROIName"] = NormalizedROIName;
+                 const auto &ROIName = c.metadata["ROIName"];
+                 auto n_it = normalized_cache.find(ROIName);
+                 if(n_it == std::end(normalized_cache)){
+                     n_it = normalized_cache.emplace(ROIName, X(ROIName)).first;
+                 }
+                 c.metadata["NormalizedROIName"] = n_it->second;
              }
         }
     }
 
     //Concatenate contour data into the Drover instance.
     {
-        if(DICOM_data.contour_data == nullptr) DICOM_data.contour_data = std::make_shared<Contour_Data>();
-        auto combined = Concatenate_Contour_Data( DICOM_data.contour_data->Duplicate(),
-                                                  loaded_contour_data_storage->Duplicate());
-        DICOM_data.contour_data = std::move(combined);
+        // The loaded contours are moved, not copied. Existing contour data is only duplicated if it is shared (e.g.,
+        // with a snapshot), so that other holders are not altered.
+        if(DICOM_data.contour_data == nullptr){
+            DICOM_data.contour_data = loaded_contour_data_storage;
+        }else{
+            if(DICOM_data.contour_data.use_count() != 1){
+                DICOM_data.contour_data = std::shared_ptr<Contour_Data>(DICOM_data.contour_data->Duplicate());
+            }
+            Splice_Contour_Data(*(DICOM_data.contour_data), *loaded_contour_data_storage);
+        }
     }
 
     //Collate each group of images into a single set, if possible. Also stuff the correct contour data in the same set.
@@ -10,7 +10,16 @@
 
 #include "Structs.h"
 
+// If requested, decoding image pixel data is deferred until it is first needed (see Deferred_Pixels.h). Deferral
+// avoids decoding (and storing) pixels for images that are only used for their metadata, but callers that opt in
+// must restore pixels before accessing them.
 bool Load_From_DICOM_Files( Drover &DICOM_data,
                             std::map<std::string,std::string> &InvocationMetadata,
                             const std::string &FilenameLex,
-                            std::list<std::filesystem::path> &Filenames );
+                            std::list<std::filesystem::path> &Filenames,
+                            bool defer_pixels = false );
+
+// Controls the number of threads used to concurrently parse and decode DICOM files.
+// Zero (the default) uses all available hardware threads, and one disables concurrent loading.
+void Set_DICOM_Loader_Thread_Count(long int n);
+long int Get_DICOM_Loader_Thread_Count();
@@ -16,6 +16,8 @@
 //#include <cfenv>              //Needed for std::feclearexcept(FE_ALL_EXCEPT).
 
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <cstdlib>            //Needed for exit() calls.
 #include <utility>            //Needed for std::pair.
 
@@ -30,9 +32,12 @@
 #include "Documentation.h"
 #include "PACS_Loader.h"
 #include "File_Loader.h"
+#include "DICOM_File_Loader.h"
+#include "Thread_Pool.h"
 #include "Lexicon_Loader.h"
 
 #include "Operation_Dispatcher.h"
+#include "Operation_Profiler.h"
 #include "DCMA_Version.h"
 
 //extern const std::string DCMA_VERSION_STR;
@@ -68,9 +73,15 @@ try{
     //A explicit declaration that the user will generate data in an operation.
     bool GeneratingVirtualData = false;
 
+    //Whether decoding image pixel data should be deferred until an operation first needs it.
+    bool DeferPixels = false;
+
     //A Boolean guard variable to ensure loose parameters are only added to valid, active operations.
     bool MostRecentOperationActive = false;
 
+    //Where operation profiling data should be written, if profiling is requested.
+    std::string ProfileFilename;
+
 
     //------------------------------------------------- Data: Database -----------------------------------------------
     // The following objects are only relevant for the PACS database loader.
@@ -202,6 +213,56 @@ try{
       })
     );
 
+    arger.push_back( ygor_arg_handlr_t(239, 'j', "concurrency", true, "0",
+      "The maximum number of worker threads used for parallel processing. All parallel work is shared"
+      " amongst this many threads, including nested parallel work. Zero uses all available hardware threads."
+      " This option can be used to limit resource usage when other jobs are running concurrently.",
+      [&](const std::string &optarg) -> void {
+        Set_Thread_Concurrency_Limit( std::stol(optarg) );
+        return;
+      })
+    );
+
+    arger.push_back( ygor_arg_handlr_t(240, 't', "loader-threads", true, "0",
+      "The number of threads to use when parsing and decoding DICOM files. Files are decoded concurrently,"
+      " but loaded data is ordered as if the files were loaded sequentially. Zero is limited only by the"
+      " global concurrency limit (see '--concurrency'), and one disables concurrent loading.",
+      [&](const std::string &optarg) -> void {
+        Set_DICOM_Loader_Thread_Count( std::stol(optarg) );
+        return;
+      })
+    );
+
+    arger.push_back( ygor_arg_handlr_t(241, 'e', "defer-pixels", false, "",
+      "Defer decoding DICOM image pixel data until an operation first needs it. Operations that only"
+      " access image metadata, such as sorting and grouping, will not cause pixel data to be decoded.",
+      [&](const std::string &) -> void {
+        DeferPixels = !DeferPixels;
+        return;
+      })
+    );
+
+    arger.push_back( ygor_arg_handlr_t(242, 'P', "profile", true, "/tmp/profile.json",
+      "Record wall time, CPU time, peak memory usage, and object counts for every operation, including"
+      " nested children operations. A trace will be written to the given file in the Chrome trace event"
+      " format, which can be viewed with Perfetto or chrome://tracing. A summary table will also be logged.",
+      [&](const std::string &optarg) -> void {
+        ProfileFilename = optarg;
+        Set_Operation_Profiling(true);
+        return;
+      })
+    );
+
+    arger.push_back( ygor_arg_handlr_t(243, 'D', "dataflow", false, "",
+      "Invoke consecutive operations concurrently when they access disjoint data. Data access is inferred"
+      " from each operation's selector arguments (e.g., images vs. contours vs. meshes). Only operations"
+      " whose side-effects are known are considered; all others act as barriers and are invoked sequentially.",
+      [&](const std::string &) -> void {
+        Set_Operation_Dataflow( !Get_Operation_Dataflow() );
+        return;
+      })
+    );
+
     arger.push_back( ygor_arg_handlr_t(300, 'm', "metadata", true, "'Volunteer=01'",
       "Metadata key-value pairs which are tacked onto results destined for a database. "
       "If there is an conflicting key-value pair, the values are concatenated.",
@@ -382,7 +443,7 @@ try{
     //Standalone file loading.
     {
         std::list<OperationArgPkg> l_Operations;
-        if(!Load_Files(DICOM_data, InvocationMetadata, FilenameLex, l_Operations, StandaloneFilesDirsReachable)){
+        if(!Load_Files(DICOM_data, InvocationMetadata, FilenameLex, l_Operations, StandaloneFilesDirsReachable, DeferPixels)){
 #ifdef DCMA_FUZZ_TESTING
             // If file loading failed, then the loader successfully rejected bad data. Terminate to indicate this success.
             return 0;
@@ -422,7 +483,25 @@ try{
         throw std::runtime_error("No data was loaded, and virtual data switch was not provided. Refusing to proceed");
     }
 
-    if(!Operation_Dispatcher(DICOM_data, InvocationMetadata, FilenameLex, Operations)){
+    const bool res = Operation_Dispatcher(DICOM_data, InvocationMetadata, FilenameLex, Operations);
+
+    if(Get_Operation_Profiling()){
+        const auto profiles = Get_Operation_Profiles();
+        std::stringstream ss;
+        Write_Operation_Profiles_Summary(ss, profiles);
+        for(std::string line; std::getline(ss, line); ) YLOGINFO(line);
+
+        std::ofstream ofs(ProfileFilename);
+        Write_Operation_Profiles_Chrome_Trace(ofs, profiles);
+        ofs.flush();
+        if(!ofs){
+            YLOGWARN("Unable to write operation profile to '" << ProfileFilename << "'");
+        }else{
+            YLOGINFO("Wrote operation profile to '" << ProfileFilename << "'");
+        }
+    }
+
+    if(!res){
         throw std::runtime_error("Analysis failed. Cannot continue");
     }
 
@@ -0,0 +1,249 @@
+//Deferred_Pixels.cc - A part of DICOMautomaton 2024. Written by hal clark.
+//
+// This file provides support for images whose pixel data is not resident in memory.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "YgorImages.h"
+#include "YgorMisc.h"         //Needed for FUNCINFO, FUNCWARN, FUNCERR macros.
+#include "YgorLog.h"
+#include "YgorString.h"
+
+#include "Structs.h"
+#include "Thread_Pool.h"
+#include "Imebra_Shim.h"
+
+#include "Deferred_Pixels.h"
+
+
+// The recorded source is encoded as "<kind>|<index>|<path>" where the index is either a DICOM frame number or a byte
+// offset into a spill file. The path is last so it can safely contain the separator.
+namespace {
+
+const std::string kind_dicom = "DICOM";
+const std::string kind_spill = "Spill";
+
+struct deferred_source_t {
+    std::string kind;
+    int64_t index = 0;
+    std::filesystem::path path;
+};
+
+std::string encode_source(const deferred_source_t &s){
+    return s.kind + "|" + std::to_string(s.index) + "|" + s.path.string();
+}
+
+deferred_source_t decode_source(const std::string &v){
+    const auto p1 = v.find('|');
+    const auto p2 = (p1 == std::string::npos) ? std::string::npos : v.find('|', p1 + 1);
+    if(p2 == std::string::npos){
+        throw std::invalid_argument("Unable to parse deferred pixel source '"_s + v + "'");
+    }
+    deferred_source_t out;
+    out.kind  = v.substr(0, p1);
+    out.index = std::stoll( v.substr(p1 + 1, p2 - p1 - 1) );
+    out.path  = v.substr(p2 + 1);
+    return out;
+}
+
+void release_pixels(planar_image<float,double> &img){
+    std::vector<float>().swap(img.data);
+    return;
+}
+
+} // namespace
+
+
+bool Has_Deferred_Pixels(const planar_image<float,double> &img){
+    return Get_Deferred_Pixel_Source(img).has_value();
+}
+
+void Defer_Pixels_To_DICOM_File(planar_image<float,double> &img,
+                                const std::filesystem::path &filename,
+                                int64_t frame){
+    deferred_source_t s;
+    s.kind = kind_dicom;
+    s.index = frame;
+    s.path = filename;
+    release_pixels(img);
+    Set_Deferred_Pixel_Source(img, encode_source(s));
+    return;
+}
+
+void Spill_Pixels(std::list<std::reference_wrapper<planar_image<float,double>>> imgs,
+                  const std::filesystem::path &spill_file){
+
+    std::ofstream ofs(spill_file, std::ios::out | std::ios::binary | std::ios::app);
+    if(!ofs) throw std::runtime_error("Unable to open spill file '"_s + spill_file.string() + "' for writing");
+    ofs.seekp(0, std::ios::end);
+
+    for(auto &img_refw : imgs){
+        auto &img = img_refw.get();
+        if(Has_Deferred_Pixels(img)) continue;
+
+        const auto N_elem = static_cast<int64_t>(img.rows) * img.columns * img.channels;
+        if(static_cast<int64_t>(img.data.size()) != N_elem){
+            throw std::logic_error("Image pixel buffer is inconsistent with its dimensions. Refusing to spill");
+        }
+
+        deferred_source_t s;
+        s.kind = kind_spill;
+        s.index = static_cast<int64_t>(ofs.tellp());
+        s.path = spill_file;
+
+        ofs.write( reinterpret_cast<const char *>(img.data.data()),
+                   static_cast<std::streamsize>(sizeof(float) * N_elem) );
+        if(!ofs) throw std::runtime_error("Unable to write to spill file '"_s + spill_file.string() + "'");
+
+        release_pixels(img);
+        Set_Deferred_Pixel_Source(img, encode_source(s));
+    }
+    ofs.flush();
+    if(!ofs) throw std::runtime_error("Unable to write to spill file '"_s + spill_file.string() + "'");
+    return;
+}
+
+void Ensure_Pixels_Resident(std::list<std::reference_wrapper<planar_image<float,double>>> imgs){
+
+    // Group the deferred images by backing file so each file is only mapped or decoded once.
+    using img_refws_t = std::list<std::pair<std::reference_wrapper<planar_image<float,double>>, int64_t>>;
+    std::map<std::pair<std::string, std::filesystem::path>, img_refws_t> by_source;
+    for(auto &img_refw : imgs){
+        auto &img = img_refw.get();
+        const auto v = Get_Deferred_Pixel_Source(img);
+        if(!v) continue;
+
+        const auto s = decode_source(v.value());
+        by_source[ std::make_pair(s.kind, s.path) ].emplace_back( img_refw, s.index );
+    }
+    if(by_source.empty()) return;
+
+    YLOGINFO("Restoring deferred pixels from " << by_source.size() << " source(s)");
+
+    std::mutex err_mutex;
+    std::list<std::string> errors;
+    {
+        task_group tp;
+        for(auto &p : by_source){
+            tp.submit_task([&p,&err_mutex,&errors]() -> void {
+                const auto &kind = p.first.first;
+                const auto &path = p.first.second;
+                try{
+                    if(kind == kind_spill){
+                        boost::iostreams::mapped_file_source mf(path.string());
+                        for(auto &ip : p.second){
+                            auto &img = ip.first.get();
+                            const auto offset = ip.second;
+                            const auto N_elem = static_cast<int64_t>(img.rows) * img.columns * img.channels;
+                            const auto N_bytes = static_cast<int64_t>(sizeof(float)) * N_elem;
+                            if( (offset < 0)
+                            ||  (static_cast<int64_t>(mf.size()) < (offset + N_bytes)) ){
+                                throw std::runtime_error("Spill file is truncated");
+                            }
+                            img.data.resize(N_elem);
+                            std::memcpy( reinterpret_cast<char *>(img.data.data()),
+                                         mf.data() + offset,
+                                         static_cast<size_t>(N_bytes) );
+                            Forget_Deferred_Pixel_Source(img);
+                        }
+
+                    }else if(kind == kind_dicom){
+                        auto decoded = Load_Image_Array(path);
+                        std::vector<planar_image<float,double>*> frames;
+                        for(auto &img : decoded->imagecoll.images) frames.push_back(&img);
+
+                        for(auto &ip : p.second){
+                            auto &img = ip.first.get();
+                            const auto frame = ip.second;
+                            if( (frame < 0)
+                            ||  (static_cast<int64_t>(frames.size()) <= frame) ){
+                                throw std::runtime_error("Frame is not present in file");
+                            }
+
+                            // The decoded image is authoritative for the pixel layout, but the deferred image's
+                            // metadata and geometry are retained since they may have been altered.
+                            //
+                            // Note: the pixels are copied because copied images can share a single frame.
+                            const auto &src = *(frames.at(frame));
+                            img.rows = src.rows;
+                            img.columns = src.columns;
+                            img.channels = src.channels;
+                            img.data = src.data;
+                            Forget_Deferred_Pixel_Source(img);
+                        }
+
+                    }else{
+                        throw std::runtime_error("Deferred pixel source kind '"_s + kind + "' not understood");
+                    }
+                }catch(const std::exception &e){
+                    std::lock_guard<std::mutex> lock(err_mutex);
+                    errors.emplace_back("'"_s + path.string() + "': " + e.what());
+                }
+            });
+        }
+        tp.wait();
+    } // Joins the thread pool.
+
+    if(!errors.empty()){
+        for(const auto &e : errors) YLOGWARN("Unable to restore deferred pixels from " << e);
+        throw std::runtime_error("Unable to restore deferred pixels");
+    }
+    return;
+}
+
+void Ensure_Pixels_Resident(Drover &DICOM_data){
+    std::list<std::reference_wrapper<planar_image<float,double>>> imgs;
+    for(auto &ia_ptr : DICOM_data.image_data){
+        if(ia_ptr == nullptr) continue;
+        for(auto &img : ia_ptr->imagecoll.images){
+            if(Has_Deferred_Pixels(img)) imgs.emplace_back( std::ref(img) );
+        }
+    }
+    Ensure_Pixels_Resident(imgs);
+    return;
+}
+
+std::set<std::string> Operations_Tolerating_Deferred_Pixels(){
+    return {
+        // Metadata- or geometry-only operations.
+        "CopyImages",
+        "DeferImagePixels",
+        "DeleteImages",
+        "GroupImages",
+        "OrderImages",
+        "SelectionIsPresent",
+
+        // Control flow operations. Children are individually assessed when they are dispatched.
+        "And",
+        "AnyOf",
+        "False",
+        "ForEachDistinct",
+        "IfElse",
+        "Ignore",
+        "NoOp",
+        "NoneOf",
+        "Repeat",
+        "Time",
+        "Transaction",
+        "True",
+        "While",
+    };
+}
+
@@ -0,0 +1,44 @@
+//Deferred_Pixels.h.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <set>
+#include <string>
+
+#include "YgorImages.h"
+
+#include "Structs.h"
+
+// Images with deferred pixels retain all metadata and spatial characteristics (rows, columns, channels, position,
+// orientation, and voxel dimensions), but their pixel buffers are empty. The location of the pixel data is recorded
+// in a side table (see Structs.h) rather than the image metadata, so it does not leak into exported files or alter how
+// images are grouped. It follows the image when it is copied, sorted, grouped, or partitioned.
+//
+// Pixels are either decoded from the originating DICOM file or read from a memory-mapped spill file when they are
+// restored. Load_Files() restores pixels unless the caller explicitly opts in to deferral, and the operation
+// dispatcher restores the pixels of the images an operation selects prior to invoking it.
+
+bool Has_Deferred_Pixels(const planar_image<float,double> &img);
+
+// Marks an image as backed by a frame of the given DICOM file. The pixel buffer is released.
+void Defer_Pixels_To_DICOM_File(planar_image<float,double> &img,
+                                const std::filesystem::path &filename,
+                                int64_t frame);
+
+// Appends the pixel data of each image to the given spill file, releases the pixel buffers, and marks the images as
+// backed by the spill file. Images that are already deferred are left as-is.
+void Spill_Pixels(std::list<std::reference_wrapper<planar_image<float,double>>> imgs,
+                  const std::filesystem::path &spill_file);
+
+// Restores pixel data for any deferred images. Each backing file is decoded or memory-mapped only once.
+void Ensure_Pixels_Resident(std::list<std::reference_wrapper<planar_image<float,double>>> imgs);
+void Ensure_Pixels_Resident(Drover &DICOM_data);
+
+// Operations that only access image metadata or geometry, or that delegate to children operations, and can therefore
+// be invoked without restoring deferred pixels.
+std::set<std::string> Operations_Tolerating_Deferred_Pixels();
+
@@ -1,7 +1,7 @@
 //File_Loader.cc - A part of DICOMautomaton 2019, 2021. Written by hal clark.
 
 #include <exception>
-//#include <functional>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
@@ -10,6 +10,7 @@
 #include <vector>
 //#include <cfenv>              //Needed for std::feclearexcept(FE_ALL_EXCEPT).
 #include <initializer_list>
+#include <set>
 
 #include <filesystem>
 //#include <cstdlib>            //Needed for exit() calls.
@@ -21,6 +22,7 @@
 #include "YgorString.h"       //Needed for GetFirstRegex(...)
 
 #include "Structs.h"
+#include "Deferred_Pixels.h"
 
 #include "Boost_Serialization_File_Loader.h"
 #include "DICOM_File_Loader.h"
@@ -55,7 +57,25 @@ Load_Files( Drover &DICOM_data,
             std::map<std::string,std::string> &InvocationMetadata,
             const std::string &FilenameLex,
             std::list<OperationArgPkg> &Operations,
-            std::list<std::filesystem::path> &Paths ){
+            std::list<std::filesystem::path> &Paths,
+            bool defer_pixels ){
+
+    // Images that were already present are left as-is, even if their pixels are deferred.
+    std::set<const Image_Array *> orig_img_arrays;
+    for(const auto &ia_ptr : DICOM_data.image_data) orig_img_arrays.insert(ia_ptr.get());
+
+    // Restore the pixels of loaded images, unless the caller is prepared to handle deferred pixels.
+    const auto ensure_pixels_resident = [&](){
+        if(defer_pixels) return;
+        std::list<std::reference_wrapper<planar_image<float,double>>> imgs;
+        for(auto &ia_ptr : DICOM_data.image_data){
+            if( (ia_ptr == nullptr)
+            ||  (orig_img_arrays.count(ia_ptr.get()) != 0) ) continue;
+            for(auto &img : ia_ptr->imagecoll.images) imgs.emplace_back( std::ref(img) );
+        }
+        Ensure_Pixels_Resident(imgs);
+        return;
+    };
 
     // Generate a priority list of file loaders.
     // Note that some file loaders are extremely generous in what they accept, so feeding them generic files could
@@ -76,7 +96,7 @@ Load_Files( Drover &DICOM_data,
         }});
 
         //Standalone file loading: Boost.Serialization archives.
-        loaders.emplace_back(file_loader_t{{".gz", ".tar", ".tar.gz", ".tgz", ".xml", ".xml.gz", ".txt", ".txt.gz"}, ++priority, [&](std::list<std::filesystem::path> &p) -> bool {
+        loaders.emplace_back(file_loader_t{{".gz", ".tar", ".tar.gz", ".tgz", ".xml", ".xml.gz", ".txt", ".txt.gz", ".bin"}, ++priority, [&](std::list<std::filesystem::path> &p) -> bool {
             if(!p.empty()
             && !Load_From_Boost_Serialization_Files( DICOM_data, InvocationMetadata, FilenameLex, p )){
                 YLOGWARN("Failed to load Boost.Serialization archive");
@@ -88,7 +108,7 @@ Load_Files( Drover &DICOM_data,
         //Standalone file loading: DICOM files.
         loaders.emplace_back(file_loader_t{{".dcm"}, ++priority, [&](std::list<std::filesystem::path> &p) -> bool {
             if(!p.empty()
-            && !Load_From_DICOM_Files( DICOM_data, InvocationMetadata, FilenameLex, p )){
+            && !Load_From_DICOM_Files( DICOM_data, InvocationMetadata, FilenameLex, p, defer_pixels )){
                 YLOGWARN("Failed to load DICOM file");
                 return false;
             }
@@ -420,6 +440,7 @@ Load_Files( Drover &DICOM_data,
             for(const auto &e : l.exts) ss << (ss.str().empty() ? "" : ", ") << "'" << e << "'";
             YLOGINFO("Trying loader for extensions: " << ss.str() << " for file(s) with extension '" << ext << "'");
             if(!l_Paths.empty() && !l.f(l_Paths)){
+                ensure_pixels_resident();
                 return false;
             }
         }
@@ -432,6 +453,7 @@ Load_Files( Drover &DICOM_data,
         for(const auto &p : Paths) YLOGWARN("Unloaded file: '" << p.string() << "'");
     }
 
+    ensure_pixels_resident();
     return (Paths.empty() && !contained_unresolvable);
 }
 
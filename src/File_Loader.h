@@ -10,10 +10,16 @@
 
 #include "Structs.h"
 
+// Loads files into the Drover, trying each of the available file loaders.
+//
+// Unless deferral is requested, the pixels of all loaded images are resident when this routine returns. If deferral
+// is requested, DICOM image pixel data may be left deferred (see Deferred_Pixels.h) and the caller must restore pixels
+// before accessing them.
 bool
 Load_Files( Drover &DICOM_data,
             std::map<std::string,std::string> &InvocationMetadata,
             const std::string &FilenameLex,
             std::list<OperationArgPkg> &Operations,
-            std::list<std::filesystem::path> &Paths );
+            std::list<std::filesystem::path> &Paths,
+            bool defer_pixels = false );
 
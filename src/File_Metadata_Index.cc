@@ -0,0 +1,220 @@
+//File_Metadata_Index.cc - A part of DICOMautomaton 2024. Written by hal clark.
+//
+// This file provides a persistent cache of file metadata, which can be used to avoid re-reading unchanged files.
+//
+
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+
+#include "YgorMisc.h"
+#include "YgorLog.h"
+
+#include "Metadata.h"
+#include "Imebra_Shim.h"
+#include "Thread_Pool.h"
+
+#include "File_Metadata_Index.h"
+
+
+namespace boost {
+namespace serialization {
+
+template<class Archive>
+void serialize(Archive &a, file_index_entry_t &e, const unsigned int /*version*/){
+    a & e.file_size
+      & e.modification_time
+      & e.header_read
+      & e.is_dicom
+      & e.processed
+      & e.metadata;
+}
+
+} // namespace serialization
+} // namespace boost
+
+namespace {
+
+// Bumped whenever the entry layout or the harvested metadata changes, which invalidates existing indices.
+const uint32_t index_format_version = 2;
+
+file_index_entry_t read_entry(const std::filesystem::path &p,
+                              std::uintmax_t file_size,
+                              int64_t modification_time){
+    file_index_entry_t e;
+    e.file_size = file_size;
+    e.modification_time = modification_time;
+    e.header_read = true;
+    try{
+        e.metadata = get_metadata_top_level_tags(p);
+        e.is_dicom = true;
+    }catch(const std::exception &){
+        e.metadata.clear();
+        e.is_dicom = false;
+    }
+    return e;
+}
+
+} // namespace
+
+
+int64_t File_Modification_Time(const std::filesystem::path &p){
+    return static_cast<int64_t>(std::filesystem::last_write_time(p).time_since_epoch().count());
+}
+
+
+std::string file_metadata_index::key(const std::filesystem::path &p){
+    return std::filesystem::absolute(p).lexically_normal().string();
+}
+
+file_metadata_index::file_metadata_index(const std::filesystem::path &l_index_file) : index_file(l_index_file) {
+    std::error_code ec;
+    if(!std::filesystem::exists(this->index_file, ec)) return;
+
+    try{
+        std::ifstream ifs(this->index_file.string(), std::ios::in | std::ios::binary);
+        boost::iostreams::filtering_istream ifsb;
+        ifsb.push(boost::iostreams::gzip_decompressor());
+        ifsb.push(ifs);
+
+        boost::archive::binary_iarchive ar(ifsb);
+        uint32_t version = 0;
+        ar & version;
+        if(version != index_format_version){
+            YLOGWARN("Ignoring file metadata index '" << this->index_file.string() << "' with incompatible version");
+            return;
+        }
+        ar & this->entries;
+        YLOGINFO("Loaded file metadata index with " << this->entries.size() << " entries");
+    }catch(const std::exception &e){
+        YLOGWARN("Ignoring unreadable file metadata index '" << this->index_file.string() << "': " << e.what());
+        this->entries.clear();
+    }
+}
+
+std::optional<file_index_entry_t> file_metadata_index::find(const std::filesystem::path &p,
+                                                            std::uintmax_t file_size,
+                                                            int64_t modification_time) const {
+    std::lock_guard<std::mutex> lock(this->m);
+    const auto it = this->entries.find(key(p));
+    if( (it == std::end(this->entries))
+    ||  (it->second.file_size != file_size)
+    ||  (it->second.modification_time != modification_time) ){
+        return {};
+    }
+    return it->second;
+}
+
+std::optional<file_index_entry_t> file_metadata_index::find(const std::filesystem::path &p) const {
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(p, ec);
+    if(ec) return {};
+    const auto mtime = std::filesystem::last_write_time(p, ec);
+    if(ec) return {};
+    return this->find(p, file_size, static_cast<int64_t>(mtime.time_since_epoch().count()));
+}
+
+file_index_entry_t file_metadata_index::lookup(const std::filesystem::path &p){
+    const auto file_size = std::filesystem::file_size(p);
+    const auto mtime = File_Modification_Time(p);
+    const auto cached = this->find(p, file_size, mtime);
+    if(cached && cached->header_read) return cached.value();
+
+    auto e = read_entry(p, file_size, mtime);
+    e.processed = (cached && cached->processed);
+    {
+        std::lock_guard<std::mutex> lock(this->m);
+        this->entries[key(p)] = e;
+        this->dirty = true;
+    }
+    return e;
+}
+
+std::vector<file_index_entry_t> file_metadata_index::lookup(const std::vector<std::filesystem::path> &ps){
+    std::vector<file_index_entry_t> out(ps.size());
+    parallel_for(0, static_cast<int64_t>(ps.size()), [&](int64_t i){
+        out[i] = this->lookup(ps[i]);
+    });
+    return out;
+}
+
+void file_metadata_index::mark_processed(const std::filesystem::path &p,
+                                         std::uintmax_t file_size,
+                                         int64_t modification_time){
+    std::lock_guard<std::mutex> lock(this->m);
+    auto &e = this->entries[key(p)];
+    if( (e.file_size != file_size)
+    ||  (e.modification_time != modification_time) ){
+        e = file_index_entry_t();
+        e.file_size = file_size;
+        e.modification_time = modification_time;
+    }
+    if(!e.processed){
+        e.processed = true;
+        this->dirty = true;
+    }
+    return;
+}
+
+void file_metadata_index::prune(){
+    std::lock_guard<std::mutex> lock(this->m);
+    std::error_code ec;
+    for(auto it = std::begin(this->entries); it != std::end(this->entries); ){
+        if(!std::filesystem::exists(it->first, ec)){
+            it = this->entries.erase(it);
+            this->dirty = true;
+        }else{
+            ++it;
+        }
+    }
+    return;
+}
+
+void file_metadata_index::write(){
+    std::lock_guard<std::mutex> lock(this->m);
+    if(this->index_file.empty() || !this->dirty) return;
+
+    // Write to a sibling file and then rename it, so a crash never leaves a truncated index.
+    auto tmp = this->index_file;
+    tmp += ".tmp";
+    {
+        std::ofstream ofs(tmp.string(), std::ios::trunc | std::ios::binary);
+        if(!ofs) throw std::runtime_error("Unable to write file metadata index '" + tmp.string() + "'");
+
+        boost::iostreams::filtering_ostream ofsb;
+        ofsb.push(boost::iostreams::gzip_compressor(boost::iostreams::gzip_params(boost::iostreams::gzip::best_speed)));
+        ofsb.push(ofs);
+        {
+            boost::archive::binary_oarchive ar(ofsb);
+            auto version = index_format_version;
+            ar & version;
+            ar & this->entries;
+        }
+        boost::iostreams::close(ofsb);
+        ofs.flush();
+        if(!ofs) throw std::runtime_error("Unable to write file metadata index '" + tmp.string() + "'");
+    }
+    std::filesystem::rename(tmp, this->index_file);
+    this->dirty = false;
+    return;
+}
+
+size_t file_metadata_index::size() const {
+    std::lock_guard<std::mutex> lock(this->m);
+    return this->entries.size();
+}
+
@@ -0,0 +1,72 @@
+//File_Metadata_Index.h.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Metadata.h"
+
+// A persistent cache of per-file metadata, keyed by path, size, and modification time.
+//
+// Entries record whether a file could be parsed as DICOM and, if so, its top-level metadata (i.e., what
+// get_metadata_top_level_tags() returns). Unchanged files can therefore be classified or filtered without opening
+// them. Entries also record whether a file has been processed, which lets pollers skip files across sessions.
+
+struct file_index_entry_t {
+    std::uintmax_t file_size = 0;
+    int64_t modification_time = 0;  // Filesystem-specific ticks.
+    bool header_read = false;       // Whether is_dicom and metadata have been harvested from the file.
+    bool is_dicom = false;
+    bool processed = false;
+    metadata_map_t metadata;        // Top-level DICOM tags. Empty for non-DICOM files.
+};
+
+int64_t File_Modification_Time(const std::filesystem::path &p);
+
+class file_metadata_index {
+    private:
+        std::filesystem::path index_file; // Empty if the index is not persistent.
+        std::map<std::string, file_index_entry_t> entries;
+        mutable std::mutex m;
+        bool dirty = false;
+
+        static std::string key(const std::filesystem::path &p);
+
+    public:
+        file_metadata_index() = default;
+
+        // Loads the index if the file exists. A corrupt or incompatible index is discarded with a warning.
+        explicit file_metadata_index(const std::filesystem::path &index_file);
+
+        // Returns the cached entry if the recorded size and modification time match. Does not open the file.
+        std::optional<file_index_entry_t> find(const std::filesystem::path &p,
+                                               std::uintmax_t file_size,
+                                               int64_t modification_time) const;
+        std::optional<file_index_entry_t> find(const std::filesystem::path &p) const;
+
+        // Returns the entry, parsing the file's DICOM header (but not pixel data) if the cached entry is missing or
+        // stale. Multiple files are parsed in parallel.
+        file_index_entry_t lookup(const std::filesystem::path &p);
+        std::vector<file_index_entry_t> lookup(const std::vector<std::filesystem::path> &ps);
+
+        // Records that the given version of the file has been processed. The file is not opened, so the entry's
+        // header is only read if the file is subsequently looked up.
+        void mark_processed(const std::filesystem::path &p,
+                            std::uintmax_t file_size,
+                            int64_t modification_time);
+
+        // Removes entries for files that no longer exist.
+        void prune();
+
+        // Atomically replaces the index file, if any, when entries have changed.
+        void write();
+
+        size_t size() const;
+};
+
@@ -12,17 +12,21 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <deque>
 #include <exception>
 #include <optional>
 #include <functional>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <list>
 #include <map>
 #include <memory>         //Needed for std::unique_ptr.
 #include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -45,13 +49,19 @@
 
 #pragma GCC diagnostic pop
 
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
 #include "Imebra_Shim.h"
 
 #include "DCMA_DICOM.h"
+#include "DCMA_DICOM_Reader.h"
 #include "Structs.h"
 #include "Metadata.h"
 #include "Alignment_Rigid.h"
 #include "Alignment_Field.h"
+#include "Deferred_Pixels.h"
+#include "Thread_Pool.h"
 
 //----------------- Accessors ---------------------
 
@@ -878,11 +888,48 @@ YLOGINFO("    This node is a leaf node. Creating a leaf tag");
 
 
 //------------------ General ----------------------
+struct Parsed_DICOM_File {
+    std::filesystem::path filename;
+    puntoexe::ptr<puntoexe::imebra::dataSet> ds;
+};
+
+//This routine reads and parses a DICOM file once so the result can be shared by multiple extraction routines.
+//
+// Note: Imebra reads large tags (e.g., pixel data) lazily, so the underlying file stream is retained until the
+//       returned object is destroyed.
+std::shared_ptr<Parsed_DICOM_File> Parse_DICOM_File(const std::filesystem::path &filename){
+    using namespace puntoexe;
+    ptr<puntoexe::stream> readStream(new puntoexe::stream);
+    readStream->openFile(filename.c_str(), std::ios::in);
+    if(readStream == nullptr){
+        throw std::runtime_error("Unable to open file '"_s + filename.string() + "'");
+    }
+
+    ptr<puntoexe::streamReader> reader(new puntoexe::streamReader(readStream));
+    auto out = std::make_shared<Parsed_DICOM_File>();
+    out->filename = filename;
+    out->ds = imebra::codecs::codecFactory::getCodecFactory()->load(reader);
+    if(out->ds == nullptr){
+        throw std::runtime_error("Unable to parse file '"_s + filename.string() + "'");
+    }
+    return out;
+}
+
 //This is used to grab the contents of a single DICOM tag. It can be used for whatever. Some routines
 // use it to grab specific things. Each invocation involves disk access and file parsing.
 //
 //NOTE: On error, the output will be an empty string.
 std::string get_tag_as_string(const std::filesystem::path &filename, size_t U, size_t L){
+    // Attempt the native reader first, which only parses the file up to the requested tag.
+    try{
+        const DCMA_DICOM::MappedFile mf(filename);
+        DCMA_DICOM::ReadOptions opts;
+        opts.wanted.insert({ static_cast<uint16_t>(U), static_cast<uint16_t>(L) });
+        const auto ds = DCMA_DICOM::read_DICOM(mf.data(), mf.size(), opts);
+        return ds.get_string(static_cast<uint16_t>(U), static_cast<uint16_t>(L)).value_or("");
+    }catch(const std::exception &){ }
+
+    // Fall back to Imebra, e.g., for unsupported transfer syntaxes.
     using namespace puntoexe;
     ptr<puntoexe::stream> readStream(new puntoexe::stream);
     readStream->openFile(filename.c_str(), std::ios::in);
@@ -899,6 +946,10 @@ std::string get_modality(const std::filesystem::path &filename){
     return get_tag_as_string(filename,0x0008,0x0060);
 }
 
+std::string get_modality(const Parsed_DICOM_File &pf){
+    return pf.ds->getString(0x0008, 0, 0x0060, 0);
+}
+
 std::string get_patient_ID(const std::filesystem::path &filename){
     //Should exist in each DICOM file.
     return get_tag_as_string(filename,0x0010,0x0020);
@@ -909,21 +960,18 @@ std::string get_patient_ID(const std::filesystem::path &filename){
 //NOTE: May not be complete. Add additional tags as needed!
 metadata_map_t
 get_metadata_top_level_tags(const std::filesystem::path &filename){
+    return get_metadata_top_level_tags(*Parse_DICOM_File(filename));
+}
+
+metadata_map_t
+get_metadata_top_level_tags(const Parsed_DICOM_File &pf){
     metadata_map_t out;
     const auto ctrim = CANONICALIZE::TRIM_ENDS;
+    const auto &filename = pf.filename;
 
-    //Attempt to parse the DICOM file and harvest the elements of interest. We are only interested in
-    // top-level elements specifying metadata (i.e., not pixel data) and will not need to recurse into 
-    // any DICOM sequences.
-    puntoexe::ptr<puntoexe::stream> readStream(new puntoexe::stream);
-    readStream->openFile(filename.c_str(), std::ios::in);
-    if(readStream == nullptr){
-        YLOGWARN("Could not parse file '" << filename << "'. Is it valid DICOM? Cannot continue");
-        return out;
-    }
-
-    puntoexe::ptr<puntoexe::streamReader> reader(new puntoexe::streamReader(readStream));
-    puntoexe::ptr<puntoexe::imebra::dataSet> tds = puntoexe::imebra::codecs::codecFactory::getCodecFactory()->load(reader);
+    //Harvest the elements of interest. We are only interested in top-level elements specifying metadata (i.e., not
+    // pixel data) and will not need to recurse into any DICOM sequences.
+    puntoexe::ptr<puntoexe::imebra::dataSet> tds = pf.ds;
 
     //We pull out all the data we need as strings. For single element strings, the SQL engine can directly perform
     // the type casting. The benefit of this is twofold: (1) the SQL engine hides the checking code, simplifying
@@ -1536,12 +1584,12 @@ get_metadata_top_level_tags(const std::filesystem::path &filename){
 //Returns a bimap with the (raw) ROI tags and their corresponding ROI numbers. The ROI numbers are
 // arbitrary identifiers used within the DICOM file to identify contours more conveniently.
 bimap<std::string,long int> get_ROI_tags_and_numbers(const std::filesystem::path &FilenameIn){
-    using namespace puntoexe;
-    ptr<puntoexe::stream> readStream(new puntoexe::stream);
-    readStream->openFile(FilenameIn.c_str(), std::ios::in);
+    return get_ROI_tags_and_numbers(*Parse_DICOM_File(FilenameIn));
+}
 
-    ptr<puntoexe::streamReader> reader(new puntoexe::streamReader(readStream));
-    ptr<imebra::dataSet> TopDataSet = imebra::codecs::codecFactory::getCodecFactory()->load(reader);
+bimap<std::string,long int> get_ROI_tags_and_numbers(const Parsed_DICOM_File &pf){
+    using namespace puntoexe;
+    ptr<imebra::dataSet> TopDataSet = pf.ds;
     ptr<imebra::dataSet> SecondDataSet;
 
     size_t i=0, j;
@@ -1576,21 +1624,103 @@ bimap<std::string,long int> get_ROI_tags_and_numbers(const std::filesystem::path
 
 //Returns contour data from a DICOM RTSTRUCT file sorted into ROI-specific collections.
 std::unique_ptr<Contour_Data> get_Contour_Data(const std::filesystem::path &filename){
+    return get_Contour_Data(*Parse_DICOM_File(filename));
+}
+
+std::unique_ptr<Contour_Data> get_Contour_Data(const Parsed_DICOM_File &pf){
     auto output = std::make_unique<Contour_Data>();
-    bimap<std::string,long int> tags_names_and_numbers = get_ROI_tags_and_numbers(filename);
+    bimap<std::string,long int> tags_names_and_numbers = get_ROI_tags_and_numbers(pf);
+
+    auto FileMetadata = get_metadata_top_level_tags(pf);
+
+    //Collect the data into a container of contours with meta info. It may be unordered (within the file).
+    //
+    // Each contour's metadata is derived from the file metadata, so it is prepared once per ROI and copied.
+    using mapcache_t = std::map<std::tuple<std::string,long int>, contour_collection<double>>;
+    mapcache_t mapcache;
+    std::map<long int, metadata_map_t> roi_metadata;
+    const auto emplace_contour = [&](mapcache_t &cache, long int ROI_number) -> contour_of_points<double> & {
+        auto ROIName = tags_names_and_numbers[ROI_number];
+        auto m_it = roi_metadata.find(ROI_number);
+        if(m_it == std::end(roi_metadata)){
+            auto metadata = FileMetadata;
+            metadata["ROINumber"] = std::to_string(ROI_number);
+            metadata["ROIName"] = ROIName;
+            m_it = roi_metadata.emplace(ROI_number, std::move(metadata)).first;
+        }
+
+        const auto key = std::make_tuple(ROIName, ROI_number);
+        auto &shtl = cache[key].contours.emplace_back();
+        shtl.closed = true;
+        shtl.metadata = m_it->second;
+        return shtl;
+    };
 
-    auto FileMetadata = get_metadata_top_level_tags(filename);
+    // Walk the ROI contour sequence natively when possible, parsing coordinates directly into preallocated storage.
+    bool walked_natively = false;
+    try{
+        const DCMA_DICOM::MappedFile mf(pf.filename);
+        DCMA_DICOM::ReadOptions opts;
+        opts.wanted.insert({ 0x3006, 0x0039 }); // ROIContourSequence
+        const auto ds = DCMA_DICOM::read_DICOM(mf.data(), mf.size(), opts);
+
+        const auto find_child = [](const DCMA_DICOM::Node &n, uint16_t group, uint16_t tag) -> const DCMA_DICOM::Node * {
+            for(const auto &c : n.children){
+                if((c.key.group == group) && (c.key.tag == tag)) return &c;
+            }
+            return nullptr;
+        };
+
+        mapcache_t l_mapcache;
+        const auto *rcs = ds.find(0x3006, 0x0039);
+        if((rcs != nullptr) && (rcs->VR == "SQ")){
+            for(const auto &rc_item : rcs->children){
+                long int ROI_number = 0;
+                if(const auto *n = find_child(rc_item, 0x3006, 0x0084); n != nullptr){ // ReferencedROINumber
+                    const auto v = Canonicalize_String2(n->val, CANONICALIZE::TRIM_ENDS);
+                    if(!v.empty()) ROI_number = std::stol(v);
+                }
+
+                const auto *cs = find_child(rc_item, 0x3006, 0x0040); // ContourSequence
+                if((cs == nullptr) || (cs->VR != "SQ")) continue;
+                for(const auto &c_item : cs->children){
+                    const auto *cd = find_child(c_item, 0x3006, 0x0050); // ContourData
+                    if(cd == nullptr) continue;
+
+                    // Count the coordinates so storage can be allocated up-front.
+                    const auto &text = cd->val;
+                    const auto N_coords = text.empty() ? 0 : (std::count(std::begin(text), std::end(text), '\\') + 1);
+
+                    auto &shtl = emplace_contour(l_mapcache, ROI_number);
+                    shtl.points.resize(N_coords / 3);
+                    const char *c_ptr = text.c_str();
+                    const auto parse_next = [&]() -> double {
+                        while((*c_ptr == '\\') || (*c_ptr == ' ')) ++c_ptr;
+                        char *c_end = nullptr;
+                        const double x = std::strtod(c_ptr, &c_end);
+                        if(c_end == c_ptr) throw std::runtime_error("Unable to parse contour coordinates");
+                        c_ptr = c_end;
+                        return x;
+                    };
+                    for(auto &p : shtl.points){
+                        p.x = parse_next();
+                        p.y = parse_next();
+                        p.z = parse_next();
+                    }
+                }
+            }
+        }
+        mapcache = std::move(l_mapcache);
+        walked_natively = true;
+    }catch(const std::exception &e){
+        YLOGWARN("Unable to read contours natively ('" << e.what() << "'), falling back to Imebra");
+    }
 
     using namespace puntoexe;
-    ptr<puntoexe::stream> readStream(new puntoexe::stream);
-    readStream->openFile(filename.c_str(), std::ios::in);
-    ptr<puntoexe::streamReader> reader(new puntoexe::streamReader(readStream));
-    ptr<imebra::dataSet> TopDataSet = imebra::codecs::codecFactory::getCodecFactory()->load(reader);
+    ptr<imebra::dataSet> TopDataSet = pf.ds;
     ptr<imebra::dataSet> SecondDataSet, ThirdDataSet;
 
-    //Collect the data into a container of contours with meta info. It may be unordered (within the file).
-    std::map<std::tuple<std::string,long int>, contour_collection<double>> mapcache;
-    for(size_t i=0; (SecondDataSet = TopDataSet->getSequenceItem(0x3006, 0, 0x0039, i)) != nullptr; ++i){
+    for(size_t i=0; !walked_natively && (SecondDataSet = TopDataSet->getSequenceItem(0x3006, 0, 0x0039, i)) != nullptr; ++i){
         long int Last_ROI_Numb = 0;
         for(size_t j=0; (ThirdDataSet = SecondDataSet->getSequenceItem(0x3006, 0, 0x0040, j)) != nullptr; ++j){
             auto ROI_number = static_cast<long int>(SecondDataSet->getSignedLong(0x3006, 0, 0x0084, j));
@@ -1606,26 +1736,19 @@ std::unique_ptr<Contour_Data> get_Contour_Data(const std::filesystem::path &file
 
             ptr<puntoexe::imebra::handlers::dataHandler> the_data_handler;
             for(size_t k=0; (the_data_handler = ThirdDataSet->getDataHandler(0x3006, 0, 0x0050, k, false)) != nullptr; ++k){
-                contour_of_points<double> shtl;
-                shtl.closed = true;
+                auto &shtl = emplace_contour(mapcache, ROI_number);
 
                 //This is the number of coordinates we will get (ie. the number of doubles).
                 const long int numb_of_coordinates = the_data_handler->getSize();
-                for(long int N = 0; N < numb_of_coordinates; N += 3){
-                    const double x = the_data_handler->getDouble(N + 0);
-                    const double y = the_data_handler->getDouble(N + 1);
-                    const double z = the_data_handler->getDouble(N + 2);
-                    shtl.points.emplace_back(x,y,z);
+                shtl.points.resize(numb_of_coordinates / 3);
+                long int N = 0;
+                for(auto &p : shtl.points){
+                    p.x = the_data_handler->getDouble(N + 0);
+                    p.y = the_data_handler->getDouble(N + 1);
+                    p.z = the_data_handler->getDouble(N + 2);
+                    N += 3;
                 }
                 //shtl.Reorient_Counter_Clockwise(); // Sometimes orientation is inconsistent.
-                shtl.metadata = FileMetadata;
-
-                auto ROIName = tags_names_and_numbers[ROI_number];
-                shtl.metadata["ROINumber"] = std::to_string(ROI_number);
-                shtl.metadata["ROIName"] = ROIName;
-                
-                const auto key = std::make_tuple(ROIName, ROI_number);
-                mapcache[key].contours.push_back(std::move(shtl));
             }
         }
     }
@@ -1633,8 +1756,7 @@ std::unique_ptr<Contour_Data> get_Contour_Data(const std::filesystem::path &file
 
     //Now sort the contours into contour_with_metas. We sort based on ROI number.
     for(auto & m_it : mapcache){
-        output->ccs.emplace_back( ); //std::move(m_it->second) ) );
-        output->ccs.back() = m_it.second; 
+        output->ccs.emplace_back( std::move(m_it.second) );
     }
 
     //Find the minimum separation between contours (which isn't zero).
@@ -1670,17 +1792,18 @@ std::unique_ptr<Contour_Data> get_Contour_Data(const std::filesystem::path &file
 // Note that individual images loaded as part of a set will likely need to be collated.
 std::unique_ptr<Image_Array>
 Load_Image_Array(const std::filesystem::path &FilenameIn){
+    return Load_Image_Array(*Parse_DICOM_File(FilenameIn));
+}
+
+std::unique_ptr<Image_Array>
+Load_Image_Array(const Parsed_DICOM_File &pf, bool decode_pixels){
     const auto inf = std::numeric_limits<double>::infinity();
     auto out = std::make_unique<Image_Array>();
 
     using namespace puntoexe;
-    ptr<puntoexe::stream> readStream(new puntoexe::stream);
-    readStream->openFile(FilenameIn.c_str(), std::ios::in);
+    ptr<imebra::dataSet> TopDataSet = pf.ds;
 
-    ptr<puntoexe::streamReader> reader(new puntoexe::streamReader(readStream));
-    ptr<imebra::dataSet> TopDataSet = imebra::codecs::codecFactory::getCodecFactory()->load(reader);
-
-    const auto tlm = get_metadata_top_level_tags(FilenameIn);
+    const auto tlm = get_metadata_top_level_tags(pf);
 
     const auto l_coalesce_metadata_as_vector_double = [&tlm](const std::list<std::string>& keys ){
         return convert_to_vector_double( coalesce_metadata_as_string(tlm, keys) );
@@ -1706,6 +1829,26 @@ Load_Image_Array(const std::filesystem::path &FilenameIn){
     const auto modality = l_coalesce_as_string({ { {0x0008, 0x0060, 0} } }).value();
     const auto frame_count = l_coalesce_as_long_int({ { {0x0028, 0x0008, 0} } }).value_or(1);
 
+    // Uncompressed monochrome pixel data is decoded natively, directly into the image buffers. Imebra is used for
+    // everything else (e.g., compressed transfer syntaxes and colour space conversions).
+    std::unique_ptr<DCMA_DICOM::MappedFile> native_file;
+    std::optional<DCMA_DICOM::ParsedDataset> native_ds;
+    if(decode_pixels){
+        try{
+            native_file = std::make_unique<DCMA_DICOM::MappedFile>(pf.filename);
+            native_ds = DCMA_DICOM::read_DICOM(native_file->data(), native_file->size());
+
+            const auto photometric = native_ds->get_string(0x0028, 0x0004).value_or("MONOCHROME2");
+            const auto samples = native_ds->get_integer(0x0028, 0x0002).value_or(1);
+            if( (modality != "RTIMAGE")
+            &&  ((samples != 1) || (photometric != "MONOCHROME2")) ){
+                native_ds.reset();
+            }
+        }catch(const std::exception &){
+            native_ds.reset();
+        }
+    }
+
     // ---------------------------------------- Image Metadata ----------------------------------------------
 
     for(uint32_t f = 0; f < frame_count; ++f){
@@ -1960,7 +2103,45 @@ Load_Image_Array(const std::filesystem::path &FilenameIn){
 
         const bool real_world_map_present = !!real_world_mapping;
 
+        if(!decode_pixels){
+            // Forgo decoding the pixel data. It will be decoded from this file when it is first needed.
+            //
+            // Note: images are converted to MONOCHROME2 below, except for RTIMAGEs.
+            auto &img = out->imagecoll.images.back();
+            img.metadata = l_meta;
+            img.init_orientation(image_orien_r,image_orien_c);
+            img.init_spatial(image_pxldx,image_pxldy,image_thickness, image_anchor, image_pos);
+            img.rows = image_rows;
+            img.columns = image_cols;
+            img.channels = ( modality == "RTIMAGE" ) ? l_coalesce_as_long_int({ { {0x0028, 0x0002, 0} } }).value_or(1) // SamplesPerPixel
+                                                     : 1;
+            Defer_Pixels_To_DICOM_File(img, pf.filename, f);
+            continue;
+        }
+
         // -------------------------------------- Image Pixel Data -----------------------------------------
+        // Without an explicit linear mapping, Imebra's modality transformation is needed unless there is nothing
+        // for it to apply.
+        if( native_ds
+        &&  ( real_world_map_present
+            || ( (native_ds->find(0x0028, 0x1052) == nullptr)     // RescaleIntercept
+              && (native_ds->find(0x0028, 0x1053) == nullptr)     // RescaleSlope
+              && (native_ds->find(0x0028, 0x3000) == nullptr) ) ) ){ // ModalityLUTSequence
+            auto &img = out->imagecoll.images.back();
+            if(DCMA_DICOM::decode_pixel_frame(*native_ds, f, img)){
+                if( (img.rows != image_rows) || (img.columns != image_cols) ){
+                    throw std::domain_error("The number of rows and columns in the image data differ from the image metadata");
+                }
+                img.metadata = l_meta;
+                img.init_orientation(image_orien_r,image_orien_c);
+                img.init_spatial(image_pxldx,image_pxldy,image_thickness, image_anchor, image_pos);
+                if(real_world_map_present){
+                    for(auto &v : img.data) v = real_world_mapping(v);
+                }
+                continue;
+            }
+        }
+
         ptr<puntoexe::imebra::image> firstImage;
         try{
             firstImage = TopDataSet->getImage(f);
@@ -2166,12 +2347,19 @@ std::unique_ptr<Image_Array> Collate_Image_Arrays(std::list<std::shared_ptr<Imag
     while(!in.empty()){
         auto pic_it = in.begin();
         const bool GeometricalOverlapOK = true;
+        const auto N_before = out->imagecoll.images.size();
         if(!out->imagecoll.Collate_Images((*pic_it)->imagecoll, GeometricalOverlapOK)){
             //We've encountered an issue and the images won't collate. Push the successfully collated
             // images back into the list and return a nullptr.
             in.push_back(std::move(out));
             return nullptr;
         }
+
+        //If the images were copied rather than spliced, carry over any deferred pixel sources.
+        if(!(*pic_it)->imagecoll.images.empty()){
+            Copy_Deferred_Pixel_Sources((*pic_it)->imagecoll.images,
+                                        std::next(std::begin(out->imagecoll.images), N_before));
+        }
         pic_it = in.erase(pic_it);
     }
     return out;
@@ -2181,7 +2369,12 @@ std::unique_ptr<Image_Array> Collate_Image_Arrays(std::list<std::shared_ptr<Imag
 //--------------------- Dose -----------------------
 //This routine reads a single DICOM dose file.
 std::unique_ptr<Image_Array>  Load_Dose_Array(const std::filesystem::path &FilenameIn){
-    auto metadata = get_metadata_top_level_tags(FilenameIn);
+    return Load_Dose_Array(*Parse_DICOM_File(FilenameIn));
+}
+
+std::unique_ptr<Image_Array>  Load_Dose_Array(const Parsed_DICOM_File &pf){
+    const auto &FilenameIn = pf.filename;
+    auto metadata = get_metadata_top_level_tags(pf);
     if(metadata["Modality"] != "RTDOSE"){
         throw std::runtime_error("Unsupported modality");
     }
@@ -2189,11 +2382,7 @@ std::unique_ptr<Image_Array>  Load_Dose_Array(const std::filesystem::path &Filen
     auto out = std::make_unique<Image_Array>();
 
     using namespace puntoexe;
-    ptr<puntoexe::stream> readStream(new puntoexe::stream);
-    readStream->openFile(FilenameIn.c_str(), std::ios::in);
-
-    ptr<puntoexe::streamReader> reader(new puntoexe::streamReader(readStream));
-    ptr<imebra::dataSet> TopDataSet = imebra::codecs::codecFactory::getCodecFactory()->load(reader);
+    ptr<imebra::dataSet> TopDataSet = pf.ds;
 
     //These should exist in all files. They appear to be the same for CT and DS files of the same set. Not sure
     // if this is *always* the case.
@@ -2360,18 +2549,19 @@ std::list<std::shared_ptr<Image_Array>>  Load_Dose_Arrays(const std::list<std::f
 
 std::unique_ptr<RTPlan> 
 Load_RTPlan(const std::filesystem::path &FilenameIn){
+    return Load_RTPlan(*Parse_DICOM_File(FilenameIn));
+}
+
+std::unique_ptr<RTPlan> 
+Load_RTPlan(const Parsed_DICOM_File &pf){
     std::unique_ptr<RTPlan> out(new RTPlan());
 
     using namespace puntoexe;
-    ptr<puntoexe::stream> readStream(new puntoexe::stream);
-    readStream->openFile(FilenameIn.c_str(), std::ios::in);
-
-    ptr<puntoexe::streamReader> reader(new puntoexe::streamReader(readStream));
-    ptr<imebra::dataSet> base_node_ptr = imebra::codecs::codecFactory::getCodecFactory()->load(reader);
+    ptr<imebra::dataSet> base_node_ptr = pf.ds;
 
 
     // ------------------------------------------- General --------------------------------------------------
-    out->metadata = get_metadata_top_level_tags(FilenameIn);
+    out->metadata = get_metadata_top_level_tags(pf);
     if(out->metadata["Modality"] != "RTPLAN"){
         throw std::runtime_error("Unsupported modality");
     }
@@ -2717,17 +2907,18 @@ Load_RTPlan(const std::filesystem::path &FilenameIn){
 // See DICOM standard, Spatial Registration Module (C.20.2).
 std::unique_ptr<Transform3>
 Load_Transform(const std::filesystem::path &FilenameIn){
+    return Load_Transform(*Parse_DICOM_File(FilenameIn));
+}
+
+std::unique_ptr<Transform3>
+Load_Transform(const Parsed_DICOM_File &pf){
     std::unique_ptr<Transform3> out(new Transform3());
 
     using namespace puntoexe;
-    ptr<puntoexe::stream> readStream(new puntoexe::stream);
-    readStream->openFile(FilenameIn.c_str(), std::ios::in);
-
-    ptr<puntoexe::streamReader> reader(new puntoexe::streamReader(readStream));
-    ptr<imebra::dataSet> base_node_ptr = imebra::codecs::codecFactory::getCodecFactory()->load(reader);
+    ptr<imebra::dataSet> base_node_ptr = pf.ds;
 
     // ------------------------------------------- General --------------------------------------------------
-    out->metadata = get_metadata_top_level_tags(FilenameIn);
+    out->metadata = get_metadata_top_level_tags(pf);
     if(out->metadata["Modality"] != "REG"){
         throw std::runtime_error("Unsupported modality");
     }
@@ -2928,18 +3119,26 @@ void Write_Dose_Array(const std::shared_ptr<Image_Array>& IA, const std::filesys
     const auto row_count = IA->imagecoll.images.front().rows;
     const auto col_count = IA->imagecoll.images.front().columns;
 
-    auto max_dose = -std::numeric_limits<float>::infinity();
-    for(const auto &p_img : IA->imagecoll.images){
+    // Images are scanned concurrently.
+    std::vector<const planar_image<float,double> *> img_ptrs;
+    img_ptrs.reserve(num_of_imgs);
+    for(const auto &p_img : IA->imagecoll.images) img_ptrs.push_back(&p_img);
+
+    std::vector<float> img_max_dose(num_of_imgs, -std::numeric_limits<float>::infinity());
+    parallel_for(0, static_cast<int64_t>(num_of_imgs), [&](int64_t i){
+        const auto &p_img = *(img_ptrs[i]);
         const long int channel = 0; // Ignore other channels for now. TODO.
         for(long int r = 0; r < row_count; r++){
             for(long int c = 0; c < col_count; c++){
                 const auto val = p_img.value(r, c, channel);
                 if(!std::isfinite(val)) throw std::domain_error("Found non-finite dose. Refusing to export.");
                 if(val < 0.0f ) throw std::domain_error("Found a voxel with negative dose. Refusing to continue.");
-                if(max_dose < val) max_dose = val;
+                if(img_max_dose[i] < val) img_max_dose[i] = val;
             }
         }
-    }
+    });
+    auto max_dose = -std::numeric_limits<float>::infinity();
+    for(const auto &v : img_max_dose) max_dose = std::max(max_dose, v);
     if( max_dose < 0.0f ) throw std::invalid_argument("No voxels were found to export. Cannot continue.");
     const double full_dose_scaling = max_dose / static_cast<double>(std::numeric_limits<uint32_t>::max());
     const double dose_scaling = std::max(full_dose_scaling, 1.0E-5); //Because excess bits might get truncated!
@@ -3235,10 +3434,14 @@ void Write_Dose_Array(const std::shared_ptr<Image_Array>& IA, const std::filesys
         }
     }
 
-    //Insert the raw pixel data.
-    std::vector<uint32_t> shtl;
-    shtl.reserve(num_of_imgs * col_count * row_count);
-    for(const auto &p_img : IA->imagecoll.images){
+    //Insert the raw pixel data. Each frame is converted concurrently into its own region of the buffer.
+    img_ptrs.clear();
+    for(const auto &p_img : IA->imagecoll.images) img_ptrs.push_back(&p_img);
+    const auto frame_size = static_cast<size_t>(col_count * row_count);
+    std::vector<uint32_t> shtl(num_of_imgs * frame_size);
+    parallel_for(0, static_cast<int64_t>(num_of_imgs), [&](int64_t i){
+        const auto &p_img = *(img_ptrs[i]);
+        auto *out = shtl.data() + (static_cast<size_t>(i) * frame_size);
 
         //Convert each pixel to the required format, scaling by the dose factor as needed.
         const long int channel = 0; // Ignore other channels for now. TODO.
@@ -3246,11 +3449,10 @@ void Write_Dose_Array(const std::shared_ptr<Image_Array>& IA, const std::filesys
             for(long int c = 0; c < col_count; c++){
                 const auto val = p_img.value(r, c, channel);
                 const auto scaled = std::round( std::abs(val/dose_scaling) );
-                auto as_uint = static_cast<uint32_t>(scaled);
-                shtl.push_back(as_uint);
+                *(out++) = static_cast<uint32_t>(scaled);
             }
         }
-    }
+    });
     {
         auto tag_ptr = tds->getTag(0x7FE0, 0, 0x0010, true);
         //YLOGINFO("Re-reading the tag.  Type is " << tag_ptr->getDataType() << ",  #_of_buffers = " <<
@@ -3281,7 +3483,8 @@ void Write_Dose_Array(const std::shared_ptr<Image_Array>& IA, const std::filesys
 void Write_CT_Images(const std::shared_ptr<Image_Array>& IA, 
                      const std::function<void(std::istream &is,
                                         long int filesize)>& file_handler,
-                     ParanoiaLevel Paranoia){
+                     ParanoiaLevel Paranoia,
+                     const DICOM_Export_Opts &opts){
     if( (IA == nullptr) 
     ||  IA->imagecoll.images.empty()){
         throw std::invalid_argument("No images provided for export. Cannot continue.");
@@ -3335,18 +3538,50 @@ void Write_CT_Images(const std::shared_ptr<Image_Array>& IA,
     // TODO: Sample any existing UID (ReferencedFrameOfReferenceUID or FrameOfReferenceUID). 
     // Probably OK to use only the first in this case though...
 
-    long int InstanceNumber = -1;
-    for(const auto &animg : IA->imagecoll.images){
-        if( (animg.rows <= 0) || (animg.columns <= 0) || (animg.channels <= 0) ){
-            continue;
+    // Identifiers are assigned serially and in image order, so they do not depend on the order slices are serialized.
+    struct slice_t {
+        const planar_image<float,double> *img = nullptr;
+        long int InstanceNumber = 0;
+        std::string SOPInstanceUID;
+        std::string file; // The serialized file.
+    };
+    std::vector<slice_t> slices;
+    {
+        long int InstanceNumber = -1;
+        for(const auto &animg : IA->imagecoll.images){
+            if( (animg.rows <= 0) || (animg.columns <= 0) || (animg.channels <= 0) ){
+                continue;
+            }
+            slices.emplace_back();
+            slices.back().img = &animg;
+            slices.back().InstanceNumber = ++InstanceNumber;
+            slices.back().SOPInstanceUID = Generate_Random_UID(60);
         }
+    }
 
-        ++InstanceNumber;
+    // Serializes a single slice. Slices share no mutable state, so slices can be serialized concurrently.
+    const auto serialize_slice = [&](slice_t &slice) -> void {
+        const auto &animg = *(slice.img);
+        const auto InstanceNumber = slice.InstanceNumber;
+        const auto &SOPInstanceUID = slice.SOPInstanceUID;
 
         DCMA_DICOM::Encoding enc = DCMA_DICOM::Encoding::ELE;
-        DCMA_DICOM::Node root_node;
+        std::string TransferSyntaxUID = "1.2.840.10008.1.2.1";
+        bool use_RLE = false;
+        bool use_deflate = false;
+        if(opts.transfer_syntax == DICOM_Transfer_Syntax::ImplicitLE){
+            enc = DCMA_DICOM::Encoding::ILE;
+            TransferSyntaxUID = "1.2.840.10008.1.2";
+        }else if(opts.transfer_syntax == DICOM_Transfer_Syntax::DeflatedExplicitLE){
+            TransferSyntaxUID = "1.2.840.10008.1.2.1.99";
+            use_deflate = true;
+        }else if( (opts.transfer_syntax == DICOM_Transfer_Syntax::RLELossless)
+              &&  (animg.channels == 1) ){
+            TransferSyntaxUID = "1.2.840.10008.1.2.5";
+            use_RLE = true;
+        }
 
-        const auto SOPInstanceUID = Generate_Random_UID(60);
+        DCMA_DICOM::Node root_node;
 
         //auto cm = IA->imagecoll.get_common_metadata({});
         auto cm = animg.metadata;
@@ -3410,14 +3645,6 @@ void Write_CT_Images(const std::shared_ptr<Image_Array>& IA,
         root_node.emplace_child_node({{0x0002, 0x0001}, "OB", std::string("\x0\x1", 2)}); // FileMetaInformationVersion
         root_node.emplace_child_node({{0x0002, 0x0002}, "UI", "1.2.840.10008.5.1.4.1.1.2"}); // MediaStorageSOPClassUID -- CT Image Storage.
         root_node.emplace_child_node({{0x0002, 0x0003}, "UI", SOPInstanceUID}); // MediaStorageSOPInstanceUID
-        std::string TransferSyntaxUID;
-        if(enc == DCMA_DICOM::Encoding::ELE){
-            TransferSyntaxUID = "1.2.840.10008.1.2.1";
-        }else if(enc == DCMA_DICOM::Encoding::ILE){
-            TransferSyntaxUID = "1.2.840.10008.1.2";
-        }else{
-            throw std::runtime_error("Unsupported transfer syntax requested. Cannot continue.");
-        }
         root_node.emplace_child_node({{0x0002, 0x0010}, "UI", TransferSyntaxUID}); // TransferSyntaxUID
 
         root_node.emplace_child_node({{0x0002, 0x0012}, "UI", "1.2.513.264.765.1.1.578"}); // ImplementationClassUID
@@ -3558,27 +3785,15 @@ void Write_CT_Images(const std::shared_ptr<Image_Array>& IA,
             throw std::runtime_error("Rescale slope and/or intercept cannot be converted to double");
         }
 
-        {
-            std::stringstream ss_pixels;
-            for(long int row = 0; row != animg.rows; ++row){
-                for(long int col = 0; col != animg.columns; ++col){
-                    for(long int chnl = 0; chnl != animg.channels; ++chnl){
-                        const auto f_val = animg.value(row, col, chnl );
-                        const auto i_val = compressor.compress(f_val);
-                        ss_pixels.write( reinterpret_cast<const char *>(&i_val), sizeof(i_val) );
-                    }
-                }
-            }
-            root_node.emplace_child_node({{0x7FE0, 0x0010}, "OB", ss_pixels.str() }); // PixelData.
-
-            // Note: the standard mentions that:
-            //
-            //   "This Attribute does not apply when Float Pixel Data (7FE0,0008) or Double Float Pixel Data (7FE0,0009) are used
-            //   instead of Pixel Data (7FE0,0010); Float Pixel Padding Value (0028,0122) or Double Float Pixel Padding Value 
-            //   (0028,0123), respectively, are used instead, and defined at the Image, not the Equipment, level."
-            //
-            // Could I use a floating-point pixel data in lieu of compressing into 16 bits? It seems to only apply to parametric images module. TODO.
-        }
+        // Note: pixel data is the final element, so it is appended directly to the emitted file below.
+        //
+        // Note: the standard mentions that:
+        //
+        //   "This Attribute does not apply when Float Pixel Data (7FE0,0008) or Double Float Pixel Data (7FE0,0009) are used
+        //   instead of Pixel Data (7FE0,0010); Float Pixel Padding Value (0028,0122) or Double Float Pixel Padding Value
+        //   (0028,0123), respectively, are used instead, and defined at the Image, not the Equipment, level."
+        //
+        // Could I use a floating-point pixel data in lieu of compressing into 16 bits? It seems to only apply to parametric images module. TODO.
 
         //-------------------------------------------------------------------------------------------------
         //CT Image Module.
@@ -3596,17 +3811,74 @@ void Write_CT_Images(const std::shared_ptr<Image_Array>& IA,
         root_node.emplace_child_node({{0x0028, 0x1050}, "DS", "0" }); //WindowCenter.
         root_node.emplace_child_node({{0x0028, 0x1051}, "DS", "1000" }); //WindowWidth
 
-        // Send the file to the user's handler.
+        // Serialize the file.
         {
-            std::stringstream ss;
+            std::ostringstream ss(std::ios_base::ate | std::ios_base::binary);
             const auto bytes_reqd = root_node.emit_DICOM(ss, enc);
             if(!ss) throw std::runtime_error("Stream not in good state after emitting DICOM file");
             if(bytes_reqd <= 0) throw std::runtime_error("Not enough DICOM data available for valid file");
+            slice.file = ss.str();
+        }
+
+        // Append the pixel data, converting directly from the pixel buffer.
+        //
+        // Note: the pixel buffer is ordered by row, then column, then channel, as required for PixelData.
+        const auto N_samples = animg.data.size();
+        if(use_RLE){
+            std::vector<int16_t> packed(N_samples);
+            std::transform(std::begin(animg.data), std::end(animg.data), std::begin(packed),
+                           [&](float f_val) -> int16_t { return compressor.compress(f_val); });
+            DCMA_DICOM::append_encapsulated_pixel_data(slice.file,
+                { DCMA_DICOM::encode_RLE_frame(reinterpret_cast<const unsigned char *>(packed.data()),
+                                               animg.rows, animg.columns, animg.channels, sizeof(int16_t)) });
+        }else{
+            const auto N_bytes = N_samples * sizeof(int16_t);
+            DCMA_DICOM::append_pixel_data_header(slice.file, enc, N_bytes);
+            const auto offset = slice.file.size();
+            slice.file.resize(offset + N_bytes);
+            char *out = &(slice.file[offset]);
+            for(const auto &f_val : animg.data){
+                const int16_t i_val = compressor.compress(f_val);
+                std::memcpy(out, &i_val, sizeof(i_val));
+                out += sizeof(i_val);
+            }
+        }
+
+        if(use_deflate){
+            DCMA_DICOM::deflate_data_set(slice.file);
+        }
+        return;
+    };
+
+    // Slices are serialized concurrently, one window at a time, and handed to the user's handler serially and in order.
+    // The next window is serialized while the current window is handed off. Files are released as soon as they have
+    // been handed off, so at most two windows of files are held in memory.
+    const auto N_slices = static_cast<int64_t>(slices.size());
+    const auto window = (0 < opts.max_in_flight) ? static_cast<int64_t>(opts.max_in_flight)
+                                                 : std::max<int64_t>(1, 2 * static_cast<int64_t>(work_stealing_scheduler::global().concurrency()));
+    const auto submit_window = [&](task_group &tg, int64_t begin){
+        const auto end = std::min(N_slices, begin + window);
+        for(int64_t i = begin; i < end; ++i){
+            tg.submit_task([&serialize_slice, &slices, i](){ serialize_slice(slices[i]); });
+        }
+    };
 
-            const auto fsize = static_cast<long int>(bytes_reqd);
-            file_handler(ss, fsize);
+    task_group tgs[2];
+    submit_window(tgs[0], 0);
+    for(int64_t w = 0, begin = 0; begin < N_slices; ++w, begin += window){
+        tgs[w % 2].wait();
+        submit_window(tgs[(w + 1) % 2], begin + window);
+
+        const auto end = std::min(N_slices, begin + window);
+        for(int64_t i = begin; i < end; ++i){
+            auto &file = slices[i].file;
+            boost::iostreams::stream<boost::iostreams::array_source> is(file.data(), file.size());
+            file_handler(is, static_cast<long int>(file.size()));
+            std::string().swap(file);
         }
     }
+    tgs[0].wait();
+    tgs[1].wait();
 
     return;
 }
@@ -22,12 +22,20 @@
 class Contour_Data;
 class Image_Array;
 
+//------------------ Parsing ----------------------
+//An opaque, fully-parsed DICOM file. Routines accepting a parsed file do not re-read or re-parse the file, so a single
+// parse can be shared between classification (e.g., modality extraction) and loading.
+struct Parsed_DICOM_File;
+
+std::shared_ptr<Parsed_DICOM_File> Parse_DICOM_File(const std::filesystem::path &filename);
+
 
 //------------------ General ----------------------
 //One-offs.
 std::string get_tag_as_string(const std::filesystem::path &filename, size_t U, size_t L);
 
 std::string get_modality(const std::filesystem::path &filename);
+std::string get_modality(const Parsed_DICOM_File &pf);
 
 std::string get_patient_ID(const std::filesystem::path &filename);
 
@@ -35,17 +43,23 @@ std::string get_patient_ID(const std::filesystem::path &filename);
 //
 //NOTE: May not be complete. Add additional tags as needed!
 metadata_map_t get_metadata_top_level_tags(const std::filesystem::path &filename);
+metadata_map_t get_metadata_top_level_tags(const Parsed_DICOM_File &pf);
 
 
 //------------------ Contours ---------------------
 bimap<std::string,long int> get_ROI_tags_and_numbers(const std::filesystem::path &filename);
+bimap<std::string,long int> get_ROI_tags_and_numbers(const Parsed_DICOM_File &pf);
 
 std::unique_ptr<Contour_Data>  get_Contour_Data(const std::filesystem::path &filename);
+std::unique_ptr<Contour_Data>  get_Contour_Data(const Parsed_DICOM_File &pf);
 
 
 //-------------------- Images ----------------------
 //This routine will often result in an array with only a single image. So collate output as needed.
 std::unique_ptr<Image_Array> Load_Image_Array(const std::filesystem::path &filename);
+//
+// If pixels are not decoded, the images will have deferred pixels that are decoded from the file when first needed.
+std::unique_ptr<Image_Array> Load_Image_Array(const Parsed_DICOM_File &pf, bool decode_pixels = true);
 
 //These pointers will actually be unique. This just aims to convert from unique_ptr to shared_ptr for you.
 std::list<std::shared_ptr<Image_Array>>  Load_Image_Arrays(const std::list<std::filesystem::path> &filenames);
@@ -56,15 +70,18 @@ std::unique_ptr<Image_Array> Collate_Image_Arrays(std::list<std::shared_ptr<Imag
 
 //--------------------- Dose -----------------------
 std::unique_ptr<Image_Array> Load_Dose_Array(const std::filesystem::path &filename);
+std::unique_ptr<Image_Array> Load_Dose_Array(const Parsed_DICOM_File &pf);
 
 //These pointers will actually be unique. This just aims to convert from unique_ptr to shared_ptr for you.
 std::list<std::shared_ptr<Image_Array>>  Load_Dose_Arrays(const std::list<std::filesystem::path> &filenames);
 
 //-------------------- Plans ------------------------
 std::unique_ptr<RTPlan> Load_RTPlan(const std::filesystem::path &filename);
+std::unique_ptr<RTPlan> Load_RTPlan(const Parsed_DICOM_File &pf);
 
 //---------------- Registrations --------------------
 std::unique_ptr<Transform3> Load_Transform(const std::filesystem::path &filename);
+std::unique_ptr<Transform3> Load_Transform(const Parsed_DICOM_File &pf);
 
 //-------------------- Export -----------------------
 //Writes an Image_Array as if it were a dose matrix.
@@ -78,11 +95,29 @@ void Write_Dose_Array(const std::shared_ptr<Image_Array>& IA,
                       const std::filesystem::path &FilenameOut, 
                       ParanoiaLevel Paranoia = ParanoiaLevel::Low);
 
-// Note: callback will be called once for each CT-modality DICOM file.
+// Transfer syntaxes available for export.
+enum class DICOM_Transfer_Syntax {
+    ImplicitLE,          // 1.2.840.10008.1.2.
+    ExplicitLE,          // 1.2.840.10008.1.2.1.
+    DeflatedExplicitLE,  // 1.2.840.10008.1.2.1.99.
+    RLELossless,         // 1.2.840.10008.1.2.5. Only single-channel images; others are written as ExplicitLE.
+};
+
+struct DICOM_Export_Opts {
+    DICOM_Transfer_Syntax transfer_syntax = DICOM_Transfer_Syntax::ExplicitLE;
+
+    // The maximum number of files serialized concurrently, which bounds memory usage since serialized files are held
+    // until they are passed to the callback. Zero defers to twice the available concurrency.
+    long int max_in_flight = 0;
+};
+
+// Note: callback will be called once for each CT-modality DICOM file, in image order, from the calling thread.
+//       Files are serialized concurrently.
 void Write_CT_Images(const std::shared_ptr<Image_Array>& IA, 
                      const std::function<void(std::istream &is,
                                         long int filesize)>& file_handler,
-                     ParanoiaLevel Paranoia = ParanoiaLevel::Low);
+                     ParanoiaLevel Paranoia = ParanoiaLevel::Low,
+                     const DICOM_Export_Opts &opts = DICOM_Export_Opts());
 
 void Write_Contours(std::list<std::reference_wrapper<contour_collection<double>>> CC,
                     const std::function<void(std::istream &is,
@@ -0,0 +1,534 @@
+//KineticModel_1Compartment2Input_5Param_LinearInterp_Batched.cc.
+// This file holds a driver for fitting a pharmacokinetic model to many voxels at once. Like the per-voxel driver, it
+// uses the Levenberg-Marquardt algorithm, which is specific to least-squares and therefore cannot be used for norms
+// other than L2.
+
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "KineticModel_1Compartment2Input_5Param_LinearInterp_Common.h"
+#include "KineticModel_1Compartment2Input_5Param_LinearInterp_Batched.h"
+#include "Thread_Pool.h"
+#include "YgorMath.h"
+#include "YgorMisc.h"
+#include "YgorLog.h"
+
+
+int64_t
+KineticModel_1Compartment2Input_5Param_LinearInterp_Batch::size() const {
+    if(this->times.empty()) return 0;
+    return static_cast<int64_t>(this->observations.size() / this->times.size());
+}
+
+int64_t
+KineticModel_1Compartment2Input_5Param_LinearInterp_Batch::add_voxel(const std::vector<double> &obs, int64_t seed){
+    if(obs.size() != this->times.size()){
+        throw std::invalid_argument("Voxel observations do not correspond with the shared times");
+    }
+    const auto N = this->size();
+    this->seeds.resize(N, -1);
+    this->seeds.push_back(seed);
+    this->observations.insert(this->observations.end(), obs.begin(), obs.end());
+    return N;
+}
+
+
+namespace {
+
+// Fitted parameters, ordered like: k1A, tauA, k1V, tauV, k2.
+using params_t = std::array<double, 5>;
+
+// The initial guess used by the per-voxel driver.
+const params_t default_guess = {{ 0.0500, 1.0000, 0.0500, 1.0000, 0.0350 }};
+
+// A linearly-interpolated input time course, which is taken to be zero outside of the samples.
+struct linear_time_course {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> slope; // Slope of each segment, or zero for degenerate segments.
+};
+
+linear_time_course
+extract_time_course(const samples_1D<double> &s){
+    linear_time_course out;
+    out.x.reserve(s.samples.size());
+    out.y.reserve(s.samples.size());
+    for(const auto &P : s.samples){
+        out.x.push_back(P[0]);
+        out.y.push_back(P[2]);
+    }
+    if(!std::is_sorted(out.x.begin(), out.x.end())){
+        throw std::invalid_argument("Input time course is not sorted");
+    }
+    for(size_t j = 1; j < out.x.size(); ++j){
+        const auto dx = out.x[j] - out.x[j-1];
+        out.slope.push_back( (0.0 < dx) ? (out.y[j] - out.y[j-1]) / dx : 0.0 );
+    }
+    return out;
+}
+
+// Evaluates phi1(z) = (exp(z) - 1)/z and phi2(z) = (exp(z)*(z - 1) + 1)/z^2, using a series near zero to avoid
+// cancellation.
+inline
+void
+exp_phi(double z, double &phi1, double &phi2){
+    if(std::abs(z) < 1.0E-2){
+        phi1 = 1.0 + z*(1.0/2.0 + z*(1.0/6.0 + z*(1.0/24.0 + z*(1.0/120.0 + z*(1.0/720.0)))));
+        phi2 = 1.0/2.0 + z*(1.0/3.0 + z*(1.0/8.0 + z*(1.0/30.0 + z*(1.0/144.0 + z*(1.0/840.0)))));
+    }else{
+        const double em1 = std::expm1(z);
+        phi1 = em1 / z;
+        phi2 = (z * (em1 + 1.0) - em1) / (z * z);
+    }
+    return;
+}
+
+// Computes \int_{p}^{q} g(u) * exp(k*(u - T)) du where g is linear over [p,q] with g(p) = gp and g(q) = gq.
+//
+// The exponential is factored at whichever endpoint keeps the remaining factor bounded.
+inline
+double
+segment_integral(double gp, double gq, double p, double q, double T, double k){
+    const double w = q - p;
+    double phi1;
+    double phi2;
+    if(0.0 <= k){
+        exp_phi(-k * w, phi1, phi2);
+        return std::exp(k * (q - T)) * w * (gq * phi1 - (gq - gp) * phi2);
+    }
+    exp_phi(k * w, phi1, phi2);
+    return std::exp(k * (p - T)) * w * (gp * phi1 + (gq - gp) * phi2);
+}
+
+// Computes \int_{0}^{t} f(u - tau) * exp(k*(u - t)) du for every time t, which is the quantity computed for each
+// time individually by Evaluate_Model().
+//
+// The times must be sorted. The integral for each time is carried forward to the next, so all times are evaluated in
+// a single sweep over the input time course.
+void
+convolve(const linear_time_course &f, double tau, double k, const std::vector<double> &times, double *out){
+    const size_t N_knots = f.x.size();
+    double J = 0.0;
+    double prev = 0.0;
+    size_t j = 0;
+    for(size_t i = 0; i < times.size(); ++i){
+        const double t = times[i];
+        if(t <= prev){
+            out[i] = J;
+            continue;
+        }
+        J *= std::exp(-k * (t - prev));
+
+        while( ((j + 1) < N_knots) && ((f.x[j+1] + tau) <= prev) ) ++j;
+        for(size_t m = j; (m + 1) < N_knots; ++m){
+            const double x0 = f.x[m] + tau;
+            const double x1 = f.x[m+1] + tau;
+            if(t <= x0) break;
+            const double p = std::max(x0, prev);
+            const double q = std::min(x1, t);
+            if(!(p < q)) continue;
+            const double gp = f.y[m] + f.slope[m] * (p - x0);
+            const double gq = f.y[m] + f.slope[m] * (q - x0);
+            J += segment_integral(gp, gq, p, q, t, k);
+        }
+
+        prev = t;
+        out[i] = J;
+    }
+    return;
+}
+
+// Quantities shared by every voxel in the batch.
+struct shared_data {
+    linear_time_course AIF;
+    linear_time_course VIF;
+    const std::vector<double> *times;
+    int64_t N_times;
+};
+
+// Evaluates the model and residuals, returning the residual sum of squares. Like the per-voxel driver, non-finite
+// model values are treated as infinitely far from the observations.
+double
+evaluate(const shared_data &sd, const params_t &x, const double *obs, double *JA, double *JV, double *res){
+    convolve(sd.AIF, x[1], x[4], *(sd.times), JA);
+    convolve(sd.VIF, x[3], x[4], *(sd.times), JV);
+    double cost = 0.0;
+    for(int64_t i = 0; i < sd.N_times; ++i){
+        double I = x[0] * JA[i] + x[2] * JV[i];
+        I = std::isfinite(I) ? I : std::numeric_limits<double>::infinity();
+        res[i] = I - obs[i];
+        cost += res[i] * res[i];
+    }
+    return cost;
+}
+
+// Per-voxel Levenberg-Marquardt state.
+struct voxel_fit {
+    params_t x;
+    std::array<double, 25> A; // J^T J.
+    std::array<double, 5> g;  // J^T r.
+    double cost = std::numeric_limits<double>::quiet_NaN();
+    double lambda = 1.0E-3;
+    int64_t iters = 0;
+    bool active = false;
+    bool converged = false;
+};
+
+// Buffers reused by every voxel in a chunk.
+struct chunk_workspace {
+    std::vector<double> JA;  // Convolutions and residuals at the current parameters, voxel-major.
+    std::vector<double> JV;
+    std::vector<double> res;
+
+    std::vector<double> tA;  // Scratch space for trial steps and numerical derivatives.
+    std::vector<double> tV;
+    std::vector<double> tres;
+    std::vector<double> jac; // Jacobian, column-major.
+
+    void resize(int64_t N_voxels, int64_t N_times){
+        const auto N = static_cast<size_t>(N_voxels * N_times);
+        const auto T = static_cast<size_t>(N_times);
+        JA.resize(N);
+        JV.resize(N);
+        res.resize(N);
+        tA.resize(T);
+        tV.resize(T);
+        tres.resize(T);
+        jac.resize(T * 5);
+    }
+};
+
+// Computes the Jacobian and assembles the normal equations.
+//
+// The model is linear in k1A and k1V, so those columns are exact. The remaining columns use forward differences with
+// the same step sizes used by GSL.
+bool
+normal_equations(const shared_data &sd, voxel_fit &f, const double *JA, const double *JV, const double *res,
+                 chunk_workspace &ws){
+    const auto T = sd.N_times;
+    const auto &x = f.x;
+    const double sqrt_eps = std::sqrt(std::numeric_limits<double>::epsilon());
+    const auto step = [&](double v) -> double {
+        const double h = sqrt_eps * std::abs(v);
+        return ((v + ((h == 0.0) ? sqrt_eps : h)) - v);
+    };
+    double *c0 = ws.jac.data();
+    double *c1 = c0 + T;
+    double *c2 = c1 + T;
+    double *c3 = c2 + T;
+    double *c4 = c3 + T;
+
+    std::copy(JA, JA + T, c0);
+    std::copy(JV, JV + T, c2);
+
+    const double h_tauA = step(x[1]);
+    convolve(sd.AIF, x[1] + h_tauA, x[4], *(sd.times), ws.tA.data());
+    for(int64_t i = 0; i < T; ++i) c1[i] = x[0] * (ws.tA[i] - JA[i]) / h_tauA;
+
+    const double h_tauV = step(x[3]);
+    convolve(sd.VIF, x[3] + h_tauV, x[4], *(sd.times), ws.tV.data());
+    for(int64_t i = 0; i < T; ++i) c3[i] = x[2] * (ws.tV[i] - JV[i]) / h_tauV;
+
+    const double h_k2 = step(x[4]);
+    convolve(sd.AIF, x[1], x[4] + h_k2, *(sd.times), ws.tA.data());
+    convolve(sd.VIF, x[3], x[4] + h_k2, *(sd.times), ws.tV.data());
+    for(int64_t i = 0; i < T; ++i){
+        c4[i] = (x[0] * (ws.tA[i] - JA[i]) + x[2] * (ws.tV[i] - JV[i])) / h_k2;
+    }
+
+    const std::array<const double *, 5> cols = {{ c0, c1, c2, c3, c4 }};
+    for(size_t a = 0; a < 5; ++a){
+        for(size_t b = 0; b <= a; ++b){
+            double s = 0.0;
+            for(int64_t i = 0; i < T; ++i) s += cols[a][i] * cols[b][i];
+            f.A[a*5 + b] = s;
+            f.A[b*5 + a] = s;
+        }
+        double s = 0.0;
+        for(int64_t i = 0; i < T; ++i) s += cols[a][i] * res[i];
+        f.g[a] = s;
+    }
+    return std::all_of(f.A.begin(), f.A.end(), [](double v){ return std::isfinite(v); })
+        && std::all_of(f.g.begin(), f.g.end(), [](double v){ return std::isfinite(v); });
+}
+
+// Solves (A + lambda * diag(A)) d = -g using a Cholesky factorization.
+bool
+solve_damped(const voxel_fit &f, params_t &d){
+    double max_diag = 0.0;
+    for(size_t i = 0; i < 5; ++i) max_diag = std::max(max_diag, f.A[i*5 + i]);
+    if(!(0.0 < max_diag)) return false;
+
+    std::array<double, 25> L;
+    L.fill(0.0);
+    for(size_t i = 0; i < 5; ++i){
+        for(size_t j = 0; j <= i; ++j){
+            double s = f.A[i*5 + j];
+            if(i == j) s += f.lambda * std::max(f.A[i*5 + i], 1.0E-12 * max_diag);
+            for(size_t k = 0; k < j; ++k) s -= L[i*5 + k] * L[j*5 + k];
+            if(i == j){
+                if(!(0.0 < s)) return false;
+                L[i*5 + i] = std::sqrt(s);
+            }else{
+                L[i*5 + j] = s / L[j*5 + j];
+            }
+        }
+    }
+
+    params_t y;
+    for(size_t i = 0; i < 5; ++i){
+        double s = -f.g[i];
+        for(size_t k = 0; k < i; ++k) s -= L[i*5 + k] * y[k];
+        y[i] = s / L[i*5 + i];
+    }
+    for(size_t ii = 5; ii-- > 0; ){
+        double s = y[ii];
+        for(size_t k = ii + 1; k < 5; ++k) s -= L[k*5 + ii] * d[k];
+        d[ii] = s / L[ii*5 + ii];
+    }
+    return std::all_of(d.begin(), d.end(), [](double v){ return std::isfinite(v); });
+}
+
+// The gradient convergence test used by GSL.
+bool
+gradient_converged(const voxel_fit &f, double gtol){
+    double gmax = 0.0;
+    for(size_t i = 0; i < 5; ++i) gmax = std::max(gmax, std::abs(f.g[i]) * std::max(std::abs(f.x[i]), 1.0));
+    return (gmax <= gtol * std::max(1.0, 0.5 * f.cost));
+}
+
+// Fits a group of voxels, advancing every voxel by one iteration at a time until all have converged or given up.
+//
+// Each voxel's initial guess must be provided in fits[].x.
+void
+fit_lockstep(const shared_data &sd,
+             const KineticModel_1Compartment2Input_5Param_LinearInterp_Batch &batch,
+             const std::vector<int64_t> &voxels,
+             std::vector<voxel_fit> &fits,
+             chunk_workspace &ws){
+    const auto T = sd.N_times;
+    const auto N = static_cast<int64_t>(voxels.size());
+    ws.resize(N, T);
+
+    const double lambda_max = 1.0E16;
+    const double lambda_min = 1.0E-12;
+
+    for(int64_t v = 0; v < N; ++v){
+        auto &f = fits[v];
+        const auto obs = batch.observations.data() + voxels[v] * T;
+        auto JA = ws.JA.data() + v * T;
+        auto JV = ws.JV.data() + v * T;
+        auto res = ws.res.data() + v * T;
+
+        f.iters = 0;
+        f.lambda = 1.0E-3;
+        f.converged = false;
+        f.cost = evaluate(sd, f.x, obs, JA, JV, res);
+        f.active = std::isfinite(f.cost) && normal_equations(sd, f, JA, JV, res, ws);
+        if(f.active && gradient_converged(f, batch.gtol_rel)){
+            f.converged = true;
+            f.active = false;
+        }
+    }
+
+    bool any_active = true;
+    while(any_active){
+        any_active = false;
+        for(int64_t v = 0; v < N; ++v){
+            auto &f = fits[v];
+            if(!f.active) continue;
+            ++f.iters;
+
+            const auto obs = batch.observations.data() + voxels[v] * T;
+            auto JA = ws.JA.data() + v * T;
+            auto JV = ws.JV.data() + v * T;
+            auto res = ws.res.data() + v * T;
+
+            params_t d;
+            bool accepted = false;
+            if(solve_damped(f, d)){
+                params_t x_trial;
+                for(size_t i = 0; i < 5; ++i) x_trial[i] = f.x[i] + d[i];
+                const double cost = evaluate(sd, x_trial, obs, ws.tA.data(), ws.tV.data(), ws.tres.data());
+
+                if(cost < f.cost){
+                    accepted = true;
+                    f.x = x_trial;
+                    f.cost = cost;
+                    f.lambda = std::max(f.lambda * 0.1, lambda_min);
+                    std::copy(ws.tA.begin(), ws.tA.end(), JA);
+                    std::copy(ws.tV.begin(), ws.tV.end(), JV);
+                    std::copy(ws.tres.begin(), ws.tres.end(), res);
+                    if(!normal_equations(sd, f, JA, JV, res, ws)){
+                        f.active = false;
+                        continue;
+                    }
+
+                    bool small_step = true;
+                    for(size_t i = 0; i < 5; ++i){
+                        const double xtol = batch.paramtol_rel;
+                        if(!(std::abs(d[i]) <= xtol * (std::abs(f.x[i]) + xtol))) small_step = false;
+                    }
+                    if(small_step || gradient_converged(f, batch.gtol_rel)){
+                        f.converged = true;
+                        f.active = false;
+                        continue;
+                    }
+                }
+            }
+            if(!accepted){
+                f.lambda *= 10.0;
+                if(lambda_max < f.lambda){
+                    f.active = false;
+                    continue;
+                }
+            }
+            if(batch.max_iterations <= f.iters){
+                f.active = false;
+                continue;
+            }
+            any_active = true;
+        }
+    }
+    return;
+}
+
+} // namespace
+
+
+int64_t
+Optimize_LevenbergMarquardt_5Param_Batched(KineticModel_1Compartment2Input_5Param_LinearInterp_Batch &batch){
+    if( !batch.cAIF || !batch.cVIF ){
+        throw std::invalid_argument("Both arterial and venous input time courses are needed");
+    }
+    if(batch.times.empty()){
+        throw std::invalid_argument("No observation times provided");
+    }
+    if(!std::is_sorted(batch.times.begin(), batch.times.end())){
+        throw std::invalid_argument("Observation times are not sorted");
+    }
+    if((batch.observations.size() % batch.times.size()) != 0){
+        throw std::invalid_argument("Observations do not correspond with the shared times");
+    }
+    const auto N = batch.size();
+    if( !batch.seeds.empty()
+    &&  (static_cast<int64_t>(batch.seeds.size()) != N) ){
+        throw std::invalid_argument("Warm-start seeds do not correspond with the voxels");
+    }
+
+    shared_data sd;
+    sd.AIF = extract_time_course(*(batch.cAIF));
+    sd.VIF = extract_time_course(*(batch.cVIF));
+    sd.times = &(batch.times);
+    sd.N_times = static_cast<int64_t>(batch.times.size());
+
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    batch.RSS.assign(N, nan);
+    batch.k1A.assign(N, nan);
+    batch.tauA.assign(N, nan);
+    batch.k1V.assign(N, nan);
+    batch.tauV.assign(N, nan);
+    batch.k2.assign(N, nan);
+    batch.FittingSuccess.assign(N, 0);
+
+    const auto seed_of = [&](int64_t v) -> int64_t {
+        return batch.seeds.empty() ? -1 : batch.seeds[v];
+    };
+
+    // Arrange the voxels into waves so that every voxel is fitted after the voxel that seeds it.
+    std::vector<int64_t> depth(N, -1);
+    for(int64_t v = 0; v < N; ++v){
+        std::vector<int64_t> path;
+        auto w = v;
+        while(depth[w] < 0){
+            const auto s = seed_of(w);
+            if(N <= s){
+                throw std::invalid_argument("Warm-start seed does not refer to a voxel in the batch");
+            }
+            if(s < 0){
+                depth[w] = 0;
+                break;
+            }
+            path.push_back(w);
+            if(N < static_cast<int64_t>(path.size())){
+                throw std::invalid_argument("Warm-start seeds form a cycle");
+            }
+            w = s;
+        }
+        auto d = depth[w];
+        for(auto it = path.rbegin(); it != path.rend(); ++it) depth[*it] = ++d;
+    }
+    std::vector<std::vector<int64_t>> waves;
+    for(int64_t v = 0; v < N; ++v){
+        const auto d = static_cast<size_t>(depth[v]);
+        if(waves.size() <= d) waves.resize(d + 1);
+        waves[d].push_back(v);
+    }
+
+    const int64_t chunk_size = 32;
+    for(const auto &wave : waves){
+        const auto N_wave = static_cast<int64_t>(wave.size());
+        const auto N_chunks = (N_wave + chunk_size - 1) / chunk_size;
+
+        parallel_for(static_cast<int64_t>(0), N_chunks, [&](int64_t c){
+            const auto b = c * chunk_size;
+            const auto e = std::min(N_wave, b + chunk_size);
+            std::vector<int64_t> voxels(wave.begin() + b, wave.begin() + e);
+            std::vector<voxel_fit> fits(voxels.size());
+            std::vector<uint8_t> warm(voxels.size(), 0);
+            chunk_workspace ws;
+
+            for(size_t i = 0; i < voxels.size(); ++i){
+                const auto s = seed_of(voxels[i]);
+                if( (0 <= s) && (batch.FittingSuccess[s] != 0) ){
+                    fits[i].x = {{ batch.k1A[s], batch.tauA[s], batch.k1V[s], batch.tauV[s], batch.k2[s] }};
+                    warm[i] = 1;
+                }else{
+                    fits[i].x = default_guess;
+                }
+            }
+            fit_lockstep(sd, batch, voxels, fits, ws);
+
+            // Voxels that could not be fitted from a warm start are re-fitted from the default guess.
+            std::vector<size_t> retry_idx;
+            std::vector<int64_t> retry_voxels;
+            for(size_t i = 0; i < voxels.size(); ++i){
+                if( (warm[i] != 0) && !fits[i].converged ){
+                    retry_idx.push_back(i);
+                    retry_voxels.push_back(voxels[i]);
+                }
+            }
+            if(!retry_voxels.empty()){
+                std::vector<voxel_fit> retry_fits(retry_voxels.size());
+                for(auto &f : retry_fits) f.x = default_guess;
+                fit_lockstep(sd, batch, retry_voxels, retry_fits, ws);
+                for(size_t i = 0; i < retry_idx.size(); ++i) fits[retry_idx[i]] = retry_fits[i];
+            }
+
+            for(size_t i = 0; i < voxels.size(); ++i){
+                const auto &f = fits[i];
+                if(!f.converged) continue;
+                const auto v = voxels[i];
+                batch.RSS[v]  = f.cost;
+                batch.k1A[v]  = f.x[0];
+                batch.tauA[v] = f.x[1];
+                batch.k1V[v]  = f.x[2];
+                batch.tauV[v] = f.x[3];
+                batch.k2[v]   = f.x[4];
+                batch.FittingSuccess[v] = 1;
+            }
+        }, 1);
+    }
+
+    const auto N_success = static_cast<int64_t>(std::count(batch.FittingSuccess.begin(), batch.FittingSuccess.end(), 1));
+    YLOGINFO("Fitted " << N_success << " of " << N << " voxels in " << waves.size() << " wave(s)");
+    return N_success;
+}
+
@@ -0,0 +1,71 @@
+//KineticModel_1Compartment2Input_5Param_LinearInterp_Batched.h.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "KineticModel_1Compartment2Input_5Param_LinearInterp_Common.h"
+
+template <class T> class samples_1D;
+
+
+// Shuttle struct for fitting the 5-parameter linear interpolation model to many voxels at once.
+//
+// All voxels in a batch share the same input time courses and observation times, so quantities derived from them are
+// computed once and shared by every fit. Voxel data are stored in structure-of-arrays form.
+struct KineticModel_1Compartment2Input_5Param_LinearInterp_Batch {
+
+    // Shared input time courses.
+    std::shared_ptr<samples_1D<double>> cAIF;
+
+    std::shared_ptr<samples_1D<double>> cVIF;
+
+    // Shared observation times. Must be sorted in ascending order.
+    std::vector<double> times;
+
+    // Observed (ROI) values for every voxel, stored voxel-major: observations[voxel * times.size() + time].
+    std::vector<double> observations;
+
+    // Optional warm-start seeds. If provided, this holds one entry per voxel: either the index of another voxel in the
+    // batch (typically a spatial neighbour) whose fitted parameters are used as the initial guess, or -1 to use the
+    // default initial guess. Seed voxels are always fitted before the voxels they seed. Voxels that fail to converge
+    // from a warm start are re-fitted from the default initial guess.
+    std::vector<int64_t> seeds;
+
+    // Fitting controls.
+    int64_t max_iterations = 5'000;
+    double paramtol_rel = 1.0E-3;
+    double gtol_rel = 1.0E-3;
+
+    // Fitted quantities, one entry per voxel. Parameters are NaN for voxels where fitting failed.
+    std::vector<double> RSS;
+    std::vector<double> k1A;
+    std::vector<double> tauA;
+    std::vector<double> k1V;
+    std::vector<double> tauV;
+    std::vector<double> k2;
+    std::vector<uint8_t> FittingSuccess;
+
+    // The number of voxels in the batch.
+    int64_t size() const;
+
+    // Append a voxel's observations (which must correspond to the shared times), returning the voxel's index.
+    int64_t add_voxel(const std::vector<double> &obs, int64_t seed = -1);
+};
+
+
+// This routine fits the 5-parameter pharmacokinetic model (k1A, tauA, k1V, tauV, k2) to every voxel in the batch
+// using a direct linear interpolation approach, the same model as Optimize_LevenbergMarquardt_5Param().
+//
+// The input time courses are treated as piecewise-linear, so their convolution with the exponential kernel is evaluated
+// in closed form for all observation times in a single sweep rather than independently for each time. Voxels are
+// fitted in chunks across the thread pool, with every voxel in a chunk advancing one Levenberg-Marquardt iteration at
+// a time and reusing the chunk's workspace.
+//
+// Returns the number of voxels that were successfully fitted.
+int64_t
+Optimize_LevenbergMarquardt_5Param_Batched(KineticModel_1Compartment2Input_5Param_LinearInterp_Batch &batch);
+
@@ -4,11 +4,14 @@
 //
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <atomic>
 #include <exception>
 #include <functional>
 #include <list>
 #include <map>
+#include <mutex>
 #include <ostream>
+#include <set>
 #include <stdexcept>
 #include <string>    
 #include <type_traits>
@@ -21,6 +24,10 @@
 #include <YgorString.h>
 
 #include "Structs.h"
+#include "Deferred_Pixels.h"
+#include "Regex_Selectors.h"
+#include "Thread_Pool.h"
+#include "Operation_Profiler.h"
 
 #include "Operations/AccumulateRowsColumns.h"
 #include "Operations/AnalyzeHistograms.h"
@@ -79,6 +86,7 @@
 #include "Operations/DecayDoseOverTimeHalve.h"
 #include "Operations/DecayDoseOverTimeJones2014.h"
 #include "Operations/DecimatePixels.h"
+#include "Operations/DeferImagePixels.h"
 #include "Operations/DeDuplicateImages.h"
 #include "Operations/DeleteContours.h"
 #include "Operations/DeleteImages.h"
@@ -321,6 +329,7 @@ std::map<std::string, op_packet_t> Known_Operations(){
     out["DecayDoseOverTimeJones2014"] = std::make_pair(OpArgDocDecayDoseOverTimeJones2014, DecayDoseOverTimeJones2014);
     out["DecimatePixels"] = std::make_pair(OpArgDocDecimatePixels, DecimatePixels);
     out["DeDuplicateImages"] = std::make_pair(OpArgDocDeDuplicateImages, DeDuplicateImages);
+    out["DeferImagePixels"] = std::make_pair(OpArgDocDeferImagePixels, DeferImagePixels);
     out["DeleteContours"] = std::make_pair(OpArgDocDeleteContours, DeleteContours);
     out["DeleteImages"] = std::make_pair(OpArgDocDeleteImages, DeleteImages);
     out["DeleteLineSamples"] = std::make_pair(OpArgDocDeleteLineSamples, DeleteLineSamples);
@@ -554,6 +563,135 @@ std::map<std::string, std::string> Operation_Lexicon(){
     return op_name_lex;
 }
 
+namespace {
+
+std::atomic<bool> dataflow_enabled(false);
+
+// Nesting depth of the dispatcher on the current thread. Dataflow execution is only used for top-level operations,
+// since control flow operations rely on children operations not being invoked after an earlier child fails.
+thread_local int64_t dispatcher_depth = 0;
+
+struct dispatcher_depth_guard {
+    dispatcher_depth_guard(){ ++dispatcher_depth; }
+    ~dispatcher_depth_guard(){ --dispatcher_depth; }
+};
+
+// An operation with its canonical name, packet, and arguments (including defaults).
+struct resolved_op_t {
+    std::string name;
+    op_packet_t packet;
+    OperationArgPkg optargs;
+};
+
+// Categories of data accessed by an operation.
+struct op_access_t {
+    std::set<std::string> reads;
+    std::set<std::string> writes;
+};
+
+// Operations known to only modify the given categories of data, and which do not modify the parameter table or
+// perform other side-effects. Unlisted operations are never invoked concurrently with other operations.
+const std::map<std::string, std::set<std::string>> & dataflow_write_sets(){
+    static const std::map<std::string, std::set<std::string>> out = {
+        { "CopyImages",              { "images" } },
+        { "DeleteImages",            { "images" } },
+        { "LogScale",                { "images" } },
+        { "ModifyImageMetadata",     { "images" } },
+        { "NegatePixels",            { "images" } },
+        { "NormalizePixels",         { "images" } },
+        { "ScalePixels",             { "images" } },
+        { "SpatialBlur",             { "images" } },
+        { "SpatialSharpen",          { "images" } },
+        { "ThresholdImages",         { "images" } },
+
+        { "ContourViaThreshold",     { "contours" } },
+        { "CopyContours",            { "contours" } },
+        { "DeleteContours",          { "contours" } },
+        { "ModifyContourMetadata",   { "contours" } },
+        { "SimplifyContours",        { "contours" } },
+
+        { "ConvertContoursToMeshes", { "meshes" } },
+        { "CopyMeshes",              { "meshes" } },
+        { "DeleteMeshes",            { "meshes" } },
+        { "SimplifySurfaceMeshes",   { "meshes" } },
+    };
+    return out;
+}
+
+// Infers which categories of data are read by an operation from its selector arguments.
+std::set<std::string> infer_read_set(const OperationArgPkg &optargs, const OperationDoc &doc){
+    const std::list<std::pair<std::string, std::string>> suffixes = {
+        { "ImageSelection",     "images" },
+        { "ROILabelRegex",      "contours" },
+        { "ROISelection",       "contours" },
+        { "MeshSelection",      "meshes" },
+        { "PointSelection",     "points" },
+        { "TableSelection",     "tables" },
+        { "LSampSelection",     "lsamps" },
+        { "TransformSelection", "trans" },
+        { "RTPlanSelection",    "rtplans" },
+    };
+
+    std::set<std::string> out;
+    for(const auto &a : doc.args){
+        if(!optargs.getValueStr(a.name)) continue;
+        for(const auto &sfx : suffixes){
+            if(boost::iends_with(a.name, sfx.first)) out.insert(sfx.second);
+        }
+    }
+    return out;
+}
+
+// Restores deferred pixels for the images an operation may access.
+//
+// Images are identified using the operation's image selector arguments. Operations without image selectors may access
+// any image, so all images are restored for them.
+void ensure_selected_pixels_resident(Drover &DICOM_data, const resolved_op_t &op){
+    std::list<std::string> selections;
+    for(const auto &a : op.packet.first().args){
+        if(!boost::iends_with(a.name, "ImageSelection")) continue;
+        const auto sel = op.optargs.getValueStr(a.name);
+        if(sel) selections.push_back(sel.value());
+    }
+    if(selections.empty()){
+        Ensure_Pixels_Resident(DICOM_data);
+        return;
+    }
+
+    std::set<const Image_Array *> selected;
+    std::list<std::reference_wrapper<planar_image<float,double>>> imgs;
+    for(const auto &sel : selections){
+        for(auto &iap_it : Whitelist(All_IAs(DICOM_data), sel)){
+            if( (*iap_it == nullptr)
+            ||  !selected.insert(iap_it->get()).second ) continue;
+            for(auto &img : (*iap_it)->imagecoll.images) imgs.emplace_back( std::ref(img) );
+        }
+    }
+    Ensure_Pixels_Resident(imgs);
+    return;
+}
+
+bool accesses_conflict(const op_access_t &A, const op_access_t &B){
+    for(const auto &w : A.writes){
+        if( (B.reads.count(w) != 0) || (B.writes.count(w) != 0) ) return true;
+    }
+    for(const auto &w : B.writes){
+        if(A.reads.count(w) != 0) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void Set_Operation_Dataflow(bool enable){
+    dataflow_enabled.store(enable);
+    return;
+}
+
+bool Get_Operation_Dataflow(){
+    return dataflow_enabled.load();
+}
+
 bool Operation_Dispatcher( Drover &DICOM_data,
                            std::map<std::string,std::string> &InvocationMetadata,
                            const std::string &FilenameLex,
@@ -561,49 +699,139 @@ bool Operation_Dispatcher( Drover &DICOM_data,
 
     auto op_name_mapping = Known_Operations();
     Explicator op_name_X( Operation_Lexicon() );
+    const auto tolerates_deferred_pixels = Operations_Tolerating_Deferred_Pixels();
+
+    const bool use_dataflow = Get_Operation_Dataflow() && (dispatcher_depth == 0);
+    dispatcher_depth_guard depth_guard;
+
+    // Find or estimate the canonical name, and insert all documented parameters with default values.
+    const auto resolve = [&](const OperationArgPkg &OptArgs) -> resolved_op_t {
+        // If not an exact match, issue a warning.
+        const auto user_op_name = OptArgs.getName();
+        const auto canonical_op_name = op_name_X(user_op_name);
+        if( op_name_X.last_best_score < 1.0 ){
+            YLOGWARN("Selecting operation '" << canonical_op_name << "' because '" << user_op_name << "' not understood");
+        }
 
-    try{
-        for(const auto &OptArgs : Operations){
-            auto optargs = OptArgs;
+        for(const auto &op_func : op_name_mapping){
+            if(boost::iequals(op_func.first, canonical_op_name)){
+                resolved_op_t out = { op_func.first, op_func.second, OptArgs };
 
-            // Find or estimate the canonical name. If not an exact match, issue a warning.
-            const auto user_op_name = optargs.getName();
-            const auto canonical_op_name = op_name_X(user_op_name);
-            if( op_name_X.last_best_score < 1.0 ){
-                YLOGWARN("Selecting operation '" << canonical_op_name << "' because '" << user_op_name << "' not understood");
+                // Attempt to insert all expected, documented parameters with the default value.
+                //
+                // Note that existing keys will not be replaced.
+                auto OpDocs = op_func.second.first();
+                for(const auto &r : OpDocs.args){
+                    if(r.expected) out.optargs.insert( r.name, r.default_val );
+                }
+                return out;
             }
+        }
+        throw std::invalid_argument("No operation matched '" + OptArgs.getName() + "'");
+    };
+
+    // Perform macro replacement using the parameter table.
+    const auto expand_macros = [&](resolved_op_t &op){
+        op.optargs.visit_opts([&InvocationMetadata](const std::string &key, std::string &val){
+            val = ExpandMacros(val, InvocationMetadata, "$");
+            return;
+        });
+        return;
+    };
+
+    // Note: when invoked concurrently with other operations, other data in the Drover may be modified at any time, so
+    // only data accessed by the operation itself can be inspected.
+    const auto invoke = [&](resolved_op_t &op, bool concurrent){
+        // Record resource usage, if requested. Deferred pixel restoration is attributed to the operation.
+        operation_profile_scope profile(op.name, DICOM_data, !concurrent);
+
+        // Restore any deferred pixels of the selected images, unless the operation is known not to access them.
+        if( !concurrent
+        &&  (tolerates_deferred_pixels.count(op.name) == 0) ){
+            ensure_selected_pixels_resident(DICOM_data, op);
+        }
 
-            bool WasFound = false;
-            for(const auto &op_func : op_name_mapping){
-                if(boost::iequals(op_func.first, canonical_op_name)){
-                    WasFound = true;
-
-                    // Attempt to insert all expected, documented parameters with the default value.
-                    //
-                    // Note that existing keys will not be replaced.
-                    auto OpDocs = op_func.second.first();
-                    for(const auto &r : OpDocs.args){
-                        if(r.expected) optargs.insert( r.name, r.default_val );
-                    }
+        YLOGINFO("Performing operation '" << op.name << "' now..");
+        const bool res = op.packet.second(DICOM_data,
+                                          op.optargs,
+                                          InvocationMetadata,
+                                          FilenameLex);
+        profile.set_succeeded(res);
+        if(!res) throw std::runtime_error("Truthiness is false");
+        return;
+    };
+
+    // Invokes a batch of operations with mutually non-conflicting data access concurrently.
+    //
+    // Operations in a batch do not modify the parameter table, so macros are expanded prior to invocation.
+    std::list<std::pair<resolved_op_t, op_access_t>> batch;
+    const auto flush_batch = [&](){
+        if(batch.size() == 1){
+            invoke(batch.front().first, false);
+
+        }else if(!batch.empty()){
+            for(auto &b : batch){
+                if(tolerates_deferred_pixels.count(b.first.name) == 0){
+                    ensure_selected_pixels_resident(DICOM_data, b.first);
+                }
+            }
 
-                    // Perform macro replacement using the parameter table.
-                    optargs.visit_opts([&InvocationMetadata](const std::string &key, std::string &val){
-                        val = ExpandMacros(val, InvocationMetadata, "$");
-                        return;
+            YLOGINFO("Performing " << batch.size() << " independent operations concurrently");
+            std::mutex err_mutex;
+            std::list<std::string> errors;
+            {
+                task_group tg;
+                for(auto &b : batch){
+                    tg.submit_task([&,op_ptr = &(b.first)](){
+                        try{
+                            invoke(*op_ptr, true);
+                        }catch(const std::exception &e){
+                            std::lock_guard<std::mutex> lock(err_mutex);
+                            errors.emplace_back("'"_s + op_ptr->name + "': " + e.what());
+                        }
                     });
+                }
+                tg.wait();
+            } // Joins the task group.
+
+            if(!errors.empty()){
+                for(const auto &e : errors) YLOGWARN("Concurrent operation failed: " << e);
+                throw std::runtime_error(errors.front());
+            }
+        }
+        batch.clear();
+        return;
+    };
 
-                    YLOGINFO("Performing operation '" << op_func.first << "' now..");
-                    const bool res = op_func.second.second(DICOM_data,
-                                                           optargs,
-                                                           InvocationMetadata,
-                                                           FilenameLex);
-                    if(!res) throw std::runtime_error("Truthiness is false");
+    try{
+        for(const auto &OptArgs : Operations){
+            auto op = resolve(OptArgs);
 
-                    break;
+            const auto w_it = dataflow_write_sets().find(op.name);
+            if( use_dataflow
+            &&  (w_it != std::end(dataflow_write_sets())) ){
+                expand_macros(op);
+
+                op_access_t access;
+                access.reads = infer_read_set(op.optargs, op.packet.first());
+                access.writes = w_it->second;
+
+                for(const auto &b : batch){
+                    if(accesses_conflict(b.second, access)){
+                        flush_batch();
+                        break;
+                    }
                 }
+                batch.emplace_back(op, access);
+                continue;
             }
-            if(!WasFound) throw std::invalid_argument("No operation matched '" + optargs.getName() + "'");
+
+            flush_batch();
+            expand_macros(op);
+            invoke(op, false);
         }
+        flush_batch();
+
     }catch(const std::exception &e){
         YLOGWARN("Analysis failed: '" << e.what() << "'. Aborting remaining analyses");
         return false;
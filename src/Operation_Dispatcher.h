@@ -28,3 +28,9 @@ bool Operation_Dispatcher( Drover &DICOM_data,
                            const std::string &FilenameLex,
                            const std::list<OperationArgPkg> &Operations);
 
+// Dataflow execution. When enabled, consecutive top-level operations that are known to access disjoint categories of
+// data (inferred from their selector arguments) are invoked concurrently. Results are identical to sequential
+// execution, except that when an operation fails, operations invoked concurrently with it are permitted to complete.
+void Set_Operation_Dataflow(bool enable);
+bool Get_Operation_Dataflow();
+
@@ -0,0 +1,294 @@
+//Operation_Profiler.cc - A part of DICOMautomaton 2024. Written by hal clark.
+//
+// This file provides instrumentation for operations invoked by the operation dispatcher.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <list>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <sys/resource.h>
+    #include <sys/time.h>
+#endif
+
+#include "YgorMisc.h"
+#include "YgorLog.h"
+
+#include "Structs.h"
+#include "Operation_Profiler.h"
+
+
+namespace {
+
+std::atomic<bool> profiling_enabled(false);
+
+std::mutex profiles_mutex;
+std::list<operation_profile_t> profiles;
+std::chrono::steady_clock::time_point profiling_origin = std::chrono::steady_clock::now();
+std::map<std::thread::id, int64_t> thread_ids;
+
+thread_local int64_t nesting_depth = 0;
+
+double get_process_cpu_time_us(){
+#if !defined(_WIN32) && !defined(_WIN64)
+    rusage ru;
+    if(getrusage(RUSAGE_SELF, &ru) == 0){
+        return   (static_cast<double>(ru.ru_utime.tv_sec) + static_cast<double>(ru.ru_stime.tv_sec)) * 1.0E6
+               + (static_cast<double>(ru.ru_utime.tv_usec) + static_cast<double>(ru.ru_stime.tv_usec));
+    }
+#endif
+    return static_cast<double>(std::clock()) * 1.0E6 / static_cast<double>(CLOCKS_PER_SEC);
+}
+
+int64_t get_peak_rss_kb(){
+#if !defined(_WIN32) && !defined(_WIN64)
+    rusage ru;
+    if(getrusage(RUSAGE_SELF, &ru) == 0){
+    #if defined(__APPLE__)
+        return static_cast<int64_t>(ru.ru_maxrss) / 1024; // Reported in bytes.
+    #else
+        return static_cast<int64_t>(ru.ru_maxrss); // Reported in kilobytes.
+    #endif
+    }
+#endif
+    return -1;
+}
+
+std::string json_escape(const std::string &in){
+    std::string out;
+    out.reserve(in.size());
+    for(const auto c : in){
+        if(c == '"'){
+            out += "\\\"";
+        }else if(c == '\\'){
+            out += "\\\\";
+        }else if(static_cast<unsigned char>(c) < 0x20){
+            std::stringstream ss;
+            ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+            out += ss.str();
+        }else{
+            out += c;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+
+drover_object_counts_t Count_Drover_Objects(const Drover &DICOM_data){
+    drover_object_counts_t out;
+    if(DICOM_data.contour_data != nullptr){
+        for(const auto &cc : DICOM_data.contour_data->ccs){
+            ++out.contour_collections;
+            out.contours += static_cast<int64_t>(cc.contours.size());
+        }
+    }
+    for(const auto &ia_ptr : DICOM_data.image_data){
+        if(ia_ptr == nullptr) continue;
+        ++out.image_arrays;
+        out.images += static_cast<int64_t>(ia_ptr->imagecoll.images.size());
+    }
+    out.point_clouds   = static_cast<int64_t>(DICOM_data.point_data.size());
+    out.surface_meshes = static_cast<int64_t>(DICOM_data.smesh_data.size());
+    out.rtplans        = static_cast<int64_t>(DICOM_data.rtplan_data.size());
+    out.line_samples   = static_cast<int64_t>(DICOM_data.lsamp_data.size());
+    out.transforms     = static_cast<int64_t>(DICOM_data.trans_data.size());
+    out.tables         = static_cast<int64_t>(DICOM_data.table_data.size());
+    return out;
+}
+
+
+void Set_Operation_Profiling(bool enable){
+    if(enable){
+        std::lock_guard<std::mutex> lock(profiles_mutex);
+        profiles.clear();
+        thread_ids.clear();
+        profiling_origin = std::chrono::steady_clock::now();
+    }
+    profiling_enabled.store(enable);
+    return;
+}
+
+bool Get_Operation_Profiling(){
+    return profiling_enabled.load();
+}
+
+std::list<operation_profile_t> Get_Operation_Profiles(){
+    std::lock_guard<std::mutex> lock(profiles_mutex);
+    return profiles;
+}
+
+void Clear_Operation_Profiles(){
+    std::lock_guard<std::mutex> lock(profiles_mutex);
+    profiles.clear();
+    return;
+}
+
+
+operation_profile_scope::operation_profile_scope(const std::string &name,
+                                                 const Drover &l_DICOM_data,
+                                                 bool count_objects){
+    if(!Get_Operation_Profiling()) return;
+    this->active = true;
+    this->DICOM_data = (count_objects) ? &l_DICOM_data : nullptr;
+
+    this->rec.name = name;
+    this->rec.depth = nesting_depth++;
+    if(this->DICOM_data != nullptr) this->rec.objects_before = Count_Drover_Objects(l_DICOM_data);
+    this->rec.peak_rss_before_kb = get_peak_rss_kb();
+    {
+        std::lock_guard<std::mutex> lock(profiles_mutex);
+        const auto tid = std::this_thread::get_id();
+        auto t_it = thread_ids.find(tid);
+        if(t_it == std::end(thread_ids)){
+            t_it = thread_ids.emplace(tid, static_cast<int64_t>(thread_ids.size())).first;
+        }
+        this->rec.thread = t_it->second;
+
+        const auto t_start = std::chrono::steady_clock::now();
+        this->rec.start_us = std::chrono::duration<double, std::micro>(t_start - profiling_origin).count();
+    }
+    this->cpu_start_us = get_process_cpu_time_us();
+}
+
+operation_profile_scope::~operation_profile_scope(){
+    if(!this->active) return;
+    try{
+        this->rec.cpu_us = get_process_cpu_time_us() - this->cpu_start_us;
+        this->rec.peak_rss_after_kb = get_peak_rss_kb();
+        if(this->DICOM_data != nullptr) this->rec.objects_after = Count_Drover_Objects(*(this->DICOM_data));
+
+        std::lock_guard<std::mutex> lock(profiles_mutex);
+        const auto t_end = std::chrono::steady_clock::now();
+        this->rec.wall_us = std::chrono::duration<double, std::micro>(t_end - profiling_origin).count()
+                          - this->rec.start_us;
+        profiles.emplace_back(this->rec);
+    }catch(const std::exception &){}
+    --nesting_depth;
+}
+
+void operation_profile_scope::set_succeeded(bool succeeded){
+    this->rec.succeeded = succeeded;
+    return;
+}
+
+
+void Write_Operation_Profiles_Chrome_Trace(std::ostream &os, const std::list<operation_profile_t> &l_profiles){
+    const auto write_counts = [&os](const drover_object_counts_t &c){
+        os << "{"
+           << "\"contour_collections\":" << c.contour_collections << ","
+           << "\"contours\":" << c.contours << ","
+           << "\"image_arrays\":" << c.image_arrays << ","
+           << "\"images\":" << c.images << ","
+           << "\"point_clouds\":" << c.point_clouds << ","
+           << "\"surface_meshes\":" << c.surface_meshes << ","
+           << "\"rtplans\":" << c.rtplans << ","
+           << "\"line_samples\":" << c.line_samples << ","
+           << "\"transforms\":" << c.transforms << ","
+           << "\"tables\":" << c.tables
+           << "}";
+    };
+
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for(const auto &p : l_profiles){
+        if(!first) os << ",";
+        first = false;
+
+        os << "\n{\"name\":\"" << json_escape(p.name) << "\""
+           << ",\"cat\":\"operation\""
+           << ",\"ph\":\"X\""
+           << ",\"pid\":1"
+           << ",\"tid\":" << p.thread
+           << ",\"ts\":" << p.start_us
+           << ",\"dur\":" << p.wall_us
+           << ",\"args\":{"
+           << "\"succeeded\":" << (p.succeeded ? "true" : "false")
+           << ",\"depth\":" << p.depth
+           << ",\"cpu_us\":" << p.cpu_us
+           << ",\"peak_rss_before_kb\":" << p.peak_rss_before_kb
+           << ",\"peak_rss_after_kb\":" << p.peak_rss_after_kb
+           << ",\"objects_before\":";
+        write_counts(p.objects_before);
+        os << ",\"objects_after\":";
+        write_counts(p.objects_after);
+        os << "}}";
+    }
+    os << "\n]}\n";
+    return;
+}
+
+void Write_Operation_Profiles_Summary(std::ostream &os, const std::list<operation_profile_t> &l_profiles){
+    struct summary_t {
+        int64_t calls = 0;
+        int64_t failures = 0;
+        double wall_us = 0.0;
+        double max_wall_us = 0.0;
+        double cpu_us = 0.0;
+        int64_t peak_rss_growth_kb = 0;
+        int64_t net_images = 0;
+        int64_t net_contours = 0;
+    };
+    std::map<std::string, summary_t> summaries;
+    for(const auto &p : l_profiles){
+        auto &s = summaries[p.name];
+        ++s.calls;
+        if(!p.succeeded) ++s.failures;
+        s.wall_us += p.wall_us;
+        s.max_wall_us = std::max(s.max_wall_us, p.wall_us);
+        s.cpu_us += p.cpu_us;
+        if( (0 <= p.peak_rss_before_kb) && (0 <= p.peak_rss_after_kb) ){
+            s.peak_rss_growth_kb += p.peak_rss_after_kb - p.peak_rss_before_kb;
+        }
+        s.net_images += p.objects_after.images - p.objects_before.images;
+        s.net_contours += p.objects_after.contours - p.objects_before.contours;
+    }
+
+    // Order by total wall time, longest first.
+    std::vector<std::pair<std::string, summary_t>> ordered( std::begin(summaries), std::end(summaries) );
+    std::stable_sort( std::begin(ordered), std::end(ordered), [](const auto &A, const auto &B){
+        return (B.second.wall_us < A.second.wall_us);
+    });
+
+    os << "Operation profile (times include children operations)" << std::endl;
+    os << std::left << std::setw(40) << "Operation"
+       << std::right << std::setw(8) << "Calls"
+       << std::setw(8) << "Failed"
+       << std::setw(14) << "Wall (ms)"
+       << std::setw(14) << "Max wall (ms)"
+       << std::setw(14) << "CPU (ms)"
+       << std::setw(16) << "Peak RSS +(kB)"
+       << std::setw(12) << "Images +/-"
+       << std::setw(12) << "Contours +/-"
+       << std::endl;
+    os << std::fixed << std::setprecision(3);
+    for(const auto &p : ordered){
+        const auto &s = p.second;
+        os << std::left << std::setw(40) << p.first
+           << std::right << std::setw(8) << s.calls
+           << std::setw(8) << s.failures
+           << std::setw(14) << (s.wall_us / 1000.0)
+           << std::setw(14) << (s.max_wall_us / 1000.0)
+           << std::setw(14) << (s.cpu_us / 1000.0)
+           << std::setw(16) << s.peak_rss_growth_kb
+           << std::setw(12) << s.net_images
+           << std::setw(12) << s.net_contours
+           << std::endl;
+    }
+    return;
+}
+
@@ -0,0 +1,80 @@
+//Operation_Profiler.h.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <ostream>
+#include <string>
+
+#include "Structs.h"
+
+// Number of objects held by a Drover, by category.
+struct drover_object_counts_t {
+    int64_t contour_collections = 0;
+    int64_t contours = 0;
+    int64_t image_arrays = 0;
+    int64_t images = 0;
+    int64_t point_clouds = 0;
+    int64_t surface_meshes = 0;
+    int64_t rtplans = 0;
+    int64_t line_samples = 0;
+    int64_t transforms = 0;
+    int64_t tables = 0;
+};
+
+drover_object_counts_t Count_Drover_Objects(const Drover &DICOM_data);
+
+
+// Resource usage for a single operation invocation. Times are inclusive of any children operations.
+struct operation_profile_t {
+    std::string name;
+    int64_t depth = 0;          // Nesting depth. Top-level operations have depth zero.
+    int64_t thread = 0;         // Sequential identifier for the invoking thread.
+    bool succeeded = false;
+
+    double start_us = 0.0;      // Wall time since profiling was enabled.
+    double wall_us = 0.0;
+    double cpu_us = 0.0;        // Process-wide CPU time, so includes all worker threads.
+
+    int64_t peak_rss_before_kb = -1; // Peak resident set size. Negative if unavailable.
+    int64_t peak_rss_after_kb = -1;
+
+    drover_object_counts_t objects_before;
+    drover_object_counts_t objects_after;
+};
+
+// Profiling is disabled by default. Enabling profiling resets the time origin and discards existing records.
+void Set_Operation_Profiling(bool enable);
+bool Get_Operation_Profiling();
+
+std::list<operation_profile_t> Get_Operation_Profiles();
+void Clear_Operation_Profiles();
+
+// Records resource usage for the lifetime of the object. Does nothing if profiling is disabled when constructed.
+//
+// Object counts are only recorded if requested, since the Drover may be concurrently modified by other operations.
+class operation_profile_scope {
+    private:
+        bool active = false;
+        const Drover *DICOM_data = nullptr;
+        operation_profile_t rec;
+        double cpu_start_us = 0.0;
+
+    public:
+        operation_profile_scope(const std::string &name, const Drover &DICOM_data, bool count_objects = true);
+        ~operation_profile_scope();
+
+        operation_profile_scope(const operation_profile_scope &) = delete;
+        operation_profile_scope & operator=(const operation_profile_scope &) = delete;
+
+        void set_succeeded(bool succeeded);
+};
+
+// Writes records in the Chrome trace event format, which can be viewed with Perfetto or chrome://tracing.
+void Write_Operation_Profiles_Chrome_Trace(std::ostream &os, const std::list<operation_profile_t> &profiles);
+
+// Writes a human-readable table summarizing records, aggregated by operation name.
+void Write_Operation_Profiles_Summary(std::ostream &os, const std::list<operation_profile_t> &profiles);
+
@@ -54,6 +54,8 @@ OperationDoc OpArgDocAnd() {
         " operation is invoked."
     );
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
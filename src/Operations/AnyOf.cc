@@ -64,6 +64,8 @@ OperationDoc OpArgDocAnyOf() {
         " with other control flow meta-operations, for example as a conditional in an if-else statement."
     );
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
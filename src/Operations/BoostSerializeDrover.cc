@@ -51,6 +51,20 @@ OperationDoc OpArgDocBoost_Serialize_Drover(){
                                  "rtplans+images+contours",
                                  "contours+images+pointclouds" };
 
+
+    out.args.emplace_back();
+    out.args.back().name = "Format";
+    out.args.back().desc = "The archive format."
+                           " 'default' writes gzipped XML, which should be portable across most CPUs."
+                           " 'chunked-binary' compresses each object independently and in parallel, and appends a"
+                           " table of contents so individual objects can be loaded without decoding the whole"
+                           " archive (see the LoadFiles operation). It is much faster for large data,"
+                           " but, like all binary archives, is not portable across CPU architectures.";
+    out.args.back().default_val = "default";
+    out.args.back().expected = true;
+    out.args.back().examples = { "default", "chunked-binary" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
     return out;
 }
 
@@ -62,6 +76,7 @@ bool Boost_Serialize_Drover(Drover &DICOM_data,
     //---------------------------------------------- User Parameters --------------------------------------------------
     auto FilenameStr = OptArgs.getValueStr("Filename").value();
     auto ComponentsStr = OptArgs.getValueStr("Components").value();
+    const auto FormatStr = OptArgs.getValueStr("Format").value();
 
     //-----------------------------------------------------------------------------------------------------------------
 
@@ -77,6 +92,14 @@ bool Boost_Serialize_Drover(Drover &DICOM_data,
     const bool include_smeshes  = std::regex_match(ComponentsStr, regex_smeshes);
     const bool include_rtplans  = std::regex_match(ComponentsStr, regex_rtplans);
 
+    const auto regex_default = Compile_Regex("^de?f?a?u?l?t?$");
+    const auto regex_chunked = Compile_Regex("^ch?u?n?k?e?d?.*$");
+    const bool format_default = std::regex_match(FormatStr, regex_default);
+    const bool format_chunked = std::regex_match(FormatStr, regex_chunked);
+    if(!format_default && !format_chunked){
+        throw std::invalid_argument("Format not understood. Cannot continue.");
+    }
+
     const std::filesystem::path apath(FilenameStr);
 
     // Figure out what needs to be serialized.
@@ -100,7 +123,8 @@ bool Boost_Serialize_Drover(Drover &DICOM_data,
         d.rtplan_data = DICOM_data.rtplan_data;
     }
 
-    const auto res = Common_Boost_Serialize_Drover(d, apath);
+    const auto res = (format_chunked) ? Common_Boost_Serialize_Drover_to_Chunked_Binary(d, apath)
+                                      : Common_Boost_Serialize_Drover(d, apath);
     if(res){
         YLOGINFO("Dumped serialization to file " << apath);
     }else{
@@ -213,6 +213,21 @@ OperationDoc OpArgDocCT_Liver_Perfusion_Pharmaco_1C2I_5Param(){
                             "9",
                             "10"};
 
+    out.args.emplace_back();
+    out.args.back().name = "UseBatchedFitting";
+    out.args.back().desc = "Control whether all voxels are fitted together using a batched fitting engine rather"
+                      " than individually. The batched engine evaluates the model for all sample times at once,"
+                      " shares AIF and VIF processing between voxels, warm-starts fits from nearby voxels, and"
+                      " distributes fits across threads, so it is considerably faster for large ROIs."
+                      " Fits may occasionally settle in different local minima than individual fits."
+                      " This option currently produces an effect only if the linear interpolation method is"
+                      " being used (i.e., the Chebyshev polynomial method is not being used).";
+    out.args.back().default_val = "false";
+    out.args.back().expected = true;
+    out.args.back().examples = { "true",
+                            "false" };
+
+
     out.args.emplace_back();
     out.args.back().name = "UseChebyshevPolyMethod";
     out.args.back().desc = "Control whether the AIF and VIF should be approximated by Chebyshev polynomials."
@@ -289,6 +304,8 @@ bool CT_Liver_Perfusion_Pharmaco_1C2I_5Param(Drover &DICOM_data,
     const auto BasisSplineCoefficientsStr = OptArgs.getValueStr("BasisSplineCoefficients").value();
     const auto BasisSplineOrder = std::stol( OptArgs.getValueStr("BasisSplineOrder").value() );
 
+    const auto UseBatchedFittingStr = OptArgs.getValueStr("UseBatchedFitting").value();
+
     const auto UseChebyshevPolyMethodStr = OptArgs.getValueStr("UseChebyshevPolyMethod").value();
     const auto ChebyshevPolyCoefficientsStr = OptArgs.getValueStr("ChebyshevPolyCoefficients").value();
 
@@ -347,6 +364,7 @@ bool CT_Liver_Perfusion_Pharmaco_1C2I_5Param(Drover &DICOM_data,
     const auto ShouldPlotAIFVIF = std::regex_match(PlotAIFVIF, TrueRegex);
     const auto UseBasisSplineInterpolation = std::regex_match(UseBasisSplineInterpolationStr, TrueRegex);
     const auto UseChebyshevPolyMethod = std::regex_match(UseChebyshevPolyMethodStr, TrueRegex);
+    const auto UseBatchedFitting = std::regex_match(UseBatchedFittingStr, TrueRegex);
 
 
     //Tokenize the plotting criteria.
@@ -723,6 +741,7 @@ bool CT_Liver_Perfusion_Pharmaco_1C2I_5Param(Drover &DICOM_data,
         ud_linear.pixels_to_plot = pixels_to_plot;
         ud_linear.TargetROIs = TargetROINameRegex;
         ud_linear.ContrastInjectionLeadTime = ContrastInjectionLeadTime;
+        ud_linear.UseBatchedFitting = UseBatchedFitting;
         {
             //Correct any unaccounted-for contrast enhancement shifts. 
             if(true) for(auto & theROI : ud.time_courses){
@@ -94,6 +94,9 @@ OperationDoc OpArgDocContourBooleanOperations(){
     out.args.back().expected = true;
     out.args.back().examples = { "A+B", "A-B", "AuB", "AnB", "AxB", "A^B", "union", "xor", "combined", "body_without_spinal_cord" };
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
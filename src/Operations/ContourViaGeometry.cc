@@ -87,6 +87,9 @@ OperationDoc OpArgDocContourViaGeometry(){
     out.args.back().expected = true;
     out.args.back().examples = { "sphere(-1.0, 2.0, 3.0,  12.3)" };
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <optional>
 #include <fstream>
+#include <functional>
 #include <iterator>
 #include <list>
 #include <map>
@@ -29,6 +30,7 @@
 #include "../Regex_Selectors.h"
 #include "../Thread_Pool.h"
 #include "../Metadata.h"
+#include "../YgorImages_Functors/Marching_Squares.h"
 #ifdef DCMA_USE_CGAL
     #include "../Surface_Meshes.h"
 #endif // DCMA_USE_CGAL
@@ -61,13 +63,14 @@ OperationDoc OpArgDocContourViaThreshold(){
     );
         
     out.notes.emplace_back(
-        "Contour orientation is (likely) not properly handled in this routine, so 'pinches' and holes will produce"
-        " contours with inconsistent or invalid topology. If in doubt, disable merge simplifications and live with"
-        " the computational penalty. The marching cubes approach will properly handle 'pinches' and contours should"
-        " all be topologically valid."
+        "The binary method does not track contour orientation, so 'pinches' and holes can produce contours with"
+        " inconsistent or invalid topology. If in doubt, disable merge simplifications and live with the"
+        " computational penalty. The marching-squares and marching-cubes methods properly handle 'pinches' and"
+        " contours should all be topologically valid."
     );
     out.notes.emplace_back(
-        "Note that the marching-squares method currently only honours the lower threshold."
+        "The marching-squares method processes all selected images in a single parallel pass and emits contours"
+        " without duplicate vertices. Outer boundaries and holes are consistently (i.e., oppositely) oriented."
     );
 
     out.args.emplace_back();
@@ -166,6 +169,9 @@ OperationDoc OpArgDocContourViaThreshold(){
     out.args.back().examples = { "true", "false" };
     
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
@@ -220,7 +226,7 @@ bool ContourViaThreshold(Drover &DICOM_data,
     for(auto & iap_it : IAs){
         const long int img_count = (*iap_it)->imagecoll.images.size();
 
-        asio_thread_pool tp;
+        task_group tp;
         std::mutex saver_printer; // Who gets to save generated contours, print to the console, and iterate the counter.
         long int completed = 0;
 
@@ -267,6 +273,39 @@ bool ContourViaThreshold(Drover &DICOM_data,
         auto cm = (*iap_it)->imagecoll.get_common_metadata({});
         cm = coalesce_metadata_for_rtstruct(cm);
 
+        // ---------------------------------------------------
+        // The marching squares method, which processes the whole image array in a single batched pass.
+        if(std::regex_match(MethodStr, marching_squares_regex)){
+            std::list<std::reference_wrapper<const planar_image<float,double>>> imgs;
+            for(const auto &animg : (*iap_it)->imagecoll.images){
+                if( (animg.rows < 1) || (animg.columns < 1) || (Channel >= animg.channels) ){
+                    throw std::runtime_error("Image or channel is empty -- cannot contour via thresholds.");
+                }
+                imgs.emplace_back( std::cref(animg) );
+            }
+
+            marching_squares_opts ms_opts;
+            ms_opts.lower = cl;
+            ms_opts.upper = cu;
+            ms_opts.channel = Channel;
+            auto copl = Marching_Squares(imgs, ms_opts);
+
+            auto contour_metadata = cm;
+            contour_metadata["ROIName"] = ROILabel;
+            contour_metadata["NormalizedROIName"] = NormalizedROILabel;
+            contour_metadata["Description"] = "Contoured via threshold ("_s + std::to_string(Lower)
+                                            + " <= pixel_val <= " + std::to_string(Upper) + ")";
+            contour_metadata["ROINumber"] = std::to_string(10000); // TODO: find highest existing and ++ it.
+            contour_metadata["MinimumSeparation"] = std::to_string(MinimumSeparation);
+            for(auto &cop : copl){
+                cop.metadata = contour_metadata;
+            }
+
+            DICOM_data.contour_data->ccs.back().contours.splice(DICOM_data.contour_data->ccs.back().contours.end(), copl);
+            YLOGINFO("Completed " << img_count << " of " << img_count << " --> 100% done");
+            continue;
+        }
+
         for(const auto &animg : (*iap_it)->imagecoll.images){
             if( (animg.rows < 1) || (animg.columns < 1) || (Channel >= animg.channels) ){
                 throw std::runtime_error("Image or channel is empty -- cannot contour via thresholds.");
@@ -426,402 +465,6 @@ bool ContourViaThreshold(Drover &DICOM_data,
                               << " --> " << static_cast<int>(1000.0*(completed)/img_count)/10.0 << "% done");
                     }
 
-                // ---------------------------------------------------
-                // The marching squares method.
-                }else if(std::regex_match(MethodStr, marching_squares_regex)){
-                    //Prepare a mask image for contouring.
-                    auto mask = *animg_ptr;
-                    double inclusion_threshold = std::numeric_limits<double>::quiet_NaN();
-                    double exterior_value = std::numeric_limits<double>::quiet_NaN();
-                    bool below_is_interior = false;
-
-                    if(std::isfinite(cl) && std::isfinite(cu)){
-                        // Transform voxels by their |distance| from the midpoint. Only interior voxels will be within
-                        // [0,width*0.5], and all others will be (width*0.5,inf).
-                        const double midpoint = (cl + cu) * 0.5;
-                        const double width = (cu - cl);
-
-                        inclusion_threshold = width * 0.5;
-                        exterior_value = inclusion_threshold + 1.0;
-                        below_is_interior = true;
-                        mask.apply_to_pixels([Channel,midpoint](long int, long int, long int chnl, float &val) -> void {
-                                if(Channel == chnl){
-                                    val = std::abs(val - midpoint);
-                                }
-                                return;
-                            });
-
-                    }else if(std::isfinite(cl)){
-                        inclusion_threshold = cl;
-                        exterior_value = inclusion_threshold - 1.0;
-                        below_is_interior = false;
-
-                    }else if(std::isfinite(cu)){
-                        inclusion_threshold = cu;
-                        exterior_value = inclusion_threshold + 1.0;
-                        below_is_interior = true;
-
-                    }else{ // Neither threshold is finite.
-                        throw std::invalid_argument("Unable to discern finite threshold for meshing. Refusing to continue.");
-                        // Note: it is possible to deal with these cases and generate meshings for each, i.e., either all
-                        // voxels are included or no voxels are included (both are valid meshings). However, it seems
-                        // most likely this is a user error. Add this functionality if necessary.
-
-                    }
-
-                    const auto R = animg_ptr->rows;
-                    const auto C = animg_ptr->columns;
-
-                    //Construct a pixel 'oracle' closure using the user-specified threshold criteria. This function identifies whether
-                    //the pixel is within (true) or outside of (false) the final ROI.
-                    const auto pixel_oracle = [inclusion_threshold,below_is_interior](float p) -> bool {
-                        return below_is_interior ? (inclusion_threshold <= p) : (p <= inclusion_threshold);
-                    };
-
-                    const auto interpolate_pos = [inclusion_threshold](float f1, const vec3<double> &pos1,
-                                                                       float f2, const vec3<double> &pos2) -> vec3<double> {
-                        const auto num = f2 - inclusion_threshold;
-                        const auto den = f2 - f1;
-                        const auto m = num / den;
-                        return pos2 + (pos1 - pos2) * m;
-                    };
-
-                    const uint8_t o_t = 1; // Edges of the unit cell pixel (top, bottom, left, right).
-                    const uint8_t o_b = 2;
-                    const uint8_t o_l = 3;
-                    const uint8_t o_r = 4;
-
-                    const vec3<double> zero3(0.0, 0.0, 0.0);
-                    struct node {  // This class holds a contour edge with both vertices.
-                        uint8_t tail_vert_pos; // = 0; // Which cell edge the tail vertex lies along.
-                        uint8_t head_vert_pos; // = 0; // Which cell edge the head vertex lies along.
-                        vec3<double> tail;
-                        vec3<double> head;
-
-                        node() : tail_vert_pos(0), head_vert_pos(0), tail(vec3<double>(0.0, 0.0, 0.0)), head(vec3<double>(0.0, 0.0, 0.0)) {};
-                        node(uint8_t t_v_p, uint8_t h_v_p, const vec3<double> &t, const vec3<double> &h) : tail_vert_pos(t_v_p), head_vert_pos(h_v_p), tail(t), head(h) {};
-                        node(const node &n){
-                            (*this) = n;
-                        };
-                        node& operator=(const node& rhs){
-                            if(this == &rhs) return *this;
-                            this->tail_vert_pos = rhs.tail_vert_pos;
-                            this->head_vert_pos = rhs.head_vert_pos;
-                            this->tail = rhs.tail;
-                            this->head = rhs.head;
-                            return *this;
-                        };
-                    };
-                    const node empty_node(0,0,zero3,zero3);
-
-                    //std::vector< std::pair<node,node> > nodes((R-1)*(C-1), std::make_pair(empty_node,empty_node));
-                    std::vector< std::pair<node,node> > nodes((R+1)*(C+1), std::make_pair(empty_node,empty_node));
-                    const auto index = [C](long int r, long int c) -> long int {
-                        return ( (C+1) * r + c);
-                    };
-
-                    // Override the normal voxel intensity and position getters to handle the 2 additional rows and columns.
-                    const auto get_value = [mask,R,C,exterior_value,Channel](long int r, long int c) -> float {
-                        float out;
-                        if( (r == 0) || (r == (R+1))
-                        ||  (c == 0) || (c == (C+1)) ){
-                            out = exterior_value;
-                        }else{
-                            out = mask.value(r-1, c-1, Channel);
-                        }
-                        return out;
-                    };
-                    const auto get_position = [&mask,R,C,exterior_value,Channel](long int r, long int c){
-                        return (  mask.anchor
-                                + mask.offset
-                                + mask.row_unit*(mask.pxl_dx*static_cast<double>(r-1))
-                                + mask.col_unit*(mask.pxl_dy*static_cast<double>(c-1)) );
-                    };
-
-                    for(long int r = 0; r < (R+1); ++r){
-                        for(long int c = 0; c < (C+1); ++c){
-                            const auto tl = get_value(r  , c  );
-                            const auto tr = get_value(r  , c+1);
-                            const auto br = get_value(r+1, c+1);
-                            const auto bl = get_value(r+1, c  );
-
-                            const auto pos_tl = get_position(r  , c  );
-                            const auto pos_tr = get_position(r  , c+1);
-                            const auto pos_br = get_position(r+1, c+1);
-                            const auto pos_bl = get_position(r+1, c  );
-
-                            const auto TL = pixel_oracle(tl);
-                            const auto TR = pixel_oracle(tr);
-                            const auto BR = pixel_oracle(br);
-                            const auto BL = pixel_oracle(bl);
-
-                            // See enumerated cases visualized at https://en.wikipedia.org/wiki/File:Marching_squares_algorithm.svg (circa 20210604).
-                            const auto i = index(r, c);
-                            auto n_ptr = &(nodes.at(i));
-                            if( false ){
-                            }else if(  TL &&  TR &&  BL &&  BR ){// case 0
-                                // No crossing. Do nothing.
-                            }else if(  TL &&  TR && !BL &&  BR ){// case 1
-                                const auto tail = interpolate_pos(tl, pos_tl,  bl, pos_bl);
-                                const auto head = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                *n_ptr = std::make_pair(node(o_l, o_b, tail, head), empty_node);
-                            }else if(  TL &&  TR &&  BL && !BR ){// case 2
-                                const auto tail = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                const auto head = interpolate_pos(br, pos_br,  tr, pos_tr);
-                                *n_ptr = std::make_pair( node(o_b, o_r, tail, head), empty_node);
-                            }else if(  TL &&  TR && !BL && !BR ){// case 3
-                                const auto tail = interpolate_pos(tl, pos_tl,  bl, pos_bl);
-                                const auto head = interpolate_pos(tr, pos_tr,  br, pos_br);
-                                *n_ptr = std::make_pair( node(o_l, o_r, tail, head), empty_node);
-                            }else if(  TL && !TR &&  BL &&  BR ){// case 4
-                                const auto tail = interpolate_pos(tr, pos_tr,  br, pos_br);
-                                const auto head = interpolate_pos(tl, pos_tl,  tr, pos_tr);
-                                *n_ptr = std::make_pair( node(o_r, o_t, tail, head), empty_node);
-                            }else if(  TL && !TR && !BL &&  BR ){// case 5
-                                // Ambiguous saddle-point case. Sample the centre of the voxel to disambiguate.
-                                const auto centre = (tl * 0.25 + tr * 0.25 + br * 0.25 + bl * 0.25);
-                                const auto C = pixel_oracle(centre);
-                                if(C == TL){
-                                    const auto tail1 = interpolate_pos(tl, pos_tl,  bl, pos_bl);
-                                    const auto head1 = interpolate_pos(bl, pos_bl,  br, pos_br);
-
-                                    const auto tail2 = interpolate_pos(br, pos_br,  tr, pos_tr);
-                                    const auto head2 = interpolate_pos(tl, pos_tl,  tr, pos_tr);
-                                    *n_ptr = std::make_pair( node(o_l, o_b, tail1, head1),
-                                                             node(o_r, o_t, tail2, head2));
-                                }else{
-                                    const auto tail1 = interpolate_pos(bl, pos_bl,  tl, pos_tl);
-                                    const auto head1 = interpolate_pos(tl, pos_tl,  tr, pos_tr);
-
-                                    const auto tail2 = interpolate_pos(tr, pos_tr,  br, pos_br);
-                                    const auto head2 = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                    *n_ptr = std::make_pair( node(o_l, o_t, tail1, head1),
-                                                             node(o_r, o_b, tail2, head2));
-                                }
-                            }else if(  TL && !TR &&  BL && !BR ){// case 6
-                                const auto tail = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                const auto head = interpolate_pos(tl, pos_tl,  tr, pos_tr);
-                                *n_ptr = std::make_pair( node(o_b, o_t, tail, head), empty_node);
-                            }else if(  TL && !TR && !BL && !BR ){// case 7
-                                const auto tail = interpolate_pos(tl, pos_tl,  bl, pos_bl);
-                                const auto head = interpolate_pos(tl, pos_tl,  tr, pos_tr);
-                                *n_ptr = std::make_pair( node(o_l, o_t, tail, head), empty_node);
-                            }else if( !TL &&  TR &&  BL &&  BR ){// case 8
-                                const auto tail = interpolate_pos(tl, pos_tl,  tr, pos_tr);
-                                const auto head = interpolate_pos(tl, pos_tl,  bl, pos_bl);
-                                *n_ptr = std::make_pair( node(o_t, o_l, tail, head), empty_node);
-                            }else if( !TL &&  TR && !BL &&  BR ){// case 9
-                                const auto tail = interpolate_pos(tl, pos_tl,  tr, pos_tr);
-                                const auto head = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                *n_ptr = std::make_pair( node(o_t, o_b, tail, head), empty_node);
-                            }else if( !TL &&  TR &&  BL && !BR ){// case 10
-                                // Ambiguous saddle-point case. Sample the centre of the voxel to disambiguate.
-                                const auto centre = (tl * 0.25 + tr * 0.25 + br * 0.25 + bl * 0.25);
-                                const auto C = pixel_oracle(centre);
-                                if(C == TL){
-                                    const auto tail1 = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                    const auto head1 = interpolate_pos(bl, pos_bl,  tl, pos_tl);
-
-                                    const auto tail2 = interpolate_pos(tr, pos_tr,  tl, pos_tl);
-                                    const auto head2 = interpolate_pos(tr, pos_tr,  br, pos_br);
-                                    *n_ptr = std::make_pair( node(o_b, o_l, tail1, head1),
-                                                             node(o_t, o_r, tail2, head2));
-                                }else{
-                                    const auto tail1 = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                    const auto head1 = interpolate_pos(br, pos_br,  tr, pos_tr);
-
-                                    const auto tail2 = interpolate_pos(tr, pos_tr,  tl, pos_tl);
-                                    const auto head2 = interpolate_pos(tl, pos_tl,  bl, pos_bl);
-                                    *n_ptr = std::make_pair( node(o_b, o_r, tail1, head1),
-                                                             node(o_t, o_l, tail2, head2));
-                                }
-                            }else if( !TL &&  TR && !BL && !BR ){// case 11
-                                const auto tail = interpolate_pos(tr, pos_tr,  tl, pos_tl);
-                                const auto head = interpolate_pos(tr, pos_tr,  br, pos_br);
-                                *n_ptr = std::make_pair( node(o_t, o_r, tail, head), empty_node);
-                            }else if( !TL && !TR &&  BL &&  BR ){// case 12
-                                const auto tail = interpolate_pos(br, pos_br,  tr, pos_tr);
-                                const auto head = interpolate_pos(bl, pos_bl,  tl, pos_tl);
-                                *n_ptr = std::make_pair( node(o_r, o_l, tail, head), empty_node);
-                            }else if( !TL && !TR && !BL &&  BR ){// case 13
-                                const auto tail = interpolate_pos(br, pos_br,  tr, pos_tr);
-                                const auto head = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                *n_ptr = std::make_pair( node(o_r, o_b, tail, head), empty_node);
-                            }else if( !TL && !TR &&  BL && !BR ){// case 14
-                                const auto tail = interpolate_pos(bl, pos_bl,  br, pos_br);
-                                const auto head = interpolate_pos(tl, pos_tl,  bl, pos_bl);
-                                *n_ptr = std::make_pair( node(o_b, o_l, tail, head), empty_node);
-                            }else if( !TL && !TR && !BL && !BR ){// case 15 
-                                // No crossing. Do nothing.
-                            }
-                        }
-                    }
-
-                    //Walk all available half-edges forming contour perimeters.
-                    std::list<contour_of_points<double>> copl;
-                    for(long int r = 0; r < (R+1); ++r){
-                        for(long int c = 0; c < (C+1); ++c){
-                            const auto i = index(r, c);
-                            for(auto n1_ptr : { &(nodes.at(i).first), &(nodes.at(i).second) }){
-                            
-                                // Search for a valid contour edge.
-                                if( (n1_ptr->head_vert_pos == 0)
-                                ||  (n1_ptr->tail_vert_pos == 0) ){
-                                    continue;
-                                }
-                                long int curr_r = r;
-                                long int curr_c = c;
-
-                                // Determine which node to look for next.
-                                const auto find_next_node = [&](const node& n_curr){
-                                    node* n_next_ptr = nullptr;
-                                    
-                                    const auto n_curr_head_vert_pos = n_curr.head_vert_pos;
-                                    if(n_curr_head_vert_pos != 0){
-
-                                        uint8_t n_next_tail_vert_pos = 0;
-                                        auto n_next_r = curr_r;
-                                        auto n_next_c = curr_c;
-                                        if(false){
-                                        }else if(n_curr_head_vert_pos == o_t){
-                                            n_next_r -= 1;
-                                            n_next_tail_vert_pos = o_b;
-                                        }else if(n_curr_head_vert_pos == o_b){
-                                            n_next_r += 1;
-                                            n_next_tail_vert_pos = o_t;
-                                        }else if(n_curr_head_vert_pos == o_l){
-                                            n_next_c -= 1;
-                                            n_next_tail_vert_pos = o_r;
-                                        }else if(n_curr_head_vert_pos == o_r){
-                                            n_next_c += 1;
-                                            n_next_tail_vert_pos = o_l;
-                                        }else{
-                                            throw std::runtime_error("Invalid tail vert position encountered");
-                                        }
-
-                                        const auto n_next_i = index(n_next_r, n_next_c);
-                                        const bool i_valid = isininc(0,n_next_r,R) && isininc(0,n_next_c,C);
-                                        if( i_valid 
-                                        &&  (nodes.at(n_next_i).first.tail_vert_pos == n_next_tail_vert_pos) ){
-                                            curr_r = n_next_r;
-                                            curr_c = n_next_c;
-                                            n_next_ptr = &(nodes.at(n_next_i).first);
-                                        }
-                                        if( i_valid
-                                        &&  (nodes.at(n_next_i).second.tail_vert_pos == n_next_tail_vert_pos) ){
-                                            curr_r = n_next_r;
-                                            curr_c = n_next_c;
-                                            n_next_ptr = &(nodes.at(n_next_i).second);
-                                        }
-                                    }
-                                    return n_next_ptr;
-                                };
-
-                                const auto find_prev_node = [&](const node& n_curr){
-                                    node* n_prev_ptr = nullptr;
-                                    
-                                    const auto n_curr_tail_vert_pos = n_curr.tail_vert_pos;
-                                    if(n_curr_tail_vert_pos != 0){
-
-                                        uint8_t n_prev_head_vert_pos = 0;
-                                        auto n_prev_r = curr_r;
-                                        auto n_prev_c = curr_c;
-                                        if(false){
-                                        }else if(n_curr_tail_vert_pos == o_t){
-                                            n_prev_r -= 1;
-                                            n_prev_head_vert_pos = o_b;
-                                        }else if(n_curr_tail_vert_pos == o_b){
-                                            n_prev_r += 1;
-                                            n_prev_head_vert_pos = o_t;
-                                        }else if(n_curr_tail_vert_pos == o_l){
-                                            n_prev_c -= 1;
-                                            n_prev_head_vert_pos = o_r;
-                                        }else if(n_curr_tail_vert_pos == o_r){
-                                            n_prev_c += 1;
-                                            n_prev_head_vert_pos = o_l;
-                                        }else{
-                                            throw std::runtime_error("Invalid head vert position encountered");
-                                        }
-
-                                        const auto n_prev_i = index(n_prev_r, n_prev_c);
-                                        const bool i_valid = isininc(0,n_prev_r,R) && isininc(0,n_prev_c,C);
-                                        if( i_valid
-                                        && (nodes.at(n_prev_i).first.head_vert_pos == n_prev_head_vert_pos) ){
-                                            curr_r = n_prev_r;
-                                            curr_c = n_prev_c;
-                                            n_prev_ptr = &(nodes.at(n_prev_i).first);
-                                        }
-                                        if( i_valid
-                                        &&  (nodes.at(n_prev_i).second.head_vert_pos == n_prev_head_vert_pos) ){
-                                            curr_r = n_prev_r;
-                                            curr_c = n_prev_c;
-                                            n_prev_ptr = &(nodes.at(n_prev_i).second);
-                                        }
-                                    }
-                                    return n_prev_ptr;
-                                };
-
-
-                                // If a valid contour edge was found, start following along the contour.
-                                copl.emplace_back();
-                                copl.back().closed = true;
-                                copl.back().metadata = cm;
-                                copl.back().metadata["ROIName"] = ROILabel;
-                                copl.back().metadata["NormalizedROIName"] = NormalizedROILabel;
-                                copl.back().metadata["Description"] = "Contoured via threshold ("_s + std::to_string(Lower)
-                                                                     + " <= pixel_val <= " + std::to_string(Upper) + ")";
-                                copl.back().metadata["ROINumber"] = std::to_string(10000); // TODO: find highest existing and ++ it.
-                                copl.back().metadata["MinimumSeparation"] = std::to_string(MinimumSeparation);
-
-                                copl.back().points.push_back( n1_ptr->tail );
-
-                                const auto n1_tail_vert_pos = n1_ptr->tail_vert_pos;
-                                const auto n1_head_vert_pos = n1_ptr->head_vert_pos;
-                                node* n_curr_ptr = n1_ptr;
-                                do{
-                                    auto n_next_ptr = find_next_node(*n_curr_ptr);
-                                    //*n_curr_ptr = empty_node;
-                                    n_curr_ptr->tail_vert_pos = 0;
-                                    n_curr_ptr->head_vert_pos = 0;
-
-                                    if(n_next_ptr == nullptr) break; // End of the contour, or image boundary.
-                                    copl.back().points.push_front( n_next_ptr->tail );
-                                    n_curr_ptr = n_next_ptr;
-                                }while(true);
-
-                                // Jump back to the original contour edge, reset it, and walk backwards.
-                                n1_ptr->tail_vert_pos = n1_tail_vert_pos;
-                                n1_ptr->head_vert_pos = n1_head_vert_pos;
-                                curr_r = r;
-                                curr_c = c;
-                                n_curr_ptr = n1_ptr;
-                                do{
-                                    auto n_prev_ptr = find_prev_node(*n_curr_ptr);
-                                    //*n_curr_ptr = empty_node;
-                                    n_curr_ptr->tail_vert_pos = 0;
-                                    n_curr_ptr->head_vert_pos = 0;
-
-                                    if(n_prev_ptr == nullptr) break; // End of the contour, or image boundary.
-                                    copl.back().points.push_back( n_prev_ptr->head );
-                                    n_curr_ptr = n_prev_ptr;
-                                }while(true);
-
-                                // Nullify the original contour edge so it cannot be used again.
-                                n1_ptr->tail_vert_pos = 0;
-                                n1_ptr->head_vert_pos = 0;
-                            }
-                        }
-                    }
-
-                    //Save the contours and print some information to screen.
-                    {
-                        std::lock_guard<std::mutex> lock(saver_printer);
-                        DICOM_data.contour_data->ccs.back().contours.splice(DICOM_data.contour_data->ccs.back().contours.end(), copl);
-
-                        ++completed;
-                        YLOGINFO("Completed " << completed << " of " << img_count
-                              << " --> " << static_cast<int>(1000.0*(completed)/img_count)/10.0 << "% done");
-                    }
 #ifdef DCMA_USE_CGAL
                 // ---------------------------------------------------
                 // The marching cubes method.
@@ -947,6 +590,7 @@ bool ContourViaThreshold(Drover &DICOM_data,
 
             }); // thread pool task closure.
         }
+        tp.wait();
     }
 
     return true;
@@ -57,6 +57,9 @@ OperationDoc OpArgDocContourWholeImages(){
     out.args.back().name = "ImageSelection";
     out.args.back().default_val = "last";
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
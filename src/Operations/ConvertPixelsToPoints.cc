@@ -132,7 +132,7 @@ bool ConvertPixelsToPoints(Drover &DICOM_data,
     auto IAs_all = All_IAs( DICOM_data );
     auto IAs = Whitelist( IAs_all, ImageSelectionStr );
     for(auto & iap_it : IAs){
-        asio_thread_pool tp;
+        task_group tp;
         std::mutex saver_printer; // Who gets to save generated contours, print to the console, and iterate the counter.
         long int completed = 0;
         const long int img_count = (*iap_it)->imagecoll.images.size();
@@ -201,6 +201,7 @@ bool ConvertPixelsToPoints(Drover &DICOM_data,
                 }
             }); // Thread pool task.
         } // Loop over images.
+        tp.wait();
     } // Loop over image arrays.
 
 
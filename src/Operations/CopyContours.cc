@@ -41,6 +41,9 @@ OperationDoc OpArgDocCopyContours(){
     out.args.back().expected = true;
     out.args.back().examples = { "unspecified", "copy", "duplicate", "bone", "roi_xyz" };
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
@@ -26,6 +26,8 @@ OperationDoc OpArgDocCopyImages(){
     out.args.back().name = "ImageSelection";
     out.args.back().default_val = "last";
     
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
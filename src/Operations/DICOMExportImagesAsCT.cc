@@ -66,6 +66,21 @@ OperationDoc OpArgDocDICOMExportImagesAsCT(){
     out.args.back().examples = { "low", "medium", "high" };
     out.args.back().samples = OpArgSamples::Exhaustive;
 
+    out.args.emplace_back();
+    out.args.back().name = "TransferSyntax";
+    out.args.back().desc = "The DICOM transfer syntax used to encode each file."
+                           " 'Explicit' and 'implicit' refer to uncompressed little-endian encodings."
+                           " 'Deflated' compresses the whole data set using the deflated explicit little-endian"
+                           " transfer syntax, which most effectively reduces file size."
+                           " 'RLE' losslessly compresses only the pixel data, and is more widely supported than"
+                           " 'deflated'. Note that RLE is only applied to single-channel images; multi-channel images"
+                           " are written using the explicit encoding."
+                           " Files are serialized concurrently regardless of the transfer syntax.";
+    out.args.back().default_val = "explicit";
+    out.args.back().expected = true;
+    out.args.back().examples = { "explicit", "implicit", "deflated", "RLE" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
     return out;
 }
 
@@ -78,6 +93,7 @@ bool DICOMExportImagesAsCT(Drover &DICOM_data,
     const auto ImageSelectionStr = OptArgs.getValueStr("ImageSelection").value();
     const auto FilenameOut = OptArgs.getValueStr("Filename").value();    
     const auto ParanoiaStr = OptArgs.getValueStr("ParanoiaLevel").value();
+    const auto TransferSyntaxStr = OptArgs.getValueStr("TransferSyntax").value();
 
     //-----------------------------------------------------------------------------------------------------------------
     const auto LowRegex  = Compile_Regex("^lo?w?$");
@@ -95,6 +111,24 @@ bool DICOMExportImagesAsCT(Drover &DICOM_data,
         throw std::runtime_error("Specified paranoia level is not valid. Cannot continue.");
     }
 
+    const auto ExplicitRegex = Compile_Regex("^ex?p?l?i?c?i?t?$");
+    const auto ImplicitRegex = Compile_Regex("^im?p?l?i?c?i?t?$");
+    const auto DeflatedRegex = Compile_Regex("^de?f?l?a?t?e?d?$");
+    const auto RLERegex      = Compile_Regex("^rl?e?$");
+
+    DICOM_Export_Opts opts;
+    if(std::regex_match(TransferSyntaxStr, ExplicitRegex)){
+        opts.transfer_syntax = DICOM_Transfer_Syntax::ExplicitLE;
+    }else if(std::regex_match(TransferSyntaxStr, ImplicitRegex)){
+        opts.transfer_syntax = DICOM_Transfer_Syntax::ImplicitLE;
+    }else if(std::regex_match(TransferSyntaxStr, DeflatedRegex)){
+        opts.transfer_syntax = DICOM_Transfer_Syntax::DeflatedExplicitLE;
+    }else if(std::regex_match(TransferSyntaxStr, RLERegex)){
+        opts.transfer_syntax = DICOM_Transfer_Syntax::RLELossless;
+    }else{
+        throw std::invalid_argument("Specified transfer syntax is not valid. Cannot continue.");
+    }
+
     auto make_sequential_filename = [=]() -> std::string {
         const auto pad_left_zeros = [](std::string in, long int desired_length) -> std::string {
             while(static_cast<long int>(in.length()) < desired_length) in = "0"_s + in;
@@ -142,7 +176,7 @@ bool DICOMExportImagesAsCT(Drover &DICOM_data,
             };
 
             try{
-                Write_CT_Images(*iap_it, file_handler, p);
+                Write_CT_Images(*iap_it, file_handler, p, opts);
             }catch(const std::exception &e){
                 YLOGWARN("Unable to export Image_Array as DICOM CT-modality files: '" << e.what() << "'");
             }
@@ -1,15 +1,21 @@
 //DecomposeImagesSVD.cc - A part of DICOMautomaton 2022. Written by hal clark.
 
+#include <algorithm>
 #include <any>
+#include <cmath>
+#include <cstdint>
 #include <optional>
 #include <functional>
 #include <iterator>
 #include <list>
 #include <map>
 #include <memory>
+#include <random>
 #include <regex>
+#include <set>
 #include <stdexcept>
 #include <string>    
+#include <vector>
 
 #include "YgorImages.h"
 #include "YgorMath.h"         //Needed for vec3 class.
@@ -28,6 +34,7 @@
 
 #include "../Structs.h"
 #include "../Regex_Selectors.h"
+#include "../Thread_Pool.h"
 #include "../YgorImages_Functors/Grouping/Misc_Functors.h"
 #include "../YgorImages_Functors/Processing/Partitioned_Image_Voxel_Visitor_Mutator.h"
 
@@ -52,6 +59,17 @@ OperationDoc OpArgDocDecomposeImagesSVD(){
         "Spatial information is disregarded for all images, and the basis images have default geometry."
     );
 
+    out.notes.emplace_back(
+        "The 'exact' method holds all selected voxels in memory in double precision, which is not feasible for large"
+        " image series. The 'randomized' method instead estimates the leading components using randomized subspace"
+        " iteration on the Gram matrix of the images. Images are streamed in blocks of voxels, so the only"
+        " voxel-sized storage needed is for the basis images themselves."
+    );
+    out.notes.emplace_back(
+        "The 'randomized' method operates on the Gram matrix, which squares the singular values. Components with"
+        " singular values that are small relative to the largest singular value will be estimated less accurately."
+    );
+
     out.args.emplace_back();
     out.args.back() = IAWhitelistOpArgDoc();
     out.args.back().name = "ImageSelection";
@@ -64,6 +82,50 @@ OperationDoc OpArgDocDecomposeImagesSVD(){
     out.args.back().expected = true;
     out.args.back().examples = { "-1", "0", "1", "2" };
 
+    out.args.emplace_back();
+    out.args.back().name = "Method";
+    out.args.back().desc = "The method used to perform the decomposition."
+                           " The 'exact' method computes the full (thin) SVD of the voxel matrix."
+                           " The 'randomized' method estimates only the leading 'Rank' components, streaming voxels"
+                           " in blocks using multiple threads and single precision arithmetic. It is suited to"
+                           " large datasets, e.g., 4D dynamic series with many voxels.";
+    out.args.back().default_val = "exact";
+    out.args.back().expected = true;
+    out.args.back().examples = { "exact", "randomized" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
+    out.args.emplace_back();
+    out.args.back().name = "Rank";
+    out.args.back().desc = "The number of leading components (i.e., basis images) to retain."
+                           " Zero or a negative number retains all components.";
+    out.args.back().default_val = "-1";
+    out.args.back().expected = true;
+    out.args.back().examples = { "-1", "1", "5", "20" };
+
+    out.args.emplace_back();
+    out.args.back().name = "Oversampling";
+    out.args.back().desc = "The number of additional components estimated by the 'randomized' method, which improves"
+                           " the accuracy of the retained components. Ignored for the 'exact' method.";
+    out.args.back().default_val = "10";
+    out.args.back().expected = true;
+    out.args.back().examples = { "0", "5", "10", "20" };
+
+    out.args.emplace_back();
+    out.args.back().name = "PowerIterations";
+    out.args.back().desc = "The number of subspace (power) iterations performed by the 'randomized' method."
+                           " Each iteration requires another pass over the images, but improves the accuracy"
+                           " when singular values decay slowly. Ignored for the 'exact' method.";
+    out.args.back().default_val = "2";
+    out.args.back().expected = true;
+    out.args.back().examples = { "0", "1", "2", "4" };
+
+    out.args.emplace_back();
+    out.args.back().name = "RandomSeed";
+    out.args.back().desc = "A parameter for the random number generator used by the 'randomized' method.";
+    out.args.back().default_val = "1317";
+    out.args.back().expected = true;
+    out.args.back().examples = { "1", "1317", "20213" };
+
     return out;
 }
 
@@ -77,8 +139,27 @@ bool DecomposeImagesSVD(Drover &DICOM_data,
     //---------------------------------------------- User Parameters --------------------------------------------------
     const auto ImageSelectionStr = OptArgs.getValueStr("ImageSelection").value();
     const auto Channel = std::stol( OptArgs.getValueStr("Channel").value() );
+    const auto MethodStr = OptArgs.getValueStr("Method").value();
+    const auto Rank = std::stol( OptArgs.getValueStr("Rank").value() );
+    const auto Oversampling = std::stol( OptArgs.getValueStr("Oversampling").value() );
+    const auto PowerIterations = std::stol( OptArgs.getValueStr("PowerIterations").value() );
+    const auto RandomSeed = std::stol( OptArgs.getValueStr("RandomSeed").value() );
 
     //-----------------------------------------------------------------------------------------------------------------
+    const auto regex_exact = Compile_Regex("^ex?a?c?t?$");
+    const auto regex_random = Compile_Regex("^ra?n?d?o?m?i?z?e?d?$");
+
+    const bool use_exact = std::regex_match(MethodStr, regex_exact);
+    const bool use_random = std::regex_match(MethodStr, regex_random);
+    if(!use_exact && !use_random){
+        throw std::invalid_argument("Method argument '"_s + MethodStr + "' is not valid");
+    }
+    if(Oversampling < 0){
+        throw std::invalid_argument("Oversampling must be non-negative");
+    }
+    if(PowerIterations < 0){
+        throw std::invalid_argument("Number of power iterations must be non-negative");
+    }
 
     long int rows = -1L;
     long int cols = -1L;
@@ -121,10 +202,158 @@ bool DecomposeImagesSVD(Drover &DICOM_data,
         Channels.insert(Channel);
     }
 
-    // Compute the average for every voxel.
+    // Create a new image array with the basis images.
+    auto out = std::make_unique<Image_Array>();
+    const vec3<double> ImageOrientationRow(0.0, 1.0, 0.0);
+    const vec3<double> ImageOrientationColumn(1.0, 0.0, 0.0);
+    const vec3<double> ImageAnchor(0.0, 0.0, 0.0);
+    const vec3<double> ImagePosition(0.0, 0.0, 0.0);
+    const long int NumberOfRows = rows;
+    const long int NumberOfColumns = cols;
+    const long int NumberOfChannels = Channels.size();
+    const double VoxelWidth = 1.0;
+    const double VoxelHeight = 1.0;
+    const double SliceThickness = 1.0;
+    const auto add_basis_image = [&](double singular_value) -> planar_image<float, double> * {
+        out->imagecoll.images.emplace_back();
+        auto *img = &(out->imagecoll.images.back());
+
+        // Note: no 'standard' image metadata is assigned here.
+        // Not sure if it's needed, especially since the output is a
+        // basis, which should be applicable to other coordinate systems, etc.
+        img->metadata["SingularValue"] = std::to_string( singular_value );
+        YLOGINFO("Basis image " << (out->imagecoll.images.size() - 1) << " has singular value " << singular_value);
+
+        img->init_orientation(ImageOrientationRow, ImageOrientationColumn);
+        img->init_buffer(NumberOfRows, NumberOfColumns, NumberOfChannels);
+        img->init_spatial(VoxelWidth, VoxelHeight, SliceThickness, ImageAnchor, ImagePosition);
+        return img;
+    };
+
     const long int N_cols = imgs;
     const long int N_rows = rows * cols * Channels.size();
 
+    if(use_random){
+        // The voxel matrix X has one row per (selected) voxel and one column per image. X is never materialized.
+        // Instead, the dominant subspace of the (small) Gram matrix G = X^T X is estimated using randomized subspace
+        // iteration, where products with G are accumulated by streaming blocks of voxels.
+        std::vector<const planar_image<float, double> *> img_ptrs;
+        for(const auto & iap_it : IAs){
+            for(const auto & img : (*iap_it)->imagecoll.images){
+                img_ptrs.push_back( &img );
+            }
+        }
+        const std::vector<long int> chans(std::begin(Channels), std::end(Channels));
+        const auto N_chans = static_cast<long int>(chans.size());
+        const auto voxel_index = [&](long int n) -> long int {
+            return (n / N_chans) * chns + chans[n % N_chans];
+        };
+
+        const long int N_block = std::max<long int>(64L, (1L << 20) / N_cols);
+        const long int N_blocks = (N_rows + N_block - 1L) / N_block;
+
+        std::vector<float> avg(N_rows, 0.0f);
+        parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(N_blocks), [&](int64_t i){
+            const long int b = i * N_block;
+            const long int e = std::min(N_rows, b + N_block);
+            std::vector<double> sums(e - b, 0.0);
+            for(const auto &img_ptr : img_ptrs){
+                for(long int n = b; n < e; ++n) sums[n - b] += img_ptr->value( voxel_index(n) );
+            }
+            for(long int n = b; n < e; ++n) avg[n] = static_cast<float>( sums[n - b] / static_cast<double>(N_cols) );
+        });
+
+        const auto fill_block = [&](long int i, Eigen::MatrixXf &X_b){
+            const long int b = i * N_block;
+            const long int e = std::min(N_rows, b + N_block);
+            X_b.resize(e - b, N_cols);
+            for(long int j = 0L; j < N_cols; ++j){
+                const auto &img = *(img_ptrs[j]);
+                for(long int n = b; n < e; ++n) X_b(n - b, j) = img.value( voxel_index(n) ) - avg[n];
+            }
+        };
+
+        // Computes G * Q.
+        const auto apply_gram = [&](const Eigen::MatrixXd &Q) -> Eigen::MatrixXd {
+            const Eigen::MatrixXf Q_f = Q.cast<float>();
+            return parallel_reduce(static_cast<int64_t>(0), static_cast<int64_t>(N_blocks),
+                                   Eigen::MatrixXd::Zero(N_cols, Q.cols()).eval(),
+                [&](int64_t b, int64_t e, Eigen::MatrixXd acc) -> Eigen::MatrixXd {
+                    Eigen::MatrixXf X_b;
+                    for(int64_t i = b; i < e; ++i){
+                        fill_block(i, X_b);
+                        const Eigen::MatrixXf XQ_b = X_b * Q_f;
+                        acc += (X_b.transpose() * XQ_b).cast<double>();
+                    }
+                    return acc;
+                },
+                [](const Eigen::MatrixXd &A, const Eigen::MatrixXd &B) -> Eigen::MatrixXd {
+                    return A + B;
+                });
+        };
+
+        const auto orthonormalize = [](const Eigen::MatrixXd &A) -> Eigen::MatrixXd {
+            Eigen::HouseholderQR<Eigen::MatrixXd> qr(A);
+            return qr.householderQ() * Eigen::MatrixXd::Identity(A.rows(), A.cols());
+        };
+
+        const long int N_rank = (0L < Rank) ? std::min(Rank, N_cols) : N_cols;
+        const long int N_sketch = std::min(N_rank + Oversampling, N_cols);
+        YLOGINFO("Estimating " << N_rank << " leading components of " << N_rows << "x" << N_cols << " matrix using "
+                 << N_sketch << " random vectors and " << PowerIterations << " power iterations");
+
+        std::mt19937 re( RandomSeed );
+        std::normal_distribution<double> nd(0.0, 1.0);
+        Eigen::MatrixXd Q(N_cols, N_sketch);
+        for(long int c = 0L; c < N_sketch; ++c){
+            for(long int r = 0L; r < N_cols; ++r) Q(r, c) = nd(re);
+        }
+        Q = orthonormalize(Q);
+        for(long int i = 0L; i <= PowerIterations; ++i){
+            Q = orthonormalize( apply_gram(Q) );
+        }
+
+        // Rayleigh-Ritz projection. The eigenvalues of Q^T G Q are the squared singular values.
+        Eigen::MatrixXd H = Q.transpose() * apply_gram(Q);
+        H = (0.5 * (H + H.transpose())).eval();
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(H);
+        if(es.info() != Eigen::Success){
+            throw std::runtime_error("Unable to diagonalize projected Gram matrix");
+        }
+
+        // Right singular vectors, scaled so that U = X * V_s.
+        std::vector<double> S;
+        Eigen::MatrixXf V_s(N_cols, N_rank);
+        for(long int i = 0L; i < N_rank; ++i){
+            const auto idx = N_sketch - 1L - i; // Eigenvalues are sorted in increasing order.
+            const auto s = std::sqrt( std::max(0.0, es.eigenvalues()(idx)) );
+            if(!(0.0 < s)) break;
+            S.push_back(s);
+            V_s.col(i) = ((Q * es.eigenvectors().col(idx)) / s).cast<float>();
+        }
+        const auto N_basis = static_cast<long int>(S.size());
+        YLOGINFO("Estimated " << N_basis << " non-zero singular values");
+
+        std::vector<planar_image<float, double> *> basis;
+        for(const auto &s : S) basis.push_back( add_basis_image(s) );
+
+        parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(N_blocks), [&](int64_t i){
+            Eigen::MatrixXf X_b;
+            fill_block(i, X_b);
+            const Eigen::MatrixXf U_b = X_b * V_s.leftCols(N_basis);
+            const long int b = i * N_block;
+            for(long int j = 0L; j < N_basis; ++j){
+                for(long int n = 0L; n < U_b.rows(); ++n) basis[j]->reference(b + n) = U_b(n, j);
+            }
+        });
+
+        if(!out->imagecoll.images.empty()){
+            DICOM_data.image_data.emplace_back(std::move(out));
+        }
+        return true;
+    }
+
+    // Compute the average for every voxel.
     planar_image<float, double> avg;
     avg.init_buffer(rows, cols, chns);
     for(long int r = 0; r < rows; ++r){
@@ -194,32 +423,10 @@ bool DecomposeImagesSVD(Drover &DICOM_data,
     YLOGINFO("Decomposition vector S has length " << S.size());
 
     // Create a new image array with the basis images.
-    auto out = std::make_unique<Image_Array>();
-    const vec3<double> ImageOrientationRow(0.0, 1.0, 0.0);
-    const vec3<double> ImageOrientationColumn(1.0, 0.0, 0.0);
-    const vec3<double> ImageAnchor(0.0, 0.0, 0.0);
-    const vec3<double> ImagePosition(0.0, 0.0, 0.0);
-    const long int NumberOfRows = rows;
-    const long int NumberOfColumns = cols;
-    const long int NumberOfChannels = Channels.size();
-    const double VoxelWidth = 1.0;
-    const double VoxelHeight = 1.0;
-    const double SliceThickness = 1.0;
     {
-        const long int U_cols = U.cols();
+        const long int U_cols = (0L < Rank) ? std::min<long int>(Rank, U.cols()) : U.cols();
         for(long int i = 0L; i < U_cols; ++i){
-            out->imagecoll.images.emplace_back();
-            auto *img = &(out->imagecoll.images.back());
-
-            // Note: no 'standard' image metadata is assigned here.
-            // Not sure if it's needed, especially since the output is a
-            // basis, which should be applicable to other coordinate systems, etc.
-            img->metadata["SingularValue"] = std::to_string( S(i) );
-
-            img->init_orientation(ImageOrientationRow, ImageOrientationColumn);
-            img->init_buffer(NumberOfRows, NumberOfColumns, NumberOfChannels);
-            img->init_spatial(VoxelWidth, VoxelHeight, SliceThickness, ImageAnchor, ImagePosition);
-
+            auto *img = add_basis_image( S(i) );
             for(long int n = 0L; n < N_rows; ++n){
                 img->reference(n) = U(n, i);
             }
@@ -0,0 +1,88 @@
+//DeferImagePixels.cc - A part of DICOMautomaton 2024. Written by hal clark.
+
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>    
+
+#include "YgorFilesDirs.h"    //Needed for Get_Unique_Sequential_Filename(...).
+#include "YgorImages.h"
+#include "YgorMisc.h"         //Needed for FUNCINFO, FUNCWARN, FUNCERR macros.
+#include "YgorLog.h"
+
+#include "../Structs.h"
+#include "../Regex_Selectors.h"
+#include "../Deferred_Pixels.h"
+
+#include "DeferImagePixels.h"
+
+
+OperationDoc OpArgDocDeferImagePixels(){
+    OperationDoc out;
+    out.name = "DeferImagePixels";
+
+    out.desc = 
+        "This operation moves image pixel data out of memory and into a spill file on disk."
+        " Image metadata and geometry remain resident, so operations that only access metadata (e.g., sorting or"
+        " grouping images) can proceed without the pixel data."
+        " Pixel data are restored automatically, via memory-mapping the spill file, when an operation that may"
+        " access pixel data is invoked.";
+
+    out.notes.emplace_back(
+        "This operation can be used to reduce memory usage when working with large image sets, for example when"
+        " loading many 4D series and then selecting a small subset for further processing."
+    );
+    out.notes.emplace_back(
+        "Spill files are not removed automatically, and must remain accessible until the pixel data are restored."
+        " Pixel data is stored in the native binary representation, so spill files are not portable."
+    );
+
+    out.args.emplace_back();
+    out.args.back() = IAWhitelistOpArgDoc();
+    out.args.back().name = "ImageSelection";
+    out.args.back().default_val = "all";
+
+    out.args.emplace_back();
+    out.args.back().name = "SpillFileName";
+    out.args.back().desc = "The file in which pixel data will be stored."
+                           " If the file exists, it will be appended to."
+                           " If left empty, a unique file will be created in the system's temporary directory.";
+    out.args.back().default_val = "";
+    out.args.back().expected = true;
+    out.args.back().examples = { "", "/tmp/pixels.spill", "/scratch/spill.bin" };
+    out.args.back().mimetype = "application/octet-stream";
+
+    return out;
+}
+
+bool DeferImagePixels(Drover &DICOM_data,
+                      const OperationArgPkg& OptArgs,
+                      std::map<std::string, std::string>& /*InvocationMetadata*/,
+                      const std::string& /*FilenameLex*/){
+
+    //---------------------------------------------- User Parameters --------------------------------------------------
+    const auto ImageSelectionStr = OptArgs.getValueStr("ImageSelection").value();
+    auto SpillFileName = OptArgs.getValueStr("SpillFileName").value();
+
+    //-----------------------------------------------------------------------------------------------------------------
+    if(SpillFileName.empty()){
+        const auto base = std::filesystem::temp_directory_path() / "dcma_deferimagepixels_";
+        SpillFileName = Get_Unique_Sequential_Filename(base.string(), 6, ".spill");
+    }
+
+    std::list<std::reference_wrapper<planar_image<float,double>>> imgs;
+    auto IAs_all = All_IAs( DICOM_data );
+    auto IAs = Whitelist( IAs_all, ImageSelectionStr );
+    for(auto & iap_it : IAs){
+        for(auto &img : (*iap_it)->imagecoll.images){
+            imgs.emplace_back( std::ref(img) );
+        }
+    }
+
+    YLOGINFO("Spilling pixel data for " << imgs.size() << " images to '" << SpillFileName << "'");
+    Spill_Pixels(imgs, SpillFileName);
+
+    return true;
+}
@@ -41,6 +41,9 @@ OperationDoc OpArgDocDeleteContours(){
     out.args.back().name = "ROILabelRegex";
     out.args.back().default_val = ".*";
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
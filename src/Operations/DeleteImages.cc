@@ -27,6 +27,8 @@ OperationDoc OpArgDocDeleteImages(){
     out.args.back().name = "ImageSelection";
     out.args.back().default_val = "last";
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
@@ -26,6 +26,8 @@ OperationDoc OpArgDocDeleteLineSamples(){
     out.args.back().name = "LineSelection";
     out.args.back().default_val = "last";
     
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
@@ -28,6 +28,8 @@ OperationDoc OpArgDocDeleteMeshes(){
     out.args.back().name = "MeshSelection";
     out.args.back().default_val = "last";
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
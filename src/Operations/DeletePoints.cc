@@ -28,6 +28,8 @@ OperationDoc OpArgDocDeletePoints(){
     out.args.back().name = "PointSelection";
     out.args.back().default_val = "last";
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
@@ -27,6 +27,8 @@ OperationDoc OpArgDocDeleteTables(){
     out.args.back().name = "TableSelection";
     out.args.back().default_val = "last";
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
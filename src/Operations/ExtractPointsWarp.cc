@@ -2,6 +2,7 @@
 
 #include <asio.hpp>
 #include <algorithm>
+#include <cmath>
 #include <optional>
 #include <fstream>
 #include <iterator>
@@ -22,6 +23,7 @@
 
 #include "../Alignment_Rigid.h"
 #include "../Alignment_TPSRPM.h"
+#include "../Alignment_CPD.h"
 
 #include "Explicator.h"       //Needed for Explicator class.
 
@@ -87,7 +89,7 @@ OperationDoc OpArgDocExtractPointsWarp(){
     out.args.back().desc = "The alignment algorithm to use."
                            " The following alignment options are available: 'centroid'"
 #ifdef DCMA_USE_EIGEN
-                           ", 'PCA', 'exhaustive_icp', 'TPS', and 'TPS-RPM'"
+                           ", 'PCA', 'exhaustive_icp', 'TPS', 'TPS-RPM', 'CPD-rigid', 'CPD-affine', and 'CPD-nonrigid'"
 #endif
                            "."
                            " The 'centroid' option finds a rotationless translation the aligns the centroid"
@@ -163,12 +165,28 @@ OperationDoc OpArgDocExtractPointsWarp(){
                            " and Yang 2011 (clarification and more robust solution; doi:10.1016/j.patrec.2011.01.015)"
                            " for more details."
                            ""
+                           " The 'CPD' or Coherent Point Drift methods treat the moving points as the centroids of a"
+                           " Gaussian mixture model and fit it to the stationary points using expectation"
+                           " maximization, so correspondence is not required and the point clouds can differ in size."
+                           " A uniform distribution is included in the mixture to account for noise and outliers."
+                           " 'CPD-rigid' finds a rotation, translation, and (optionally) isotropic scaling,"
+                           " 'CPD-affine' finds a general Affine transformation, and 'CPD-nonrigid' finds a smooth"
+                           " (i.e., 'deformable') displacement field that is sampled onto a regular grid."
+                           " Sums over all pairs of points are evaluated without storing the correspondence matrix,"
+                           " either directly, over truncated neighbourhoods, or using the improved fast Gauss transform."
+                           " The non-rigid method uses a low-rank (Nystrom) approximation of the kernel matrix for"
+                           " large point clouds, and all methods can use a coarse-to-fine schedule of randomly"
+                           " subsampled point clouds, so the CPD methods are suitable for point clouds with"
+                           " hundreds of thousands of points."
+                           " Consult Myronenko and Song 2010 (doi:10.1109/TPAMI.2010.46) for more details."
+                           ""
 #endif
                            "";
     out.args.back().default_val = "centroid";
     out.args.back().expected = true;
 #ifdef DCMA_USE_EIGEN
-    out.args.back().examples = { "centroid", "pca", "exhaustive_icp", "tps", "tps_rpm" };
+    out.args.back().examples = { "centroid", "pca", "exhaustive_icp", "tps", "tps_rpm",
+                                 "cpd_rigid", "cpd_affine", "cpd_nonrigid" };
 #else
     out.args.back().examples = { "centroid" };
 #endif
@@ -392,6 +410,38 @@ OperationDoc OpArgDocExtractPointsWarp(){
     out.args.back().samples = OpArgSamples::Exhaustive;
 #endif
 
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "TPSRPMEngine";
+    out.args.back().desc = "The implementation used to evaluate the correspondence matrix and thin plate spline."
+                           " The 'dense' engine stores the full correspondence matrix and uses every moving point as a"
+                           " control point, so memory and time grow quadratically (or worse) with the number of points."
+                           " The 'scalable' engine stores only non-negligible correspondence coefficients (or"
+                           " approximates the sums with the improved fast Gauss transform when too many are"
+                           " non-negligible) and restricts the warp to a well-spread subset of control points."
+                           " The 'automatic' option selects the scalable engine for large point clouds (i.e., more"
+                           " than 2500 points) and the dense engine otherwise."
+                           " The scalable engine approximates the dense engine, so results will differ slightly."
+                           " Note that this parameter is used with the TPS-RPM method, but *not* in the TPS method.";
+    out.args.back().default_val = "dense";
+    out.args.back().expected = true;
+    out.args.back().examples = { "automatic", "dense", "scalable" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "TPSRPMMaxControlPoints";
+    out.args.back().desc = "The maximum number of control points used by the scalable engine. If there are more moving"
+                           " points than this, a subset is selected using farthest-point sampling. More control points"
+                           " permit more localized deformations, but the cost of solving for the transformation grows"
+                           " cubically with the number of control points."
+                           " Note that this parameter is used with the TPS-RPM method, but *not* in the TPS method.";
+    out.args.back().default_val = "1000";
+    out.args.back().expected = true;
+    out.args.back().examples = { "250", "1000", "2500" };
+#endif
+
 #ifdef DCMA_USE_EIGEN
     out.args.emplace_back();
     out.args.back().name = "TPSRPMHardConstraints";
@@ -449,6 +499,118 @@ OperationDoc OpArgDocExtractPointsWarp(){
     out.args.back().examples = { "true", "false" };
 #endif
 
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDOutlierWeight";
+    out.args.back().desc = "The weight of the uniform distribution used by the CPD methods to account for noise and"
+                           " outliers. Must be within [0:1). Larger values make the registration more robust to"
+                           " outliers, but can slow convergence."
+                           " Note that this parameter is only used with the CPD methods.";
+    out.args.back().default_val = "0.2";
+    out.args.back().expected = true;
+    out.args.back().examples = { "0.0", "0.1", "0.2", "0.5" };
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDPermitScaling";
+    out.args.back().desc = "Whether the CPD-rigid method can apply an isotropic scale factor."
+                           " Note that this parameter is only used with the CPD-rigid method.";
+    out.args.back().default_val = "true";
+    out.args.back().expected = true;
+    out.args.back().examples = { "true", "false" };
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDBeta";
+    out.args.back().desc = "The width of the Gaussian kernel used by the CPD-nonrigid method to regularize the"
+                           " displacement field. Larger values produce smoother, more global deformations."
+                           " This parameter is relative to the size (i.e., the RMS radius) of the point clouds."
+                           " Note that this parameter is only used with the CPD-nonrigid method.";
+    out.args.back().default_val = "2.0";
+    out.args.back().expected = true;
+    out.args.back().examples = { "0.5", "1.0", "2.0", "5.0" };
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDLambda";
+    out.args.back().desc = "The trade-off between goodness of fit and smoothness for the CPD-nonrigid method."
+                           " Larger values produce smoother deformations."
+                           " Note that this parameter is only used with the CPD-nonrigid method.";
+    out.args.back().default_val = "2.0";
+    out.args.back().expected = true;
+    out.args.back().examples = { "0.5", "2.0", "10.0" };
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDEngine";
+    out.args.back().desc = "The implementation used to evaluate sums over the Gaussian kernel between all pairs of"
+                           " moving and stationary points. The 'direct' engine evaluates every pair, the 'truncated'"
+                           " engine only evaluates pairs that are close enough to contribute, and the 'fast_gauss'"
+                           " engine approximates the sums using the improved fast Gauss transform."
+                           " The 'automatic' option selects an engine every iteration based on the number of points"
+                           " and the current width of the mixture components."
+                           " Note that this parameter is only used with the CPD methods.";
+    out.args.back().default_val = "automatic";
+    out.args.back().expected = true;
+    out.args.back().examples = { "automatic", "direct", "truncated", "fast_gauss" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDSolver";
+    out.args.back().desc = "The method used by the CPD-nonrigid method to solve for the displacement field."
+                           " The 'exact' solver factors a dense system with one row per moving point, so it is only"
+                           " practical for a few thousand points. The 'low_rank' solver approximates the kernel matrix"
+                           " using a subset of the moving points as landmarks."
+                           " The 'automatic' option selects the low-rank solver for large point clouds."
+                           " Note that this parameter is only used with the CPD-nonrigid method.";
+    out.args.back().default_val = "automatic";
+    out.args.back().expected = true;
+    out.args.back().examples = { "automatic", "exact", "low_rank" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDLowRank";
+    out.args.back().desc = "The number of landmarks used by the low-rank solver. More landmarks permit more localized"
+                           " deformations, but the cost grows quadratically with the number of landmarks."
+                           " Note that this parameter is only used with the CPD-nonrigid method.";
+    out.args.back().default_val = "250";
+    out.args.back().expected = true;
+    out.args.back().examples = { "100", "250", "1000" };
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDCoarseToFine";
+    out.args.back().desc = "Whether the CPD methods first register randomly subsampled point clouds, progressively"
+                           " using more points until the full point clouds are used. This significantly reduces"
+                           " runtime for large point clouds."
+                           " Note that this parameter is only used with the CPD methods.";
+    out.args.back().default_val = "true";
+    out.args.back().expected = true;
+    out.args.back().examples = { "true", "false" };
+#endif
+
+#ifdef DCMA_USE_EIGEN
+    out.args.emplace_back();
+    out.args.back().name = "CPDFieldVoxelSize";
+    out.args.back().desc = "The CPD-nonrigid method samples the displacement field onto a regular grid covering the"
+                           " moving point cloud. This parameter controls the (DICOM units, i.e., mm) spacing of grid"
+                           " voxels. If non-positive, the spacing is selected so the grid has 64 voxels along the"
+                           " largest dimension."
+                           " Note that this parameter is only used with the CPD-nonrigid method.";
+    out.args.back().default_val = "-1.0";
+    out.args.back().expected = true;
+    out.args.back().examples = { "-1.0", "1.0", "2.5", "5.0" };
+#endif
+
     out.args.emplace_back();
     out.args.back().name = "MaxIterations";
     out.args.back().desc = "If the method is iterative, only permit this many iterations to occur."
@@ -505,6 +667,8 @@ bool ExtractPointsWarp(Drover &DICOM_data,
     const auto TPSRPMDoubleSidedOutliersStr = OptArgs.getValueStr("TPSRPMDoubleSidedOutliers").value();
     const auto TPSRPMKDim = std::stol( OptArgs.getValueStr("TPSRPMKernelDimension").value() );
     const auto TPSRPMSolverStr = OptArgs.getValueStr("TPSRPMSolver").value();
+    const auto TPSRPMEngineStr = OptArgs.getValueStr("TPSRPMEngine").value();
+    const auto TPSRPMMaxControlPoints = std::stol( OptArgs.getValueStr("TPSRPMMaxControlPoints").value() );
     const auto TPSRPMTStart = std::stod( OptArgs.getValueStr("TPSRPMTStart").value() );
     const auto TPSRPMTEnd = std::stod( OptArgs.getValueStr("TPSRPMTEnd").value() );
     const auto TPSRPMTStep = std::stod( OptArgs.getValueStr("TPSRPMTStep").value() );
@@ -515,6 +679,17 @@ bool ExtractPointsWarp(Drover &DICOM_data,
     const auto TPSRPMHardContraintsStr = OptArgs.getValueStr("TPSRPMHardConstraints").value();
     const auto TPSRPMPermitMovingOutliersStr = OptArgs.getValueStr("TPSRPMPermitMovingOutliers").value();
     const auto TPSRPMPermitStationaryOutliersStr = OptArgs.getValueStr("TPSRPMPermitStationaryOutliers").value();
+
+    // CPD params.
+    const auto CPDOutlierWeight = std::stod( OptArgs.getValueStr("CPDOutlierWeight").value() );
+    const auto CPDPermitScalingStr = OptArgs.getValueStr("CPDPermitScaling").value();
+    const auto CPDBeta = std::stod( OptArgs.getValueStr("CPDBeta").value() );
+    const auto CPDLambda = std::stod( OptArgs.getValueStr("CPDLambda").value() );
+    const auto CPDEngineStr = OptArgs.getValueStr("CPDEngine").value();
+    const auto CPDSolverStr = OptArgs.getValueStr("CPDSolver").value();
+    const auto CPDLowRank = std::stol( OptArgs.getValueStr("CPDLowRank").value() );
+    const auto CPDCoarseToFineStr = OptArgs.getValueStr("CPDCoarseToFine").value();
+    const auto CPDFieldVoxelSize = std::stod( OptArgs.getValueStr("CPDFieldVoxelSize").value() );
 #endif // DCMA_USE_EIGEN
 
     const auto MaxIters = std::stol( OptArgs.getValueStr("MaxIterations").value() );
@@ -528,14 +703,28 @@ bool ExtractPointsWarp(Drover &DICOM_data,
     const auto regex_exhicp = Compile_Regex("^ex?h?a?u?s?t?i?v?e?[-_]?i?c?p?$");
     const auto regex_tps    = Compile_Regex("^tp?s?$");
     const auto regex_tpsrpm = Compile_Regex("^tp?s?[-_]?rp?m?$");
+    const auto regex_cpd_rigid    = Compile_Regex("^cp?d?[-_]?ri?g?i?d?$");
+    const auto regex_cpd_affine   = Compile_Regex("^cp?d?[-_]?af?f?i?n?e?$");
+    const auto regex_cpd_nonrigid = Compile_Regex("^cp?d?[-_]?no?n?[-_]?r?i?g?i?d?$");
 
     const auto regex_ldlt = Compile_Regex("^LD?L?T?$");
     const auto regex_pinv = Compile_Regex("^ps?e?u?d?o?[-_]?i?n?v?e?r?s?e?$");
 
+    const auto regex_auto     = Compile_Regex("^au?t?o?m?a?t?i?c?$");
+    const auto regex_dense    = Compile_Regex("^de?n?s?e?$");
+    const auto regex_scalable = Compile_Regex("^sc?a?l?a?b?l?e?$");
+    const auto regex_direct   = Compile_Regex("^di?r?e?c?t?$");
+    const auto regex_trunc    = Compile_Regex("^tr?u?n?c?a?t?e?d?$");
+    const auto regex_fgt      = Compile_Regex("^fa?s?t?[-_]?g?a?u?s?s?[-_]?t?r?a?n?s?f?o?r?m?$");
+    const auto regex_exact    = Compile_Regex("^ex?a?c?t?$");
+    const auto regex_lowrank  = Compile_Regex("^lo?w?[-_]?ra?n?k?$");
+
     const auto TPSRPMSeedWithCentroidShift = std::regex_match(TPSRPMSeedWithCentroidShiftStr, regex_true);
     const auto TPSRPMDoubleSidedOutliers = std::regex_match(TPSRPMDoubleSidedOutliersStr, regex_true);
     const auto TPSRPMPermitMovingOutliers = std::regex_match(TPSRPMPermitMovingOutliersStr, regex_true);
     const auto TPSRPMPermitStationaryOutliers = std::regex_match(TPSRPMPermitStationaryOutliersStr, regex_true);
+    const auto CPDPermitScaling = std::regex_match(CPDPermitScalingStr, regex_true);
+    const auto CPDCoarseToFine = std::regex_match(CPDCoarseToFineStr, regex_true);
 
     std::vector<std::pair<long int, long int>> TPSRPMHardContraints;
     {
@@ -661,6 +850,7 @@ bool ExtractPointsWarp(Drover &DICOM_data,
             params.forced_correspondence    = TPSRPMHardContraints;
             params.permit_move_outliers     = TPSRPMPermitMovingOutliers;
             params.permit_stat_outliers     = TPSRPMPermitStationaryOutliers;
+            params.max_control_points       = TPSRPMMaxControlPoints;
 
 /*
 // Debugging...
@@ -674,6 +864,16 @@ params.report_final_correspondence = true;
                 throw std::runtime_error("Solver not understood. Unable to continue.");
             }
 
+            if( std::regex_match(TPSRPMEngineStr, regex_auto) ){
+                params.engine = AlignViaTPSRPMParams::Engine::Automatic;
+            }else if( std::regex_match(TPSRPMEngineStr, regex_dense) ){
+                params.engine = AlignViaTPSRPMParams::Engine::Dense;
+            }else if( std::regex_match(TPSRPMEngineStr, regex_scalable) ){
+                params.engine = AlignViaTPSRPMParams::Engine::Scalable;
+            }else{
+                throw std::runtime_error("Engine not understood. Unable to continue.");
+            }
+
             YLOGINFO("Performing TPS alignment using lambda = " << TPSRPMLambdaStart << ","
                      << " zeta = " << TPSRPMZetaStart << ","
                      << " and kdim = " << TPSRPMKDim);
@@ -790,6 +990,73 @@ for(long int step = 0; step <= num_steps; ++step){
             }else{
                 throw std::runtime_error("Failed to warp using TPS-RPM.");
             }
+
+        }else if( std::regex_match(MethodStr, regex_cpd_rigid)
+              ||  std::regex_match(MethodStr, regex_cpd_affine)
+              ||  std::regex_match(MethodStr, regex_cpd_nonrigid) ){
+            AlignViaCPDParams params;
+            params.outlier_weight   = CPDOutlierWeight;
+            params.permit_scaling   = CPDPermitScaling;
+            params.beta             = CPDBeta;
+            params.lambda           = CPDLambda;
+            params.low_rank         = CPDLowRank;
+            params.coarse_to_fine   = CPDCoarseToFine;
+            params.field_voxel_size = CPDFieldVoxelSize;
+            params.max_iterations   = MaxIters;
+            if(std::isfinite(RelativeTol)){
+                params.tolerance = std::max(0.0, RelativeTol);
+            }
+
+            if( std::regex_match(CPDEngineStr, regex_auto) ){
+                params.engine = AlignViaCPDParams::Engine::Automatic;
+            }else if( std::regex_match(CPDEngineStr, regex_direct) ){
+                params.engine = AlignViaCPDParams::Engine::Direct;
+            }else if( std::regex_match(CPDEngineStr, regex_trunc) ){
+                params.engine = AlignViaCPDParams::Engine::Truncated;
+            }else if( std::regex_match(CPDEngineStr, regex_fgt) ){
+                params.engine = AlignViaCPDParams::Engine::FastGauss;
+            }else{
+                throw std::runtime_error("Engine not understood. Unable to continue.");
+            }
+
+            if( std::regex_match(CPDSolverStr, regex_auto) ){
+                params.solver = AlignViaCPDParams::Solver::Automatic;
+            }else if( std::regex_match(CPDSolverStr, regex_exact) ){
+                params.solver = AlignViaCPDParams::Solver::Exact;
+            }else if( std::regex_match(CPDSolverStr, regex_lowrank) ){
+                params.solver = AlignViaCPDParams::Solver::LowRank;
+            }else{
+                throw std::runtime_error("Solver not understood. Unable to continue.");
+            }
+
+            std::optional<decltype(Transform3().transform)> t_opt;
+            std::string warp_type;
+            if( std::regex_match(MethodStr, regex_cpd_rigid) ){
+                warp_type = "CPD-Rigid";
+                if(auto a_opt = AlignViaRigidCPD( params, (*pcp_it)->pset, (*ref_PCs.front())->pset )){
+                    t_opt = a_opt.value();
+                }
+            }else if( std::regex_match(MethodStr, regex_cpd_affine) ){
+                warp_type = "CPD-Affine";
+                if(auto a_opt = AlignViaAffineCPD( params, (*pcp_it)->pset, (*ref_PCs.front())->pset )){
+                    t_opt = a_opt.value();
+                }
+            }else{
+                warp_type = "CPD-NonRigid";
+                YLOGINFO("Performing non-rigid CPD alignment using beta = " << CPDBeta << " and lambda = " << CPDLambda);
+                if(auto d_opt = AlignViaNonRigidCPD( params, (*pcp_it)->pset, (*ref_PCs.front())->pset )){
+                    t_opt = std::move(d_opt.value());
+                }
+            }
+            if(t_opt){
+                YLOGINFO("Successfully found warp using " << warp_type);
+                DICOM_data.trans_data.emplace_back( std::make_shared<Transform3>( ) );
+                DICOM_data.trans_data.back()->transform = std::move(t_opt.value());
+                DICOM_data.trans_data.back()->metadata["Name"] = "unspecified";
+                DICOM_data.trans_data.back()->metadata["WarpType"] = warp_type;
+            }else{
+                throw std::runtime_error("Failed to warp using "_s + warp_type + ".");
+            }
 #endif // DCMA_USE_EIGEN
 
         }else{
@@ -171,22 +171,34 @@ bool ExtractRadiomicFeatures(Drover &DICOM_data,
         contours_header << ",LongestPerimeter";
         contours_report << "," << LongestPerimeter;
 
-        double LongestVertVertDistance = -1.0;
+        // The convex hull is shared by several features. The longest vertex-vertex distance is always realized by a
+        // pair of hull vertices, so the hull also avoids comparing every pair of contour vertices.
+        std::vector<vec3<double>> verts;
         for(const auto &cc_refw : cc_ROIs){
-            for(const auto &cA : cc_refw.get().contours){
-                for(const auto &vA : cA.points){
-                    for(const auto &cB : cc_refw.get().contours){
-                        for(const auto &vB : cB.points){
-                            const auto dist = vB.distance( vA );
-                            if(dist > LongestVertVertDistance) LongestVertVertDistance = dist;
-                        }
-                    }
-                }
+            for(const auto &c : cc_refw.get().contours){
+                verts.insert(std::end(verts), std::begin(c.points), std::end(c.points));
             }
         }
+        const auto hull = polyhedron_processing::Convex_Hull(verts);
+
+        double LongestVertVertDistance = -1.0;
+        if(!verts.empty()){
+            LongestVertVertDistance = polyhedron_processing::Farthest_Pair_Distance(verts, hull);
+        }
         contours_header << ",LongestVertexVertexDistance";
         contours_report << "," << LongestVertVertDistance;
 
+        double ContourConvexHullVolume = std::numeric_limits<double>::quiet_NaN();
+        double ContourConvexHullSurfaceArea = std::numeric_limits<double>::quiet_NaN();
+        if(!hull.empty()){
+            ContourConvexHullVolume = polyhedron_processing::Volume(hull);
+            ContourConvexHullSurfaceArea = polyhedron_processing::SurfaceArea(hull);
+        }
+        contours_header << ",ContourConvexHullVolume";
+        contours_report << "," << ContourConvexHullVolume;
+
+        contours_header << ",ContourConvexHullSurfaceArea";
+        contours_report << "," << ContourConvexHullSurfaceArea;
     }
 
     // Surface-mesh-based features.
@@ -226,6 +238,32 @@ bool ExtractRadiomicFeatures(Drover &DICOM_data,
         const auto C = V/std::sqrt( pi * std::pow(A, 3.0) );
         smesh_header << ",MeshCompactness";
         smesh_report << "," << C;
+
+        // The mesh does not coincide with the contours (e.g., it is closed off beyond the extreme contours), so the
+        // hull-based mesh features use the hull of the mesh itself.
+        const auto hull = polyhedron_processing::Convex_Hull(fv_mesh.vertices);
+
+        double MaxDiameter = std::numeric_limits<double>::quiet_NaN();
+        if(!fv_mesh.vertices.empty()){
+            MaxDiameter = polyhedron_processing::Farthest_Pair_Distance(fv_mesh.vertices, hull);
+        }
+        smesh_header << ",MeshMaximum3DDiameter";
+        smesh_report << "," << MaxDiameter;
+
+        double HullV = std::numeric_limits<double>::quiet_NaN();
+        double HullA = std::numeric_limits<double>::quiet_NaN();
+        if(!hull.empty()){
+            HullV = polyhedron_processing::Volume(hull);
+            HullA = polyhedron_processing::SurfaceArea(hull);
+        }
+
+        const auto Sol = V/HullV;
+        smesh_header << ",MeshSolidity";
+        smesh_report << "," << Sol;
+
+        const auto AD = A/HullA;
+        smesh_header << ",MeshConvexHullAreaDensity";
+        smesh_report << "," << AD;
     }
 
 
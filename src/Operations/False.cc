@@ -46,6 +46,8 @@ OperationDoc OpArgDocFalse() {
     out.desc = "This operation is a control flow meta-operation that does not complete successfully."
                " It has no side effects.";
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
@@ -452,7 +452,7 @@ bool GridBasedRayCastDoseAccumulate(Drover &DICOM_data,
     //Now ready to ray cast. Loop over integer pixel coordinates. Start and finish are image pixels.
     // The top image can be the length image.
     {
-        asio_thread_pool tp;
+        task_group tp;
         std::mutex printer; // Who gets to print to the console and iterate the counter.
         long int completed = 0;
 
@@ -511,6 +511,7 @@ bool GridBasedRayCastDoseAccumulate(Drover &DICOM_data,
                 }
             });
         }
+        tp.wait();
     } // Complete tasks and terminate thread pool.
 
     // Save image maps to file.
@@ -64,6 +64,8 @@ OperationDoc OpArgDocIfElse() {
         " with other control flow meta-operations."
     );
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
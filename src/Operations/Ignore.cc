@@ -56,6 +56,8 @@ OperationDoc OpArgDocIgnore() {
         " This operation works well with idempotent or non-critical children operations."
     );
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
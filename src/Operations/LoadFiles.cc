@@ -32,6 +32,7 @@
 #include "../Thread_Pool.h"
 #include "../Write_File.h"
 #include "../File_Loader.h"
+#include "../File_Metadata_Index.h"
 #include "../Operation_Dispatcher.h"
 
 #include "LoadFiles.h"
@@ -59,6 +60,48 @@ OperationDoc OpArgDocLoadFiles(){
     out.args.back().expected = true;
     out.args.back().examples = { "/tmp/image.dcm", "rois.dcm", "dose.dcm", "image.fits", "point_cloud.xyz" };
 
+    out.args.emplace_back();
+    out.args.back().name = "ArchiveSelection";
+    out.args.back().desc = "Objects to load from chunked Boost.Serialization archives. Other file types are unaffected."
+                           " The selection is a semicolon-separated list of categories ('contours', 'images',"
+                           " 'pointclouds', 'surfacemeshes', 'rtplans', or 'linesamples'), each optionally"
+                           " followed by an '@' and comma-separated indices within the category."
+                           " Negative indices count from the end."
+                           " If empty, all objects are loaded.";
+    out.args.back().default_val = "";
+    out.args.back().expected = false;
+    out.args.back().examples = { "images", "images@0", "images@0,-1;contours", "surfacemeshes@2;rtplans" };
+
+    out.args.emplace_back();
+    out.args.back().name = "MetadataFilter";
+    out.args.back().desc = "If provided, only files with top-level DICOM metadata satisfying all criteria are loaded."
+                           " Directories are searched recursively."
+                           " Criteria are separated by semicolons and have the form 'key@regex', which requires the"
+                           " key to be present with a value matching the regex, or '!key@regex', which excludes files"
+                           " with a matching value."
+                           " Only file headers are read (in parallel) when evaluating criteria, and results can be"
+                           " persisted between invocations with the 'IndexFile' parameter."
+                           " Files that are not DICOM have no metadata."
+                           " If empty, all files are loaded.";
+    out.args.back().default_val = "";
+    out.args.back().expected = false;
+    out.args.back().examples = { "Modality@CT", "Modality@RTSTRUCT;!StructureSetLabel@.*test.*",
+                                 "PatientID@^123456$;SeriesDescription@.*[Aa]xial.*" };
+
+    out.args.emplace_back();
+    out.args.back().name = "IndexFile";
+    out.args.back().desc = "An optional file used to persistently cache top-level DICOM metadata, keyed by file path,"
+                           " size, and modification time. Unchanged files are filtered without being re-read."
+                           " The same index can be shared with the PollDirectories operation."
+                           " This parameter is only used when 'MetadataFilter' is provided."
+                           " If empty, no index is used.";
+    out.args.back().default_val = "";
+    out.args.back().expected = false;
+    out.args.back().examples = { "/tmp/index.bin.gz", "/home/user/dicom.index" };
+
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
@@ -69,6 +112,9 @@ bool LoadFiles(Drover &DICOM_data,
 
     //---------------------------------------------- User Parameters --------------------------------------------------
     const auto FileNameStr = OptArgs.getValueStr("FileName").value();
+    const auto ArchiveSelectionOpt = OptArgs.getValueStr("ArchiveSelection");
+    const auto MetadataFilterStr = OptArgs.getValueStr("MetadataFilter").value_or("");
+    const auto IndexFileStr = OptArgs.getValueStr("IndexFile").value_or("");
 
     //-----------------------------------------------------------------------------------------------------------------
 
@@ -92,10 +138,73 @@ bool LoadFiles(Drover &DICOM_data,
             throw std::invalid_argument(ss.str().c_str());
         }
     }
+
+    // Optionally filter files using their top-level metadata.
+    if(!MetadataFilterStr.empty()){
+        struct criterion_t {
+            std::string key;
+            std::regex value;
+            bool negate;
+        };
+        std::vector<criterion_t> criteria;
+        for(auto c : SplitStringToVector(MetadataFilterStr, ';', 'd')){
+            c = Canonicalize_String2(c, CANONICALIZE::TRIM_ENDS);
+            if(c.empty()) continue;
+
+            const bool negate = (c.front() == '!');
+            if(negate) c.erase(0, 1);
+            const auto pos = c.find('@');
+            if( (pos == std::string::npos) || (pos == 0) ){
+                throw std::invalid_argument("Metadata filter criterion '" + c + "' not understood. Refusing to continue.");
+            }
+            criteria.push_back({ c.substr(0, pos), Compile_Regex(c.substr(pos + 1)), negate });
+        }
+
+        std::vector<std::filesystem::path> candidates;
+        for(const auto &p : Paths){
+            if(std::filesystem::is_directory(p)){
+                for(const auto &e : std::filesystem::recursive_directory_iterator(p)){
+                    if(e.is_regular_file()) candidates.emplace_back(e.path());
+                }
+            }else{
+                candidates.emplace_back(p);
+            }
+        }
+
+        file_metadata_index index = IndexFileStr.empty() ? file_metadata_index()
+                                                         : file_metadata_index(std::filesystem::path(IndexFileStr));
+        const auto entries = index.lookup(candidates);
+
+        Paths.clear();
+        for(size_t i = 0; i < candidates.size(); ++i){
+            const auto &metadata = entries[i].metadata;
+            const bool satisfied = std::all_of(std::begin(criteria), std::end(criteria), [&](const criterion_t &c){
+                const auto it = metadata.find(c.key);
+                const bool matches = (it != std::end(metadata)) && std::regex_match(it->second, c.value);
+                return (matches != c.negate);
+            });
+            if(satisfied) Paths.emplace_back(candidates[i]);
+        }
+        YLOGINFO("Metadata filter selected " << Paths.size() << " of " << candidates.size() << " files");
+
+        try{
+            index.write();
+        }catch(const std::exception &e){
+            YLOGWARN("Unable to write file metadata index: " << e.what());
+        }
+
+        if(Paths.empty()){
+            YLOGWARN("No files satisfied the metadata filter");
+            return true;
+        }
+    }
     
     // Load the files to a placeholder Drover class.
     Drover DD_work;
     std::map<std::string, std::string> dummy;
+    if(ArchiveSelectionOpt && !ArchiveSelectionOpt.value().empty()){
+        dummy["ArchiveSelection"] = ArchiveSelectionOpt.value();
+    }
     std::list<OperationArgPkg> Operations;
     const auto res = Load_Files(DD_work, dummy, FilenameLex, Operations, Paths);
     if(!res){
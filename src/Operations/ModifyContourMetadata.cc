@@ -50,6 +50,9 @@ OperationDoc OpArgDocModifyContourMetadata(){
                             "MinimumSeparation@1.23", 
                             "'Description@some description;MinimumSeparation@1.23'" };
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
@@ -124,6 +124,9 @@ OperationDoc OpArgDocModifyImageMetadata(){
                                  "0.0, 1.0, 1.0",
                                  "-1.0, 0.0, 0.0" };
 
+    out.footprint = drover_payloads_t();
+    out.footprint->images = true;
+
     return out;
 }
 
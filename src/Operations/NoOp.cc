@@ -17,6 +17,8 @@ OperationDoc OpArgDocNoOp(){
     out.desc = 
         "This operation does nothing. It produces no side-effects.";
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
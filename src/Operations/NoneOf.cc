@@ -60,6 +60,8 @@ OperationDoc OpArgDocNoneOf() {
         " with other control flow meta-operations, for example as a conditional in an if-else statement."
     );
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
@@ -23,6 +23,7 @@
 #include "../Structs.h"
 #include "../Regex_Selectors.h"
 #include "../File_Loader.h"
+#include "../File_Metadata_Index.h"
 #include "../Operation_Dispatcher.h"
 
 #include "PollDirectories.h"
@@ -43,6 +44,8 @@ OperationDoc OpArgDocPollDirectories(){
     out.notes.emplace_back(
         "Only file names and sizes are used to evaluate when a file was last altered."
         " Filesystem modification times are not used, and file contents being altered will not be detected."
+        " The exception is the optional index file, which uses file sizes and modification times to recognize"
+        " files processed in previous sessions."
     );
     out.notes.emplace_back(
         "To reduce external dependencies, only rudimentary directory polling methods are used."
@@ -125,6 +128,18 @@ OperationDoc OpArgDocPollDirectories(){
     out.args.back().examples = { "separate", "subdirs", "altogether" };
     out.args.back().samples = OpArgSamples::Exhaustive;
 
+    out.args.emplace_back();
+    out.args.back().name = "IndexFile";
+    out.args.back().desc = "An optional file used to persistently record which files have been processed, along with"
+                           " their top-level DICOM metadata. Files are keyed by path, size, and modification time."
+                           " When provided, files that were processed in a previous session and have not changed"
+                           " since are skipped without being opened. The index can also be provided to the LoadFiles"
+                           " operation to filter files by metadata without re-reading them."
+                           " If empty, no index is used.";
+    out.args.back().default_val = "";
+    out.args.back().expected = false;
+    out.args.back().examples = { "/tmp/poll_index.bin.gz", "/home/user/incoming.index" };
+
     return out;
 }
 
@@ -141,6 +156,7 @@ bool PollDirectories(Drover &DICOM_data,
     const auto SettleDelay = std::stod( OptArgs.getValueStr("SettleDelay").value() );
     const auto GroupByStr = OptArgs.getValueStr("GroupBy").value();
     const auto IgnoreExistingStr = OptArgs.getValueStr("IgnoreExisting").value();
+    const auto IndexFileOpt = OptArgs.getValueStr("IndexFile");
 
     long int filesystem_error_count = 0;
     const long int max_filesystem_error_count = 20;
@@ -185,10 +201,16 @@ bool PollDirectories(Drover &DICOM_data,
         throw std::invalid_argument("No directories to poll. Cannot continue.");
     }
 
+    std::optional<file_metadata_index> index;
+    if(IndexFileOpt && !IndexFileOpt.value().empty()){
+        index.emplace( std::filesystem::path(IndexFileOpt.value()) );
+    }
+
     struct file_metadata {
         //std::filesystem::file_time_type last_time;
         std::chrono::time_point<std::chrono::steady_clock> last_time;
         std::uintmax_t file_size = 0U;
+        int64_t modification_time = 0; // Filesystem-specific ticks.
 
         bool present   = false; // File appeared in the most recent directory enumeration.
         bool processed = false; // File has already been processed and should be ignored.
@@ -201,6 +223,11 @@ bool PollDirectories(Drover &DICOM_data,
     using cache_t = std::map<std::filesystem::path, inner_cache_t>;
     cache_t cache;
     bool first_pass = true;
+
+    // Pruning the index requires checking every indexed file, so it is only performed occasionally.
+    const auto index_prune_interval = std::chrono::minutes(10);
+    auto last_index_prune = std::chrono::steady_clock::now() - index_prune_interval;
+
     while(true){
         if(!first_pass) wait();
 
@@ -221,6 +248,7 @@ bool PollDirectories(Drover &DICOM_data,
                     const auto f = e.path();
                     const auto p = f.parent_path();
                     const auto s = e.file_size();
+                    const auto mtime = static_cast<int64_t>(e.last_write_time().time_since_epoch().count());
                     const auto now = std::chrono::steady_clock::now();
 
                     // Ensure the subdirectory block exists.
@@ -243,11 +271,18 @@ bool PollDirectories(Drover &DICOM_data,
                         entry_ptr->present   = true;
                         entry_ptr->processed = (IgnoreExisting && first_pass);
                         entry_ptr->ready     = false;
+
+                        // Skip files processed in a previous session, if they have not changed since.
+                        if(index && !entry_ptr->processed){
+                            const auto ie = index->find(f, s, mtime);
+                            entry_ptr->processed = (ie && ie->processed);
+                        }
                     }
 
                     // Mark the file as present.
                     entry_ptr = &(it->second);
                     entry_ptr->present = true;
+                    entry_ptr->modification_time = mtime;
 
                     // If already processed, ignore.
                     if( entry_ptr->processed == true ) continue;
@@ -460,6 +495,25 @@ bool PollDirectories(Drover &DICOM_data,
                     return false;
                 }
             }
+
+            // Record the processed files using the size and modification time from the directory enumeration, so
+            // the files do not need to be re-read.
+            if(index){
+                for(const auto &f : batch){
+                    const auto &fm = cache.at(f.parent_path()).at(f);
+                    index->mark_processed(f, fm.file_size, fm.modification_time);
+                }
+                try{
+                    const auto now = std::chrono::steady_clock::now();
+                    if(index_prune_interval < (now - last_index_prune)){
+                        index->prune();
+                        last_index_prune = now;
+                    }
+                    index->write();
+                }catch(const std::exception &e){
+                    YLOGWARN("Unable to update file metadata index: " << e.what());
+                }
+            }
         }
 
         // Optionally remove all processed files from input directories.
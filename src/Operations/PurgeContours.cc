@@ -126,6 +126,9 @@ OperationDoc OpArgDocPurgeContours(){
     out.args.back().expected = true;
     out.args.back().examples = { "-inf", "10.0", "100", "10.23E4" };
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
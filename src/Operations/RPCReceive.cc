@@ -1,13 +1,16 @@
 //RPCReceive.cc - A part of DICOMautomaton 2022. Written by hal clark.
 
 #include <any>
+#include <filesystem>
 #include <optional>
 #include <functional>
 #include <iterator>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <regex>
+#include <sstream>
 #include <stdexcept>
 #include <string>    
 #include <vector>
@@ -21,13 +24,17 @@
 
 #include "../Structs.h"
 #include "../Regex_Selectors.h"
+#include "../Operation_Dispatcher.h"
+#include "../File_Loader.h"
+#include "../Script_Loader.h"
+#include "../Deferred_Pixels.h"
 
 #ifndef DCMA_USE_THRIFT
     #error "Attempted to compile RPC server without Apache Thrift, which is required"
 #endif //DCMA_USE_THRIFT
 
 #include <thrift/protocol/TBinaryProtocol.h>
-#include <thrift/server/TSimpleServer.h>
+#include <thrift/server/TThreadedServer.h>
 #include <thrift/transport/TServerSocket.h>
 #include <thrift/transport/TBufferTransports.h>
 
@@ -42,53 +49,89 @@ using namespace ::apache::thrift::protocol;
 using namespace ::apache::thrift::transport;
 using namespace ::apache::thrift::server;
 
+// The handler operates on a single, resident Drover that persists between calls. Each client connection is serviced
+// by a separate thread, so access to the resident Drover is serialized.
 class ReceiverHandler : virtual public ::dcma::rpc::ReceiverIf {
+  private:
+    std::mutex m;
+    Drover &DICOM_data;
+    std::map<std::string, std::string> &InvocationMetadata;
+    std::string FilenameLex;
+    ::dcma::rpc::PayloadCompression::type compression;
+
   public:
-    ReceiverHandler() {
-        YLOGINFO("Initialization code goes here");
-    }
+    ReceiverHandler(Drover &DICOM_data,
+                    std::map<std::string, std::string> &InvocationMetadata,
+                    const std::string &FilenameLex,
+                    ::dcma::rpc::PayloadCompression::type compression)
+        : DICOM_data(DICOM_data),
+          InvocationMetadata(InvocationMetadata),
+          FilenameLex(FilenameLex),
+          compression(compression) { }
 
     void GetSupportedOperations(std::vector<::dcma::rpc::KnownOperation> & _return,
-                                const ::dcma::rpc::OperationsQuery& query) {
-        YLOGINFO("GetSupportedOperations implementation goes here");
-
-        // Simple test.
-        {
-            ::vec3<double> a;
-            ::dcma::rpc::vec3_double b;
-            Serialize(a, b);
-            Deserialize(b, a);
+                                const ::dcma::rpc::OperationsQuery& /*query*/) {
+        _return.clear();
+        for(const auto &op : Known_Operations()){
+            _return.emplace_back();
+            _return.back().name = op.first;
         }
+    }
 
-        // Slightly more complicated test.
-        {
-            ::contour_of_points<double> a;
-            ::dcma::rpc::contour_of_points_double b;
-            Serialize(a, b);
-            Deserialize(b, a);
+    void LoadFiles(::dcma::rpc::LoadFilesResponse& _return,
+                   const std::vector<::dcma::rpc::LoadFilesQuery> & server_filenames) {
+        std::list<std::filesystem::path> Paths;
+        for(const auto &q : server_filenames) Paths.emplace_back(q.server_filename);
+
+        Drover DD_work;
+        std::map<std::string, std::string> dummy;
+        std::list<OperationArgPkg> Operations;
+        _return.success = Load_Files(DD_work, dummy, this->FilenameLex, Operations, Paths);
+
+        std::lock_guard<std::mutex> lock(this->m);
+        if(_return.success){
+            this->DICOM_data.Consume(DD_work);
+            if(!Operations.empty()){
+                _return.success = Operation_Dispatcher(this->DICOM_data, this->InvocationMetadata, this->FilenameLex, Operations);
+            }
         }
+        YLOGINFO("Loaded " << Paths.size() << " files into the resident Drover " << (_return.success ? "successfully" : "unsuccessfully"));
+    }
+
+    void ExecuteScript(::dcma::rpc::ExecuteScriptResponse& _return,
+                       const ::dcma::rpc::ExecuteScriptQuery& query) {
+        _return.success = false;
 
-        // Slightly more complicated test.
+        std::list<OperationArgPkg> op_list;
         {
-            ::contour_collection<double> a;
-            ::dcma::rpc::contour_collection_double b;
-            Serialize(a, b);
-            Deserialize(b, a);
+            std::stringstream ss(query.script);
+            std::list<script_feedback_t> feedback;
+            if(!Load_DCMA_Script(ss, feedback, op_list)){
+                std::stringstream fs;
+                Print_Feedback(fs, feedback);
+                YLOGWARN("Unable to parse script: " << fs.str());
+                return;
+            }
         }
 
-        // Full-blown test of Drover serialization.
-        {
-            ::Drover a;
-            ::dcma::rpc::Drover b;
-            Serialize(a, b);
-            Deserialize(b, a);
-            Serialize(a, b);
+        // Unpack any provided data outside of the critical section.
+        Drover DD_work;
+        if(query.__isset.drover) Deserialize(query.drover, DD_work);
+
+        std::lock_guard<std::mutex> lock(this->m);
+        this->DICOM_data.Consume(DD_work);
+        try{
+            _return.success = Operation_Dispatcher(this->DICOM_data, this->InvocationMetadata, this->FilenameLex, op_list);
+        }catch(const std::exception &e){
+            YLOGWARN("Script execution failed: '" << e.what() << "'");
         }
-    }
 
-    void LoadFiles(::dcma::rpc::LoadFilesResponse& _return,
-                   const std::vector<::dcma::rpc::LoadFilesQuery> & server_filenames) {
-        YLOGINFO("LoadFiles implementation goes here");
+        if(query.return_drover){
+            Ensure_Pixels_Resident(this->DICOM_data);
+            _return.drover = ::dcma::rpc::Drover();
+            Serialize(this->DICOM_data, _return.drover, this->compression);
+            _return.__isset.drover = true;
+        }
     }
 };
 
@@ -100,10 +143,24 @@ OperationDoc OpArgDocRPCReceive(){
     out.desc = 
         "This operation launches a server that accepts remote procedure calls (RPC) for distributed computing.";
 
+    out.notes.emplace_back(
+        "Multiple clients can connect concurrently. Files loaded and scripts executed by clients all operate on the"
+        " Drover that was active when this operation was invoked, so data can remain resident on the server between"
+        " calls rather than being shipped back and forth."
+    );
+
     out.notes.emplace_back(
         "RPC functionality is currently alpha-quality code, and much is expected to change."
     );
 
+    out.notes.emplace_back(
+        "The server does not authenticate clients or encrypt traffic. Any client that can connect can load files"
+        " accessible to the server and execute arbitrary scripts, including operations that read and write files"
+        " and run external programs. By default the server only listens on the loopback interface, so only local"
+        " clients can connect. Listening on other interfaces exposes the server to the network and should only be"
+        " done on trusted networks or behind an authenticating tunnel (e.g., SSH port forwarding)."
+    );
+
     out.args.emplace_back();
     out.args.back().name = "Port";
     out.args.back().desc = "The port number to listen on.";
@@ -111,6 +168,29 @@ OperationDoc OpArgDocRPCReceive(){
     out.args.back().expected = true;
     out.args.back().examples = { "13", "8080", "9090", "16378" };
 
+    out.args.emplace_back();
+    out.args.back().name = "ListenAddress";
+    out.args.back().desc = "The address of the network interface to listen on."
+                           " The default, 'localhost', only accepts connections from the local machine."
+                           " Other addresses accept connections from any client that can reach that interface."
+                           " The special value 'all' listens on every interface."
+                           " Note that the server does not authenticate clients, so listening on anything other"
+                           " than the loopback interface permits remote clients to execute arbitrary operations.";
+    out.args.back().default_val = "localhost";
+    out.args.back().expected = true;
+    out.args.back().examples = { "localhost", "127.0.0.1", "::1", "192.168.1.10", "all" };
+
+    out.args.emplace_back();
+    out.args.back().name = "Compression";
+    out.args.back().desc = "The compression applied to image pixel payloads sent to clients."
+                           " Payloads received from clients can use any compression method."
+                           " Compression reduces the payload size, but may be slower than sending raw data"
+                           " over fast networks. Note that zstd compression may not be available.";
+    out.args.back().default_val = "none";
+    out.args.back().expected = true;
+    out.args.back().examples = { "none", "zlib", "zstd" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
     return out;
 }
 
@@ -118,23 +198,49 @@ OperationDoc OpArgDocRPCReceive(){
 
 bool RPCReceive(Drover &DICOM_data,
                      const OperationArgPkg& OptArgs,
-                     std::map<std::string, std::string>& /*InvocationMetadata*/,
-                     const std::string& /*FilenameLex*/){
+                     std::map<std::string, std::string>& InvocationMetadata,
+                     const std::string& FilenameLex){
 
     //---------------------------------------------- User Parameters --------------------------------------------------
     const auto Port = std::stol( OptArgs.getValueStr("Port").value() );
+    const auto ListenAddress = OptArgs.getValueStr("ListenAddress").value();
+    const auto CompressionStr = OptArgs.getValueStr("Compression").value();
     //-----------------------------------------------------------------------------------------------------------------
+    const auto regex_none = Compile_Regex("^no?n?e?$");
+    const auto regex_zlib = Compile_Regex("^zl?i?b?$");
+    const auto regex_zstd = Compile_Regex("^zs?t?d?$");
+
+    const auto regex_all = Compile_Regex("^al?l?$");
+
+    ::dcma::rpc::PayloadCompression::type Compression = ::dcma::rpc::PayloadCompression::NONE;
+    if(std::regex_match(CompressionStr, regex_none)){
+        Compression = ::dcma::rpc::PayloadCompression::NONE;
+    }else if(std::regex_match(CompressionStr, regex_zlib)){
+        Compression = ::dcma::rpc::PayloadCompression::ZLIB;
+    }else if(std::regex_match(CompressionStr, regex_zstd)){
+        Compression = ::dcma::rpc::PayloadCompression::ZSTD;
+    }else{
+        throw std::invalid_argument("Compression argument not understood");
+    }
+    Validate_Payload_Compression(Compression);
 
-    //using namespace ::dcma::rpc;
-
-    auto handler = std::make_shared<ReceiverHandler>();
+    auto handler = std::make_shared<ReceiverHandler>(DICOM_data, InvocationMetadata, FilenameLex, Compression);
     auto processor = std::make_shared<::dcma::rpc::ReceiverProcessor>(handler);
 
-    auto transport_server = std::make_shared<TServerSocket>( Port );
+    std::shared_ptr<TServerSocket> transport_server;
+    if(std::regex_match(ListenAddress, regex_all)){
+        YLOGWARN("Listening on all interfaces. Clients are not authenticated, so any client that can connect can execute arbitrary operations");
+        transport_server = std::make_shared<TServerSocket>( Port );
+    }else if(ListenAddress.empty()){
+        throw std::invalid_argument("ListenAddress cannot be empty");
+    }else{
+        YLOGINFO("Listening on '" << ListenAddress << "' port " << Port);
+        transport_server = std::make_shared<TServerSocket>( ListenAddress, Port );
+    }
     auto transport_factory = std::make_shared<TBufferedTransportFactory>();
     auto protocol_factory = std::make_shared<TBinaryProtocolFactory>();
 
-    TSimpleServer server(processor, transport_server, transport_factory, protocol_factory);
+    TThreadedServer server(processor, transport_server, transport_factory, protocol_factory);
     server.serve();
 
     return true;
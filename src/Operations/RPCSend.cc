@@ -21,6 +21,7 @@
 
 #include "../Structs.h"
 #include "../Regex_Selectors.h"
+#include "../Deferred_Pixels.h"
 
 #ifndef DCMA_USE_THRIFT
     #error "Attempted to compile RPC client without Apache Thrift, which is required"
@@ -47,6 +48,12 @@ OperationDoc OpArgDocRPCSend(){
     out.desc = 
         "This operation sends a remote procedure call (RPC) to a corresponding client for distributed computing.";
 
+    out.notes.emplace_back(
+        "If a script is provided, it is executed by the server on the server's resident Drover. Data can optionally"
+        " be sent to the server beforehand, and the server's resident Drover can optionally be returned afterward."
+        " Returned data is merged into the local Drover, so sending and then returning data will duplicate it."
+    );
+
     out.notes.emplace_back(
         "RPC functionality is currently alpha-quality code, and much is expected to change."
     );
@@ -58,6 +65,47 @@ OperationDoc OpArgDocRPCSend(){
     out.args.back().expected = true;
     out.args.back().examples = { "13", "8080", "9090", "16378" };
 
+    out.args.emplace_back();
+    out.args.back().name = "Host";
+    out.args.back().desc = "The hostname or address of the server.";
+    out.args.back().default_val = "localhost";
+    out.args.back().expected = true;
+    out.args.back().examples = { "localhost", "127.0.0.1", "compute-node-3" };
+
+    out.args.emplace_back();
+    out.args.back().name = "Script";
+    out.args.back().desc = "A script of operations to execute on the server. If empty, no script is executed.";
+    out.args.back().default_val = "";
+    out.args.back().expected = false;
+    out.args.back().examples = { "GenerateVirtualDataImageSphereV1();",
+                                 "AnalyzeHistograms( ImageSelection = 'last' );" };
+
+    out.args.emplace_back();
+    out.args.back().name = "SendDrover";
+    out.args.back().desc = "Whether to send the local data to the server before the script is executed.";
+    out.args.back().default_val = "false";
+    out.args.back().expected = true;
+    out.args.back().examples = { "true", "false" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
+    out.args.emplace_back();
+    out.args.back().name = "ReturnDrover";
+    out.args.back().desc = "Whether the server should return its resident data after the script is executed.";
+    out.args.back().default_val = "false";
+    out.args.back().expected = true;
+    out.args.back().examples = { "true", "false" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
+    out.args.emplace_back();
+    out.args.back().name = "Compression";
+    out.args.back().desc = "The compression applied to image pixel payloads sent to the server."
+                           " Compression reduces the payload size, but may be slower than sending raw data"
+                           " over fast networks. Note that zstd compression may not be available.";
+    out.args.back().default_val = "none";
+    out.args.back().expected = true;
+    out.args.back().examples = { "none", "zlib", "zstd" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
     return out;
 }
 
@@ -69,31 +117,76 @@ bool RPCSend(Drover &DICOM_data,
 
     //---------------------------------------------- User Parameters --------------------------------------------------
     const auto Port = std::stol( OptArgs.getValueStr("Port").value() );
+    const auto Host = OptArgs.getValueStr("Host").value();
+    const auto ScriptOpt = OptArgs.getValueStr("Script");
+    const auto SendDroverStr = OptArgs.getValueStr("SendDrover").value();
+    const auto ReturnDroverStr = OptArgs.getValueStr("ReturnDrover").value();
+    const auto CompressionStr = OptArgs.getValueStr("Compression").value();
     //-----------------------------------------------------------------------------------------------------------------
+    const auto regex_true = Compile_Regex("^tr?u?e?$");
+    const auto regex_none = Compile_Regex("^no?n?e?$");
+    const auto regex_zlib = Compile_Regex("^zl?i?b?$");
+    const auto regex_zstd = Compile_Regex("^zs?t?d?$");
+
+    const auto SendDrover = std::regex_match(SendDroverStr, regex_true);
+    const auto ReturnDrover = std::regex_match(ReturnDroverStr, regex_true);
+
+    ::dcma::rpc::PayloadCompression::type Compression = ::dcma::rpc::PayloadCompression::NONE;
+    if(std::regex_match(CompressionStr, regex_none)){
+        Compression = ::dcma::rpc::PayloadCompression::NONE;
+    }else if(std::regex_match(CompressionStr, regex_zlib)){
+        Compression = ::dcma::rpc::PayloadCompression::ZLIB;
+    }else if(std::regex_match(CompressionStr, regex_zstd)){
+        Compression = ::dcma::rpc::PayloadCompression::ZSTD;
+    }else{
+        throw std::invalid_argument("Compression argument not understood");
+    }
+    Validate_Payload_Compression(Compression);
 
     std::shared_ptr<TTransport> transport;
-    //auto transport = std::make_shared<TTransport>();
-    transport = std::make_shared<TSocket>("localhost", Port);
+    transport = std::make_shared<TSocket>(Host, Port);
     transport = std::make_shared<TBufferedTransport>(transport);
 
     auto protocol = std::make_shared<TBinaryProtocol>(transport);
     ::dcma::rpc::ReceiverClient client(protocol);
 
-    //using namespace ::dcma::rpc;
-
+    bool success = true;
     try{
         transport->open();
 
         std::vector<::dcma::rpc::KnownOperation> known_ops;
         ::dcma::rpc::OperationsQuery q;
         client.GetSupportedOperations(known_ops, q);
-
-        YLOGINFO("Implementation of client goes here");
+        YLOGINFO("Server supports " << known_ops.size() << " operations");
+
+        if(ScriptOpt && !ScriptOpt.value().empty()){
+            ::dcma::rpc::ExecuteScriptQuery query;
+            query.script = ScriptOpt.value();
+            query.return_drover = ReturnDrover;
+            if(SendDrover){
+                Ensure_Pixels_Resident(DICOM_data);
+                Serialize(DICOM_data, query.drover, Compression);
+                query.__isset.drover = true;
+            }
+
+            ::dcma::rpc::ExecuteScriptResponse response;
+            client.ExecuteScript(response, query);
+            success = response.success;
+            if(!success){
+                YLOGWARN("Server failed to execute script");
+            }
+
+            if(response.__isset.drover){
+                Drover DD_work;
+                Deserialize(response.drover, DD_work);
+                DICOM_data.Consume(DD_work);
+            }
+        }
     }catch( const std::exception &e){
         YLOGWARN("Client failed: '" << e.what() << "'");
+        success = false;
     }
     transport->close();
 
-    return true;
+    return success;
 }
-
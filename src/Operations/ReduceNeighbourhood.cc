@@ -43,6 +43,11 @@ OperationDoc OpArgDocReduceNeighbourhood(){
         " dilation and erosion, which produces an outline), and various other combinations of core"
         " and composite operations."
     );
+    out.notes.emplace_back(
+        "The 'min', 'median', 'max', and 'percentile01' reductions are evaluated using a sliding window"
+        " for large cubic and fixed-size neighbourhoods, which avoids re-sorting overlapping neighbourhoods."
+        " Fixed-size neighbourhoods that extend beyond the image boundaries or contain NaNs are evaluated directly."
+    );
     
     out.args.emplace_back();
     out.args.back() = IAWhitelistOpArgDoc();
@@ -179,6 +184,17 @@ OperationDoc OpArgDocReduceNeighbourhood(){
                                  "2.0",
                                  "15.0" };
 
+
+    out.args.emplace_back();
+    out.args.back().name = "SlidingWindow";
+    out.args.back().desc = "Controls whether the sliding window can be used to evaluate eligible reductions."
+                           " The sliding window produces the same results as evaluating each neighbourhood directly,"
+                           " so disabling it is only useful for verification or benchmarking.";
+    out.args.back().default_val = "true";
+    out.args.back().expected = true;
+    out.args.back().examples = { "true", "false" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
     return out;
 }
 
@@ -200,6 +216,7 @@ bool ReduceNeighbourhood(Drover &DICOM_data,
 
     const auto MaxDistance = std::stod( OptArgs.getValueStr("MaxDistance").value() );
 
+    const auto SlidingWindowStr = OptArgs.getValueStr("SlidingWindow").value();
 
     //-----------------------------------------------------------------------------------------------------------------
     const auto regex_sph = Compile_Regex("^sp?h?e?r?i?c?a?l?$");
@@ -230,6 +247,9 @@ bool ReduceNeighbourhood(Drover &DICOM_data,
     const auto regex_is_min_nan = Compile_Regex("^is?[-_]?m?ini?m?u?m?[-_]?nan$");
     const auto regex_is_max_nan = Compile_Regex("^is?[-_]?m?axi?m?u?m?[-_]?nan$");
 
+    const auto regex_true = Compile_Regex("^tr?u?e?$");
+    const auto SlidingWindow = std::regex_match(SlidingWindowStr, regex_true);
+
     //Stuff references to all contours into a list. Remember that you can still address specific contours through
     // the original holding containers (which are not modified here).
     auto cc_all = All_CCs( DICOM_data );
@@ -531,10 +551,12 @@ bool ReduceNeighbourhood(Drover &DICOM_data,
             ud.f_reduce = [](float, std::vector<float> &shtl, vec3<double>) -> float {
                               return Stats::Min(shtl);
                           };
+            ud.sliding_window_reduction = ComputeVolumetricNeighbourhoodSamplerUserData::SlidingWindowReduction::Min;
         }else if( std::regex_match(ReductionStr, regex_median) ){
             ud.f_reduce = [](float, std::vector<float> &shtl, vec3<double>) -> float {
                               return Stats::Median(shtl);
                           };
+            ud.sliding_window_reduction = ComputeVolumetricNeighbourhoodSamplerUserData::SlidingWindowReduction::Median;
         }else if( std::regex_match(ReductionStr, regex_mean) ){
             ud.f_reduce = [](float, std::vector<float> &shtl, vec3<double>) -> float {
                               return Stats::Mean(shtl);
@@ -544,6 +566,7 @@ bool ReduceNeighbourhood(Drover &DICOM_data,
             ud.f_reduce = [](float, std::vector<float> &shtl, vec3<double>) -> float {
                               return Stats::Max(shtl);
                           };
+            ud.sliding_window_reduction = ComputeVolumetricNeighbourhoodSamplerUserData::SlidingWindowReduction::Max;
 
         }else if( std::regex_match(ReductionStr, regex_geomean) ){
             const auto nan = std::numeric_limits<double>::quiet_NaN();
@@ -602,6 +625,7 @@ bool ReduceNeighbourhood(Drover &DICOM_data,
                               } 
                               return f;
                           };
+            ud.sliding_window_reduction = ComputeVolumetricNeighbourhoodSamplerUserData::SlidingWindowReduction::Percentile01;
 
         }else if( std::regex_match(ReductionStr, regex_is_min_nan) ){
             const auto machine_eps = std::sqrt( std::numeric_limits<float>::epsilon() );
@@ -637,6 +661,10 @@ bool ReduceNeighbourhood(Drover &DICOM_data,
             throw std::invalid_argument("Reduction argument '"_s + ReductionStr + "' is not valid");
         }
 
+        if(!SlidingWindow){
+            ud.sliding_window_reduction = ComputeVolumetricNeighbourhoodSamplerUserData::SlidingWindowReduction::None;
+        }
+
         if(!ud.voxel_triplets.empty()){
             YLOGINFO("Neighbourhood comprises " << ud.voxel_triplets.size() << " neighbours");
         }
@@ -66,6 +66,8 @@ OperationDoc OpArgDocRepeat() {
     out.args.back().expected    = true;
     out.args.back().examples    = {"0", "1", "5", "10", "1000"};
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
@@ -4412,13 +4412,20 @@ bool SDL_Viewer(Drover &DICOM_data,
                             ImGui::OpenPopup("Save Contours");
 
                             // Launch a thread to operate on a copy of the data.
-                            auto l_work = [l_contouring_imgs = contouring_imgs.Deep_Copy(),
+                            //
+                            // The existing contours are discarded, so only the images (which can be modified while
+                            // the thread runs) need to be copied.
+                            auto l_contouring_imgs = contouring_imgs.Snapshot();
+                            l_contouring_imgs.contour_data = std::make_shared<Contour_Data>();
+                            drover_payloads_t l_payloads;
+                            l_payloads.images = true;
+                            l_contouring_imgs.Detach_Shared(contouring_imgs, l_payloads);
+
+                            auto l_work = [l_contouring_imgs = std::move(l_contouring_imgs),
                                            l_InvocationMetadata = InvocationMetadata,
                                            l_FilenameLex = FilenameLex,
                                            l_contouring_method = contouring_method ]() mutable -> Drover {
                                 // Fully extract contours from the mask images.
-                                l_contouring_imgs.Ensure_Contour_Data_Allocated();
-                                l_contouring_imgs.contour_data->ccs.clear();
 
                                 std::list<OperationArgPkg> Operations;
                                 Operations.emplace_back("ContourViaThreshold");
@@ -99,6 +99,9 @@ OperationDoc OpArgDocScalePixels(){
     out.args.back().expected = true;
     out.args.back().examples = { "0", "1", "2" };
 
+    out.footprint = drover_payloads_t();
+    out.footprint->images = true;
+
     return out;
 }
 
@@ -107,6 +107,8 @@ OperationDoc OpArgDocSelectionIsPresent() {
     out.args.back().default_val = "last";
     out.args.back().expected = false;
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
@@ -88,6 +88,9 @@ OperationDoc OpArgDocSimplifyContours(){
     out.args.back().samples = OpArgSamples::Exhaustive;
 
 
+    out.footprint = drover_payloads_t();
+    out.footprint->contours = true;
+
     return out;
 }
 
@@ -46,6 +46,7 @@
 #include "../Regex_Selectors.h"
 #include "../Thread_Pool.h"
 #include "../Dose_Meld.h"
+#include "../Ray_Casting.h"
 
 #include "../YgorImages_Functors/Grouping/Misc_Functors.h"
 
@@ -58,7 +59,9 @@ OperationDoc OpArgDocSimulateRadiograph(){
     out.name = "SimulateRadiograph";
 
     out.desc = 
-        "This routine uses ray marching and volumetric sampling to simulate radiographs using a CT image array."
+        "This routine uses ray casting and volumetric sampling to simulate radiographs using a CT image array."
+        " Rays are traversed voxel-by-voxel (i.e., using Siddon's method) so the exact path length within each voxel"
+        " is used."
         " Voxels are assumed to have intensities in HU. A simplisitic conversion"
         " from CT number (in HU) to relative electron density (see note below) is performed for marched"
         " rays.";
@@ -154,6 +157,20 @@ OperationDoc OpArgDocSimulateRadiograph(){
     out.args.back().samples = OpArgSamples::Exhaustive;
 
 
+    out.args.emplace_back();
+    out.args.back().name = "RayTraversal";
+    out.args.back().desc = "This parameter controls how rays are traversed through the image volume."
+                           " The 'exact' method visits every voxel the ray passes through and uses the exact length"
+                           " of the ray within each voxel."
+                           " The 'nearest-step' method walks the ray one voxel at a time, stepping to whichever"
+                           " neighbouring voxel remains closest to the ray, and uses the length of each step."
+                           " The 'nearest-step' method is slower and blockier, and is retained only for comparison.";
+    out.args.back().default_val = "exact";
+    out.args.back().expected = true;
+    out.args.back().examples = { "exact", "nearest-step" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
+
     out.args.emplace_back();
     out.args.back().name = "Rows";
     out.args.back().desc = "The number of rows that the simulated radiograph will contain."
@@ -197,6 +214,8 @@ bool SimulateRadiograph(Drover &DICOM_data,
     const auto RadiographRows = std::stol( OptArgs.getValueStr("Rows").value() );
     const auto RadiographColumns = std::stol( OptArgs.getValueStr("Columns").value() );
 
+    const auto RayTraversalStr = OptArgs.getValueStr("RayTraversal").value();
+
     //-----------------------------------------------------------------------------------------------------------------
     const auto Channel = 0;
 
@@ -206,12 +225,21 @@ bool SimulateRadiograph(Drover &DICOM_data,
     const auto regex_mudl = Compile_Regex("^at?t?e?n?u?a?t?i?o?n?[-_]?l?e?n?g?t?h?$");
     const auto regex_exp = Compile_Regex("^expo?n?e?n?t?i?a?l?$");
 
+    const auto regex_exact = Compile_Regex("^ex?a?c?t?$");
+    const auto regex_nearest = Compile_Regex("^ne?a?r?e?s?t?[-_]?s?t?e?p?$");
+
     const bool spos_is_relative = std::regex_match(SourcePositionStr, regex_rel);
     const bool spos_is_absolute = std::regex_match(SourcePositionStr, regex_abs);
 
     const bool imgmodel_is_mudl = std::regex_match(ImageModelStr, regex_mudl);
     const bool imgmodel_is_exp  = std::regex_match(ImageModelStr, regex_exp);
 
+    const bool traversal_is_exact   = std::regex_match(RayTraversalStr, regex_exact);
+    const bool traversal_is_nearest = std::regex_match(RayTraversalStr, regex_nearest);
+    if(!traversal_is_exact && !traversal_is_nearest){
+        throw std::invalid_argument("Ray traversal method not understood. Unable to continue.");
+    }
+
     const vec3<double> vec3_nan( std::numeric_limits<double>::quiet_NaN(),
                                  std::numeric_limits<double>::quiet_NaN(),
                                  std::numeric_limits<double>::quiet_NaN() );
@@ -291,6 +319,23 @@ bool SimulateRadiograph(Drover &DICOM_data,
     const auto N_cols = static_cast<long int>(img_arr_ptr->imagecoll.images.front().columns);
     const auto N_imgs = static_cast<long int>(img_adj.int_to_img.size());
 
+    dcma_ray_casting::voxel_grid_t voxel_grid;
+    voxel_grid.zero = grid_zero;
+    voxel_grid.row_unit = row_unit;
+    voxel_grid.col_unit = col_unit;
+    voxel_grid.img_unit = img_unit;
+    voxel_grid.pxl_dx = pxl_dx;
+    voxel_grid.pxl_dy = pxl_dy;
+    voxel_grid.pxl_dz = pxl_dz;
+    voxel_grid.N_rows = N_rows;
+    voxel_grid.N_cols = N_cols;
+    voxel_grid.N_imgs = N_imgs;
+
+    std::vector<const planar_image<float,double>*> imgs_by_index;
+    for(long int k = 0; k < N_imgs; ++k){
+        imgs_by_index.push_back( &(img_adj.index_to_image(k).get()) );
+    }
+
     // Determine an appropriate radiograph orientation.
     const auto img_centre = img_arr_ptr->imagecoll.center(); // TODO: For TBI, should be at the t0 point (i.e., at the level of the lung).
     auto ray_source = vec3_nan;
@@ -400,9 +445,9 @@ bool SimulateRadiograph(Drover &DICOM_data,
     const auto detector_plane = DetectImg->image_plane();
 
     //------------------------
-    // March rays through the image data.
+    // Cast rays through the image data.
     {
-        asio_thread_pool tp;
+        task_group tp;
         std::mutex printer; // Who gets to print to the console and iterate the counter.
         long int completed = 0;
 
@@ -410,162 +455,167 @@ bool SimulateRadiograph(Drover &DICOM_data,
             tp.submit_task([&,RadiographRow]() -> void {
                 for(long int RadiographCol = 0; RadiographCol < RadiographColumns; ++RadiographCol){
 
-                    // Construct a line segment between the source and detector. 
+                    // Construct a line segment between the source and detector. Only the portion within the image
+                    // volume contributes.
                     const auto ray_terminus = DetectImg->position(RadiographRow, RadiographCol);
-                    const auto ray_line = line<double>(ray_source, ray_terminus);
-
-                    // Find the intersection of the ray with the detector bounding planes.
-                    vec3<double> detector_panel_bp_intersection;
-                    if(!detector_plane.Intersects_With_Line_Once(ray_line, detector_panel_bp_intersection)){
-                        throw std::logic_error("Ray line does not intersect far image array bounding plane. Cannot continue.");
-                    }
-                    const auto ray_ls = line_segment<double>(ray_source, detector_panel_bp_intersection);
-
-                    // Find the intersections of the ray and the bounding box containing the images.
-                    std::vector<vec3<double>> bp_intersections;
-                    for(const auto & img_bp : img_bps){
-                        vec3<double> P;
-                        //if(img_bp.Intersects_With_Line_Once(ray_line, P)){
-                        if(img_bp.Intersects_With_Line_Segment_Once(ray_ls, P)){
-
-                            // Determine if the intersection point is on a face of the cube.
-                            const auto bp_centre = img_bp.Project_Onto_Plane_Orthogonally(img_centre);
-                            const auto dP = (P - bp_centre);
-                            const auto dP_row = std::abs(dP.Dot(row_unit));
-                            const auto dP_col = std::abs(dP.Dot(col_unit));
-                            const auto dP_img = std::abs(dP.Dot(img_unit));
-
-                            const auto max_row = (static_cast<double>(N_rows) * pxl_dx * 0.5);
-                            const auto max_col = (static_cast<double>(N_cols) * pxl_dy * 0.5);
-                            const auto max_img = (static_cast<double>(N_imgs) * pxl_dz * 0.5);
-
-                            if( (dP_row <= max_row)
-                            &&  (dP_col <= max_col)
-                            &&  (dP_img <= max_img) ){
-                                bp_intersections.emplace_back(P);
-                            }
-                        }
-                    }
-
-                    // Explicitly add the ray source point if it is bounded within the image volume.
-                    if(ray_source_is_within_image_volume){
-                        bp_intersections.emplace_back(ray_source);
-                    }
-
-                    // Skip rays that do not intersect the image volume twice.
-                    if(bp_intersections.size() != 2){
-                        continue;
-                    }
 
-                    // Explicitly state the ray start and end positions using identified bounding-box intersection points.
-                    const vec3<double> ray_start = bp_intersections[0];
-                    const vec3<double> ray_end = bp_intersections[1];
-                    const auto ray_direction = (ray_end - ray_start).unit();
-                    const auto ray_total_sq_dist = ray_end.sq_dist(ray_start);
-
-                    // Determine whether moving from tail to head along the ray will increase or decrease the
-                    // row/col/img coordinates. Note that the direction will never change.
-                    const long int incr_row = (row_unit.Dot(ray_direction) < 0.0) ? -1L : 1L;
-                    const long int incr_col = (col_unit.Dot(ray_direction) < 0.0) ? -1L : 1L;
-                    const long int incr_img = (img_unit.Dot(ray_direction) < 0.0) ? -1L : 1L;
-
-                    // Determine the amount the ray will traverse due to incrementing i, j, or k individually.
-                    const auto true_ray_pos_dR_incr_row = ray_direction * (std::abs(row_unit.Dot(ray_direction)) * pxl_dx);
-                    const auto true_ray_pos_dR_incr_col = ray_direction * (std::abs(col_unit.Dot(ray_direction)) * pxl_dy);
-                    const auto true_ray_pos_dR_incr_img = ray_direction * (std::abs(img_unit.Dot(ray_direction)) * pxl_dz);
-
-                    const auto true_ray_pos_dR_incr_row_length = true_ray_pos_dR_incr_row.length();
-                    const auto true_ray_pos_dR_incr_col_length = true_ray_pos_dR_incr_col.length();
-                    const auto true_ray_pos_dR_incr_img_length = true_ray_pos_dR_incr_img.length();
-
-                    const auto blocky_ray_pos_dR_incr_row = row_unit * (pxl_dx * static_cast<double>(incr_row));
-                    const auto blocky_ray_pos_dR_incr_col = col_unit * (pxl_dy * static_cast<double>(incr_col));
-                    const auto blocky_ray_pos_dR_incr_img = img_unit * (pxl_dz * static_cast<double>(incr_img));
-
-                    // Determine the pseudo integer coordinates for the starting point.
-                    //
-                    // Note that these coordinates will not necessarily intersect any real voxels. They are defined only
-                    // by the (infinite) regular grid that coincides with the real voxels.
-                    const auto ray_start_grid_offset = ray_start - grid_zero;
-                    const auto ray_start_row_index = static_cast<long int>( std::round( ray_start_grid_offset.Dot(row_unit)/pxl_dx ) );
-                    const auto ray_start_col_index = static_cast<long int>( std::round( ray_start_grid_offset.Dot(col_unit)/pxl_dy ) );
-                    const auto ray_start_img_index = static_cast<long int>( std::round( ray_start_grid_offset.Dot(img_unit)/pxl_dz ) );
-
-                    long int ray_i = ray_start_row_index;
-                    long int ray_j = ray_start_col_index;
-                    long int ray_k = ray_start_img_index;
-
-                    vec3<double> true_ray_pos = ray_start;
-                    vec3<double> blocky_ray_pos = grid_zero + row_unit * (static_cast<double>(ray_i) * pxl_dx)
-                                                            + col_unit * (static_cast<double>(ray_j) * pxl_dy)
-                                                            + img_unit * (static_cast<double>(ray_k) * pxl_dz);
-
-                    // Each time the ray samples the CT number, the ray is simulated to have interacted with the medium
-                    // for the length of the ray advancement.
+                    // Each time the ray passes through a voxel, the ray is simulated to have interacted with the medium
+                    // for the length of the ray within the voxel.
                     //
                     // For purposes of simulating a radiograph, the remaining fractional ray intensity could be
                     // immediately reduced by multiplying by a factor of exp(-attenuation_coeff*dL). However, it is
                     // easier to sum all the attenuation_coeff*dL contributions and apply the reduction factor once at
                     // the end.
                     double accumulated_attenuation_length_product = 0.0;
-                    double last_move_dist = 0.0;
-
-                    while(true){
-                        // Test which single increment (either i, j, or k) remaing the closest to the ray line.
-                        const auto cand_pos_i = blocky_ray_pos + blocky_ray_pos_dR_incr_row;
-                        const auto cand_pos_j = blocky_ray_pos + blocky_ray_pos_dR_incr_col;
-                        const auto cand_pos_k = blocky_ray_pos + blocky_ray_pos_dR_incr_img;
-
-                        const auto cand_sq_dist_i = ray_line.Sq_Distance_To_Point( cand_pos_i );
-                        const auto cand_sq_dist_j = ray_line.Sq_Distance_To_Point( cand_pos_j );
-                        const auto cand_sq_dist_k = ray_line.Sq_Distance_To_Point( cand_pos_k );
-
-                        if( (cand_sq_dist_i <= cand_sq_dist_j) && (cand_sq_dist_i <= cand_sq_dist_k) ){
-                            blocky_ray_pos = cand_pos_i;
-                            true_ray_pos += true_ray_pos_dR_incr_row;
-                            last_move_dist = true_ray_pos_dR_incr_row_length;
-                            ray_i += incr_row;
-                        }else if( cand_sq_dist_j <= cand_sq_dist_k ){
-                            blocky_ray_pos = cand_pos_j;
-                            true_ray_pos += true_ray_pos_dR_incr_col;
-                            last_move_dist = true_ray_pos_dR_incr_col_length;
-                            ray_j += incr_col;
-                        }else{
-                            blocky_ray_pos = cand_pos_k;
-                            true_ray_pos += true_ray_pos_dR_incr_img;
-                            last_move_dist = true_ray_pos_dR_incr_img_length;
-                            ray_k += incr_img;
-                        }
+                    const auto accumulate = [&](int64_t i, int64_t j, int64_t k, double dL) -> void {
+                        const auto voxel_val = imgs_by_index[k]->value(i, j, Channel);
 
-                        // Terminate if the geometry is invalid.
-                        if( pxl_diagonal_sq_length < true_ray_pos.sq_dist(blocky_ray_pos) ){
-                            throw std::runtime_error("Real ray position and blocky ray position differ by more than a voxel diagonal");
-                        }
+                        // Ficticious mass density encountered by the ray.
+                        const auto intensity = (voxel_val < -1000.0f) ? -1000.0f : voxel_val; // Enforce physicality.
+                        const auto attenuation_coeff = 1.0f + (intensity / 1000.0f); 
 
-                        // Process the voxel.
-                        if( ( 0 <= ray_i ) && (ray_i < N_rows)
-                        &&  ( 0 <= ray_j ) && (ray_j < N_cols)
-                        &&  ( 0 <= ray_k ) && (ray_k < N_imgs) ){
-                            const auto intersecting_img_refw = img_adj.index_to_image(ray_k);
-                            const auto voxel_val = intersecting_img_refw.get().value(ray_i, ray_j, Channel);
+                        accumulated_attenuation_length_product += attenuation_coeff * dL;
+                    };
 
-                            // Ficticious mass density encountered by the ray.
-                            const auto intensity = (voxel_val < -1000.0f) ? -1000.0f : voxel_val; // Enforce physicality.
-                            const auto attenuation_coeff = 1.0f + (intensity / 1000.0f); 
+                    if(traversal_is_exact){
+                        dcma_ray_casting::Traverse_Voxels(voxel_grid, ray_source, ray_terminus, accumulate);
 
-                            accumulated_attenuation_length_product += attenuation_coeff * last_move_dist;
-                            
-                            // Could alternately invoke a more generic user function using (i,j,k) and the various ray
-                            // positions/distances here.
+                    }else{
+                        // Walk the ray one voxel at a time, crediting each voxel with the length of the step that
+                        // reached it.
+                        const auto ray_line = line<double>(ray_source, ray_terminus);
+
+                        // Find the intersection of the ray with the detector bounding planes.
+                        vec3<double> detector_panel_bp_intersection;
+                        if(!detector_plane.Intersects_With_Line_Once(ray_line, detector_panel_bp_intersection)){
+                            throw std::logic_error("Ray line does not intersect far image array bounding plane. Cannot continue.");
+                        }
+                        const auto ray_ls = line_segment<double>(ray_source, detector_panel_bp_intersection);
+
+                        // Find the intersections of the ray and the bounding box containing the images.
+                        std::vector<vec3<double>> bp_intersections;
+                        for(const auto & img_bp : img_bps){
+                            vec3<double> P;
+                            //if(img_bp.Intersects_With_Line_Once(ray_line, P)){
+                            if(img_bp.Intersects_With_Line_Segment_Once(ray_ls, P)){
+
+                                // Determine if the intersection point is on a face of the cube.
+                                const auto bp_centre = img_bp.Project_Onto_Plane_Orthogonally(img_centre);
+                                const auto dP = (P - bp_centre);
+                                const auto dP_row = std::abs(dP.Dot(row_unit));
+                                const auto dP_col = std::abs(dP.Dot(col_unit));
+                                const auto dP_img = std::abs(dP.Dot(img_unit));
+
+                                const auto max_row = (static_cast<double>(N_rows) * pxl_dx * 0.5);
+                                const auto max_col = (static_cast<double>(N_cols) * pxl_dy * 0.5);
+                                const auto max_img = (static_cast<double>(N_imgs) * pxl_dz * 0.5);
+
+                                if( (dP_row <= max_row)
+                                &&  (dP_col <= max_col)
+                                &&  (dP_img <= max_img) ){
+                                    bp_intersections.emplace_back(P);
+                                }
+                            }
+                        }
 
-                            //  ... TODO ...
+                        // Explicitly add the ray source point if it is bounded within the image volume.
+                        if(ray_source_is_within_image_volume){
+                            bp_intersections.emplace_back(ray_source);
+                        }
 
+                        // Skip rays that do not intersect the image volume twice.
+                        if(bp_intersections.size() != 2){
+                            continue;
                         }
 
-                        // Terminate if the ray has traveled far enough.
-                        const auto ray_traveled_sq_dist = ray_start.sq_dist(true_ray_pos);
-                        if(ray_total_sq_dist <= ray_traveled_sq_dist){
-                            break;
+                        // Explicitly state the ray start and end positions using identified bounding-box intersection points.
+                        const vec3<double> ray_start = bp_intersections[0];
+                        const vec3<double> ray_end = bp_intersections[1];
+                        const auto ray_direction = (ray_end - ray_start).unit();
+                        const auto ray_total_sq_dist = ray_end.sq_dist(ray_start);
+
+                        // Determine whether moving from tail to head along the ray will increase or decrease the
+                        // row/col/img coordinates. Note that the direction will never change.
+                        const long int incr_row = (row_unit.Dot(ray_direction) < 0.0) ? -1L : 1L;
+                        const long int incr_col = (col_unit.Dot(ray_direction) < 0.0) ? -1L : 1L;
+                        const long int incr_img = (img_unit.Dot(ray_direction) < 0.0) ? -1L : 1L;
+
+                        // Determine the amount the ray will traverse due to incrementing i, j, or k individually.
+                        const auto true_ray_pos_dR_incr_row = ray_direction * (std::abs(row_unit.Dot(ray_direction)) * pxl_dx);
+                        const auto true_ray_pos_dR_incr_col = ray_direction * (std::abs(col_unit.Dot(ray_direction)) * pxl_dy);
+                        const auto true_ray_pos_dR_incr_img = ray_direction * (std::abs(img_unit.Dot(ray_direction)) * pxl_dz);
+
+                        const auto true_ray_pos_dR_incr_row_length = true_ray_pos_dR_incr_row.length();
+                        const auto true_ray_pos_dR_incr_col_length = true_ray_pos_dR_incr_col.length();
+                        const auto true_ray_pos_dR_incr_img_length = true_ray_pos_dR_incr_img.length();
+
+                        const auto blocky_ray_pos_dR_incr_row = row_unit * (pxl_dx * static_cast<double>(incr_row));
+                        const auto blocky_ray_pos_dR_incr_col = col_unit * (pxl_dy * static_cast<double>(incr_col));
+                        const auto blocky_ray_pos_dR_incr_img = img_unit * (pxl_dz * static_cast<double>(incr_img));
+
+                        // Determine the pseudo integer coordinates for the starting point.
+                        //
+                        // Note that these coordinates will not necessarily intersect any real voxels. They are defined only
+                        // by the (infinite) regular grid that coincides with the real voxels.
+                        const auto ray_start_grid_offset = ray_start - grid_zero;
+                        const auto ray_start_row_index = static_cast<long int>( std::round( ray_start_grid_offset.Dot(row_unit)/pxl_dx ) );
+                        const auto ray_start_col_index = static_cast<long int>( std::round( ray_start_grid_offset.Dot(col_unit)/pxl_dy ) );
+                        const auto ray_start_img_index = static_cast<long int>( std::round( ray_start_grid_offset.Dot(img_unit)/pxl_dz ) );
+
+                        long int ray_i = ray_start_row_index;
+                        long int ray_j = ray_start_col_index;
+                        long int ray_k = ray_start_img_index;
+
+                        vec3<double> true_ray_pos = ray_start;
+                        vec3<double> blocky_ray_pos = grid_zero + row_unit * (static_cast<double>(ray_i) * pxl_dx)
+                                                                + col_unit * (static_cast<double>(ray_j) * pxl_dy)
+                                                                + img_unit * (static_cast<double>(ray_k) * pxl_dz);
+
+                        double last_move_dist = 0.0;
+                        while(true){
+                            // Test which single increment (either i, j, or k) remaing the closest to the ray line.
+                            const auto cand_pos_i = blocky_ray_pos + blocky_ray_pos_dR_incr_row;
+                            const auto cand_pos_j = blocky_ray_pos + blocky_ray_pos_dR_incr_col;
+                            const auto cand_pos_k = blocky_ray_pos + blocky_ray_pos_dR_incr_img;
+
+                            const auto cand_sq_dist_i = ray_line.Sq_Distance_To_Point( cand_pos_i );
+                            const auto cand_sq_dist_j = ray_line.Sq_Distance_To_Point( cand_pos_j );
+                            const auto cand_sq_dist_k = ray_line.Sq_Distance_To_Point( cand_pos_k );
+
+                            if( (cand_sq_dist_i <= cand_sq_dist_j) && (cand_sq_dist_i <= cand_sq_dist_k) ){
+                                blocky_ray_pos = cand_pos_i;
+                                true_ray_pos += true_ray_pos_dR_incr_row;
+                                last_move_dist = true_ray_pos_dR_incr_row_length;
+                                ray_i += incr_row;
+                            }else if( cand_sq_dist_j <= cand_sq_dist_k ){
+                                blocky_ray_pos = cand_pos_j;
+                                true_ray_pos += true_ray_pos_dR_incr_col;
+                                last_move_dist = true_ray_pos_dR_incr_col_length;
+                                ray_j += incr_col;
+                            }else{
+                                blocky_ray_pos = cand_pos_k;
+                                true_ray_pos += true_ray_pos_dR_incr_img;
+                                last_move_dist = true_ray_pos_dR_incr_img_length;
+                                ray_k += incr_img;
+                            }
+
+                            // Terminate if the geometry is invalid.
+                            if( pxl_diagonal_sq_length < true_ray_pos.sq_dist(blocky_ray_pos) ){
+                                throw std::runtime_error("Real ray position and blocky ray position differ by more than a voxel diagonal");
+                            }
+
+                            // Process the voxel.
+                            if( ( 0 <= ray_i ) && (ray_i < N_rows)
+                            &&  ( 0 <= ray_j ) && (ray_j < N_cols)
+                            &&  ( 0 <= ray_k ) && (ray_k < N_imgs) ){
+                                accumulate(ray_i, ray_j, ray_k, last_move_dist);
+                            }
+
+                            // Terminate if the ray has traveled far enough.
+                            const auto ray_traveled_sq_dist = ray_start.sq_dist(true_ray_pos);
+                            if(ray_total_sq_dist <= ray_traveled_sq_dist){
+                                break;
+                            }
                         }
                     }
 
@@ -583,6 +633,7 @@ bool SimulateRadiograph(Drover &DICOM_data,
             });
 
         }
+        tp.wait();
     } // Complete tasks and terminate thread pool.
 
     //------------------------
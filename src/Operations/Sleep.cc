@@ -65,6 +65,8 @@ OperationDoc OpArgDocSleep() {
     out.args.back().expected = true;
     out.args.back().examples = { "0.1", "1.23", "5" };
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
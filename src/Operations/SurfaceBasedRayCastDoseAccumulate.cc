@@ -14,6 +14,7 @@
 #include <thread>
 #include <array>
 #include <mutex>
+#include <memory>
 #include <limits>
 #include <cmath>
 #include <regex>
@@ -79,6 +80,7 @@
 #include "../Regex_Selectors.h"
 #include "../Thread_Pool.h"
 #include "../Surface_Meshes.h"
+#include "../Ray_Casting.h"
 #include "../Dose_Meld.h"
 
 #include "../YgorImages_Functors/Grouping/Misc_Functors.h"
@@ -135,8 +137,9 @@ OperationDoc OpArgDocSurfaceBasedRayCastDoseAccumulate(){
         " Though it is not required by the implementation, only the ray-surface intersection nearest to the detector is"
         " considered. All other intersections (i.e., on the far side of the surface mesh) are ignored."
         " This routine is fairly fast compared to the slow grid-based counterpart previously implemented. The speedup comes"
-        " from use of an AABB-tree to accelerate intersection queries and avoid having to 'walk' rays step-by-step through"
-        " over/through the geometry.";
+        " from use of a bounding volume hierarchy to accelerate intersection queries and avoid having to 'walk' rays"
+        " step-by-step through over/through the geometry. Rays from neighbouring detector pixels are traced together as"
+        " packets.";
 
 
     out.args.emplace_back();
@@ -397,6 +400,19 @@ OperationDoc OpArgDocSurfaceBasedRayCastDoseAccumulate(){
     out.args.back().examples = { "1", "4", "1000"};
 
 
+    out.args.emplace_back();
+    out.args.back().name = "IntersectionMethod";
+    out.args.back().desc = "The acceleration structure used to find ray-surface intersections."
+                      " The 'bvh' method traces rays from neighbouring detector pixels together as packets through"
+                      " a bounding volume hierarchy."
+                      " The 'aabb-tree' method traces each ray individually using CGAL's AABB tree, and is retained"
+                      " only for comparison.";
+    out.args.back().default_val = "bvh";
+    out.args.back().expected = true;
+    out.args.back().examples = { "bvh", "aabb-tree" };
+    out.args.back().samples = OpArgSamples::Exhaustive;
+
+
     out.args.emplace_back();
     out.args.back().name = "OnlyGenerateSurface";
     out.args.back().desc = "Stop processing after writing the surface and subdivided surface meshes."
@@ -445,6 +461,8 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     const auto MeshingSubdivisionIterations = std::stol(OptArgs.getValueStr("MeshingSubdivisionIterations").value());
     const auto MaxRaySurfaceIntersections = std::stol(OptArgs.getValueStr("MaxRaySurfaceIntersections").value());
 
+    const auto IntersectionMethodStr = OptArgs.getValueStr("IntersectionMethod").value();
+
     const auto OnlyGenerateSurfaceStr = OptArgs.getValueStr("OnlyGenerateSurface").value();
 
     //-----------------------------------------------------------------------------------------------------------------
@@ -453,6 +471,8 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     const auto refregex = Compile_Regex(ReferenceROILabelRegex);
     const auto refnormalizedregex = Compile_Regex(NormalizedReferenceROILabelRegex);
     const auto TrueRegex = Compile_Regex("^tr?u?e?$");
+    const auto regex_bvh = Compile_Regex("^bv?h?$");
+    const auto regex_aabb = Compile_Regex("^aa?b?b?[-_]?t?r?e?e?$");
 
     Explicator X(FilenameLex);
 
@@ -460,6 +480,12 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     //Boolean options.
     const auto OnlyGenerateSurface = std::regex_match(OnlyGenerateSurfaceStr, TrueRegex);
 
+    const bool method_is_bvh  = std::regex_match(IntersectionMethodStr, regex_bvh);
+    const bool method_is_aabb = std::regex_match(IntersectionMethodStr, regex_aabb);
+    if(!method_is_bvh && !method_is_aabb){
+        throw std::invalid_argument("Intersection method not understood. Cannot continue.");
+    }
+
     //Merge the dose arrays if multiple are available.
     DICOM_data = Meld_Only_Dose_Data(DICOM_data);
 
@@ -537,6 +563,9 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     const auto ucp = Unique_Contour_Planes(cc_ROIs, est_cont_normal, /*distance_eps=*/ 0.005);
 
 
+    // The reference ROIs are often the same as (or only slightly altered from) the ROIs, so meshes are shared.
+    dcma_surface_meshes::mesh_cache meshing_cache;
+
     dcma_surface_meshes::Parameters meshing_params;
     //meshing_params.RQ = dcma_surface_meshes::ReproductionQuality::Medium;
     meshing_params.GridRows = 128;
@@ -544,7 +573,7 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     meshing_params.MutateOpts.inclusivity = Mutate_Voxels_Opts::Inclusivity::Centre;
     meshing_params.MutateOpts.contouroverlap = Mutate_Voxels_Opts::ContourOverlap::Ignore;
     YLOGWARN("Ignoring contour orientations; assuming ROI polyhderon is simple");
-    auto surface_mesh = dcma_surface_meshes::Estimate_Surface_Mesh_Marching_Cubes( cc_ROIs, meshing_params );
+    auto surface_mesh = dcma_surface_meshes::Estimate_Surface_Mesh_Marching_Cubes( cc_ROIs, meshing_params, &meshing_cache );
     auto polyhedron = dcma_surface_meshes::FVSMeshToPolyhedron( surface_mesh );
 
     YLOGINFO("The polyhedron surface has " << polyhedron.size_of_vertices() << " vertices"
@@ -580,7 +609,7 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     meshing_params.MutateOpts.inclusivity = Mutate_Voxels_Opts::Inclusivity::Centre;
     meshing_params.MutateOpts.contouroverlap = Mutate_Voxels_Opts::ContourOverlap::Ignore;
     YLOGWARN("Ignoring contour orientations; assuming ROI polyhderon is simple");
-    auto ref_surface_mesh = dcma_surface_meshes::Estimate_Surface_Mesh_Marching_Cubes( cc_Refs, meshing_params );
+    auto ref_surface_mesh = dcma_surface_meshes::Estimate_Surface_Mesh_Marching_Cubes( cc_Refs, meshing_params, &meshing_cache );
     auto ref_polyhedron = dcma_surface_meshes::FVSMeshToPolyhedron( ref_surface_mesh );
 
     YLOGINFO("The reference polyhedron surface has " << ref_polyhedron.size_of_vertices() << " vertices"
@@ -608,8 +637,7 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     if(OnlyGenerateSurface) return true;
 
 
-    // ================================ Construct AABB Trees for Spatial Lookups ===================================
-    //typedef CGAL::Exact_predicates_inexact_constructions_kernel Kernel;
+    // ================================ Construct BVHs for Spatial Lookups ===================================
     using Kernel                = dcma_surface_meshes::Kernel;
     using Point                 = Kernel::Point_3;
     using Segment               = Kernel::Segment_3;
@@ -618,11 +646,19 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     using Traits                = CGAL::AABB_traits<Kernel, Triangle_Primitive>;
     using AABB_Tree             = CGAL::AABB_tree<Traits>;
     using Segment_intersection  = boost::optional<AABB_Tree::Intersection_and_primitive_id<Segment>::Type>;
-    //using Line_intersection     = boost::optional<AABB_Tree::Intersection_and_primitive_id<Line>::Type>;
 
-    //Construct the tree.
-    AABB_Tree tree(faces(polyhedron).first, faces(polyhedron).second, polyhedron);
-    AABB_Tree ref_tree(faces(ref_polyhedron).first, faces(ref_polyhedron).second, ref_polyhedron);
+    std::unique_ptr<dcma_ray_casting::mesh_bvh> bvh;
+    std::unique_ptr<dcma_ray_casting::mesh_bvh> ref_bvh;
+    std::unique_ptr<AABB_Tree> tree;
+    std::unique_ptr<AABB_Tree> ref_tree;
+    if(method_is_bvh){
+        bvh = std::make_unique<dcma_ray_casting::mesh_bvh>( dcma_surface_meshes::PolyhedronToFVSMesh(polyhedron) );
+        ref_bvh = std::make_unique<dcma_ray_casting::mesh_bvh>( dcma_surface_meshes::PolyhedronToFVSMesh(ref_polyhedron) );
+        YLOGINFO("Constructed BVHs with " << bvh->node_count() << " and " << ref_bvh->node_count() << " nodes");
+    }else{
+        tree = std::make_unique<AABB_Tree>(faces(polyhedron).first, faces(polyhedron).second, polyhedron);
+        ref_tree = std::make_unique<AABB_Tree>(faces(ref_polyhedron).first, faces(ref_polyhedron).second, ref_polyhedron);
+    }
 
     //Figure out what z-margin is needed so the extra two images do not interfere with the grid lining up with the
     // contours. (Want exactly one contour plane per image.) So the margin should be large enough so the empty
@@ -755,88 +791,142 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
     //Now ready to ray cast. Loop over integer pixel coordinates. Start and finish are image pixels.
     // The top image can be the length image.
     {
-        asio_thread_pool tp;
+        task_group tp;
         std::mutex printer; // Who gets to print to the console and iterate the counter.
         long int completed = 0;
+        long int rays_intersecting = 0;     // The number of rays that intersect the ROI surface.
+        long int rays_ref_intersecting = 0; // The number of rays that intersect the ROI and reference ROI surfaces.
 
         for(long int row = 0; row < SourceDetectorRows; ++row){
             tp.submit_task([&,row]() -> void {
+                //Construct line segments between the source and detector. Rays in a row are coherent, so they are
+                // traced together as packets.
+                std::vector<dcma_ray_casting::ray_t> rays;
+                rays.reserve(SourceDetectorColumns);
                 for(long int col = 0; col < SourceDetectorColumns; ++col){
+                    const vec3<double> ray_start = SourceImg->position(row, col); // The naive starting position, without boosting.
+                    const vec3<double> ray_end = DetectImg->position(row, col);
+                    rays.emplace_back();
+                    rays.back().origin = ray_start;
+                    rays.back().direction = ray_end - ray_start;
+                }
+                std::vector<std::vector<dcma_ray_casting::ray_hit_t>> all_hits;
+                if(method_is_bvh) all_hits = bvh->intersect_all(rays);
 
-                    //Construct a line segment between the source and detector. 
+                long int row_rays_intersecting = 0;
+                long int row_rays_ref_intersecting = 0;
+                for(long int col = 0; col < SourceDetectorColumns; ++col){
                     long int accumulated_counts = 0;      //The number of ray-surface intersections.
                     long int ref_accumulated_counts = 0;  //Whether the ray intersects the reference ROI anywhere..
                     double accumulated_totaldose = 0.0;   //The total accumulated dose from all intersections.
-                    const vec3<double> ray_start = SourceImg->position(row, col); // The naive starting position, without boosting.
-                    const vec3<double> ray_end = DetectImg->position(row, col);
+                    const auto &ray = rays[col];
 
-                    Segment line_segment( Point(ray_start.x, ray_start.y, ray_start.z),
-                                          Point(ray_end.x,   ray_end.y,   ray_end.z)   );
-
-                    //Fast check for intersections.
-                    if(tree.do_intersect(line_segment)){
-
-                        //Enumerate all intersections. Note that some may be line segment "glances."
-                        std::list<Segment_intersection> intersections;
-                        tree.all_intersections(line_segment, std::back_inserter(intersections));
-
-                        //Sort by distance from the detector so the first intersection is closest to the detector.
-                        intersections.sort([&](const Segment_intersection &A, const Segment_intersection &B) -> bool {
-                            const Point *pA = boost::get<Point>(&(A->first));
-                            const Point *pB = boost::get<Point>(&(B->first));
-                            if( (pA) && (pB) ){ // Both valid points.
-                                const vec3<double> PA(static_cast<double>( CGAL::to_double( pA->x() )),
-                                                      static_cast<double>( CGAL::to_double( pA->y() )),
-                                                      static_cast<double>( CGAL::to_double( pA->z() )));
-                                const vec3<double> PB(static_cast<double>( CGAL::to_double( pB->x() )),
-                                                      static_cast<double>( CGAL::to_double( pB->y() )),
-                                                      static_cast<double>( CGAL::to_double( pB->z() )));
-                                return std::abs( detector_plane.Get_Signed_Distance_To_Point(PA) ) 
-                                          < std::abs( detector_plane.Get_Signed_Distance_To_Point(PB) );
-                            }else if((pA) && !(pB)){
-                                return true;
-                            }else if(!(pA) && (pB)){
-                                return false;
-                            }
-                            return false; //Both non-points.
-
-                        });
-
-                        //Cycle through the intersections stopping after the point nearest the detector is located.
-                        for(const auto & intersection : intersections){
-                            if(intersection){
-                                const Point* p = boost::get<Point>(&(intersection->first));
-                                if(p){
-                                    //Convert from CGAL vector to Ygor vector.
-                                    const vec3<double> P(static_cast<double>( CGAL::to_double( p->x() )),
-                                                         static_cast<double>( CGAL::to_double( p->y() )),
-                                                         static_cast<double>( CGAL::to_double( p->z() )));
-
-                                    //Compute the distance to the detector.
-                                    const auto P_src_dist = std::abs( detector_plane.Get_Signed_Distance_To_Point(P) );
-                                    DepthImg->reference(row, col, accumulated_counts) = static_cast<float>( P_src_dist );
-
-                                    //Compute the distance to the COM-COM line (between target ROI and reference ROI).
-                                    const auto P_rad_dist = COM_COM_line.Distance_To_Point(P);
-                                    RadialDistImg->reference(row, col, accumulated_counts) = static_cast<float>( P_rad_dist );
-
-                                    //Find the dose at the intersection point.
-                                    const auto interp_val = img_arr_ptr->imagecoll.trilinearly_interpolate(P,0);
-
-                                    accumulated_totaldose += interp_val;
-                                    ++accumulated_counts;
-
-                                    //Determine whether the reference ROI is orthogonally adjacent to this intersection.
-                                    Line cgal_line( Point(ray_start.x, ray_start.y, ray_start.z),
-                                                    Point(ray_end.x,   ray_end.y,   ray_end.z)   );
-                                    
-                                    //Fast check for intersections with the reference ROI.
-                                    if(ref_tree.do_intersect(cgal_line)){
-                                        ++ref_accumulated_counts;
-                                    }
+                    if(method_is_bvh && !all_hits[col].empty()){
+                        const auto &hits = all_hits[col];
+
+                        //Determine whether the reference ROI is orthogonally adjacent to the intersections, i.e.,
+                        // whether the (infinite) ray line intersects it. This only depends on the ray.
+                        auto ref_line = ray;
+                        ref_line.t_min = -std::numeric_limits<double>::infinity();
+                        ref_line.t_max =  std::numeric_limits<double>::infinity();
+                        const bool ref_intersects = ref_bvh->intersects(ref_line);
+
+                        //Cycle through the intersections, nearest to the detector first, stopping after the desired
+                        // number of intersections. Hits are sorted by distance from the source, and the source and
+                        // detector are parallel, so the nearest to the detector is last.
+                        for(auto h_it = std::rbegin(hits); h_it != std::rend(hits); ++h_it){
+                            const vec3<double> P = ray.origin + ray.direction * h_it->t;
+
+                            //Compute the distance to the detector.
+                            const auto P_src_dist = std::abs( detector_plane.Get_Signed_Distance_To_Point(P) );
+                            DepthImg->reference(row, col, accumulated_counts) = static_cast<float>( P_src_dist );
+
+                            //Compute the distance to the COM-COM line (between target ROI and reference ROI).
+                            const auto P_rad_dist = COM_COM_line.Distance_To_Point(P);
+                            RadialDistImg->reference(row, col, accumulated_counts) = static_cast<float>( P_rad_dist );
 
-                                    //Terminate the loop after desired number of intersections.
-                                    if(accumulated_counts >= MaxRaySurfaceIntersections) break;
+                            //Find the dose at the intersection point.
+                            const auto interp_val = img_arr_ptr->imagecoll.trilinearly_interpolate(P,0);
+
+                            accumulated_totaldose += interp_val;
+                            ++accumulated_counts;
+                            if(ref_intersects) ++ref_accumulated_counts;
+
+                            //Terminate the loop after desired number of intersections.
+                            if(accumulated_counts >= MaxRaySurfaceIntersections) break;
+                        }
+
+                    }else if(method_is_aabb){
+                        const vec3<double> ray_start = ray.origin;
+                        const vec3<double> ray_end = ray.origin + ray.direction;
+                        Segment line_segment( Point(ray_start.x, ray_start.y, ray_start.z),
+                                              Point(ray_end.x,   ray_end.y,   ray_end.z)   );
+
+                        //Fast check for intersections.
+                        if(tree->do_intersect(line_segment)){
+
+                            //Enumerate all intersections. Note that some may be line segment "glances."
+                            std::list<Segment_intersection> intersections;
+                            tree->all_intersections(line_segment, std::back_inserter(intersections));
+
+                            //Sort by distance from the detector so the first intersection is closest to the detector.
+                            intersections.sort([&](const Segment_intersection &A, const Segment_intersection &B) -> bool {
+                                const Point *pA = boost::get<Point>(&(A->first));
+                                const Point *pB = boost::get<Point>(&(B->first));
+                                if( (pA) && (pB) ){ // Both valid points.
+                                    const vec3<double> PA(static_cast<double>( CGAL::to_double( pA->x() )),
+                                                          static_cast<double>( CGAL::to_double( pA->y() )),
+                                                          static_cast<double>( CGAL::to_double( pA->z() )));
+                                    const vec3<double> PB(static_cast<double>( CGAL::to_double( pB->x() )),
+                                                          static_cast<double>( CGAL::to_double( pB->y() )),
+                                                          static_cast<double>( CGAL::to_double( pB->z() )));
+                                    return std::abs( detector_plane.Get_Signed_Distance_To_Point(PA) ) 
+                                              < std::abs( detector_plane.Get_Signed_Distance_To_Point(PB) );
+                                }else if((pA) && !(pB)){
+                                    return true;
+                                }else if(!(pA) && (pB)){
+                                    return false;
+                                }
+                                return false; //Both non-points.
+
+                            });
+
+                            //Cycle through the intersections stopping after the point nearest the detector is located.
+                            for(const auto & intersection : intersections){
+                                if(intersection){
+                                    const Point* p = boost::get<Point>(&(intersection->first));
+                                    if(p){
+                                        //Convert from CGAL vector to Ygor vector.
+                                        const vec3<double> P(static_cast<double>( CGAL::to_double( p->x() )),
+                                                             static_cast<double>( CGAL::to_double( p->y() )),
+                                                             static_cast<double>( CGAL::to_double( p->z() )));
+
+                                        //Compute the distance to the detector.
+                                        const auto P_src_dist = std::abs( detector_plane.Get_Signed_Distance_To_Point(P) );
+                                        DepthImg->reference(row, col, accumulated_counts) = static_cast<float>( P_src_dist );
+
+                                        //Compute the distance to the COM-COM line (between target ROI and reference ROI).
+                                        const auto P_rad_dist = COM_COM_line.Distance_To_Point(P);
+                                        RadialDistImg->reference(row, col, accumulated_counts) = static_cast<float>( P_rad_dist );
+
+                                        //Find the dose at the intersection point.
+                                        const auto interp_val = img_arr_ptr->imagecoll.trilinearly_interpolate(P,0);
+
+                                        accumulated_totaldose += interp_val;
+                                        ++accumulated_counts;
+
+                                        //Determine whether the reference ROI is orthogonally adjacent to this intersection.
+                                        Line cgal_line( Point(ray_start.x, ray_start.y, ray_start.z),
+                                                        Point(ray_end.x,   ray_end.y,   ray_end.z)   );
+                                        
+                                        //Fast check for intersections with the reference ROI.
+                                        if(ref_tree->do_intersect(cgal_line)){
+                                            ++ref_accumulated_counts;
+                                        }
+
+                                        //Terminate the loop after desired number of intersections.
+                                        if(accumulated_counts >= MaxRaySurfaceIntersections) break;
+                                    }
                                 }
                             }
                         }
@@ -849,16 +939,24 @@ bool SurfaceBasedRayCastDoseAccumulate(Drover &DICOM_data,
                     if(ref_accumulated_counts != 0){
                         RefCroppedImg->reference(row, col, 0)    = static_cast<float>(accumulated_totaldose);
                     }
+                    if(accumulated_counts != 0) ++row_rays_intersecting;
+                    if(ref_accumulated_counts != 0) ++row_rays_ref_intersecting;
                 }
 
                 {
                     std::lock_guard<std::mutex> lock(printer);
+                    rays_intersecting += row_rays_intersecting;
+                    rays_ref_intersecting += row_rays_ref_intersecting;
                     ++completed;
                     YLOGINFO("Completed " << completed << " of " << SourceDetectorRows 
                           << " --> " << static_cast<int>(1000.0*(completed)/SourceDetectorRows)/10.0 << "% done");
                 }
             });
         }
+        tp.wait();
+
+        YLOGINFO("Number of rays intersecting the ROI surface: " << rays_intersecting);
+        YLOGINFO("Number of rays intersecting the ROI and reference ROI surfaces: " << rays_ref_intersecting);
     } // Complete tasks and terminate thread pool.
 
 
@@ -58,6 +58,8 @@ OperationDoc OpArgDocTime() {
         " If a child operation fails, the remaining child operations are not performed."
     );
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
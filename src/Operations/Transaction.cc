@@ -3,6 +3,7 @@
 #include <any>
 #include <optional>
 #include <functional>
+#include <initializer_list>
 #include <iterator>
 #include <list>
 #include <map>
@@ -23,6 +24,33 @@
 #include "Transaction.h"
 
 
+namespace {
+
+// Estimates which payloads an operation (and any children) might modify in-place, using the footprint declared in
+// each operation's documentation. Operations that cannot be identified, or that have not declared a footprint, are
+// assumed to modify everything.
+drover_payloads_t Operation_Footprint(const OperationArgPkg &op,
+                                      const std::map<std::string, op_packet_t> &known_ops){
+    drover_payloads_t out;
+    out.set_all();
+
+    const auto name = op.getName();
+    for(const auto &p : known_ops){
+        if(!icase_str_eq(name, p.first)) continue;
+
+        const auto doc = p.second.first();
+        if(doc.footprint){
+            out = doc.footprint.value();
+            for(const auto &c : op.getChildren()) out.merge( Operation_Footprint(c, known_ops) );
+        }
+        break;
+    }
+    return out;
+}
+
+} // namespace
+
+
 
 OperationDoc OpArgDocTransaction(){
     OperationDoc out;
@@ -42,7 +70,9 @@ OperationDoc OpArgDocTransaction(){
         " Side-effects will therefore be committed immediately, regardless of whether the transaction succeeds."
     );
     out.notes.emplace_back(
-        "This operation duplicates the full internal data state, so can be memory-intensive."
+        "The snapshot is copy-on-write: data are only duplicated immediately before a child operation that might"
+        " modify them is invoked. Operations that do not declare which data they modify are conservatively assumed to"
+        " modify all data, so transactions can still be memory-intensive."
     );
 
     return out;
@@ -65,12 +95,18 @@ bool Transaction(Drover &DICOM_data,
         YLOGWARN("No children operations specified, forgoing transaction");
     }else{
 
-        // Copy Drover and other relevant internal state.
-        const auto orig_DICOM_data = DICOM_data.Deep_Copy();
+        // Snapshot Drover and other relevant internal state.
+        const auto orig_DICOM_data = DICOM_data.Snapshot();
         const auto orig_InvocationMetadata = InvocationMetadata;
-
-        // Perform children operations.
-        const bool res = Operation_Dispatcher(DICOM_data, InvocationMetadata, FilenameLex, children);
+        const auto known_ops = Known_Operations_and_Aliases();
+
+        // Perform children operations, detaching any shared data that each might modify.
+        bool res = true;
+        for(const auto &child : children){
+            DICOM_data.Detach_Shared(orig_DICOM_data, Operation_Footprint(child, known_ops));
+            res = Operation_Dispatcher(DICOM_data, InvocationMetadata, FilenameLex, { child });
+            if(!res) break;
+        }
         if(res){
             YLOGINFO("Transaction succeeding. Committing state");
             
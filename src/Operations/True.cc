@@ -44,6 +44,8 @@ OperationDoc OpArgDocTrue() {
     out.desc = "This operation is a control flow meta-operation that completes successfully."
                " It has no side effects and evaluates to a no-op.";
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
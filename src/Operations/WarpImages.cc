@@ -55,13 +55,15 @@ OperationDoc OpArgDocWarpImages(){
         "Image metadata may become invalidated by this operation."
     );
     out.notes.emplace_back(
-        "This operation can only handle individual transforms. If multiple, sequential transforms"
-        " are required, this operation must be invoked multiple time. This will guarantee the"
-        " ordering of the transforms."
+        "This operation can only handle individual transforms, with the exception of deformation fields."
+        " If multiple, sequential transforms are required, this operation must be invoked multiple time."
+        " This will guarantee the ordering of the transforms."
+        " If multiple deformation fields are selected, they are applied in the order they are selected"
+        " and are fused into a single field so that the images are only resampled once."
     );
     out.notes.emplace_back(
-        "This operation currently supports only affine transformations."
-        " Local transformations require special handling and voxel resampling that is not yet implemented."
+        "This operation currently supports only affine transformations and deformation fields."
+        " Deformation fields are inverted numerically, which requires the field to be smooth and non-folding."
     );
     out.notes.emplace_back(
         "Transformations are not (generally) restricted to the coordinate frame of reference that they were"
@@ -227,9 +229,28 @@ bool WarpImages(Drover &DICOM_data,
     auto T3s_all = All_T3s( DICOM_data );
     auto T3s = Whitelist( T3s_all, TFormSelectionStr );
     YLOGINFO("Selected " << T3s.size() << " transformation objects");
-    if(T3s.size() != 1){
-        // I can't think of a better way to handle the ordering of multiple transforms right now. Disallowing for now...
-        throw std::invalid_argument("Selection of only a single transformation is currently supported. Refusing to continue.");
+    if(T3s.empty()){
+        throw std::invalid_argument("No transformations selected. Refusing to continue.");
+    }
+
+    // Multiple deformation fields are fused into a single field so the images are only resampled once.
+    // I can't think of a better way to handle the ordering of other multiple transforms right now. Disallowing for now...
+    std::list<Transform3> composed;
+    std::list<std::reference_wrapper<Transform3>> tforms;
+    if(T3s.size() == 1){
+        tforms.push_back( std::ref( *(*( T3s.front() )) ) );
+    }else{
+        std::list<std::reference_wrapper<const deformation_field>> fields;
+        for(auto & t3p_it : T3s){
+            if(!std::holds_alternative<deformation_field>( (*t3p_it)->transform )){
+                throw std::invalid_argument("Selection of multiple transformations is only supported for deformation fields. Refusing to continue.");
+            }
+            fields.push_back( std::cref( std::get<deformation_field>( (*t3p_it)->transform ) ) );
+        }
+        YLOGINFO("Composing " << fields.size() << " deformation fields");
+        composed.emplace_back();
+        composed.back().transform = Compose_Deformation_Fields(fields);
+        tforms.push_back( std::ref( composed.back() ) );
     }
 
 /*
@@ -314,12 +335,12 @@ bool WarpImages(Drover &DICOM_data,
 
         const auto ia_cm = (*iap_it)->imagecoll.get_common_metadata({});
 
-        for(auto & t3p_it : T3s){
+        for(auto & t3_refw : tforms){
             // Invert the transformation, if possible.
             Transform3 t_inv;
             //std::optional<affine_transform<double>> t_inv;
 
-            YLOGINFO("Inverting affine transformation now");
+            YLOGINFO("Inverting transformation now");
             std::visit([&](auto && t){
                 using V = std::decay_t<decltype(t)>;
                 if constexpr (std::is_same_v<V, std::monostate>){
@@ -335,13 +356,13 @@ bool WarpImages(Drover &DICOM_data,
 
                 // Deformation field transformations.
                 }else if constexpr (std::is_same_v<V, deformation_field>){
-                    throw std::invalid_argument("Inverting a deformation field is not yet supported. Unable to continue.");
+                    t_inv.transform = Invert_Deformation_Field(t);
 
                 }else{
                     static_assert(std::is_same_v<V,void>, "Transformation not understood.");
                 }
                 return;
-            }, (*t3p_it)->transform );
+            }, t3_refw.get().transform );
             
             if(std::holds_alternative<std::monostate>( t_inv.transform )){
                 throw std::runtime_error("Unable to invert transformation. Unable to continue.");
@@ -427,7 +448,7 @@ bool WarpImages(Drover &DICOM_data,
 
                             // Deformation field transformations.
                             }else if constexpr (std::is_same_v<V, deformation_field>){
-                                throw std::invalid_argument("Inverting a deformation field is not yet supported. Unable to continue.");
+                                t.apply_to(corr_p);
 
                             }else{
                                 static_assert(std::is_same_v<V,void>, "Transformation not understood.");
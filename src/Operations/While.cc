@@ -65,6 +65,8 @@ OperationDoc OpArgDocWhile() {
     out.args.back().examples    = {"-1", "0", "5", "10", "1000"};
 
 
+    out.footprint = drover_payloads_t();
+
     return out;
 }
 
@@ -0,0 +1,402 @@
+//Ray_Casting.cc - A part of DICOMautomaton 2024. Written by hal clark.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "YgorMath.h"
+
+#include "Ray_Casting.h"
+
+
+namespace dcma_ray_casting {
+
+namespace {
+
+using arr3 = std::array<double, 3>;
+
+const size_t sah_bin_count = 16;
+const uint32_t max_leaf_size = 4;
+const size_t max_packet_size = 32;  // Limited by the width of the ray mask.
+const size_t max_stack_depth = 128;
+
+struct aabb_t {
+    arr3 lo = {{  std::numeric_limits<double>::infinity(),
+                  std::numeric_limits<double>::infinity(),
+                  std::numeric_limits<double>::infinity() }};
+    arr3 hi = {{ -std::numeric_limits<double>::infinity(),
+                 -std::numeric_limits<double>::infinity(),
+                 -std::numeric_limits<double>::infinity() }};
+
+    void expand(const arr3 &p){
+        for(size_t a = 0; a < 3; ++a){
+            lo[a] = std::min(lo[a], p[a]);
+            hi[a] = std::max(hi[a], p[a]);
+        }
+    }
+    void expand(const aabb_t &b){
+        for(size_t a = 0; a < 3; ++a){
+            lo[a] = std::min(lo[a], b.lo[a]);
+            hi[a] = std::max(hi[a], b.hi[a]);
+        }
+    }
+    double half_area() const {
+        const auto dx = hi[0] - lo[0];
+        const auto dy = hi[1] - lo[1];
+        const auto dz = hi[2] - lo[2];
+        if( (dx < 0.0) || (dy < 0.0) || (dz < 0.0) ) return 0.0;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+// A ray in the form used for traversal. Inverse direction components are kept finite so slab tests never produce NaNs.
+struct prepared_ray_t {
+    arr3 o;
+    arr3 d;
+    arr3 inv_d;
+    double t_min;
+    double t_max;
+};
+
+prepared_ray_t prepare_ray(const ray_t &ray){
+    prepared_ray_t r;
+    r.o = {{ ray.origin.x, ray.origin.y, ray.origin.z }};
+    r.d = {{ ray.direction.x, ray.direction.y, ray.direction.z }};
+    for(size_t a = 0; a < 3; ++a){
+        const auto tiny = 1.0E-300;
+        const auto d = (std::abs(r.d[a]) < tiny) ? std::copysign(tiny, r.d[a]) : r.d[a];
+        r.inv_d[a] = 1.0 / d;
+    }
+    r.t_min = ray.t_min;
+    r.t_max = ray.t_max;
+    return r;
+}
+
+inline bool ray_hits_box(const prepared_ray_t &r, const arr3 &lo, const arr3 &hi){
+    double t0 = r.t_min;
+    double t1 = r.t_max;
+    for(size_t a = 0; a < 3; ++a){
+        auto t_near = (lo[a] - r.o[a]) * r.inv_d[a];
+        auto t_far  = (hi[a] - r.o[a]) * r.inv_d[a];
+        if(t_far < t_near) std::swap(t_near, t_far);
+        t0 = (t0 < t_near) ? t_near : t0;
+        t1 = (t_far < t1) ? t_far : t1;
+        if(t1 < t0) return false;
+    }
+    return true;
+}
+
+// Moller-Trumbore ray-triangle intersection. Returns the ray parameter, or NaN if there is no intersection.
+inline double ray_hits_triangle(const prepared_ray_t &r, const arr3 &v0, const arr3 &e1, const arr3 &e2){
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    const arr3 p = {{ r.d[1] * e2[2] - r.d[2] * e2[1],
+                      r.d[2] * e2[0] - r.d[0] * e2[2],
+                      r.d[0] * e2[1] - r.d[1] * e2[0] }};
+    const auto det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    const auto scale = (std::abs(e1[0]) + std::abs(e1[1]) + std::abs(e1[2]))
+                     * (std::abs(p[0]) + std::abs(p[1]) + std::abs(p[2]));
+    if( !(std::abs(det) > scale * 1.0E-12) ) return nan; // Parallel, glancing, or degenerate.
+    const auto inv_det = 1.0 / det;
+
+    const arr3 s = {{ r.o[0] - v0[0], r.o[1] - v0[1], r.o[2] - v0[2] }};
+    const auto u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inv_det;
+    if( (u < 0.0) || (1.0 < u) ) return nan;
+
+    const arr3 q = {{ s[1] * e1[2] - s[2] * e1[1],
+                      s[2] * e1[0] - s[0] * e1[2],
+                      s[0] * e1[1] - s[1] * e1[0] }};
+    const auto v = (r.d[0] * q[0] + r.d[1] * q[1] + r.d[2] * q[2]) * inv_det;
+    if( (v < 0.0) || (1.0 < (u + v)) ) return nan;
+
+    const auto t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inv_det;
+    if( (t < r.t_min) || (r.t_max < t) ) return nan;
+    return t;
+}
+
+} // namespace
+
+
+mesh_bvh::mesh_bvh(const fv_surface_mesh<double, uint64_t> &mesh){
+    // Fan-triangulate faces.
+    std::vector<triangle_t> tris;
+    tris.reserve(mesh.faces.size());
+    const auto N_verts = static_cast<uint64_t>(mesh.vertices.size());
+    for(uint64_t f = 0; f < static_cast<uint64_t>(mesh.faces.size()); ++f){
+        const auto &face = mesh.faces[f];
+        if(face.size() < 3) continue;
+        for(const auto &v : face){
+            if(N_verts <= v) throw std::invalid_argument("Face refers to a non-existent vertex. Cannot continue.");
+        }
+        const auto &A = mesh.vertices[face[0]];
+        for(size_t i = 1; (i + 1) < face.size(); ++i){
+            const auto &B = mesh.vertices[face[i]];
+            const auto &C = mesh.vertices[face[i + 1]];
+            triangle_t t;
+            t.v0 = {{ A.x, A.y, A.z }};
+            t.e1 = {{ B.x - A.x, B.y - A.y, B.z - A.z }};
+            t.e2 = {{ C.x - A.x, C.y - A.y, C.z - A.z }};
+            t.face = f;
+            tris.emplace_back(t);
+        }
+    }
+    const auto N_tris = static_cast<uint32_t>(tris.size());
+    if(static_cast<size_t>(N_tris) != tris.size()){
+        throw std::invalid_argument("Mesh has too many faces. Cannot continue.");
+    }
+
+    std::vector<aabb_t> boxes(N_tris);
+    std::vector<arr3> centroids(N_tris);
+    std::vector<uint32_t> order(N_tris);
+    for(uint32_t i = 0; i < N_tris; ++i){
+        const auto &t = tris[i];
+        const arr3 B = {{ t.v0[0] + t.e1[0], t.v0[1] + t.e1[1], t.v0[2] + t.e1[2] }};
+        const arr3 C = {{ t.v0[0] + t.e2[0], t.v0[1] + t.e2[1], t.v0[2] + t.e2[2] }};
+        boxes[i].expand(t.v0);
+        boxes[i].expand(B);
+        boxes[i].expand(C);
+        for(size_t a = 0; a < 3; ++a) centroids[i][a] = (t.v0[a] + B[a] + C[a]) / 3.0;
+        order[i] = i;
+    }
+
+    // Build top-down using binned SAH splits. Children are allocated in pairs so the second child need not be stored.
+    nodes.reserve(std::max<size_t>(1, 2 * static_cast<size_t>(N_tris) / max_leaf_size + 1));
+    nodes.emplace_back();
+    struct pending_t {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+    };
+    std::vector<pending_t> pending;
+    pending.push_back({ 0, 0, N_tris });
+    while(!pending.empty()){
+        const auto p = pending.back();
+        pending.pop_back();
+
+        aabb_t bounds;
+        aabb_t c_bounds;
+        for(uint32_t i = p.begin; i < p.end; ++i){
+            bounds.expand(boxes[order[i]]);
+            c_bounds.expand(centroids[order[i]]);
+        }
+        nodes[p.node].lo = bounds.lo;
+        nodes[p.node].hi = bounds.hi;
+        nodes[p.node].first = p.begin;
+        nodes[p.node].count = p.end - p.begin;
+
+        const auto N = p.end - p.begin;
+        if(N <= 1) continue;
+
+        // Find the lowest-cost split plane among the bin boundaries along all axes.
+        double best_cost = std::numeric_limits<double>::infinity();
+        size_t best_axis = 0;
+        size_t best_bin = 0;
+        for(size_t a = 0; a < 3; ++a){
+            const auto extent = c_bounds.hi[a] - c_bounds.lo[a];
+            if(!(0.0 < extent)) continue;
+            const auto bin_scale = static_cast<double>(sah_bin_count) / extent;
+
+            std::array<aabb_t, sah_bin_count> bin_boxes;
+            std::array<uint32_t, sah_bin_count> bin_counts;
+            bin_counts.fill(0);
+            for(uint32_t i = p.begin; i < p.end; ++i){
+                const auto b = std::min(sah_bin_count - 1,
+                                        static_cast<size_t>((centroids[order[i]][a] - c_bounds.lo[a]) * bin_scale));
+                bin_boxes[b].expand(boxes[order[i]]);
+                ++(bin_counts[b]);
+            }
+
+            std::array<double, sah_bin_count> right_costs;
+            aabb_t right;
+            uint32_t right_count = 0;
+            for(size_t b = sah_bin_count - 1; 0 < b; --b){
+                right.expand(bin_boxes[b]);
+                right_count += bin_counts[b];
+                right_costs[b] = right.half_area() * static_cast<double>(right_count);
+            }
+            aabb_t left;
+            uint32_t left_count = 0;
+            for(size_t b = 0; (b + 1) < sah_bin_count; ++b){
+                left.expand(bin_boxes[b]);
+                left_count += bin_counts[b];
+                if( (left_count == 0) || (left_count == N) ) continue;
+                const auto cost = left.half_area() * static_cast<double>(left_count) + right_costs[b + 1];
+                if(cost < best_cost){
+                    best_cost = cost;
+                    best_axis = a;
+                    best_bin = b;
+                }
+            }
+        }
+
+        // Stop when splitting is not expected to be cheaper than testing every triangle, unless the leaf would be
+        // large. Triangles with coincident centroids cannot be split.
+        const auto leaf_cost = bounds.half_area() * static_cast<double>(N);
+        if(!std::isfinite(best_cost)) continue;
+        if( (N <= max_leaf_size) && (leaf_cost <= best_cost) ) continue;
+
+        const auto a = best_axis;
+        const auto bin_scale = static_cast<double>(sah_bin_count) / (c_bounds.hi[a] - c_bounds.lo[a]);
+        const auto mid_it = std::partition(std::next(std::begin(order), p.begin),
+                                           std::next(std::begin(order), p.end),
+                                           [&](uint32_t i){
+            const auto b = std::min(sah_bin_count - 1,
+                                    static_cast<size_t>((centroids[i][a] - c_bounds.lo[a]) * bin_scale));
+            return (b <= best_bin);
+        });
+        const auto mid = static_cast<uint32_t>(std::distance(std::begin(order), mid_it));
+        if( (mid == p.begin) || (mid == p.end) ) continue;
+
+        const auto left_node = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        nodes.emplace_back();
+        nodes[p.node].first = left_node;
+        nodes[p.node].count = 0;
+        pending.push_back({ left_node, p.begin, mid });
+        pending.push_back({ left_node + 1, mid, p.end });
+    }
+
+    this->triangles.reserve(N_tris);
+    for(const auto &i : order) this->triangles.emplace_back(tris[i]);
+}
+
+
+std::vector<ray_hit_t>
+mesh_bvh::intersect_all(const ray_t &ray) const {
+    std::vector<ray_hit_t> hits;
+    if(this->triangles.empty()) return hits;
+    const auto r = prepare_ray(ray);
+
+    std::array<uint32_t, max_stack_depth> stack;
+    size_t N_stack = 0;
+    stack[N_stack++] = 0;
+    while(0 < N_stack){
+        const auto &n = this->nodes[stack[--N_stack]];
+        if(!ray_hits_box(r, n.lo, n.hi)) continue;
+
+        if(0 < n.count){
+            for(uint32_t i = n.first; i < (n.first + n.count); ++i){
+                const auto &tri = this->triangles[i];
+                const auto t = ray_hits_triangle(r, tri.v0, tri.e1, tri.e2);
+                if(!std::isnan(t)) hits.push_back({ t, tri.face });
+            }
+        }else{
+            if(max_stack_depth < (N_stack + 2)) throw std::runtime_error("BVH is too deep. Cannot continue.");
+            stack[N_stack++] = n.first + 1;
+            stack[N_stack++] = n.first;
+        }
+    }
+
+    std::sort(std::begin(hits), std::end(hits), [](const ray_hit_t &A, const ray_hit_t &B){
+        return (A.t < B.t);
+    });
+    return hits;
+}
+
+
+bool
+mesh_bvh::intersects(const ray_t &ray) const {
+    if(this->triangles.empty()) return false;
+    const auto r = prepare_ray(ray);
+
+    std::array<uint32_t, max_stack_depth> stack;
+    size_t N_stack = 0;
+    stack[N_stack++] = 0;
+    while(0 < N_stack){
+        const auto &n = this->nodes[stack[--N_stack]];
+        if(!ray_hits_box(r, n.lo, n.hi)) continue;
+
+        if(0 < n.count){
+            for(uint32_t i = n.first; i < (n.first + n.count); ++i){
+                const auto &tri = this->triangles[i];
+                if(!std::isnan(ray_hits_triangle(r, tri.v0, tri.e1, tri.e2))) return true;
+            }
+        }else{
+            if(max_stack_depth < (N_stack + 2)) throw std::runtime_error("BVH is too deep. Cannot continue.");
+            stack[N_stack++] = n.first + 1;
+            stack[N_stack++] = n.first;
+        }
+    }
+    return false;
+}
+
+
+std::vector<std::vector<ray_hit_t>>
+mesh_bvh::intersect_all(const std::vector<ray_t> &rays) const {
+    std::vector<std::vector<ray_hit_t>> hits(rays.size());
+    if(this->triangles.empty()) return hits;
+
+    // Each node is fetched and tested once per packet, carrying a mask of the rays that are still active in its
+    // subtree. Rays that miss a node are masked out for its whole subtree.
+    std::vector<prepared_ray_t> packet;
+    packet.reserve(max_packet_size);
+    struct entry_t {
+        uint32_t node;
+        uint32_t mask;
+    };
+    std::array<entry_t, max_stack_depth> stack;
+
+    for(size_t p_begin = 0; p_begin < rays.size(); p_begin += max_packet_size){
+        const auto p_end = std::min(rays.size(), p_begin + max_packet_size);
+        const auto N_packet = p_end - p_begin;
+        packet.clear();
+        for(size_t i = p_begin; i < p_end; ++i) packet.emplace_back( prepare_ray(rays[i]) );
+
+        size_t N_stack = 0;
+        const uint32_t all_mask = (N_packet == 32) ? ~static_cast<uint32_t>(0)
+                                                   : ((static_cast<uint32_t>(1) << N_packet) - 1);
+        stack[N_stack++] = { 0, all_mask };
+        while(0 < N_stack){
+            const auto e = stack[--N_stack];
+            const auto &n = this->nodes[e.node];
+
+            uint32_t mask = 0;
+            for(size_t j = 0; j < N_packet; ++j){
+                const uint32_t bit = static_cast<uint32_t>(1) << j;
+                if( ((e.mask & bit) != 0) && ray_hits_box(packet[j], n.lo, n.hi) ) mask |= bit;
+            }
+            if(mask == 0) continue;
+
+            if(0 < n.count){
+                for(uint32_t i = n.first; i < (n.first + n.count); ++i){
+                    const auto &tri = this->triangles[i];
+                    for(size_t j = 0; j < N_packet; ++j){
+                        if((mask & (static_cast<uint32_t>(1) << j)) == 0) continue;
+                        const auto t = ray_hits_triangle(packet[j], tri.v0, tri.e1, tri.e2);
+                        if(!std::isnan(t)) hits[p_begin + j].push_back({ t, tri.face });
+                    }
+                }
+            }else{
+                if(max_stack_depth < (N_stack + 2)) throw std::runtime_error("BVH is too deep. Cannot continue.");
+                stack[N_stack++] = { n.first + 1, mask };
+                stack[N_stack++] = { n.first, mask };
+            }
+        }
+    }
+
+    for(auto &h : hits){
+        std::sort(std::begin(h), std::end(h), [](const ray_hit_t &A, const ray_hit_t &B){
+            return (A.t < B.t);
+        });
+    }
+    return hits;
+}
+
+
+size_t
+mesh_bvh::triangle_count() const {
+    return this->triangles.size();
+}
+
+
+size_t
+mesh_bvh::node_count() const {
+    return this->nodes.size();
+}
+
+} // namespace dcma_ray_casting
+
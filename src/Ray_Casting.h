@@ -0,0 +1,187 @@
+//Ray_Casting.h - A part of DICOMautomaton 2024. Written by hal clark.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "YgorMath.h"
+
+// This file provides a shared ray-tracing core for operations that cast many rays, e.g., from every pixel of a detector.
+//
+// Surface meshes are wrapped in a bounding volume hierarchy (BVH) built using the surface area heuristic (SAH), so each
+// ray only visits a logarithmic number of nodes. Coherent rays (e.g., neighbouring detector pixels) can be traced as a
+// packet, which shares node visits and triangle fetches among the rays.
+//
+// Image volumes are traversed voxel-by-voxel using a 3D digital differential analyzer (i.e., Siddon's method), which
+// visits exactly the voxels a ray passes through and reports the exact intersection length within each voxel.
+
+namespace dcma_ray_casting {
+
+// A ray segment spanning origin + direction * t for t in [t_min, t_max]. The direction need not be normalized.
+struct ray_t {
+    vec3<double> origin;
+    vec3<double> direction;
+    double t_min = 0.0;
+    double t_max = 1.0;
+};
+
+struct ray_hit_t {
+    double t = 0.0;     // The hit is at origin + direction * t.
+    uint64_t face = 0;  // Index of the mesh face that was hit.
+};
+
+// A BVH over the faces of a surface mesh. Polygonal faces are fan-triangulated, and faces with fewer than three vertices
+// are ignored.
+//
+// The BVH holds copies of the triangle vertices, so it remains valid if the source mesh is altered or destroyed.
+// Queries are thread-safe.
+class mesh_bvh {
+    private:
+        struct node_t {
+            std::array<double, 3> lo;
+            std::array<double, 3> hi;
+            uint32_t first = 0;  // Leaves: first triangle. Interior nodes: first child (the second child follows it).
+            uint32_t count = 0;  // Number of triangles. Zero for interior nodes.
+        };
+
+        struct triangle_t {
+            std::array<double, 3> v0;
+            std::array<double, 3> e1; // v1 - v0.
+            std::array<double, 3> e2; // v2 - v0.
+            uint64_t face = 0;
+        };
+
+        std::vector<node_t> nodes;
+        std::vector<triangle_t> triangles; // Ordered so each leaf refers to a contiguous range.
+
+    public:
+        explicit mesh_bvh(const fv_surface_mesh<double, uint64_t> &mesh);
+
+        // Returns all hits within the ray segment, sorted by t. Hits along edges shared by multiple triangles may be
+        // reported once per triangle. Rays that glance (i.e., are coplanar with) a triangle do not hit it.
+        std::vector<ray_hit_t> intersect_all(const ray_t &ray) const;
+
+        // Returns true if the ray segment hits anything. Faster than intersect_all() because traversal stops at the
+        // first hit.
+        bool intersects(const ray_t &ray) const;
+
+        // Traces a packet of rays together, returning the hits for each ray (sorted by t) in the same order as the
+        // rays. Best performance is achieved when the rays are coherent, e.g., neighbouring detector pixels.
+        std::vector<std::vector<ray_hit_t>> intersect_all(const std::vector<ray_t> &rays) const;
+
+        size_t triangle_count() const;
+        size_t node_count() const;
+};
+
+
+// A regular, rectilinear voxel grid. The centre of voxel (row, column, image) = (i, j, k) is located at
+//
+//     zero + row_unit * (i * pxl_dx) + col_unit * (j * pxl_dy) + img_unit * (k * pxl_dz),
+//
+// where the unit vectors are orthonormal.
+struct voxel_grid_t {
+    vec3<double> zero;
+    vec3<double> row_unit;
+    vec3<double> col_unit;
+    vec3<double> img_unit;
+    double pxl_dx = 1.0;
+    double pxl_dy = 1.0;
+    double pxl_dz = 1.0;
+    int64_t N_rows = 0;
+    int64_t N_cols = 0;
+    int64_t N_imgs = 0;
+};
+
+// Visits, in order, every voxel intersected by the line segment from A to B, invoking f(i, j, k, length) where length
+// is the length of the portion of the segment within the voxel. Portions of the segment outside the grid are ignored.
+template <class F>
+void
+Traverse_Voxels(const voxel_grid_t &grid,
+                const vec3<double> &A,
+                const vec3<double> &B,
+                F &&f){
+    const double length = A.distance(B);
+    if( !std::isfinite(length) || (length <= 0.0) ) return;
+
+    // Work in continuous voxel coordinates, where voxel i spans [i, i+1) along each axis.
+    const std::array<int64_t, 3> N = {{ grid.N_rows, grid.N_cols, grid.N_imgs }};
+    const std::array<double, 3> pxl = {{ grid.pxl_dx, grid.pxl_dy, grid.pxl_dz }};
+    const std::array<vec3<double>, 3> units = {{ grid.row_unit, grid.col_unit, grid.img_unit }};
+    std::array<double, 3> u0;
+    std::array<double, 3> du;
+    for(size_t a = 0; a < 3; ++a){
+        if(N[a] <= 0) return;
+        u0[a] = (A - grid.zero).Dot(units[a]) / pxl[a] + 0.5;
+        du[a] = (B - A).Dot(units[a]) / pxl[a];
+    }
+
+    // Clip the segment to the grid.
+    double t_lo = 0.0;
+    double t_hi = 1.0;
+    for(size_t a = 0; a < 3; ++a){
+        if(du[a] == 0.0){
+            if( (u0[a] < 0.0) || (static_cast<double>(N[a]) <= u0[a]) ) return;
+            continue;
+        }
+        auto t_a = (0.0 - u0[a]) / du[a];
+        auto t_b = (static_cast<double>(N[a]) - u0[a]) / du[a];
+        if(t_b < t_a) std::swap(t_a, t_b);
+        t_lo = std::max(t_lo, t_a);
+        t_hi = std::min(t_hi, t_b);
+    }
+    if(!(t_lo < t_hi)) return;
+
+    // Locate the first voxel using the midpoint of the first step, which avoids ambiguity when the clipped segment
+    // starts on a voxel boundary.
+    std::array<int64_t, 3> idx;
+    std::array<int64_t, 3> step;
+    std::array<double, 3> t_next;  // Segment parameter at the next boundary crossing along each axis.
+    std::array<double, 3> t_delta; // Segment parameter increment between boundary crossings along each axis.
+    const auto inf = std::numeric_limits<double>::infinity();
+    for(size_t a = 0; a < 3; ++a){
+        const auto u = u0[a] + du[a] * t_lo;
+        auto i = static_cast<int64_t>(std::floor(u));
+        if( (du[a] < 0.0) && (static_cast<double>(i) == u) ) --i;
+        idx[a] = std::clamp<int64_t>(i, 0, N[a] - 1);
+
+        if(0.0 < du[a]){
+            step[a] = 1;
+            t_delta[a] = 1.0 / du[a];
+            t_next[a] = (static_cast<double>(idx[a] + 1) - u0[a]) / du[a];
+        }else if(du[a] < 0.0){
+            step[a] = -1;
+            t_delta[a] = -1.0 / du[a];
+            t_next[a] = (static_cast<double>(idx[a]) - u0[a]) / du[a];
+        }else{
+            step[a] = 0;
+            t_delta[a] = inf;
+            t_next[a] = inf;
+        }
+    }
+
+    double t = t_lo;
+    while(t < t_hi){
+        size_t a = 0;
+        if(t_next[1] < t_next[a]) a = 1;
+        if(t_next[2] < t_next[a]) a = 2;
+
+        const auto t_exit = std::min(t_next[a], t_hi);
+        if(t < t_exit){
+            f(idx[0], idx[1], idx[2], (t_exit - t) * length);
+        }
+        t = t_exit;
+
+        idx[a] += step[a];
+        t_next[a] += t_delta[a];
+        if( (idx[a] < 0) || (N[a] <= idx[a]) ) break;
+    }
+    return;
+}
+
+} // namespace dcma_ray_casting
+
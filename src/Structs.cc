@@ -7,11 +7,14 @@
 #include <optional>
 #include <functional>
 #include <initializer_list>
+#include <list>
 #include <map>
+#include <mutex>
 #include <ostream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>   //For std::pair.
 #include <vector>
 #include <variant>
@@ -530,13 +533,89 @@ Image_Array::Image_Array(const Image_Array &rhs){
     *this = rhs; //Performs a deep copy (unless copying self).
 }
 
+Image_Array::~Image_Array(){
+    Forget_Deferred_Pixel_Sources(this->imagecoll.images);
+}
+
 Image_Array & Image_Array::operator=(const Image_Array &rhs){
     if(this != &rhs){
+        // Note: list assignment may reuse the existing images, so their sources must be forgotten beforehand.
+        Forget_Deferred_Pixel_Sources(this->imagecoll.images);
         this->imagecoll  = rhs.imagecoll;
+        Copy_Deferred_Pixel_Sources(rhs.imagecoll.images, std::begin(this->imagecoll.images));
     }
     return *this;
 }
 
+//---------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------- Deferred Pixel Sources -------------------------------------------------
+//---------------------------------------------------------------------------------------------------------------------------
+namespace {
+
+struct deferred_pixel_sources_t {
+    std::mutex m;
+    std::map<const planar_image<float,double> *, std::string> sources;
+};
+
+deferred_pixel_sources_t & get_deferred_pixel_sources(){
+    // Note: intentionally leaked so that image arrays destroyed during static destruction can still access it.
+    static auto *t = new deferred_pixel_sources_t();
+    return *t;
+}
+
+} // namespace
+
+std::optional<std::string> Get_Deferred_Pixel_Source(const planar_image<float,double> &img){
+    std::optional<std::string> out;
+    if(!img.data.empty()) return out;
+
+    auto &t = get_deferred_pixel_sources();
+    std::lock_guard<std::mutex> lock(t.m);
+    const auto it = t.sources.find( &img );
+    if(it != std::end(t.sources)) out = it->second;
+    return out;
+}
+
+void Set_Deferred_Pixel_Source(const planar_image<float,double> &img, const std::string &source){
+    auto &t = get_deferred_pixel_sources();
+    std::lock_guard<std::mutex> lock(t.m);
+    t.sources[ &img ] = source;
+    return;
+}
+
+void Forget_Deferred_Pixel_Source(const planar_image<float,double> &img){
+    auto &t = get_deferred_pixel_sources();
+    std::lock_guard<std::mutex> lock(t.m);
+    t.sources.erase( &img );
+    return;
+}
+
+void Forget_Deferred_Pixel_Sources(const std::list<planar_image<float,double>> &imgs){
+    auto &t = get_deferred_pixel_sources();
+    std::lock_guard<std::mutex> lock(t.m);
+    if(t.sources.empty()) return;
+    for(const auto &img : imgs) t.sources.erase( &img );
+    return;
+}
+
+void Copy_Deferred_Pixel_Sources(const std::list<planar_image<float,double>> &from,
+                                 std::list<planar_image<float,double>>::iterator to){
+    auto &t = get_deferred_pixel_sources();
+    std::lock_guard<std::mutex> lock(t.m);
+    if(t.sources.empty()) return;
+    for(const auto &img : from){
+        const auto it = t.sources.find( &img );
+        if( (it != std::end(t.sources))
+        &&  img.data.empty() ){
+            t.sources[ &(*to) ] = it->second;
+        }else{
+            t.sources.erase( &(*to) );
+        }
+        ++to;
+    }
+    return;
+}
+
 //---------------------------------------------------------------------------------------------------------------------------
 //-------------------------------------------------------- Point_Cloud ------------------------------------------------------
 //---------------------------------------------------------------------------------------------------------------------------
@@ -1575,6 +1654,77 @@ Drover Drover::Deep_Copy() const {
     return out;
 }
 
+Drover Drover::Snapshot() const {
+    return Drover(*this);
+}
+
+void Drover::Detach_Shared(const Drover &snapshot, const drover_payloads_t &which){
+    // Note: a payload may be referenced multiple times, so each shared payload is copied only once and all references
+    // are redirected to the single copy.
+    const auto detach = [](auto &live, const auto &snap){
+        using ptr_t = typename std::decay_t<decltype(live)>::value_type;
+        std::map<const void*, ptr_t> copies;
+        for(const auto &p : snap){
+            if(p != nullptr) copies[ static_cast<const void*>(p.get()) ] = nullptr;
+        }
+        if(copies.empty()) return;
+
+        for(auto &p : live){
+            if(p == nullptr) continue;
+            auto c_it = copies.find( static_cast<const void*>(p.get()) );
+            if(c_it == std::end(copies)) continue;
+            if(c_it->second == nullptr){
+                c_it->second = std::make_shared<typename ptr_t::element_type>(*p);
+            }
+            p = c_it->second;
+        }
+        return;
+    };
+
+    if( which.contours
+    &&  (this->contour_data != nullptr)
+    &&  (this->contour_data == snapshot.contour_data) ){
+        this->contour_data = this->contour_data->Duplicate();
+    }
+    if(which.images)   detach(this->image_data,  snapshot.image_data);
+    if(which.points)   detach(this->point_data,  snapshot.point_data);
+    if(which.meshes)   detach(this->smesh_data,  snapshot.smesh_data);
+    if(which.rtplans)  detach(this->rtplan_data, snapshot.rtplan_data);
+    if(which.lsamps)   detach(this->lsamp_data,  snapshot.lsamp_data);
+    if(which.trans)    detach(this->trans_data,  snapshot.trans_data);
+    if(which.tables)   detach(this->table_data,  snapshot.table_data);
+    return;
+}
+
+drover_payloads_t & drover_payloads_t::set_all(){
+    this->contours = true;
+    this->images   = true;
+    this->points   = true;
+    this->meshes   = true;
+    this->rtplans  = true;
+    this->lsamps   = true;
+    this->trans    = true;
+    this->tables   = true;
+    return *this;
+}
+
+drover_payloads_t & drover_payloads_t::merge(const drover_payloads_t &rhs){
+    this->contours = this->contours || rhs.contours;
+    this->images   = this->images   || rhs.images;
+    this->points   = this->points   || rhs.points;
+    this->meshes   = this->meshes   || rhs.meshes;
+    this->rtplans  = this->rtplans  || rhs.rtplans;
+    this->lsamps   = this->lsamps   || rhs.lsamps;
+    this->trans    = this->trans    || rhs.trans;
+    this->tables   = this->tables   || rhs.tables;
+    return *this;
+}
+
+bool drover_payloads_t::any() const {
+    return this->contours || this->images || this->points || this->meshes
+        || this->rtplans  || this->lsamps || this->trans  || this->tables;
+}
+
 bool Drover::Has_Contour_Data() const {
     return (this->contour_data != nullptr);
 }
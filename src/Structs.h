@@ -129,11 +129,28 @@ class Image_Array { //: public Base_Array {
         //Constructor/Destructors.
         Image_Array();
         Image_Array(const Image_Array &rhs); //Performs a deep copy (unless copying self).
+        ~Image_Array(); //Forgets the deferred pixel sources of the images.
 
         //Member functions.
         Image_Array & operator=(const Image_Array &rhs); //Performs a deep copy (unless copying self).
 };
 
+// Side table recording where the pixel data can be found for images whose pixels are not resident in memory (see
+// Deferred_Pixels.h). Sources are kept out of the image metadata so they are never exported or used for grouping.
+//
+// Sources are keyed by image address. Images are held in std::lists, so they can be reordered or spliced between
+// image arrays freely. Image_Array carries sources over to copies and forgets them when destroyed. Images with resident
+// pixels never have a source, so a stale entry for a reused address is ignored.
+std::optional<std::string> Get_Deferred_Pixel_Source(const planar_image<float,double> &img);
+void Set_Deferred_Pixel_Source(const planar_image<float,double> &img, const std::string &source);
+void Forget_Deferred_Pixel_Source(const planar_image<float,double> &img);
+void Forget_Deferred_Pixel_Sources(const std::list<planar_image<float,double>> &imgs);
+
+// Copies the deferred pixel source of each image in 'from' onto the corresponding (i.e., same position) image in the
+// sequence starting at 'to', which must contain copies of the images in 'from'.
+void Copy_Deferred_Pixel_Sources(const std::list<planar_image<float,double>> &from,
+                                 std::list<planar_image<float,double>>::iterator to);
+
 
 // This class is meant to hold a simple 3D point cloud.
 class Point_Cloud {
@@ -426,6 +443,22 @@ drover_bnded_dose_min_mean_median_max_dose_map_t drover_bnded_dose_min_mean_medi
 drover_bnded_dose_pos_dose_map_t                 drover_bnded_dose_pos_dose_map_factory();
 drover_bnded_dose_stat_moments_map_t             drover_bnded_dose_stat_moments_map_factory();
 
+// Identifies categories of Drover payloads, e.g., those that an operation might modify in-place.
+struct drover_payloads_t {
+    bool contours = false;
+    bool images   = false;
+    bool points   = false;
+    bool meshes   = false;
+    bool rtplans  = false;
+    bool lsamps   = false;
+    bool trans    = false;
+    bool tables   = false;
+
+    drover_payloads_t & set_all();
+    drover_payloads_t & merge(const drover_payloads_t &rhs);
+    bool any() const;
+};
+
 class Drover {
     public:
 
@@ -469,6 +502,12 @@ class Drover {
         Drover Duplicate(const Contour_Data &in) const; 
         Drover Duplicate(const Drover &in) const;
         Drover Deep_Copy() const; // Make a deep copy of *this.
+
+        // Copy-on-write support. A snapshot shares all payloads with *this. Before payloads are modified in-place,
+        // Detach_Shared() replaces any that are still shared with the snapshot with private copies so the snapshot
+        // remains unaltered. Payloads added after the snapshot was taken are never copied.
+        Drover Snapshot() const;
+        void Detach_Shared(const Drover &snapshot, const drover_payloads_t &which);
     
         bool Has_Contour_Data() const;
         bool Has_Image_Data() const;
@@ -603,5 +642,10 @@ struct OperationDoc {
     std::string desc; // Documentation for the operation itself.
     std::list<std::string> notes; // Special notes concerning the operation, usually caveats or notices.
 
+    // The payloads the operation might modify in-place. Adding or removing whole payloads, or merely reading them,
+    // does not count as modifying them. Operations that do not declare a footprint are assumed to modify everything.
+    // Payloads modified by children operations are accounted for separately.
+    std::optional<drover_payloads_t> footprint;
+
 };
 
@@ -7,12 +7,16 @@
 #include <string>    
 #include <vector>
 #include <map>
+#include <set>
 #include <list>
+#include <memory>
 #include <functional>
 #include <array>
 #include <mutex>
+#include <atomic>
 #include <limits>
 #include <cmath>
+#include <cstdint>
 
 #include <utility>            //Needed for std::pair.
 #include <algorithm>
@@ -21,6 +25,7 @@
     #define BOOST_PARAMETER_MAX_ARITY 12
 
     #include <CGAL/subdivision_method_3.h>
+    #include <CGAL/convex_hull_3.h>
     #include <CGAL/OFF_to_nef_3.h>
     #include <CGAL/Min_sphere_of_spheres_d.h>
 
@@ -63,6 +68,7 @@
 #include "CSG_SDF.h"
 
 #include "YgorImages_Functors/Grouping/Misc_Functors.h"
+#include "YgorImages_Functors/Contour_Voxel_Index.h"
 #include "YgorImages_Functors/Processing/Partitioned_Image_Voxel_Visitor_Mutator.h"
 
 #include "Surface_Meshes.h"
@@ -71,6 +77,16 @@
 // ----------------------------------------------- Pure contour meshing -----------------------------------------------
 namespace dcma_surface_meshes {
 
+// Partially-connected mesh covering the cubes between a single image and the next adjacent image.
+struct per_img_fv_mesh_t {
+    std::vector<vec3<double>> verts;
+    std::vector<std::vector<uint64_t>> faces;
+
+    std::vector<std::vector<uint64_t>> fsrel; // which img num vert num is relative to.
+    std::vector<uint64_t> vscor; // lower bound index of the local verts that correspond to a given voxel.
+};
+using per_img_fv_meshes_t = std::map<long int, per_img_fv_mesh_t>;
+
 // Marching Cubes core implementation. This routine must be fed an image volume.
 //
 // NOTE: This implementation borrows from the public domain implementation available at
@@ -79,7 +95,10 @@ namespace dcma_surface_meshes {
 //       version to support rectangular cubes, avoid 3D interpolation, and explicitly constructs a polyhedron mesh.
 //       Thanks Cory! Thanks Paul!
 //
-
+// Partial meshes can optionally be retained and reused. If 'retained' holds the partial meshes from a previous call
+// with the same grid, only the partial meshes affected by the 'altered' images are recomputed. Otherwise all partial
+// meshes are computed and stored in 'retained' for later reuse.
+//
 static
 fv_surface_mesh<double, uint64_t>
 Marching_Cubes_Implementation(
@@ -89,7 +108,9 @@ Marching_Cubes_Implementation(
         bool below_is_interior,  // Controls how the inclusion_threshold is interpretted.
                                  // If true, anything <= is considered to be interior to the surface.
                                  // If false, anything >= is considered to be interior to the surface.
-        Parameters /*params*/ ){
+        Parameters /*params*/,
+        per_img_fv_meshes_t *retained = nullptr,
+        const std::set<const planar_image<float,double>*> *altered = nullptr ){
 
     const double ExteriorVal = inclusion_threshold + (below_is_interior ? 1.0 : -1.0);
 
@@ -422,19 +443,51 @@ Marching_Cubes_Implementation(
 
     // Storage for partially-connected meshes within the plane of a single image.
     // Data is processed one image at a time and we only merge meshes and de-duplicate out-of-plane vertices afterward.
-    struct per_img_fv_mesh_t {
-        std::vector<vec3<double>> verts;
-        std::vector<std::vector<uint64_t>> faces;
+    per_img_fv_meshes_t l_per_img_fv_mesh;
+    auto &per_img_fv_mesh = (retained != nullptr) ? *retained : l_per_img_fv_mesh;
+    const auto [img_num_min, img_num_max] = img_adj.get_min_max_indices();
+    const auto N_img_nums = static_cast<size_t>(img_num_max - img_num_min + 1);
 
-        std::vector<std::vector<uint64_t>> fsrel; // which img num vert num is relative to.
-        std::vector<uint64_t> vscor; // lower bound index of the local verts that correspond to a given voxel.
-    };
-    std::map<long int, per_img_fv_mesh_t> per_img_fv_mesh;
+    // Determine which partial meshes need to be (re)computed.
+    //
+    // The partial mesh for an image covers the cubes spanning it and the next image, so altering an image affects two
+    // partial meshes. Even-numbered partial meshes also refer to vertices in the adjacent odd-numbered partial meshes,
+    // so they must be recomputed whenever either neighbour is.
+    const bool reuse_retained = (retained != nullptr)
+                             && (altered != nullptr)
+                             && (per_img_fv_mesh.size() == N_img_nums)
+                             && (per_img_fv_mesh.begin()->first == 0L)
+                             && (per_img_fv_mesh.rbegin()->first == static_cast<long int>(N_img_nums) - 1L);
+    std::set<long int> img_nums_to_compute;
+    if(reuse_retained){
+        const long int l_min = img_num_min;
+        const long int l_max = img_num_max;
+        const auto mark = [&](long int i){
+            if( (l_min <= i) && (i <= l_max) ) img_nums_to_compute.insert(i);
+        };
+        for(long int i = img_num_min; i <= img_num_max; ++i){
+            if(altered->count( &(img_adj.index_to_image(i).get()) ) == 0) continue;
+            mark(i - 1);
+            mark(i);
+        }
+        const auto directly_affected = img_nums_to_compute;
+        for(const auto &i : directly_affected){
+            if(i % 2 == 0) continue;
+            mark(i - 1);
+            mark(i + 1);
+        }
+    }else{
+        per_img_fv_mesh.clear();
+        for(long int i = img_num_min; i <= img_num_max; ++i){
+            img_nums_to_compute.insert(i);
+        }
+    }
 
     // Prime the map.
-    const auto [img_num_min, img_num_max] = img_adj.get_min_max_indices();
-    for(long int i = img_num_min; i <= img_num_max; ++i){
-        per_img_fv_mesh[i - img_num_min].vscor.emplace_back(0);
+    for(const auto &i : img_nums_to_compute){
+        auto &l_mini_mesh = per_img_fv_mesh[i - img_num_min];
+        l_mini_mesh = per_img_fv_mesh_t();
+        l_mini_mesh.vscor.emplace_back(0);
     }
     const auto vscor_index = [](long int N_rows, long int N_cols, 
                                 long int drow, long int dcol) -> long int {
@@ -443,7 +496,7 @@ Marching_Cubes_Implementation(
 
     std::mutex saver_printer; // Thread synchro lock for saving shared data, logging, and counter iterating.
     long int completed = 0;
-    const long int img_count = grid_imgs.size();
+    const long int img_count = img_nums_to_compute.size();
     auto final_merge_tol = std::numeric_limits<double>::infinity();
 
     // Iterate over all voxels, traversing the images in order of adjacency for consistency.
@@ -520,10 +573,14 @@ Marching_Cubes_Implementation(
         per_img_fv_mesh_t* m_mini_mesh_ptr = &(per_img_fv_mesh[shifted_img_num]); // 'Middle' (current) image plane.
         per_img_fv_mesh_t* l_mini_mesh_ptr = nullptr; // 'Lower' adjacent image plane.
         per_img_fv_mesh_t* u_mini_mesh_ptr = nullptr; // 'Upper' adjacent image plane.
-        if(per_img_fv_mesh.count(shifted_img_num - 1L) != 0){
+
+        // Only even-numbered images refer to vertices in the adjacent images, which are always processed beforehand.
+        // Odd-numbered partial meshes are therefore self-contained.
+        const bool refer_to_adjacent = (img_num % 2 == 0);
+        if(refer_to_adjacent && (per_img_fv_mesh.count(shifted_img_num - 1L) != 0)){
             l_mini_mesh_ptr = &(per_img_fv_mesh[shifted_img_num - 1L]);
         }
-        if(per_img_fv_mesh.count(shifted_img_num + 1L) != 0){
+        if(refer_to_adjacent && (per_img_fv_mesh.count(shifted_img_num + 1L) != 0)){
             u_mini_mesh_ptr = &(per_img_fv_mesh[shifted_img_num + 1L]);
         }
 
@@ -795,22 +852,37 @@ Marching_Cubes_Implementation(
 
     // NOTE: if lower memory use is needed, we can further break down the traversal order and eagerly purge sidecar
     // information (e.g., vscor for completely deduplicated submeshes).
+    if(reuse_retained){
+        YLOGINFO("Re-extracting " << img_count << " of " << N_img_nums << " image meshes");
+    }
     YLOGINFO("Extracting odd-numbered image meshes");
     {
-        asio_thread_pool tp;
-        for(long int i = img_num_min; i <= img_num_max; ++i){
+        task_group tp;
+        for(const auto &i : img_nums_to_compute){
             if( i % 2 == 0 ) continue;
             tp.submit_task( std::bind(work, img_adj.index_to_image(i)) );
         }
+        tp.wait();
     }
 
     YLOGINFO("Extracting even-numbered image meshes");
     {
-        asio_thread_pool tp;
-        for(long int i = img_num_min; i <= img_num_max; ++i){
-            if( i % 2 == 1 ) continue;
+        task_group tp;
+        for(const auto &i : img_nums_to_compute){
+            if( i % 2 != 0 ) continue;
             tp.submit_task( std::bind(work, img_adj.index_to_image(i)) );
         }
+        tp.wait();
+    }
+
+    // Even-numbered partial meshes are never referred to, so their voxel-vertex correspondence is no longer needed.
+    if(retained != nullptr){
+        for(const auto &i : img_nums_to_compute){
+            if( i % 2 != 0 ) continue;
+            auto &l_vscor = per_img_fv_mesh[i - img_num_min].vscor;
+            l_vscor.assign(1, 0);
+            l_vscor.shrink_to_fit();
+        }
     }
 
     YLOGINFO("Joining mesh partitions..");
@@ -823,29 +895,25 @@ Marching_Cubes_Implementation(
         verts_offset.push_back( prev_total + l_N_verts );
     }
 
-    // Adjust indices to account for vertices being merged together sequentially.
-// NOTE: this loop can be parallelized too!
-    for(auto& [img_num, l_mini_mesh] : per_img_fv_mesh){
+    // Insert the vertices and indices, adjusting the latter to account for vertices being merged together sequentially.
+    // The partial meshes are left unaltered so they can be retained.
+    fv_surface_mesh<double, uint64_t> fv_mesh;
+    for(const auto& [img_num, l_mini_mesh] : per_img_fv_mesh){
+        fv_mesh.vertices.insert( std::end(fv_mesh.vertices),
+                                 std::begin(l_mini_mesh.verts), std::end(l_mini_mesh.verts) );
+
         const auto l_N_faces = l_mini_mesh.faces.size();
         for(size_t i = 0; i < l_N_faces; ++i){
-            const auto l_N_vert_indices = l_mini_mesh.faces[i].size();
+            fv_mesh.faces.emplace_back( l_mini_mesh.faces[i] );
+            auto &face = fv_mesh.faces.back();
+            const auto l_N_vert_indices = face.size();
             for(size_t j = 0; j < l_N_vert_indices; ++j){
                 const auto l_img_num = l_mini_mesh.fsrel[i][j];
-                l_mini_mesh.faces[i][j] += verts_offset[ l_img_num ];
+                face[j] += verts_offset[ l_img_num ];
             }
         }
     }
 
-    // Insert the vertices and adjusted indices.
-    fv_surface_mesh<double, uint64_t> fv_mesh;
-    for(auto& [img_num, l_mini_mesh] : per_img_fv_mesh){
-        fv_mesh.vertices.insert( std::end(fv_mesh.vertices),
-                                 std::begin(l_mini_mesh.verts), std::end(l_mini_mesh.verts) );
-
-        fv_mesh.faces.insert( std::end(fv_mesh.faces),
-                              std::begin(l_mini_mesh.faces), std::end(l_mini_mesh.faces) );
-    }
-
 //    YLOGINFO("Deduplicating vertices..");
 //    fv_mesh.merge_duplicate_vertices(final_merge_tol);
 
@@ -1055,30 +1123,79 @@ Marching_Cubes_Implementation(
 
 
 
-// This sub-routine performs the Marching Cubes algorithm for the given ROI contours.
-// ROI inclusivity is separately pre-computed before surface probing by generating an inclusivity mask on a
-// custom-fitted planar image collection. This is done for performance purposes and so inclusivity and surface
-// meshing can be separately tweaked as necessary.
-//
-// NOTE: This routine does not require the images that the contours were originally generated on.
-//       A custom set of dummy images that contiguously cover all ROIs are generated and used internally.
+// Contour meshing caches.
 //
-// NOTE: This routine assumes all ROIs are co-planar.
-//
-// NOTE: This routine will handle ROIs with several disconnected components (e.g., "eyes"). But all components
-//       will be lumped together into a single polyhedron.
-//
-fv_surface_mesh<double, uint64_t>
-Estimate_Surface_Mesh_Marching_Cubes(
-        const std::list<std::reference_wrapper<contour_collection<double>>>& cc_ROIs,
-        Parameters params ){
+// Meshes are keyed by the grid geometry, the contour inclusivity options, and the contours within each grid image.
+// Partial meshes are also retained so that when only some contours are altered, only the partial meshes bordering the
+// affected images need to be recomputed.
+namespace {
+
+// The inclusivity mask convention. Anything <= the threshold is considered to be interior to the ROI.
+constexpr double contour_inclusion_threshold = 0.0;
+constexpr bool contour_below_is_interior = true;
+constexpr double contour_interior_val = contour_inclusion_threshold - 1.0;
+constexpr double contour_exterior_val = contour_inclusion_threshold + 1.0;
+
+// The full inputs to meshing, compared exactly so that distinct inputs never share a mesh.
+struct mesh_key_t {
+    std::vector<double> grid;                // Grid geometry and the inclusivity options.
+    std::vector<std::vector<double>> slices; // Contour vertices within each grid image's slab, in grid order.
+
+    bool operator==(const mesh_key_t &rhs) const {
+        return (this->grid == rhs.grid) && (this->slices == rhs.slices);
+    }
+};
+
+struct cached_mesh_t {
+    mesh_key_t key;
+    std::shared_ptr<const fv_surface_mesh<double, uint64_t>> mesh;
+    size_t bytes = 0;
+};
+
+struct retained_meshing_t {
+    mesh_key_t key; // The inputs the partial meshes were computed from.
+    per_img_fv_meshes_t partial_meshes;
+    size_t bytes = 0;
+};
+
+// Caches are bounded and evict the least recently used entries first.
+const size_t max_cached_mesh_bytes = 256UL * 1024UL * 1024UL;
+const size_t max_retained_bytes = 512UL * 1024UL * 1024UL;
+
+size_t estimate_bytes(const fv_surface_mesh<double, uint64_t> &mesh){
+    return mesh.vertices.size() * sizeof(vec3<double>)
+         + mesh.faces.size() * (sizeof(std::vector<uint64_t>) + 3 * sizeof(uint64_t));
+}
 
-    // Define the convention we will use in our mask.
-    const double inclusion_threshold = 0.0;
-    const bool below_is_interior = true;  // Anything <= is considered to be interior to the ROI.
+size_t estimate_bytes(const per_img_fv_meshes_t &partial_meshes){
+    size_t bytes = 0;
+    for(const auto &p : partial_meshes){
+        bytes += p.second.verts.size() * sizeof(vec3<double>);
+        bytes += p.second.vscor.size() * sizeof(uint64_t);
+        bytes += p.second.faces.size() * 2 * (sizeof(std::vector<uint64_t>) + 3 * sizeof(uint64_t)); // Incl. fsrel.
+    }
+    return bytes;
+}
 
-    const double InteriorVal = inclusion_threshold - (below_is_interior ? 1.0 : -1.0);
-    const double ExteriorVal = inclusion_threshold + (below_is_interior ? 1.0 : -1.0);
+} // namespace
+
+struct mesh_cache::state_t {
+    std::mutex m;
+    std::list<cached_mesh_t> meshes; // Most recently used first.
+    size_t mesh_bytes = 0;
+    std::list<std::unique_ptr<retained_meshing_t>> retained; // Most recently used first.
+    size_t retained_bytes = 0;
+};
+
+mesh_cache::mesh_cache() : state(std::make_shared<state_t>()) { }
+
+
+// Generates a grid contiguously covering the given ROI(s) for marching cubes. Contours are expected to be co-planar.
+static
+planar_image_collection<float,double>
+Make_Marching_Cubes_Grid(
+        const std::list<std::reference_wrapper<contour_collection<double>>>& cc_ROIs,
+        Parameters params ){
 
     // Figure out plane alignment and work out spacing.
     const auto est_cont_normal = Average_Contour_Normals(cc_ROIs);
@@ -1180,7 +1297,7 @@ Estimate_Surface_Mesh_Marching_Cubes(
 
     // Generate a grid volume bounding the ROI(s).
     const long int NumberOfChannels = 1;
-    const double PixelFill = ExteriorVal; //std::numeric_limits<double>::quiet_NaN();
+    const double PixelFill = contour_exterior_val; //std::numeric_limits<double>::quiet_NaN();
     const bool OnlyExtremeSlices = false;
     auto grid_image_collection = Contiguously_Grid_Volume<float,double>(
              cc_ROIs, 
@@ -1190,43 +1307,162 @@ Estimate_Surface_Mesh_Marching_Cubes(
              GridX, GridY, GridZ,
              PixelFill, OnlyExtremeSlices );
 
-    // Generate an ROI inclusivity voxel map.
-    {
-        PartitionedImageVoxelVisitorMutatorUserData ud;
+    return grid_image_collection;
+}
 
-        // Use options from the user, but override what we need to for a valid mesh extraction.
-        ud.mutation_opts = params.MutateOpts;
+// Performs the Marching Cubes algorithm for the given ROI contours using the provided grid, which is not altered.
+//
+// If a cache is provided, meshes are cached. When contours are altered, partial meshes retained from an earlier call
+// with the same grid are reused and only the cubes bordering images with altered contours are re-meshed.
+//
+static
+fv_surface_mesh<double, uint64_t>
+Estimate_Surface_Mesh_Marching_Cubes(
+        const planar_image_collection<float,double> &grid,
+        const std::list<std::reference_wrapper<contour_collection<double>>>& cc_ROIs,
+        Parameters params,
+        mesh_cache *cache ){
 
-        ud.mutation_opts.editstyle = Mutate_Voxels_Opts::EditStyle::InPlace;
-        ud.mutation_opts.aggregate = Mutate_Voxels_Opts::Aggregate::First;
-        ud.mutation_opts.adjacency = Mutate_Voxels_Opts::Adjacency::SingleVoxel;
-        ud.mutation_opts.maskmod   = Mutate_Voxels_Opts::MaskMod::Noop;
+    if(grid.images.empty()){
+        throw std::invalid_argument("An insufficient number of images was provided. Cannot continue.");
+    }
+    if(cc_ROIs.empty()){
+        throw std::invalid_argument("No contours provided. Cannot continue");
+    }
 
-        /// Leave the following options up to the caller.
-        //ud.mutation_opts.inclusivity = Mutate_Voxels_Opts::Inclusivity::Centre;
-        //ud.mutation_opts.contouroverlap = Mutate_Voxels_Opts::ContourOverlap::ImplicitOrientations;
+    // Only the following options are left up to the caller.
+    const auto inclusivity = params.MutateOpts.inclusivity;
+    const auto contouroverlap = params.MutateOpts.contouroverlap;
+
+    const auto &first_img = grid.images.front();
+    const auto normal = first_img.row_unit.Cross(first_img.col_unit).unit();
+    const contour_slice_index index(cc_ROIs, normal);
+
+    // Key the grid and the contours within each image's slab. Contours are selected the same way they are when the
+    // inclusivity masks are rasterized, so matching keys imply matching masks.
+    const auto N_imgs = static_cast<int64_t>(grid.images.size());
+    const auto slab_of = [&](const planar_image<float,double> &img) -> std::pair<double, double> {
+        const auto img_offset = normal.Dot(img.position(0, 0));
+        const auto half_thickness = std::abs(img.pxl_dz * 0.5);
+        return { img_offset - half_thickness, img_offset + half_thickness };
+    };
 
-        ud.description = "ROI Inclusivity";
+    mesh_key_t key;
+    key.grid.push_back(static_cast<double>(static_cast<int64_t>(inclusivity)));
+    key.grid.push_back(static_cast<double>(static_cast<int64_t>(contouroverlap)));
+    key.slices.reserve(N_imgs);
+    for(const auto &img : grid.images){
+        key.grid.insert(std::end(key.grid), { static_cast<double>(img.rows), static_cast<double>(img.columns),
+                                              img.pxl_dx, img.pxl_dy, img.pxl_dz,
+                                              img.anchor.x, img.anchor.y, img.anchor.z,
+                                              img.offset.x, img.offset.y, img.offset.z,
+                                              img.row_unit.x, img.row_unit.y, img.row_unit.z,
+                                              img.col_unit.x, img.col_unit.y, img.col_unit.z });
+
+        key.slices.emplace_back();
+        auto &slice = key.slices.back();
+        const auto [slab_lo, slab_hi] = slab_of(img);
+        for(const auto *e : index.within_slab(slab_lo, slab_hi)){
+            slice.push_back(static_cast<double>(e->points.size()));
+            for(const auto &p : e->points) slice.insert(std::end(slice), { p.x, p.y, p.z });
+        }
+    }
 
-        ud.f_bounded = [&](long int /*row*/, long int /*col*/, long int /*chan*/,
-                                          std::reference_wrapper<planar_image<float,double>> /*img_refw*/,
-                                          std::reference_wrapper<planar_image<float,double>> /*mask_img_refw*/,
-                                          float &voxel_val) {
-            voxel_val = InteriorVal;
-        };
-        //ud.f_unbounded = [&](long int /*row*/, long int /*col*/, long int /*chan*/,
-        //                                    std::reference_wrapper<planar_image<float,double>> /*img_refw*/,
-        //                                    std::reference_wrapper<planar_image<float,double>> /*mask_img_refw*/,
-        //                                    float &voxel_val) {
-        //    voxel_val = ExteriorVal;
-        //};
+    std::shared_ptr<const fv_surface_mesh<double, uint64_t>> cached_mesh;
+    std::unique_ptr<retained_meshing_t> retained;
+    if(cache != nullptr){
+        auto &c = *(cache->state);
+        std::lock_guard<std::mutex> lock(c.m);
+        for(auto it = std::begin(c.meshes); it != std::end(c.meshes); ++it){
+            if(it->key == key){
+                cached_mesh = it->mesh;
+                c.meshes.splice(std::begin(c.meshes), c.meshes, it);
+                break;
+            }
+        }
 
-        if(!grid_image_collection.Process_Images_Parallel( GroupIndividualImages,
-                                                           PartitionedImageVoxelVisitorMutator,
-                                                           {}, cc_ROIs, &ud )){
-            throw std::runtime_error("Unable to create an ROI inclusivity map.");
+        // Claim the retained partial meshes that most closely match. Those for other contours are only claimed when
+        // most images match, so alternately meshing several ROIs on a common grid does not continually discard them.
+        if(!cached_mesh){
+            auto best = std::end(c.retained);
+            int64_t best_matches = 0;
+            for(auto it = std::begin(c.retained); it != std::end(c.retained); ++it){
+                if( ((*it)->key.grid != key.grid)
+                ||  (static_cast<int64_t>((*it)->key.slices.size()) != N_imgs) ) continue;
+
+                int64_t matches = 0;
+                for(int64_t i = 0; i < N_imgs; ++i){
+                    if((*it)->key.slices[i] == key.slices[i]) ++matches;
+                }
+                if( (N_imgs < 2 * matches) && (best_matches < matches) ){
+                    best = it;
+                    best_matches = matches;
+                }
+            }
+            if(best != std::end(c.retained)){
+                retained = std::move(*best);
+                c.retained_bytes -= retained->bytes;
+                c.retained.erase(best);
+            }
         }
     }
+    if(cached_mesh){
+        YLOGINFO("Reusing cached surface mesh");
+        return *cached_mesh;
+    }
+
+    const bool incremental = static_cast<bool>(retained);
+    if(!incremental){
+        retained = std::make_unique<retained_meshing_t>();
+    }
+
+    // Work on a copy of the grid so the grid can be shared.
+    auto grid_image_collection = grid;
+    std::vector<planar_image<float,double>*> img_ptrs;
+    for(auto &img : grid_image_collection.images) img_ptrs.push_back( &img );
+
+    // Only images sampled by recomputed partial meshes need to be rasterized. Altering an image affects partial meshes
+    // that sample images at most two images away.
+    std::set<const planar_image<float,double>*> altered;
+    std::vector<uint8_t> needed(N_imgs, incremental ? 0 : 1);
+    if(incremental){
+        std::vector<int64_t> order(N_imgs);
+        std::vector<double> img_offsets(N_imgs);
+        for(int64_t i = 0; i < N_imgs; ++i){
+            order[i] = i;
+            img_offsets[i] = normal.Dot(img_ptrs[i]->position(0, 0));
+        }
+        std::sort(std::begin(order), std::end(order), [&](int64_t a, int64_t b){
+            return img_offsets[a] < img_offsets[b];
+        });
+
+        for(int64_t j = 0; j < N_imgs; ++j){
+            const auto i = order[j];
+            if(retained->key.slices[i] == key.slices[i]) continue;
+            altered.insert( img_ptrs[i] );
+            for(auto k = std::max<int64_t>(0, j - 2); k <= std::min<int64_t>(N_imgs - 1, j + 2); ++k){
+                needed[order[k]] = 1;
+            }
+        }
+        YLOGINFO("Contours within " << altered.size() << " of " << N_imgs << " images were altered");
+    }
+
+    // Generate an ROI inclusivity voxel map.
+    parallel_for(static_cast<int64_t>(0), N_imgs, [&](int64_t i){
+        if(needed[i] == 0) return;
+        auto &img = *(img_ptrs[i]);
+        img.fill_pixels(static_cast<float>(contour_exterior_val));
+
+        const auto mask = Rasterize_Contour_Voxel_Mask(img, index, inclusivity, contouroverlap);
+        for(long int row = 0; row < img.rows; ++row){
+            for(long int col = 0; col < img.columns; ++col){
+                if(mask[row * img.columns + col] == 0) continue;
+                for(long int chan = 0; chan < img.channels; ++chan){
+                    img.reference(row, col, chan) = static_cast<float>(contour_interior_val);
+                }
+            }
+        }
+    });
 
     std::list<std::reference_wrapper<planar_image<float,double>>> grid_imgs;
     for(auto &img : grid_image_collection.images){
@@ -1238,11 +1474,210 @@ Estimate_Surface_Mesh_Marching_Cubes(
     }
 
     // Offload the actual Marching Cubes computation.
-    return Marching_Cubes_Implementation( grid_imgs,
-                                          std::shared_ptr<csg::sdf::node>(),
-                                          inclusion_threshold,
-                                          below_is_interior,
-                                          params );
+    auto fv_mesh = Marching_Cubes_Implementation( grid_imgs,
+                                                  std::shared_ptr<csg::sdf::node>(),
+                                                  contour_inclusion_threshold,
+                                                  contour_below_is_interior,
+                                                  params,
+                                                  ((cache != nullptr) ? &(retained->partial_meshes) : nullptr),
+                                                  (incremental ? &altered : nullptr) );
+
+    if(cache != nullptr){
+        retained->bytes = estimate_bytes(retained->partial_meshes);
+        const auto mesh_bytes = estimate_bytes(fv_mesh);
+
+        auto &c = *(cache->state);
+        std::lock_guard<std::mutex> lock(c.m);
+        if(mesh_bytes <= max_cached_mesh_bytes){
+            c.meshes.emplace_front();
+            c.meshes.front().key = key;
+            c.meshes.front().mesh = std::make_shared<const fv_surface_mesh<double, uint64_t>>(fv_mesh);
+            c.meshes.front().bytes = mesh_bytes;
+            c.mesh_bytes += mesh_bytes;
+            while(max_cached_mesh_bytes < c.mesh_bytes){
+                c.mesh_bytes -= c.meshes.back().bytes;
+                c.meshes.pop_back();
+            }
+        }
+        if(retained->bytes <= max_retained_bytes){
+            retained->key = std::move(key);
+            c.retained_bytes += retained->bytes;
+            c.retained.emplace_front(std::move(retained));
+            while(max_retained_bytes < c.retained_bytes){
+                c.retained_bytes -= c.retained.back()->bytes;
+                c.retained.pop_back();
+            }
+        }
+    }
+    return fv_mesh;
+}
+
+// This sub-routine performs the Marching Cubes algorithm for the given ROI contours.
+// ROI inclusivity is separately pre-computed before surface probing by generating an inclusivity mask on a
+// custom-fitted planar image collection. This is done for performance purposes and so inclusivity and surface
+// meshing can be separately tweaked as necessary.
+//
+// NOTE: This routine does not require the images that the contours were originally generated on.
+//       A custom set of dummy images that contiguously cover all ROIs are generated and used internally.
+//
+// NOTE: This routine assumes all ROIs are co-planar.
+//
+// NOTE: This routine will handle ROIs with several disconnected components (e.g., "eyes"). But all components
+//       will be lumped together into a single polyhedron.
+//
+fv_surface_mesh<double, uint64_t>
+Estimate_Surface_Mesh_Marching_Cubes(
+        const std::list<std::reference_wrapper<contour_collection<double>>>& cc_ROIs,
+        Parameters params,
+        mesh_cache *cache ){
+
+    const auto grid = Make_Marching_Cubes_Grid(cc_ROIs, params);
+    return Estimate_Surface_Mesh_Marching_Cubes(grid, cc_ROIs, params, cache);
+}
+
+// Samples an SDF at the centre of every voxel of a rectilinear image volume.
+//
+// Empty space is pruned by recursively subdividing the volume into blocks. Since the SDF cannot change faster than its
+// Lipschitz bound, a single sample at a block's centre bounds the SDF throughout the block. Marching cubes only need
+// the exact value at voxels near the isosurface; elsewhere only the side of the threshold matters. So blocks that are
+// far enough from the isosurface that no cube touching them can straddle it are filled with the centre sample. The
+// remaining (narrow-band) voxels are evaluated in batches.
+static
+void
+Sample_SDF_Narrow_Band( const csg::sdf::node &sdf,
+                        const std::list<std::reference_wrapper<planar_image<float,double>>> &imgs,
+                        double inclusion_threshold ){
+
+    if(imgs.empty()) return;
+    std::vector<planar_image<float,double>*> img_ptrs;
+    for(const auto &img_refw : imgs) img_ptrs.push_back( &(img_refw.get()) );
+
+    const auto &first_img = *(img_ptrs.front());
+    const auto N_rows = static_cast<int64_t>(first_img.rows);
+    const auto N_cols = static_cast<int64_t>(first_img.columns);
+    const auto N_imgs = static_cast<int64_t>(img_ptrs.size());
+    for(const auto *img_ptr : img_ptrs){
+        if( (img_ptr->rows != N_rows) || (img_ptr->columns != N_cols) ){
+            throw std::invalid_argument("Images must all have the same number of rows and columns");
+        }
+    }
+    if( (N_rows <= 0) || (N_cols <= 0) ) return;
+
+    const auto normal = first_img.row_unit.Cross(first_img.col_unit).unit();
+    std::sort( std::begin(img_ptrs), std::end(img_ptrs),
+               [&normal](const planar_image<float,double> *A, const planar_image<float,double> *B){
+                   return normal.Dot(A->position(0, 0)) < normal.Dot(B->position(0, 0));
+               });
+    const auto position = [&](int64_t row, int64_t col, int64_t img) -> vec3<double> {
+        return img_ptrs[img]->position(row, col);
+    };
+
+    // A voxel is only involved in cubes spanning its neighbours, so if the SDF at the voxel differs from the threshold
+    // by more than the bound over a cube diagonal, all involved cubes lie entirely on one side of the isosurface.
+    double img_sep = std::abs(first_img.pxl_dz);
+    if(1 < N_imgs){
+        img_sep = std::max(img_sep, (position(0, 0, 1) - position(0, 0, 0)).length());
+    }
+    const auto cube_diagonal = std::sqrt( first_img.pxl_dx * first_img.pxl_dx
+                                        + first_img.pxl_dy * first_img.pxl_dy
+                                        + img_sep * img_sep );
+    const auto lipschitz_bound = sdf.evaluate_lipschitz_bound();
+
+    // Voxel index ranges, half-open.
+    struct block_t {
+        int64_t row_lo, row_hi;
+        int64_t col_lo, col_hi;
+        int64_t img_lo, img_hi;
+    };
+    const int64_t leaf_extent = 4;  // Blocks no larger than this along every axis are evaluated directly.
+    const int64_t tile_extent = 32; // The volume is initially split into tiles of this size, which are processed in parallel.
+
+    const auto N_tile_rows = (N_rows + tile_extent - 1) / tile_extent;
+    const auto N_tile_cols = (N_cols + tile_extent - 1) / tile_extent;
+    const auto N_tile_imgs = (N_imgs + tile_extent - 1) / tile_extent;
+
+    std::atomic<int64_t> N_evaluated(0);
+    parallel_for(static_cast<int64_t>(0), N_tile_rows * N_tile_cols * N_tile_imgs, [&](int64_t t){
+        const auto t_row = t % N_tile_rows;
+        const auto t_col = (t / N_tile_rows) % N_tile_cols;
+        const auto t_img = t / (N_tile_rows * N_tile_cols);
+
+        std::vector<block_t> blocks;
+        blocks.push_back({ t_row * tile_extent, std::min(N_rows, (t_row + 1) * tile_extent),
+                           t_col * tile_extent, std::min(N_cols, (t_col + 1) * tile_extent),
+                           t_img * tile_extent, std::min(N_imgs, (t_img + 1) * tile_extent) });
+
+        std::vector<vec3<double>> batch_pos;
+        std::vector<double> batch_sdf;
+        int64_t l_N_evaluated = 0;
+        while(!blocks.empty()){
+            const auto b = blocks.back();
+            blocks.pop_back();
+
+            const auto pos_lo = position(b.row_lo, b.col_lo, b.img_lo);
+            const auto pos_hi = position(b.row_hi - 1, b.col_hi - 1, b.img_hi - 1);
+            const auto centre = (pos_lo + pos_hi) * 0.5;
+            const auto radius = (pos_hi - pos_lo).length() * 0.5;
+
+            const auto centre_sdf = sdf.evaluate_sdf(centre);
+            ++l_N_evaluated;
+            if( (lipschitz_bound * (radius + cube_diagonal)) < std::abs(centre_sdf - inclusion_threshold) ){
+                for(auto img = b.img_lo; img < b.img_hi; ++img){
+                    for(auto row = b.row_lo; row < b.row_hi; ++row){
+                        for(auto col = b.col_lo; col < b.col_hi; ++col){
+                            img_ptrs[img]->reference(row, col, 0) = static_cast<float>(centre_sdf);
+                        }
+                    }
+                }
+                continue;
+            }
+
+            const auto d_rows = b.row_hi - b.row_lo;
+            const auto d_cols = b.col_hi - b.col_lo;
+            const auto d_imgs = b.img_hi - b.img_lo;
+            if( (d_rows <= leaf_extent) && (d_cols <= leaf_extent) && (d_imgs <= leaf_extent) ){
+                batch_pos.clear();
+                for(auto img = b.img_lo; img < b.img_hi; ++img){
+                    for(auto row = b.row_lo; row < b.row_hi; ++row){
+                        for(auto col = b.col_lo; col < b.col_hi; ++col){
+                            batch_pos.emplace_back( position(row, col, img) );
+                        }
+                    }
+                }
+                sdf.evaluate_sdf_batch(batch_pos, batch_sdf);
+                l_N_evaluated += static_cast<int64_t>(batch_pos.size());
+
+                size_t i = 0;
+                for(auto img = b.img_lo; img < b.img_hi; ++img){
+                    for(auto row = b.row_lo; row < b.row_hi; ++row){
+                        for(auto col = b.col_lo; col < b.col_hi; ++col){
+                            img_ptrs[img]->reference(row, col, 0) = static_cast<float>(batch_sdf[i++]);
+                        }
+                    }
+                }
+                continue;
+            }
+
+            // Split every axis that spans more than a single voxel.
+            const auto row_mid = (1 < d_rows) ? b.row_lo + d_rows / 2 : b.row_hi;
+            const auto col_mid = (1 < d_cols) ? b.col_lo + d_cols / 2 : b.col_hi;
+            const auto img_mid = (1 < d_imgs) ? b.img_lo + d_imgs / 2 : b.img_hi;
+            for(const auto &[r_lo, r_hi] : { std::make_pair(b.row_lo, row_mid), std::make_pair(row_mid, b.row_hi) }){
+                for(const auto &[c_lo, c_hi] : { std::make_pair(b.col_lo, col_mid), std::make_pair(col_mid, b.col_hi) }){
+                    for(const auto &[i_lo, i_hi] : { std::make_pair(b.img_lo, img_mid), std::make_pair(img_mid, b.img_hi) }){
+                        if( (r_lo < r_hi) && (c_lo < c_hi) && (i_lo < i_hi) ){
+                            blocks.push_back({ r_lo, r_hi, c_lo, c_hi, i_lo, i_hi });
+                        }
+                    }
+                }
+            }
+        }
+        N_evaluated += l_N_evaluated;
+    });
+
+    YLOGINFO("Evaluated the SDF " << N_evaluated.load() << " times to sample "
+             << (N_rows * N_cols * N_imgs) << " voxels");
+    return;
 }
 
 // Perform Marching Cubes using a user-provided signed-distance function.
@@ -1329,8 +1764,11 @@ Estimate_Surface_Mesh_Marching_Cubes(
     }
 //YLOGINFO("Images stretch from " << img_bb.min << " to " << img_bb.max);
 
+    // Sample the SDF once per voxel, rather than once per cube corner, and only near the surface.
+    Sample_SDF_Narrow_Band( *sdf, imgs, inclusion_threshold );
+
     return Marching_Cubes_Implementation( imgs,
-                                          sdf,
+                                          std::shared_ptr<csg::sdf::node>(),
                                           inclusion_threshold,
                                           below_is_interior,
                                           params );
@@ -1996,6 +2434,35 @@ FVSMeshToPolyhedron(
 
     return output_mesh;
 }
+
+
+fv_surface_mesh<double, uint64_t>
+PolyhedronToFVSMesh(
+        const Polyhedron &in ){
+
+    fv_surface_mesh<double, uint64_t> out;
+    out.vertices.reserve(in.size_of_vertices());
+    out.faces.reserve(in.size_of_facets());
+
+    std::map<const Polyhedron::Vertex *, uint64_t> vert_index;
+    for(auto v_it = in.vertices_begin(); v_it != in.vertices_end(); ++v_it){
+        const auto &p = v_it->point();
+        vert_index[ &(*v_it) ] = static_cast<uint64_t>(out.vertices.size());
+        out.vertices.emplace_back( static_cast<double>( CGAL::to_double( p.x() ) ),
+                                   static_cast<double>( CGAL::to_double( p.y() ) ),
+                                   static_cast<double>( CGAL::to_double( p.z() ) ) );
+    }
+
+    for(auto f_it = in.facets_begin(); f_it != in.facets_end(); ++f_it){
+        std::vector<uint64_t> face;
+        auto h = f_it->facet_begin();
+        do{
+            face.push_back( vert_index.at( &(*(h->vertex())) ) );
+        }while(++h != f_it->facet_begin());
+        out.faces.emplace_back(face);
+    }
+    return out;
+}
 #endif // DCMA_USE_CGAL
 
 
@@ -2583,6 +3050,156 @@ SurfaceArea(const Polyhedron &mesh){
 }
 
 
+// Identifies how many dimensions a point cloud spans. Up to four points that span the cloud are selected: the first
+// point, the point farthest from it, the point farthest from the line through both, and the point farthest from the
+// plane through all three.
+static int64_t
+spanning_points(const std::vector<vec3<double>> &points,
+                std::array<vec3<double>, 4> &span){
+    if(points.empty()) return -1;
+
+    const auto farthest = [&](const std::function<double(const vec3<double> &)> &f) -> std::pair<double, vec3<double>> {
+        std::pair<double, vec3<double>> out = { -1.0, points.front() };
+        for(const auto &p : points){
+            const auto d = f(p);
+            if(out.first < d) out = { d, p };
+        }
+        return out;
+    };
+
+    span[0] = points.front();
+    const auto [d1, p1] = farthest([&](const vec3<double> &p){ return p.sq_dist(span[0]); });
+    span[1] = p1;
+    const auto extent = std::sqrt(d1);
+    const auto eps = extent * 1.0E-9;
+    if(extent <= 0.0) return 0;
+
+    const auto u = (span[1] - span[0]).unit();
+    const auto [d2, p2] = farthest([&](const vec3<double> &p){ return ((p - span[0]) - u * u.Dot(p - span[0])).length(); });
+    span[2] = p2;
+    if(d2 <= eps) return 1;
+
+    const auto n = u.Cross(span[2] - span[0]).unit();
+    const auto [d3, p3] = farthest([&](const vec3<double> &p){ return std::abs(n.Dot(p - span[0])); });
+    span[3] = p3;
+    if(d3 <= eps) return 2;
+    return 3;
+}
+
+Polyhedron
+Convex_Hull(const std::vector<vec3<double>> &points){
+    Polyhedron hull;
+
+    // CGAL can only represent degenerate hulls partially, so they are rejected here.
+    std::array<vec3<double>, 4> span;
+    if(spanning_points(points, span) < 3) return hull;
+
+    std::vector<Kernel::Point_3> cgal_points;
+    cgal_points.reserve(points.size());
+    for(const auto &p : points) cgal_points.emplace_back(p.x, p.y, p.z);
+    CGAL::convex_hull_3(std::begin(cgal_points), std::end(cgal_points), hull);
+    return hull;
+}
+
+double
+Farthest_Pair_Distance(const std::vector<vec3<double>> &points,
+                       const Polyhedron &hull){
+    if(points.empty()) return std::numeric_limits<double>::quiet_NaN();
+
+    // Select candidate points from the hull.
+    std::vector<vec3<double>> cands;
+    if(!hull.empty()){
+        cands.reserve(hull.size_of_vertices());
+        for(auto v_it = hull.vertices_begin(); v_it != hull.vertices_end(); ++v_it){
+            const auto &p = v_it->point();
+            cands.emplace_back( static_cast<double>(p.x()),
+                                static_cast<double>(p.y()),
+                                static_cast<double>(p.z()) );
+        }
+
+    }else{
+        std::array<vec3<double>, 4> span;
+        const auto dim = spanning_points(points, span);
+        if(dim <= 0) return 0.0;
+        if(dim == 1){
+            // The point farthest from the first point is an endpoint of the segment.
+            double best_sq = 0.0;
+            for(const auto &p : points) best_sq = std::max(best_sq, p.sq_dist(span[1]));
+            return std::sqrt(best_sq);
+        }
+
+        // Compute the planar hull in the plane of the points using Andrew's monotone chain algorithm.
+        const auto u = (span[1] - span[0]).unit();
+        const auto w = u.Cross(span[2] - span[0]).Cross(u).unit();
+        std::vector<std::pair<std::array<double, 2>, int64_t>> proj;
+        proj.reserve(points.size());
+        for(size_t i = 0; i < points.size(); ++i){
+            const auto r = points[i] - span[0];
+            proj.push_back( { {{ u.Dot(r), w.Dot(r) }}, static_cast<int64_t>(i) } );
+        }
+        std::sort(std::begin(proj), std::end(proj));
+        const auto cross = [](const std::array<double, 2> &o, const std::array<double, 2> &a, const std::array<double, 2> &b){
+            return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+        };
+        std::vector<int64_t> chain(2 * proj.size());
+        int64_t k = 0;
+        for(int64_t i = 0; i < static_cast<int64_t>(proj.size()); ++i){
+            while((2 <= k) && (cross(proj[chain[k-2]].first, proj[chain[k-1]].first, proj[i].first) <= 0.0)) --k;
+            chain[k++] = i;
+        }
+        for(int64_t i = static_cast<int64_t>(proj.size()) - 2, t = k + 1; 0 <= i; --i){
+            while((t <= k) && (cross(proj[chain[k-2]].first, proj[chain[k-1]].first, proj[i].first) <= 0.0)) --k;
+            chain[k++] = i;
+        }
+        for(int64_t i = 0; i < (k - 1); ++i) cands.push_back( points[ proj[chain[i]].second ] );
+    }
+    if(cands.size() < 2) return 0.0;
+
+    // Establish a lower bound using the extreme points along each axis.
+    vec3<double> lo = cands.front();
+    vec3<double> hi = cands.front();
+    std::array<vec3<double>, 6> extremes;
+    extremes.fill(cands.front());
+    for(const auto &p : cands){
+        if(p.x < extremes[0].x) extremes[0] = p;
+        if(p.y < extremes[1].y) extremes[1] = p;
+        if(p.z < extremes[2].z) extremes[2] = p;
+        if(extremes[3].x < p.x) extremes[3] = p;
+        if(extremes[4].y < p.y) extremes[4] = p;
+        if(extremes[5].z < p.z) extremes[5] = p;
+        lo = vec3<double>( std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z) );
+        hi = vec3<double>( std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z) );
+    }
+    double best_sq = 0.0;
+    for(const auto &a : extremes){
+        for(const auto &b : extremes) best_sq = std::max(best_sq, a.sq_dist(b));
+    }
+
+    // A point can only participate in a longer pair if the farthest corner of the bounding box is farther than the
+    // bound, since its partner lies within the bounding box.
+    std::vector<vec3<double>> kept;
+    for(const auto &p : cands){
+        const vec3<double> corner( (p.x - lo.x < hi.x - p.x) ? hi.x : lo.x,
+                                   (p.y - lo.y < hi.y - p.y) ? hi.y : lo.y,
+                                   (p.z - lo.z < hi.z - p.z) ? hi.z : lo.z );
+        if(best_sq < p.sq_dist(corner)) kept.push_back(p);
+    }
+
+    const auto N = static_cast<int64_t>(kept.size());
+    best_sq = parallel_reduce(static_cast<int64_t>(0), N, best_sq,
+        [&](int64_t b, int64_t e, double best) -> double {
+            for(int64_t i = b; i < e; ++i){
+                for(int64_t j = i + 1; j < N; ++j) best = std::max(best, kept[i].sq_dist(kept[j]));
+            }
+            return best;
+        },
+        [](double A, double B) -> double {
+            return std::max(A, B);
+        });
+    return std::sqrt(best_sq);
+}
+
+
 } // namespace polyhedron_processing
 #endif // DCMA_USE_CGAL
 
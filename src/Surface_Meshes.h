@@ -2,8 +2,16 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include "YgorImages.h"
+#include "YgorMath.h"
 
 #include "CSG_SDF.h"
 
@@ -45,10 +53,23 @@ namespace dcma_surface_meshes {
         ReproductionQuality RQ = ReproductionQuality::High;
     };
 
+    // Meshes retained for reuse when contours are meshed again. An identical mesh is returned without re-meshing, and
+    // when only some contours have been altered only the portion of the mesh bordering the affected images is
+    // recomputed. Caches are owned by the caller, so cached data are released along with the cache (e.g., at the end
+    // of an operation). Thread-safe.
+    class mesh_cache {
+        public:
+            struct state_t;
+            std::shared_ptr<state_t> state;
+
+            mesh_cache();
+    };
+
     fv_surface_mesh<double, uint64_t>
     Estimate_Surface_Mesh_Marching_Cubes(
             const std::list<std::reference_wrapper<contour_collection<double>>>& cc_ROIs,
-            Parameters p );
+            Parameters p,
+            mesh_cache *cache = nullptr );
 
     fv_surface_mesh<double, uint64_t>
     Estimate_Surface_Mesh_Marching_Cubes(
@@ -87,6 +108,11 @@ namespace dcma_surface_meshes {
     Polyhedron
     FVSMeshToPolyhedron(
             const fv_surface_mesh<double, uint64_t> &mesh );
+
+    // Faces retain their vertex ordering. Vertices are numbered in the polyhedron's iteration order.
+    fv_surface_mesh<double, uint64_t>
+    PolyhedronToFVSMesh(
+            const Polyhedron &mesh );
 #endif // DCMA_USE_CGAL
 
 } // namespace dcma_surface_meshes
@@ -156,6 +182,19 @@ namespace polyhedron_processing {
     double
     SurfaceArea(const Polyhedron &mesh);
 
+    // Convex hull of a point cloud. The hull is empty if the points do not span three dimensions (e.g., they are
+    // coplanar, as for a single contour).
+    Polyhedron
+    Convex_Hull(const std::vector<vec3<double>> &points);
+
+    // The largest distance between any two points (i.e., the diameter of the point cloud).
+    //
+    // The farthest pair is always a pair of convex hull vertices, so only the vertices of the provided hull are
+    // considered. If the hull is empty, the planar (or linear) hull of the points is used instead.
+    double
+    Farthest_Pair_Distance(const std::vector<vec3<double>> &points,
+                           const Polyhedron &hull);
+
 } // namespace polyhedron_processing
 #endif // DCMA_USE_CGAL
 
@@ -2,54 +2,392 @@
 
 #pragma once
 
-#include <mutex>
-#include <shared_mutex>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <thread>
-#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "YgorLog.h"
+
+
+// Process-wide concurrency limit. This is the number of worker threads used by the shared scheduler.
+//
+// Note: the limit must be set before the scheduler is first used, since worker threads are created on first use.
+// A value <= 0 selects the hardware concurrency.
+inline std::atomic<int64_t> & thread_concurrency_limit(){
+    static std::atomic<int64_t> limit(0);
+    return limit;
+}
 
-#include <asio.hpp>
-#include <boost/thread.hpp> // For class thread_group.
-#include <boost/bind/bind.hpp>
+inline void Set_Thread_Concurrency_Limit(int64_t n){
+    thread_concurrency_limit().store(n);
+    return;
+}
 
-//#include <boost/asio/io_service.hpp>
-//#include <boost/thread/thread.hpp>
+inline int64_t Get_Thread_Concurrency_Limit(){
+    return thread_concurrency_limit().load();
+}
 
 
-class asio_thread_pool {
+// Shared, process-wide work-stealing task scheduler.
+//
+// Each worker thread owns a task deque. Tasks submitted from a worker are pushed onto the back of its own deque and
+// are popped from the back (LIFO, for locality), whereas idle workers steal from the front of other workers' deques
+// (FIFO). Tasks submitted from outside the scheduler are placed in a shared FIFO queue.
+//
+// Workers that wait on nested work continue to execute queued tasks while they wait, so nested parallelism does not
+// create additional threads or deadlock the scheduler.
+class work_stealing_scheduler {
+  public:
+    using task_t = std::function<void()>;
+
   private:
+    struct worker_t {
+        std::mutex m;
+        std::deque<task_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<worker_t>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex injected_mutex;
+    std::deque<task_t> injected;
+
+    std::mutex sleep_mutex;
+    std::condition_variable sleeper;
+    std::atomic<int64_t> queued = 0;
+    std::atomic<bool> should_quit = false;
+
+    // Identifies the scheduler and worker owning the current thread, if any.
+    static inline thread_local work_stealing_scheduler *this_scheduler = nullptr;
+    static inline thread_local size_t this_worker = 0;
 
-    asio::io_service _io_service;
-    boost::thread_group _thread_pool;
-    using work_t = std::unique_ptr<asio::io_service::work>;
-    work_t _work;
+    bool try_pop(task_t &out){
+        const auto N = this->workers.size();
+        const bool is_worker = this->is_worker_thread();
+
+        // Own deque (LIFO).
+        if(is_worker){
+            auto &w = *(this->workers[this_worker]);
+            std::lock_guard<std::mutex> lock(w.m);
+            if(!w.tasks.empty()){
+                out = std::move(w.tasks.back());
+                w.tasks.pop_back();
+                --(this->queued);
+                return true;
+            }
+        }
+
+        // Externally-submitted tasks (FIFO).
+        {
+            std::lock_guard<std::mutex> lock(this->injected_mutex);
+            if(!this->injected.empty()){
+                out = std::move(this->injected.front());
+                this->injected.pop_front();
+                --(this->queued);
+                return true;
+            }
+        }
+
+        // Steal from other workers (FIFO).
+        const size_t offset = (is_worker) ? this_worker + 1 : 0;
+        for(size_t i = 0; i < N; ++i){
+            auto &w = *(this->workers[(offset + i) % N]);
+            std::lock_guard<std::mutex> lock(w.m);
+            if(!w.tasks.empty()){
+                out = std::move(w.tasks.front());
+                w.tasks.pop_front();
+                --(this->queued);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(size_t idx){
+        this_scheduler = this;
+        this_worker = idx;
+        while(!this->should_quit.load()){
+            if(this->run_one()) continue;
+
+            std::unique_lock<std::mutex> lock(this->sleep_mutex);
+            this->sleeper.wait_for(lock, std::chrono::milliseconds(50), [&](){
+                return this->should_quit.load() || (0 < this->queued.load());
+            });
+        }
+        return;
+    }
 
   public:
 
-    //Constructor and destructor.
-    asio_thread_pool(const size_t num_threads = 0) : _io_service(), 
-                                                     _work(new work_t::element_type(_io_service)) {
-        auto n = (num_threads == 0) ? std::thread::hardware_concurrency()
-                                    : num_threads;
-        if(n == 0) n = 2;
-        for(size_t i = 0 ; i < n; ++i){
-            this->_thread_pool.create_thread(
-                boost::bind(&asio::io_service::run, &this->_io_service)
-            );
+    explicit work_stealing_scheduler(int64_t num_threads = 0){
+        int64_t n = (num_threads <= 0) ? static_cast<int64_t>(std::thread::hardware_concurrency())
+                                       : num_threads;
+        if(n <= 0) n = 2;
+        for(int64_t i = 0; i < n; ++i){
+            this->workers.emplace_back(std::make_unique<worker_t>());
+        }
+        for(int64_t i = 0; i < n; ++i){
+            this->threads.emplace_back( [this,i](){ this->worker_loop(static_cast<size_t>(i)); } );
+        }
+    }
+
+    ~work_stealing_scheduler(){
+        {
+            std::lock_guard<std::mutex> lock(this->sleep_mutex);
+            this->should_quit.store(true);
         }
+        this->sleeper.notify_all();
+        for(auto &t : this->threads) t.join();
     }
-    ~asio_thread_pool(){
-        this->_work.reset();
-        this->_thread_pool.join_all();
-        this->_io_service.stop();
+
+    work_stealing_scheduler(const work_stealing_scheduler &) = delete;
+    work_stealing_scheduler & operator=(const work_stealing_scheduler &) = delete;
+
+    // The shared scheduler. Worker threads are created on first use, honouring the process-wide concurrency limit.
+    static work_stealing_scheduler & global(){
+        static work_stealing_scheduler sched( Get_Thread_Concurrency_Limit() );
+        return sched;
+    }
+
+    size_t concurrency() const {
+        return this->workers.size();
+    }
+
+    bool is_worker_thread() const {
+        return (this_scheduler == this);
+    }
+
+    // Tasks must not throw.
+    void submit(task_t t){
+        if(this->is_worker_thread()){
+            auto &w = *(this->workers[this_worker]);
+            std::lock_guard<std::mutex> lock(w.m);
+            w.tasks.push_back(std::move(t));
+        }else{
+            std::lock_guard<std::mutex> lock(this->injected_mutex);
+            this->injected.push_back(std::move(t));
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->sleep_mutex);
+            ++(this->queued);
+        }
+        this->sleeper.notify_one();
+        return;
+    }
+
+    // Executes a single queued task on the calling thread, if one is available.
+    bool run_one(){
+        task_t t;
+        if(!this->try_pop(t)) return false;
+        t();
+        return true;
+    }
+};
+
+
+// A group of tasks executed by the shared scheduler. wait() blocks until all tasks have completed.
+//
+// A per-group concurrency limit can be provided to restrict how many of the group's tasks execute simultaneously.
+// A limit of zero means the group is only limited by the scheduler.
+//
+// Exceptions thrown by tasks are captured and the first is rethrown by wait(), so callers should always call wait()
+// explicitly. The destructor also joins outstanding tasks (e.g., during stack unwinding), but since it can not rethrow
+// it logs any captured exception instead.
+class task_group {
+  public:
+    using task_t = work_stealing_scheduler::task_t;
+
+  private:
+    work_stealing_scheduler &sched;
+    const int64_t limit;
+
+    std::mutex m;
+    std::condition_variable cv;
+    int64_t outstanding = 0;  // Submitted but not yet completed tasks.
+    int64_t runners = 0;      // Active runners draining 'held' (only used with a group limit).
+    std::deque<task_t> held;  // Tasks awaiting a runner (only used with a group limit).
+    std::exception_ptr first_error;
+
+    bool is_complete() const {
+        return (this->outstanding == 0) && (this->runners == 0);
+    }
+
+    void execute(const task_t &t){
+        std::exception_ptr e;
+        try{
+            t();
+        }catch(...){
+            e = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(this->m);
+        if(e && !this->first_error) this->first_error = std::move(e);
+        --(this->outstanding);
+        this->cv.notify_all();
+        return;
+    }
+
+    void run_held(){
+        while(true){
+            task_t t;
+            {
+                std::lock_guard<std::mutex> lock(this->m);
+                if(this->held.empty()){
+                    --(this->runners);
+                    this->cv.notify_all();
+                    return;
+                }
+                t = std::move(this->held.front());
+                this->held.pop_front();
+            }
+            this->execute(t);
+        }
+    }
+
+  public:
+
+    explicit task_group(int64_t max_concurrency = 0,
+                        work_stealing_scheduler &s = work_stealing_scheduler::global())
+        : sched(s), limit(max_concurrency) { }
+
+    task_group(const task_group &) = delete;
+    task_group & operator=(const task_group &) = delete;
+
+    ~task_group(){
+        try{
+            this->wait();
+        }catch(const std::exception &e){
+            YLOGWARN("Task group destroyed with an unhandled task exception: " << e.what());
+        }catch(...){
+            YLOGWARN("Task group destroyed with an unhandled task exception");
+        }
     }
 
-    //Work submission routine.
     template<class T>
     void submit_task(T atask){
-        this->_io_service.post(atask);
+        bool new_runner = false;
+        {
+            std::lock_guard<std::mutex> lock(this->m);
+            ++(this->outstanding);
+            if(0 < this->limit){
+                this->held.emplace_back(std::move(atask));
+                if(this->runners < this->limit){
+                    ++(this->runners);
+                    new_runner = true;
+                }
+            }
+        }
+
+        if(0 < this->limit){
+            if(new_runner) this->sched.submit([this](){ this->run_held(); });
+        }else{
+            this->sched.submit([this, t = task_t(std::move(atask))](){ this->execute(t); });
+        }
+        return;
     }
-}; 
+
+    // Blocks until all submitted tasks have completed. Worker threads execute other queued tasks while waiting.
+    void wait(){
+        if(this->sched.is_worker_thread()){
+            while(true){
+                {
+                    std::unique_lock<std::mutex> lock(this->m);
+                    if(this->is_complete()) break;
+                }
+                if(!this->sched.run_one()){
+                    std::unique_lock<std::mutex> lock(this->m);
+                    this->cv.wait_for(lock, std::chrono::milliseconds(1), [this](){ return this->is_complete(); });
+                }
+            }
+        }else{
+            std::unique_lock<std::mutex> lock(this->m);
+            this->cv.wait(lock, [this](){ return this->is_complete(); });
+        }
+
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(this->m);
+            std::swap(e, this->first_error);
+        }
+        if(e) std::rethrow_exception(e);
+        return;
+    }
+};
+
+
+// Invokes f(i) for every i in [begin, end) using the shared scheduler.
+//
+// The range is split into contiguous chunks of at least 'grain' elements. If no grain is provided, a few chunks per
+// worker are used to balance load.
+template<class F>
+void parallel_for(int64_t begin, int64_t end, F f, int64_t grain = 0){
+    if(end <= begin) return;
+    const auto N = end - begin;
+    auto &sched = work_stealing_scheduler::global();
+    if(grain <= 0){
+        grain = std::max<int64_t>(1, N / (4 * static_cast<int64_t>(sched.concurrency())));
+    }
+    if(N <= grain){
+        for(int64_t i = begin; i < end; ++i) f(i);
+        return;
+    }
+
+    task_group tg(0, sched);
+    for(int64_t b = begin; b < end; b += grain){
+        const auto e = std::min(end, b + grain);
+        tg.submit_task([b,e,&f](){
+            for(int64_t i = b; i < e; ++i) f(i);
+        });
+    }
+    tg.wait();
+    return;
+}
+
+// Computes a reduction over [begin, end) using the shared scheduler.
+//
+// 'map' is invoked as map(chunk_begin, chunk_end, init) and returns the partial result for a contiguous chunk.
+// Partial results are combined with 'reduce' in chunk order, so the result is deterministic for a given grain.
+template<class T, class M, class R>
+T parallel_reduce(int64_t begin, int64_t end, T init, M map, R reduce, int64_t grain = 0){
+    if(end <= begin) return init;
+    const auto N = end - begin;
+    auto &sched = work_stealing_scheduler::global();
+    if(grain <= 0){
+        grain = std::max<int64_t>(1, N / (4 * static_cast<int64_t>(sched.concurrency())));
+    }
+    if(N <= grain){
+        return reduce(init, map(begin, end, init));
+    }
+
+    const auto N_chunks = (N + grain - 1) / grain;
+    std::vector<T> partials(static_cast<size_t>(N_chunks), init);
+    {
+        task_group tg(0, sched);
+        for(int64_t c = 0; c < N_chunks; ++c){
+            const auto b = begin + c * grain;
+            const auto e = std::min(end, b + grain);
+            tg.submit_task([b,e,c,&map,&partials,&init](){
+                partials[static_cast<size_t>(c)] = map(b, e, init);
+            });
+        }
+        tg.wait();
+    }
+
+    T out = init;
+    for(auto &p : partials) out = reduce(out, p);
+    return out;
+}
 
 
 
@@ -87,7 +425,7 @@ class work_queue {
                 // Assume ownership of only the first item in the queue (FIFO).
                 std::list<T> l_queue;
                 if(!this->queue.empty()) l_queue.splice( std::end(l_queue), this->queue, std::begin(this->queue) );
-                
+
                 //// Assume ownership of all available items in the queue.
                 //std::list<T> l_queue;
                 //l_queue.swap( this->queue );
@@ -126,4 +464,3 @@ class work_queue {
     }
 };
 
-
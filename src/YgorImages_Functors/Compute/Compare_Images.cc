@@ -143,7 +143,7 @@ bool ComputeCompareImages(planar_image_collection<float,double> &imagecoll,
 
     std::mutex passing_counter; // Used to tally the gamma passing rate.
 
-    asio_thread_pool tp;
+    task_group tp;
     std::mutex saver_printer; // Who gets to save generated contours, print to the console, and iterate the counter.
     long int completed = 0;
     const long int img_count = imagecoll.images.size();
@@ -639,6 +639,7 @@ bool ComputeCompareImages(planar_image_collection<float,double> &imagecoll,
         }); // thread pool task closure.
 
     }
+    tp.wait();
 
 
     return true;
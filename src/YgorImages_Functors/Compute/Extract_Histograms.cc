@@ -108,7 +108,7 @@ bool ComputeExtractHistograms(planar_image_collection<float,double> &imagecoll,
                        voxel_extrema;
 
     { // Scope for thread pool.
-        asio_thread_pool tp;
+        task_group tp;
         std::mutex saver;
         std::mutex printer;
         long int completed = 0;
@@ -170,6 +170,7 @@ bool ComputeExtractHistograms(planar_image_collection<float,double> &imagecoll,
 
             }); // thread pool task closure.
         } // Loop over all images.
+        tp.wait();
     }
 
 
@@ -216,7 +217,7 @@ bool ComputeExtractHistograms(planar_image_collection<float,double> &imagecoll,
 
     // Visit all voxels to build the histograms.
     {
-        asio_thread_pool tp;
+        task_group tp;
         std::mutex saver;
         std::mutex printer;
         long int completed = 0;
@@ -296,6 +297,7 @@ bool ComputeExtractHistograms(planar_image_collection<float,double> &imagecoll,
 
             }); // thread pool task closure.
         } // Loop over all images.
+        tp.wait();
     }
 
     // Prepare differential histograms.
@@ -126,7 +126,7 @@ bool ComputeGenerateSurfaceMask(planar_image_collection<float,double> &imagecoll
 
         //Loop over the pixels of the image.
         {
-            asio_thread_pool tp;
+            task_group tp;
 
             for(auto row = 0; row < img.rows; ++row){
                 tp.submit_task([&,row]() -> void {
@@ -210,6 +210,7 @@ bool ComputeGenerateSurfaceMask(planar_image_collection<float,double> &imagecoll
                     }
                 });
             }
+            tp.wait();
         }
     } //Finish tasks and terminate thread pool.
 
@@ -126,7 +126,7 @@ bool ComputeInterpolateImageSlices(planar_image_collection<float,double> &imagec
 
 
 
-    asio_thread_pool tp;
+    task_group tp;
     std::mutex saver_printer; // Who gets to save generated contours, print to the console, and iterate the counter.
     long int completed = 0;
     const long int img_count = imagecoll.images.size();
@@ -281,6 +281,7 @@ bool ComputeInterpolateImageSlices(planar_image_collection<float,double> &imagec
         }); // thread pool task closure.
 
     }
+    tp.wait();
 
     return true;
 }
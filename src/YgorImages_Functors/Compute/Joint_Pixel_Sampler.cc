@@ -92,7 +92,7 @@ bool ComputeJointPixelSampler(planar_image_collection<float,double> &imagecoll,
 
     std::mutex passing_counter; // Used to tally the gamma passing rate.
 
-    asio_thread_pool tp;
+    task_group tp;
     std::mutex saver_printer; // Who gets to save generated contours, print to the console, and iterate the counter.
     long int completed = 0;
     const long int img_count = imagecoll.images.size();
@@ -260,6 +260,7 @@ bool ComputeJointPixelSampler(planar_image_collection<float,double> &imagecoll,
         }); // thread pool task closure.
 
     }
+    tp.wait();
 
 
     return true;
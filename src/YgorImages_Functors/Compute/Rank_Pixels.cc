@@ -74,7 +74,7 @@ bool ComputeRankPixels(planar_image_collection<float,double> &imagecoll,
         YLOGWARN("No voxels were selected to participate in the rank; nothing to do");
 
     }else{
-        asio_thread_pool tp;
+        task_group tp;
         std::mutex saver_printer; // Who gets to save generated contours, print to the console, and iterate the counter.
         long int completed = 0;
         const long int img_count = imagecoll.images.size();
@@ -133,6 +133,7 @@ bool ComputeRankPixels(planar_image_collection<float,double> &imagecoll,
             }); // thread pool task closure.
                 
         } // Loop over images.
+        tp.wait();
     }
 
     return true;
@@ -1,6 +1,9 @@
 //Volumetric_Neighbourhood_Sampler.cc.
 
+#include <cmath>
+#include <cstdint>
 #include <exception>
+#include <limits>
 #include <any>
 #include <optional>
 #include <functional>
@@ -10,6 +13,9 @@
 #include <random>
 #include <ostream>
 #include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "../../Thread_Pool.h"
 #include "../Grouping/Misc_Functors.h"
@@ -24,6 +30,248 @@
 #include "YgorClustering.hpp"
 
 
+// A contiguous run of neighbourhood voxels within a single row. Relative to the current voxel, the run comprises
+// voxels (row + d_row, col + c_lo ... col + c_hi, img + d_img).
+struct neighbourhood_run {
+    long int d_row;
+    long int d_img;
+    long int c_lo;
+    long int c_hi;
+};
+
+// Decomposes the neighbourhood into runs, if possible. An empty list is returned if the neighbourhood cannot (or
+// should not) be reduced using a sliding window.
+static std::vector<neighbourhood_run>
+get_neighbourhood_runs(const ComputeVolumetricNeighbourhoodSamplerUserData &ud,
+                       bool is_regular_grid,
+                       long int img_rows,
+                       long int img_cols,
+                       long int img_imgs,
+                       double pxl_dx,
+                       double pxl_dy,
+                       double pxl_dz){
+    std::vector<neighbourhood_run> runs;
+
+    if( (ud.neighbourhood == ComputeVolumetricNeighbourhoodSamplerUserData::Neighbourhood::Cubic)
+    &&  is_regular_grid ){
+        // Voxels outside the image volume are omitted from cubic neighbourhoods, so the extent can be clamped.
+        const auto dx_u = std::min( static_cast<long int>( std::floor( ud.maximum_distance / pxl_dx ) ), img_rows - 1L );
+        const auto dy_u = std::min( static_cast<long int>( std::floor( ud.maximum_distance / pxl_dy ) ), img_cols - 1L );
+        const auto dz_u = std::min( static_cast<long int>( std::floor( ud.maximum_distance / pxl_dz ) ), img_imgs - 1L );
+        if( (dx_u < 0) || (dy_u < 0) || (dz_u < 0) ) return runs;
+
+        for(long int d_img = -dz_u; d_img <= dz_u; ++d_img){
+            for(long int d_row = -dx_u; d_row <= dx_u; ++d_row){
+                runs.push_back( { d_row, d_img, -dy_u, dy_u } );
+            }
+        }
+
+    }else if(ud.neighbourhood == ComputeVolumetricNeighbourhoodSamplerUserData::Neighbourhood::Selection){
+        // Group the triplets by row and image. Each group must form a contiguous run of columns without duplicates.
+        std::map<std::pair<long int, long int>, std::vector<long int>> groups;
+        for(const auto &triplets : ud.voxel_triplets){
+            groups[ { triplets[0], triplets[2] } ].push_back( triplets[1] );
+        }
+        for(auto &g : groups){
+            auto &cols = g.second;
+            std::sort(std::begin(cols), std::end(cols));
+            for(size_t i = 1; i < cols.size(); ++i){
+                if(cols[i] != (cols[i-1] + 1)) return {};
+            }
+            runs.push_back( { g.first.first, g.first.second, cols.front(), cols.back() } );
+        }
+    }
+
+    long int N_voxels = 0;
+    for(const auto &r : runs) N_voxels += (r.c_hi - r.c_lo + 1);
+    if(N_voxels < ud.sliding_window_min_voxels) runs.clear();
+    return runs;
+}
+
+// Histogram of value ranks, implemented as a Fenwick tree. Supports insertion and removal of ranks, counting the
+// number of ranks below a given rank, and selecting the k-th smallest rank.
+class rank_histogram {
+  private:
+    std::vector<long int> tree;
+    long int top = 1;
+
+  public:
+    explicit rank_histogram(long int N) : tree(N + 1, 0){
+        while((this->top * 2) <= N) this->top *= 2;
+    }
+
+    void add(long int rank, long int delta){
+        const auto N = static_cast<long int>(this->tree.size());
+        for(long int i = rank + 1; i < N; i += (i & -i)) this->tree[i] += delta;
+        return;
+    }
+
+    // The number of entries with rank < the given rank.
+    long int count_below(long int rank) const {
+        long int out = 0;
+        for(long int i = rank; 0 < i; i -= (i & -i)) out += this->tree[i];
+        return out;
+    }
+
+    // The rank of the k-th smallest entry (zero-based).
+    long int select(long int k) const {
+        const auto N = static_cast<long int>(this->tree.size());
+        long int pos = 0;
+        for(long int step = this->top; 0 < step; step /= 2){
+            if( ((pos + step) < N) && (this->tree[pos + step] <= k) ){
+                pos += step;
+                k -= this->tree[pos];
+            }
+        }
+        return pos;
+    }
+};
+
+// Reduces the neighbourhood of every voxel in a row of the reference image by sliding a window along the row.
+//
+// Voxels for which the sliding window cannot reproduce the reduction functor exactly are marked invalid and must be
+// reduced by sampling the neighbourhood.
+static void
+sliding_window_reduce_row(const std::vector<neighbourhood_run> &runs,
+                          bool absent_voxels_are_nan,
+                          ComputeVolumetricNeighbourhoodSamplerUserData::SlidingWindowReduction reduction,
+                          planar_image_adjacency<float,double> &img_adj,
+                          const planar_image<float,double> &ref_img,
+                          long int R_num,
+                          long int R_row,
+                          long int channel,
+                          std::vector<float> &vals,
+                          std::vector<uint8_t> &valid){
+    using reduction_t = ComputeVolumetricNeighbourhoodSamplerUserData::SlidingWindowReduction;
+
+    const auto N_rows = ref_img.rows;
+    const auto N_cols = ref_img.columns;
+    vals.assign(N_cols, std::numeric_limits<float>::quiet_NaN());
+    valid.assign(N_cols, 0);
+
+    // Extract the rows that contribute to the neighbourhood.
+    struct active_run {
+        long int c_lo;
+        long int c_hi;
+        long int a = 0;  // The columns currently within the window, inclusive.
+        long int b = -1;
+        std::vector<float> vals;
+        std::vector<long int> ranks; // Negative for NaN.
+    };
+    std::vector<active_run> active;
+    std::vector<float> distinct;
+
+    long int N_voxels = 0; // Including voxels outside the image volume.
+    for(const auto &r : runs){
+        N_voxels += (r.c_hi - r.c_lo + 1);
+
+        const auto l_row = R_row + r.d_row;
+        const auto l_img = R_num + r.d_img;
+        if(!isininc(0, l_row, N_rows - 1L)
+        || !img_adj.index_present(l_img) ) continue;
+        auto adj_img_refw = img_adj.index_to_image(l_img);
+
+        active.emplace_back();
+        active.back().c_lo = r.c_lo;
+        active.back().c_hi = r.c_hi;
+        active.back().vals.reserve(N_cols);
+        for(long int l_col = 0; l_col < N_cols; ++l_col){
+            const auto v = adj_img_refw.get().value(l_row, l_col, channel);
+            active.back().vals.push_back(v);
+            if(!std::isnan(v)) distinct.push_back(v);
+        }
+    }
+
+    // Map voxel values to ranks.
+    std::sort(std::begin(distinct), std::end(distinct));
+    distinct.erase( std::unique(std::begin(distinct), std::end(distinct)), std::end(distinct) );
+    for(auto &ar : active){
+        ar.ranks.reserve(N_cols);
+        for(const auto &v : ar.vals){
+            const auto it = std::lower_bound(std::begin(distinct), std::end(distinct), v);
+            ar.ranks.push_back( std::isnan(v) ? -1L : static_cast<long int>(std::distance(std::begin(distinct), it)) );
+        }
+    }
+
+    rank_histogram hist(static_cast<long int>(distinct.size()));
+    long int N_present = 0;  // Voxels within the window that are within the image volume.
+    long int N_nan = 0;
+    const auto update = [&](const active_run &ar, long int col, long int delta){
+        N_present += delta;
+        const auto rank = ar.ranks[col];
+        if(rank < 0){
+            N_nan += delta;
+            return;
+        }
+        hist.add(rank, delta);
+        return;
+    };
+
+    for(long int R_col = 0; R_col < N_cols; ++R_col){
+        // Advance the window.
+        for(auto &ar : active){
+            const auto a = std::max(R_col + ar.c_lo, 0L);
+            const auto b = std::min(R_col + ar.c_hi, N_cols - 1L);
+            for(long int col = ar.a; col <= std::min(ar.b, a - 1L); ++col) update(ar, col, -1);
+            for(long int col = std::max(ar.b + 1L, a); col <= b; ++col) update(ar, col, 1);
+            ar.a = a;
+            ar.b = b;
+        }
+
+        // Non-NaN voxels within the window.
+        const auto N = N_present - N_nan;
+
+        // Whether the sampled neighbourhood would contain only non-NaN voxels.
+        const auto N_absent = (absent_voxels_are_nan) ? (N_voxels - N_present) : 0L;
+        const bool complete = (N_absent == 0L) && (N_nan == 0L) && (0L < N);
+
+        if(reduction == reduction_t::Min){
+            if(complete){
+                vals[R_col] = distinct[ hist.select(0L) ];
+                valid[R_col] = 1;
+            }
+
+        }else if(reduction == reduction_t::Max){
+            if(complete){
+                vals[R_col] = distinct[ hist.select(N - 1L) ];
+                valid[R_col] = 1;
+            }
+
+        }else if(reduction == reduction_t::Median){
+            // Medians of an even number of voxels are left to the reduction functor.
+            if(complete && ((N % 2L) == 1L)){
+                vals[R_col] = distinct[ hist.select(N / 2L) ];
+                valid[R_col] = 1;
+            }
+
+        }else if(reduction == reduction_t::Percentile01){
+            // NaNs are purged, so the window need not be complete.
+            float f = ref_img.value(R_row, R_col, channel);
+            if(!std::isnan(f)){
+                if(N == 0L){
+                    f = std::numeric_limits<float>::quiet_NaN();
+                }else{
+                    // Determine the percentile where duplicates use the middle position.
+                    const auto lhs_it = std::lower_bound(std::begin(distinct), std::end(distinct), f);
+                    const auto rhs_it = std::upper_bound(std::begin(distinct), std::end(distinct), f);
+                    const auto N_lhs = hist.count_below( static_cast<long int>(std::distance(std::begin(distinct), lhs_it)) );
+                    const auto N_le  = hist.count_below( static_cast<long int>(std::distance(std::begin(distinct), rhs_it)) );
+                    if(N_lhs == N_le){
+                        f = std::numeric_limits<float>::quiet_NaN();
+                    }else{
+                        const auto N_rhs = N_le - 1L;
+                        f = 0.5 * static_cast<float>(N_rhs + N_lhs) / (static_cast<float>(N) - 1.0);
+                    }
+                }
+            }
+            vals[R_col] = f;
+            valid[R_col] = 1;
+        }
+    }
+    return;
+}
+
+
 bool ComputeVolumetricNeighbourhoodSampler(planar_image_collection<float,double> &imagecoll,
                       std::list<std::reference_wrapper<planar_image_collection<float,double>>> /*external_imgs*/,
                       std::list<std::reference_wrapper<contour_collection<double>>> ccsl,
@@ -90,7 +338,7 @@ bool ComputeVolumetricNeighbourhoodSampler(planar_image_collection<float,double>
     mv_opts.maskmod        = Mutate_Voxels_Opts::MaskMod::Noop;
 
 
-    asio_thread_pool tp;
+    task_group tp;
     std::mutex saver_printer; // Who gets to save generated contours, print to the console, and iterate the counter.
     long int completed = 0;
     const long int img_count = imagecoll.images.size();
@@ -121,16 +369,9 @@ bool ComputeVolumetricNeighbourhoodSampler(planar_image_collection<float,double>
             std::vector<float> shtl;
             shtl.reserve(100); // An arbitrary guess.
 
-            auto f_bounded = [&, img_rows, img_cols, img_imgs, ref_img_refw](
-                                 long int E_row, long int E_col, long int channel,
-                                 std::reference_wrapper<planar_image<float,double>> /*img_refw*/,
-                                 std::reference_wrapper<planar_image<float,double>> /*mask_img_refw*/,
-                                 float &voxel_val) {
-                // No-op if this is the wrong channel.
-                if( (user_data_s->channel >= 0) && (channel != user_data_s->channel) ){
-                    return;
-                }
-
+            // Locates a voxel in the overlapping reference image. The position and value of the voxel are returned,
+            // along with the row, column, and image numbers of the voxel in the reference image.
+            const auto locate = [&, ref_img_refw](long int E_row, long int E_col, long int channel){
                 // Get the position of the voxel in the overlapping reference image.
                 const auto E_pos = ref_img_refw.get().position(E_row, E_col);
                 const auto E_val = ref_img_refw.get().value(E_row, E_col, channel);
@@ -149,7 +390,13 @@ bool ComputeVolumetricNeighbourhoodSampler(planar_image_collection<float,double>
                     throw std::logic_error("One or more images were not included in the image adjacency determination. Refusing to continue.");
                 }
                 const auto R_num = img_adj.image_to_index( ref_img_refw );
+                return std::make_tuple(E_pos, E_val, R_row, R_col, R_num);
+            };
 
+            // Samples the neighbourhood of a voxel in the reference image, leaving the neighbourhood in the shuttle.
+            const auto sample = [&, img_rows, img_cols, img_imgs, ref_img_refw](
+                                 const vec3<double> &E_pos,
+                                 long int R_row, long int R_col, long int R_num, long int channel) {
                 shtl.clear();
 
                 // Sample the neighbourhood in a growing cubic pattern until a spherical boundary is reached.
@@ -290,17 +537,100 @@ bool ComputeVolumetricNeighbourhoodSampler(planar_image_collection<float,double>
 
                 }
 
+                return;
+            };
+
+            auto f_bounded = [&](long int E_row, long int E_col, long int channel,
+                                 std::reference_wrapper<planar_image<float,double>> /*img_refw*/,
+                                 std::reference_wrapper<planar_image<float,double>> /*mask_img_refw*/,
+                                 float &voxel_val) {
+                // No-op if this is the wrong channel.
+                if( (user_data_s->channel >= 0) && (channel != user_data_s->channel) ){
+                    return;
+                }
+
+                const auto [E_pos, E_val, R_row, R_col, R_num] = locate(E_row, E_col, channel);
+                sample(E_pos, R_row, R_col, R_num, channel);
+
                 // Assign the voxel a value.
                 voxel_val = user_data_s->f_reduce(E_val, shtl, E_pos);
 
                 return;
             };
 
-            Mutate_Voxels<float,double>( img_refw,
-                                         { img_refw },
-                                         ccsl, 
-                                         mv_opts, 
-                                         f_bounded );
+            // Determine whether the neighbourhoods can be reduced using a sliding window.
+            std::vector<neighbourhood_run> runs;
+            if(user_data_s->sliding_window_reduction != ComputeVolumetricNeighbourhoodSamplerUserData::SlidingWindowReduction::None){
+                runs = get_neighbourhood_runs(*user_data_s, is_regular_grid, img_rows, img_cols, img_imgs,
+                                              pxl_dx, pxl_dy, pxl_dz);
+            }
+
+            if(runs.empty()){
+                Mutate_Voxels<float,double>( img_refw,
+                                             { img_refw },
+                                             ccsl, 
+                                             mv_opts, 
+                                             f_bounded );
+
+            }else{
+                // Identify the voxels to edit and the rows they occupy. Neighbourhoods are drawn from the reference
+                // image, so voxels can be edited after all rows have been reduced.
+                struct voxel_t {
+                    long int E_row;
+                    long int E_col;
+                    long int channel;
+                    long int R_row;
+                    long int R_col;
+                };
+                std::vector<voxel_t> voxels;
+                std::map<std::pair<long int, long int>, size_t> row_slots; // (channel, row) --> slot.
+                std::vector<std::pair<long int, long int>> rows;
+                long int R_num = -1;
+
+                auto f_record = [&](long int E_row, long int E_col, long int channel,
+                                    std::reference_wrapper<planar_image<float,double>> /*img_refw*/,
+                                    std::reference_wrapper<planar_image<float,double>> /*mask_img_refw*/,
+                                    float & /*voxel_val*/) {
+                    if( (user_data_s->channel >= 0) && (channel != user_data_s->channel) ){
+                        return;
+                    }
+                    const auto [E_pos, E_val, R_row, R_col, l_num] = locate(E_row, E_col, channel);
+                    R_num = l_num;
+                    voxels.push_back( { E_row, E_col, channel, R_row, R_col } );
+                    if(row_slots.emplace( std::make_pair(channel, R_row), rows.size() ).second){
+                        rows.emplace_back(channel, R_row);
+                    }
+                    return;
+                };
+                Mutate_Voxels<float,double>( img_refw,
+                                             { img_refw },
+                                             ccsl, 
+                                             mv_opts, 
+                                             f_record );
+
+                // Reduce the rows in parallel.
+                const bool absent_voxels_are_nan = (user_data_s->neighbourhood
+                                                    == ComputeVolumetricNeighbourhoodSamplerUserData::Neighbourhood::Selection);
+                std::vector<std::vector<float>> row_vals(rows.size());
+                std::vector<std::vector<uint8_t>> row_valid(rows.size());
+                parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(rows.size()), [&](int64_t i){
+                    sliding_window_reduce_row(runs, absent_voxels_are_nan, user_data_s->sliding_window_reduction,
+                                              img_adj, ref_img_refw.get(), R_num, rows[i].second, rows[i].first,
+                                              row_vals[i], row_valid[i]);
+                });
+
+                // Edit the voxels, sampling any neighbourhoods that could not be reduced with the sliding window.
+                for(const auto &v : voxels){
+                    const auto slot = row_slots.at( std::make_pair(v.channel, v.R_row) );
+                    float voxel_val = row_vals[slot][v.R_col];
+                    if(row_valid[slot][v.R_col] == 0){
+                        const auto [E_pos, E_val, R_row, R_col, l_num] = locate(v.E_row, v.E_col, v.channel);
+                        sample(E_pos, R_row, R_col, l_num, v.channel);
+                        voxel_val = user_data_s->f_reduce(E_val, shtl, E_pos);
+                    }
+                    img_refw.get().reference(v.E_row, v.E_col, v.channel) = voxel_val;
+                }
+            }
 
             if(!(user_data_s->description.empty())){
                 UpdateImageDescription( img_refw, user_data_s->description );
@@ -317,6 +647,7 @@ bool ComputeVolumetricNeighbourhoodSampler(planar_image_collection<float,double>
         }); // thread pool task closure.
 
     }
+    tp.wait();
 
 
     return true;
@@ -66,6 +66,35 @@ struct ComputeVolumetricNeighbourhoodSamplerUserData {
         return v; // Effectively does nothing.
     };
 
+    // -----------------------------
+    // Sliding-window reduction.
+    //
+    // If the reduction functor implements one of these reductions, it can be identified here so that neighbourhoods
+    // are reduced incrementally as a window slides along each row, rather than sampling and reducing every voxel's
+    // neighbourhood independently. The sliding window maintains a histogram of the ranks of the voxel values within
+    // the window, so order statistics can be evaluated without sorting.
+    //
+    // Note: The sliding window is only used for cubic neighbourhoods (on regular grids) and specific-voxel sampling where
+    //       the voxels selected along each row form a contiguous run (e.g., cubes and spheres). Other neighbourhoods
+    //       are always sampled.
+    //
+    // Note: The sliding window is only used when it is guaranteed to reproduce the reduction functor exactly.
+    //       Otherwise (e.g., when a neighbourhood contains NaNs or extends beyond the image boundaries, or the median of
+    //       an even number of voxels is needed) the neighbourhood is sampled and passed to the reduction functor.
+    //       Means are not supported, since a running sum cannot reproduce the reduction functor's rounding.
+    enum class
+    SlidingWindowReduction {
+        None,         // Always sample the neighbourhood and use the reduction functor.
+        Min,          // Equivalent to Stats::Min().
+        Max,          // Equivalent to Stats::Max().
+        Median,       // Equivalent to Stats::Median().
+        Percentile01, // The percentile of the existing voxel value within the (non-NaN) neighbourhood, scaled to [0,1].
+    } sliding_window_reduction = SlidingWindowReduction::None;
+
+    // The sliding window is only used for neighbourhoods with at least this many voxels, since directly sorting very
+    // small neighbourhoods is faster.
+    long int sliding_window_min_voxels = 64;
+
     // -----------------------------
     // Outgoing image description to imbue.
     std::string description;
@@ -0,0 +1,297 @@
+//Contour_Voxel_Index.cc - A part of DICOMautomaton 2024. Written by hal clark.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "YgorImages.h"
+#include "YgorMath.h"
+#include "YgorMisc.h"
+#include "YgorLog.h"
+
+#include "Contour_Voxel_Index.h"
+
+
+contour_slice_index::contour_slice_index(const std::list<std::reference_wrapper<contour_collection<double>>> &ccsl,
+                                         const vec3<double> &orientation_normal) : normal(orientation_normal.unit()) {
+    for(const auto &cc_refw : ccsl){
+        for(const auto &c : cc_refw.get().contours){
+            if(c.points.size() < 3) continue;
+
+            entry_t e;
+            e.points.assign(std::begin(c.points), std::end(c.points));
+            e.offset_min = std::numeric_limits<double>::infinity();
+            e.offset_max = -std::numeric_limits<double>::infinity();
+            for(const auto &p : e.points){
+                const auto o = this->normal.Dot(p);
+                e.offset_min = std::min(e.offset_min, o);
+                e.offset_max = std::max(e.offset_max, o);
+            }
+            this->entries.emplace_back(std::move(e));
+        }
+    }
+    std::sort(std::begin(this->entries), std::end(this->entries),
+              [](const entry_t &l, const entry_t &r){ return l.offset_min < r.offset_min; });
+}
+
+const vec3<double> & contour_slice_index::get_normal() const {
+    return this->normal;
+}
+
+std::vector<const contour_slice_index::entry_t *>
+contour_slice_index::within_slab(double offset_lo, double offset_hi) const {
+    std::vector<const entry_t *> out;
+    const auto tol = 1.0E-5 + 1.0E-9 * std::max(std::abs(offset_lo), std::abs(offset_hi));
+    const auto lo = offset_lo - tol;
+    const auto hi = offset_hi + tol;
+    const auto beg = std::lower_bound(std::begin(this->entries), std::end(this->entries), lo,
+                                      [](const entry_t &e, double o){ return e.offset_min < o; });
+    for(auto it = beg; (it != std::end(this->entries)) && (it->offset_min <= hi); ++it){
+        if(it->offset_max <= hi) out.push_back( &(*it) );
+    }
+    return out;
+}
+
+size_t contour_slice_index::size() const {
+    return this->entries.size();
+}
+
+
+namespace {
+
+struct uv_point_t {
+    double u; // Fractional row number.
+    double v; // Fractional column number.
+};
+
+// Marks the samples v_first + k, for k in [0, n), that are enclosed by the polygon along the line of constant u.
+// Uses the even-odd rule with half-open edges, so vertices lying on the line are counted once.
+void fill_scanline(const std::vector<uv_point_t> &poly,
+                   double u,
+                   double v_first,
+                   int64_t n,
+                   std::vector<double> &crossings,
+                   uint8_t *out){
+    std::fill(out, out + n, static_cast<uint8_t>(0));
+    crossings.clear();
+
+    const auto N = poly.size();
+    for(size_t i = 0, j = N - 1; i < N; j = i++){
+        const auto &A = poly[i];
+        const auto &B = poly[j];
+        if((A.u > u) == (B.u > u)) continue;
+        crossings.push_back( A.v + (u - A.u) * (B.v - A.v) / (B.u - A.u) );
+    }
+    std::sort(std::begin(crossings), std::end(crossings));
+
+    for(size_t i = 0; (i + 1) < crossings.size(); i += 2){
+        const auto k_beg = std::max<int64_t>(0, static_cast<int64_t>(std::ceil(crossings[i] - v_first)));
+        const auto k_end = std::min<int64_t>(n - 1, static_cast<int64_t>(std::floor(crossings[i + 1] - v_first)));
+        for(auto k = k_beg; k <= k_end; ++k) out[k] = 1;
+    }
+    return;
+}
+
+// Caches are bounded and evict the oldest entries first.
+const size_t max_cached_indices = 16;
+const size_t max_cached_mask_bytes = 256UL * 1024UL * 1024UL;
+
+} // namespace
+
+
+contour_voxel_mask_t Rasterize_Contour_Voxel_Mask(const planar_image<float,double> &img,
+                                                  const contour_slice_index &index,
+                                                  Mutate_Voxels_Opts::Inclusivity inclusivity,
+                                                  Mutate_Voxels_Opts::ContourOverlap contouroverlap){
+    const int64_t rows = img.rows;
+    const int64_t columns = img.columns;
+    contour_voxel_mask_t mask(static_cast<size_t>(rows * columns), 0);
+    if((rows <= 0) || (columns <= 0) || (index.size() == 0)) return mask;
+
+    const auto use_corners = (inclusivity != Mutate_Voxels_Opts::Inclusivity::Centre);
+    const auto need_all    = (inclusivity == Mutate_Voxels_Opts::Inclusivity::Exclusive);
+
+    // Voxel (r,c) is at fractional coordinates (r,c) and its corners are at (r +- 0.5, c +- 0.5).
+    const auto origin = img.position(0, 0);
+    const auto &normal = index.get_normal();
+    const auto img_offset = normal.Dot(origin);
+    const auto half_thickness = std::abs(img.pxl_dz * 0.5);
+    const auto to_uv = [&](const vec3<double> &p) -> uv_point_t {
+        const auto d = p - origin;
+        return { d.Dot(img.row_unit) / img.pxl_dx, d.Dot(img.col_unit) / img.pxl_dy };
+    };
+
+    std::vector<uv_point_t> poly;
+    std::vector<double> crossings;
+    std::vector<uint8_t> centre_line;
+    std::vector<uint8_t> corner_lines;
+    std::vector<uint8_t> enclosed;
+
+    for(const auto *e : index.within_slab(img_offset - half_thickness, img_offset + half_thickness)){
+        poly.clear();
+        double u_min = std::numeric_limits<double>::infinity();
+        double u_max = -u_min;
+        double v_min = u_min;
+        double v_max = -u_min;
+        double area = 0.0;
+        for(const auto &p : e->points){
+            poly.push_back(to_uv(p));
+            u_min = std::min(u_min, poly.back().u);
+            u_max = std::max(u_max, poly.back().u);
+            v_min = std::min(v_min, poly.back().v);
+            v_max = std::max(v_max, poly.back().v);
+        }
+        for(size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++){
+            area += (poly[j].u * poly[i].v) - (poly[i].u * poly[j].v);
+        }
+
+        // Restrict to the voxels whose centres or corners could be enclosed.
+        const auto r_beg = std::max<int64_t>(0, static_cast<int64_t>(std::floor(u_min - 0.5)));
+        const auto r_end = std::min<int64_t>(rows - 1, static_cast<int64_t>(std::ceil(u_max + 0.5)));
+        const auto c_beg = std::max<int64_t>(0, static_cast<int64_t>(std::floor(v_min - 0.5)));
+        const auto c_end = std::min<int64_t>(columns - 1, static_cast<int64_t>(std::ceil(v_max + 0.5)));
+        if((r_end < r_beg) || (c_end < c_beg)) continue;
+        const auto n_cols = c_end - c_beg + 1;
+
+        int32_t contribution = 1;
+        if( (contouroverlap == Mutate_Voxels_Opts::ContourOverlap::HonourOppositeOrientations)
+        &&  (area < 0.0) ){
+            contribution = -1;
+        }
+
+        centre_line.resize(static_cast<size_t>(n_cols));
+        enclosed.resize(static_cast<size_t>(n_cols));
+        if(use_corners){
+            // Two rows of corners, above and below the current row of voxels. Each is reused for adjacent rows.
+            corner_lines.resize(static_cast<size_t>(2 * (n_cols + 1)));
+            fill_scanline(poly, static_cast<double>(r_beg) - 0.5, static_cast<double>(c_beg) - 0.5, n_cols + 1,
+                          crossings, corner_lines.data());
+        }
+
+        for(auto r = r_beg; r <= r_end; ++r){
+            fill_scanline(poly, static_cast<double>(r), static_cast<double>(c_beg), n_cols,
+                          crossings, centre_line.data());
+
+            if(use_corners){
+                const auto above = ((r - r_beg) % 2 == 0) ? 0 : (n_cols + 1);
+                const auto below = (n_cols + 1) - above;
+                fill_scanline(poly, static_cast<double>(r) + 0.5, static_cast<double>(c_beg) - 0.5, n_cols + 1,
+                              crossings, corner_lines.data() + below);
+                const auto *A = corner_lines.data() + above;
+                const auto *B = corner_lines.data() + below;
+                for(int64_t k = 0; k < n_cols; ++k){
+                    const bool c = (centre_line[k] != 0);
+                    enclosed[k] = need_all ? ( c && A[k] && A[k+1] && B[k] && B[k+1] )
+                                           : ( c || A[k] || A[k+1] || B[k] || B[k+1] );
+                }
+            }else{
+                std::copy(std::begin(centre_line), std::end(centre_line), std::begin(enclosed));
+            }
+
+            auto *m = mask.data() + (r * columns + c_beg);
+            for(int64_t k = 0; k < n_cols; ++k){
+                if(enclosed[k] == 0) continue;
+                if(contouroverlap == Mutate_Voxels_Opts::ContourOverlap::ImplicitOrientations){
+                    m[k] ^= 1;
+                }else if(contouroverlap == Mutate_Voxels_Opts::ContourOverlap::HonourOppositeOrientations){
+                    m[k] += contribution;
+                }else{
+                    m[k] = 1;
+                }
+            }
+        }
+    }
+    return mask;
+}
+
+
+std::shared_ptr<const contour_voxel_mask_t>
+contour_voxel_mask_cache::get(const planar_image<float,double> &img,
+                              const std::list<std::reference_wrapper<contour_collection<double>>> &ccsl,
+                              Mutate_Voxels_Opts::Inclusivity inclusivity,
+                              Mutate_Voxels_Opts::ContourOverlap contouroverlap){
+    const auto normal = img.row_unit.Cross(img.col_unit).unit();
+
+    std::vector<const contour_collection<double> *> l_contours;
+    for(const auto &cc_refw : ccsl) l_contours.push_back( &(cc_refw.get()) );
+
+    const mask_key_t key = {{ static_cast<double>(img.rows), static_cast<double>(img.columns),
+                              img.pxl_dx, img.pxl_dy, img.pxl_dz,
+                              img.anchor.x, img.anchor.y, img.anchor.z,
+                              img.offset.x, img.offset.y, img.offset.z,
+                              img.row_unit.x, img.row_unit.y, img.row_unit.z,
+                              img.col_unit.x, img.col_unit.y, img.col_unit.z,
+                              static_cast<double>(static_cast<int64_t>(inclusivity)),
+                              static_cast<double>(static_cast<int64_t>(contouroverlap)) }};
+
+    std::shared_ptr<const contour_slice_index> index;
+    {
+        std::lock_guard<std::mutex> lock(this->m);
+        if(l_contours != this->contours){
+            this->contours = l_contours;
+            this->indices.clear();
+            this->masks.clear();
+            this->mask_order.clear();
+            this->mask_bytes = 0;
+        }
+
+        const auto m_it = this->masks.find(key);
+        if(m_it != std::end(this->masks)) return m_it->second;
+
+        for(const auto &i : this->indices){
+            if(i->get_normal() == normal){
+                index = i;
+                break;
+            }
+        }
+    }
+
+    // Build outside the lock so images can be processed concurrently. Racing threads may duplicate work, but the
+    // results are identical.
+    if(!index){
+        index = std::make_shared<const contour_slice_index>(ccsl, normal);
+        std::lock_guard<std::mutex> lock(this->m);
+        if(l_contours == this->contours) this->indices.emplace_back(index);
+        while(max_cached_indices < this->indices.size()) this->indices.pop_front();
+    }
+    auto mask = std::make_shared<const contour_voxel_mask_t>(
+                    Rasterize_Contour_Voxel_Mask(img, *index, inclusivity, contouroverlap) );
+
+    const auto bytes = mask->size() * sizeof(contour_voxel_mask_t::value_type);
+    if(bytes <= max_cached_mask_bytes){
+        std::lock_guard<std::mutex> lock(this->m);
+        if( (l_contours == this->contours)
+        &&  this->masks.emplace(key, mask).second ){
+            this->mask_order.push_back(key);
+            this->mask_bytes += bytes;
+        }
+        while(max_cached_mask_bytes < this->mask_bytes){
+            const auto it = this->masks.find(this->mask_order.front());
+            this->mask_bytes -= it->second->size() * sizeof(contour_voxel_mask_t::value_type);
+            this->masks.erase(it);
+            this->mask_order.pop_front();
+        }
+    }
+    return mask;
+}
+
+void contour_voxel_mask_cache::clear(){
+    std::lock_guard<std::mutex> lock(this->m);
+    this->contours.clear();
+    this->indices.clear();
+    this->masks.clear();
+    this->mask_order.clear();
+    this->mask_bytes = 0;
+    return;
+}
+
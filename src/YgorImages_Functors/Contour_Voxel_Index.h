@@ -0,0 +1,100 @@
+//Contour_Voxel_Index.h.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "YgorImages.h"
+#include "YgorMath.h"
+
+// This file provides an acceleration structure for identifying voxels bounded by contours. Rather than testing every
+// voxel against every contour, contours are bucketed by their position along the image orientation normal, so only
+// contours lying within an image's slab are considered, and each contour is rasterized only within its bounding box
+// using scanlines (i.e., edge crossings are computed once per row rather than once per voxel).
+//
+// Indices and voxel masks can be cached for the duration of an operation, so images sharing an orientation share an
+// index and repeated passes over the same image and ROI(s) do not re-rasterize contours.
+
+// Contours projected into a common frame and sorted by their position along the orientation normal.
+//
+// The index holds copies of the contour vertices, so it remains valid if the source contours are altered or destroyed.
+class contour_slice_index {
+    public:
+        struct entry_t {
+            std::vector<vec3<double>> points;
+            double offset_min = 0.0; // Extent along the orientation normal.
+            double offset_max = 0.0;
+        };
+
+    private:
+        vec3<double> normal;
+        std::vector<entry_t> entries; // Sorted by offset_min.
+
+    public:
+        contour_slice_index(const std::list<std::reference_wrapper<contour_collection<double>>> &ccsl,
+                            const vec3<double> &orientation_normal);
+
+        const vec3<double> & get_normal() const;
+
+        // Returns contours with all vertices within the slab [offset_lo, offset_hi] along the orientation normal. The slab
+        // is widened slightly to accommodate round-off, so contours lying on the boundary, or on the plane of a
+        // zero-thickness slab, are included.
+        std::vector<const entry_t *> within_slab(double offset_lo, double offset_hi) const;
+
+        size_t size() const;
+};
+
+// A per-voxel mask for a single image, stored row-major (i.e., index = row * columns + column). Non-zero voxels are
+// bounded.
+//
+// For ContourOverlap::Ignore and ContourOverlap::ImplicitOrientations the values are 0 or 1, the latter toggling for
+// every enclosing contour. For ContourOverlap::HonourOppositeOrientations each enclosing contour adds +1 or -1
+// according to its orientation (relative to the image orientation normal), so overlapping contours with opposing
+// orientations cancel.
+//
+// For Inclusivity::Centre only voxel centres are considered. For Inclusivity::Inclusive a voxel is enclosed if the
+// centre or any in-plane corner is enclosed, and for Inclusivity::Exclusive the centre and all corners must be.
+using contour_voxel_mask_t = std::vector<int32_t>;
+
+contour_voxel_mask_t Rasterize_Contour_Voxel_Mask(const planar_image<float,double> &img,
+                                                  const contour_slice_index &index,
+                                                  Mutate_Voxels_Opts::Inclusivity inclusivity,
+                                                  Mutate_Voxels_Opts::ContourOverlap contouroverlap);
+
+// A cache of indices and masks for a single set of contours. It is meant to be scoped to a single operation, and all
+// cached data are released when it is destroyed.
+//
+// The contours are identified by the addresses of their collections, so they must not be altered while the cache is
+// in use. Providing different collections discards everything cached for the previous collections. Thread-safe.
+class contour_voxel_mask_cache {
+    private:
+        // Exact image geometry and mask options.
+        using mask_key_t = std::array<double, 19>;
+
+        std::mutex m;
+        std::vector<const contour_collection<double> *> contours;
+        std::list<std::shared_ptr<const contour_slice_index>> indices;
+        std::map<mask_key_t, std::shared_ptr<const contour_voxel_mask_t>> masks;
+        std::list<mask_key_t> mask_order; // Oldest first.
+        size_t mask_bytes = 0;
+
+    public:
+        // Returns the mask for the image, building the index and rasterizing contours only when the mask is not
+        // cached.
+        std::shared_ptr<const contour_voxel_mask_t>
+        get(const planar_image<float,double> &img,
+            const std::list<std::reference_wrapper<contour_collection<double>>> &ccsl,
+            Mutate_Voxels_Opts::Inclusivity inclusivity,
+            Mutate_Voxels_Opts::ContourOverlap contouroverlap);
+
+        // Discards all cached indices and masks.
+        void clear();
+};
+
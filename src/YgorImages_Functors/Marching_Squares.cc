@@ -0,0 +1,264 @@
+//Marching_Squares.cc - A part of DICOMautomaton 2024. Written by hal clark.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "YgorImages.h"
+#include "YgorMath.h"
+#include "YgorMisc.h"
+#include "YgorLog.h"
+
+#include "../Thread_Pool.h"
+#include "Marching_Squares.h"
+
+
+namespace {
+
+// Cell edges, in clockwise order. Edge e joins corner e and corner (e+1)%4, where corners are also in clockwise order
+// (top-left, top-right, bottom-right, bottom-left).
+enum cell_edge : int8_t {
+    e_top    = 0,
+    e_right  = 1,
+    e_bottom = 2,
+    e_left   = 3,
+};
+
+struct cell_segments_t {
+    int8_t N = 0;
+    std::array<int8_t, 2> from = {{ 0, 0 }};
+    std::array<int8_t, 2> to   = {{ 0, 0 }};
+};
+
+// Indexed by [configuration][centre is interior]. Configuration bits are (top-left, top-right, bottom-right,
+// bottom-left), from most to least significant.
+using edge_table_t = std::array<std::array<cell_segments_t, 2>, 16>;
+
+edge_table_t build_edge_table(){
+    edge_table_t table;
+    for(int k = 0; k < 16; ++k){
+        const std::array<bool, 4> interior = {{ (k & 8) != 0, (k & 4) != 0, (k & 2) != 0, (k & 1) != 0 }};
+
+        for(int centre = 0; centre < 2; ++centre){
+            auto &t = table[k][centre];
+
+            // Walking the cell perimeter clockwise, segments run from an edge where the walk enters the interior to an
+            // edge where it exits. This places the interior on the same side of every segment, so segments from
+            // neighbouring cells chain with consistent orientation.
+            //
+            // Saddles have two entries and two exits. Each entry is paired with the following exit, which separates the
+            // interior corners, unless the centre is interior, in which case the preceding exit is used to join them.
+            const bool is_saddle = (k == 5) || (k == 10);
+            for(int8_t e = 0; e < 4; ++e){
+                const bool is_entry = !interior[e] && interior[(e + 1) % 4];
+                if(!is_entry) continue;
+
+                const int step = (is_saddle && (centre == 1)) ? 3 : 1;
+                for(int d = 0, x = (e + step) % 4; d < 4; ++d, x = (x + step) % 4){
+                    const bool is_exit = interior[x] && !interior[(x + 1) % 4];
+                    if(is_exit){
+                        t.from[t.N] = e;
+                        t.to[t.N] = static_cast<int8_t>(x);
+                        ++(t.N);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return table;
+}
+
+const edge_table_t & get_edge_table(){
+    static const edge_table_t table = build_edge_table();
+    return table;
+}
+
+} // namespace
+
+
+std::list<contour_of_points<double>>
+Marching_Squares(const planar_image<float,double> &img,
+                 const marching_squares_opts &opts){
+    std::list<contour_of_points<double>> out;
+    if( (img.rows <= 0) || (img.columns <= 0) ) return out;
+    if( (opts.channel < 0) || (img.channels <= opts.channel) ){
+        throw std::invalid_argument("Requested channel is not present. Cannot continue.");
+    }
+
+    const bool has_lower = std::isfinite(opts.lower);
+    const bool has_upper = std::isfinite(opts.upper);
+    if(!has_lower && !has_upper){
+        throw std::invalid_argument("Unable to discern finite threshold. Refusing to continue.");
+    }
+    if(has_lower && has_upper && (opts.upper < opts.lower)){
+        throw std::invalid_argument("Thresholds conflict. Refusing to continue.");
+    }
+
+    // A scalar field that is non-negative for interior voxels and varies linearly with voxel value, so isocontour
+    // crossings can be interpolated directly. Voxels that cannot be classified are exterior.
+    const double exterior = -1.0;
+    const double midpoint = 0.5 * (opts.lower + opts.upper);
+    const double half_width = 0.5 * (opts.upper - opts.lower);
+    const auto field = [&](float v) -> double {
+        double g = exterior;
+        if(has_lower && has_upper){
+            g = half_width - std::abs(static_cast<double>(v) - midpoint);
+        }else if(has_lower){
+            g = static_cast<double>(v) - opts.lower;
+        }else{
+            g = opts.upper - static_cast<double>(v);
+        }
+        return std::isnan(g) ? exterior : g;
+    };
+
+    // Samples are taken on a grid padded with one exterior row and column on each side. Padded sample (r, c)
+    // corresponds to voxel (r - 1, c - 1).
+    const int64_t R = img.rows;
+    const int64_t C = img.columns;
+    const int64_t W = C + 2;
+    const auto origin = img.anchor + img.offset;
+    const auto row_step = img.row_unit * img.pxl_dx;
+    const auto col_step = img.col_unit * img.pxl_dy;
+    const auto position = [&](int64_t r, int64_t c) -> vec3<double> {
+        return origin + row_step * static_cast<double>(r - 1)
+                      + col_step * static_cast<double>(c - 1);
+    };
+
+    std::vector<double> g_top(W, exterior);
+    std::vector<double> g_bot(W, exterior);
+    const auto load_row = [&](int64_t r, std::vector<double> &g){
+        if( (r <= 0) || (R < r) ){
+            std::fill(std::begin(g), std::end(g), exterior);
+            return;
+        }
+        const auto *p = &(img.data[img.index(r - 1, 0, opts.channel)]);
+        for(int64_t c = 0; c < C; ++c){
+            g[c + 1] = field(p[c * img.channels]);
+        }
+        g.front() = exterior;
+        g.back() = exterior;
+        return;
+    };
+
+    // Vertices are created when first needed and shared by both adjacent cells. Only the edges bordering the current
+    // row pair need to be tracked.
+    std::vector<vec3<double>> verts;
+    std::vector<int64_t> next; // The vertex following each vertex along its contour.
+    std::vector<int64_t> h_top(W - 1, -1); // Vertices along horizontal edges in the top row of the current cells.
+    std::vector<int64_t> h_bot(W - 1, -1); // Vertices along horizontal edges in the bottom row of the current cells.
+    std::vector<int64_t> v_mid(W, -1);     // Vertices along vertical edges of the current cells.
+
+    const auto interpolate = [&](double g_a, int64_t r_a, int64_t c_a,
+                                 double g_b, int64_t r_b, int64_t c_b) -> int64_t {
+        auto t = g_a / (g_a - g_b);
+        if(!std::isfinite(t)) t = 0.5;
+        const auto p_a = position(r_a, c_a);
+        const auto p_b = position(r_b, c_b);
+        verts.emplace_back( p_a + (p_b - p_a) * t );
+        next.emplace_back(-1);
+        return static_cast<int64_t>(verts.size()) - 1;
+    };
+
+    const auto get_vertex = [&](int8_t e, int64_t r, int64_t c) -> int64_t {
+        int64_t *v = nullptr;
+        if(e == e_top){
+            v = &(h_top[c]);
+            if(*v < 0) *v = interpolate(g_top[c], r, c, g_top[c + 1], r, c + 1);
+        }else if(e == e_bottom){
+            v = &(h_bot[c]);
+            if(*v < 0) *v = interpolate(g_bot[c], r + 1, c, g_bot[c + 1], r + 1, c + 1);
+        }else if(e == e_left){
+            v = &(v_mid[c]);
+            if(*v < 0) *v = interpolate(g_top[c], r, c, g_bot[c], r + 1, c);
+        }else{
+            v = &(v_mid[c + 1]);
+            if(*v < 0) *v = interpolate(g_top[c + 1], r, c + 1, g_bot[c + 1], r + 1, c + 1);
+        }
+        return *v;
+    };
+
+    const auto &edge_table = get_edge_table();
+    load_row(0, g_top);
+    for(int64_t r = 0; r <= R; ++r){
+        load_row(r + 1, g_bot);
+        std::fill(std::begin(h_bot), std::end(h_bot), -1);
+        std::fill(std::begin(v_mid), std::end(v_mid), -1);
+
+        for(int64_t c = 0; c <= C; ++c){
+            const double tl = g_top[c];
+            const double tr = g_top[c + 1];
+            const double br = g_bot[c + 1];
+            const double bl = g_bot[c];
+            const int k = ((0.0 <= tl) ? 8 : 0)
+                        | ((0.0 <= tr) ? 4 : 0)
+                        | ((0.0 <= br) ? 2 : 0)
+                        | ((0.0 <= bl) ? 1 : 0);
+            if( (k == 0) || (k == 15) ) continue;
+
+            const bool centre = ((k == 5) || (k == 10)) && (0.0 <= 0.25 * (tl + tr + br + bl));
+            const auto &segs = edge_table[k][centre ? 1 : 0];
+            for(int8_t s = 0; s < segs.N; ++s){
+                const auto a = get_vertex(segs.from[s], r, c);
+                const auto b = get_vertex(segs.to[s], r, c);
+                next[a] = b;
+            }
+        }
+
+        std::swap(g_top, g_bot);
+        std::swap(h_top, h_bot);
+    }
+
+    // Walk the vertex chains. Vertices only coincide when a voxel lies exactly on a threshold, so coincident
+    // neighbours are pruned as the contour is assembled.
+    const auto N_verts = static_cast<int64_t>(verts.size());
+    std::vector<uint8_t> visited(N_verts, 0);
+    for(int64_t s = 0; s < N_verts; ++s){
+        if(visited[s] != 0) continue;
+
+        contour_of_points<double> cop;
+        cop.closed = true;
+        int64_t i = s;
+        while( (0 <= i) && (visited[i] == 0) ){
+            visited[i] = 1;
+            if( cop.points.empty() || !(cop.points.back() == verts[i]) ){
+                cop.points.push_back(verts[i]);
+            }
+            i = next[i];
+        }
+        if( (1 < cop.points.size()) && (cop.points.front() == cop.points.back()) ){
+            cop.points.pop_back();
+        }
+        if(3 <= cop.points.size()){
+            out.emplace_back(std::move(cop));
+        }
+    }
+    return out;
+}
+
+
+std::list<contour_of_points<double>>
+Marching_Squares(const std::list<std::reference_wrapper<const planar_image<float,double>>> &imgs,
+                 const marching_squares_opts &opts){
+    std::vector<const planar_image<float,double> *> img_ptrs;
+    img_ptrs.reserve(imgs.size());
+    for(const auto &img_refw : imgs) img_ptrs.push_back( &(img_refw.get()) );
+
+    const auto N_imgs = static_cast<int64_t>(img_ptrs.size());
+    std::vector<std::list<contour_of_points<double>>> results(N_imgs);
+    parallel_for(0, N_imgs, [&](int64_t i){
+        results[i] = Marching_Squares(*(img_ptrs[i]), opts);
+    });
+
+    std::list<contour_of_points<double>> out;
+    for(auto &l : results) out.splice(std::end(out), l);
+    return out;
+}
+
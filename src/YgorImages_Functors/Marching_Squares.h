@@ -0,0 +1,39 @@
+//Marching_Squares.h.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+
+#include "YgorImages.h"
+#include "YgorMath.h"
+
+// This file provides a marching-squares engine for extracting threshold isocontours from images.
+//
+// Voxels are interior when lower <= value <= upper, and isocontour vertices are estimated by linearly interpolating
+// between adjacent voxel centres. The image is implicitly surrounded by exterior voxels, so all contours are closed.
+//
+// Rows are processed in pairs and cell configurations are resolved using a precomputed edge table, so each voxel is
+// read once and each vertex is computed once and shared by both cells adjacent to it. Contours are therefore emitted
+// without duplicate vertices. Ambiguous saddle configurations are resolved by sampling the cell centre.
+//
+// Contours are consistently oriented: outer boundaries are counter-clockwise when viewed along row_unit x col_unit,
+// and holes are clockwise.
+
+struct marching_squares_opts {
+    double lower = -std::numeric_limits<double>::infinity(); // Inclusive. At least one threshold must be finite.
+    double upper =  std::numeric_limits<double>::infinity(); // Inclusive.
+    int64_t channel = 0;
+};
+
+std::list<contour_of_points<double>>
+Marching_Squares(const planar_image<float,double> &img,
+                 const marching_squares_opts &opts);
+
+// Processes all images in a single parallel pass. Contours are returned in image order.
+std::list<contour_of_points<double>>
+Marching_Squares(const std::list<std::reference_wrapper<const planar_image<float,double>>> &imgs,
+                 const marching_squares_opts &opts);
+
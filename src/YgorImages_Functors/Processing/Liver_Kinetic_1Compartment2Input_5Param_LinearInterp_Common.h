@@ -19,6 +19,10 @@ struct KineticModel_Liver_1C2I_5Param_LinearInterp_UserData {
     std::list<KineticModel_PixelSelectionCriteria> pixels_to_plot;
 
     std::regex TargetROIs;
+
+    // Whether to fit all voxels together using the batched fitting engine rather than fitting each voxel
+    // individually.
+    bool UseBatchedFitting = false;
 };
 
 #endif // DCMA_USE_GNU_GSL
@@ -5,6 +5,7 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/iterator/iterator_traits.hpp>
 #include <cstddef>
+#include <cstdint>
 #include <array>
 #include <exception>
 #include <any>
@@ -22,11 +23,13 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "../../Common_Boost_Serialization.h"
 #include "../../Common_Plotting.h"
 #include "../../KineticModel_1Compartment2Input_5Param_LinearInterp_Common.h"
 #include "../../KineticModel_1Compartment2Input_5Param_LinearInterp_LevenbergMarquardt.h"
+#include "../../KineticModel_1Compartment2Input_5Param_LinearInterp_Batched.h"
 #include "../ConvenienceRoutines.h"
 #include "Liver_Kinetic_1Compartment2Input_5Param_LinearInterp_Common.h"
 #include "Liver_Kinetic_1Compartment2Input_5Param_LinearInterp_LevenbergMarquardt.h"
@@ -243,6 +246,80 @@ KineticModel_Liver_1C2I_5Param_LinearInterp(planar_image_collection<float,double
     } //Loop over contour_collections.
 
 
+    //Record a fitted voxel in the parameter maps, plotting the fitted model if requested.
+    const auto record_fit = [&](long int row, long int col, long int chan,
+                                const KineticModel_1Compartment2Input_5Param_LinearInterp_Parameters &after_state) -> void {
+        if(!after_state.FittingSuccess) ++Minimization_Failure_Count;
+
+        const double RSS  = after_state.RSS;
+        const double k1A  = after_state.k1A;
+        const double tauA = after_state.tauA;
+        const double k1V  = after_state.k1V;
+        const double tauV = after_state.tauV;
+        const double k2   = after_state.k2;
+        if(true) YLOGINFO("k1A,tauA,k1V,tauV,k2,RSS = " << k1A << ", " << tauA << ", " 
+                          << k1V << ", " << tauV << ", " << k2 << ", " << RSS);
+
+        //const auto LiverPerfusion = (k1A + k1V);
+        //const auto MeanTransitTime = 1.0 / k2;
+        //const auto ArterialFraction = 100.0 * k1A / LiverPerfusion;
+        //const auto DistributionVolume = 100.0 * LiverPerfusion * MeanTransitTime;
+
+        //==============================================================================
+        // Plot the fitted model with the ROI time course.
+        if(PixelsToPlot.count( {row, col}) != 0){ 
+            std::map<std::string, samples_1D<double>> time_courses;
+            std::string title;
+            //Add the ROI.
+            title = "Linear Interpolation: ROI time course: row = " + std::to_string(row) + ", col = " + std::to_string(col);
+            time_courses[title] = *(after_state.cROI);
+            samples_1D<double> fitted_model;
+            KineticModel_1Compartment2Input_5Param_LinearInterp_Results eval_res;
+            for(const auto &P : after_state.cROI->samples){
+                const double t = P[0];
+                Evaluate_Model(after_state,t,eval_res);
+                fitted_model.push_back(t, 0.0, eval_res.I, 0.0);
+            }
+            title = "Fitted model";
+            time_courses[title] = fitted_model;
+
+            PlotTimeCourses("Raw ROI and Fitted Model", time_courses, {});
+        }
+
+        //==============================================================================
+
+        //Update pixel values.
+        const auto k1A_f  = static_cast<float>(k1A);
+        const auto tauA_f = static_cast<float>(tauA);
+        const auto k1V_f  = static_cast<float>(k1V);
+        const auto tauV_f = static_cast<float>(tauV);
+        const auto k2_f   = static_cast<float>(k2);
+
+        minmax_k1A.Digest(k1A_f);
+        minmax_tauA.Digest(tauA_f);
+        minmax_k1V.Digest(k1V_f);
+        minmax_tauV.Digest(tauV_f);
+        minmax_k2.Digest(k2_f);
+
+        {
+            out_img_k1A.get().reference(row, col, chan)  = k1A_f;
+            out_img_tauA.get().reference(row, col, chan) = tauA_f;
+            out_img_k1V.get().reference(row, col, chan)  = k1V_f;
+            out_img_tauV.get().reference(row, col, chan) = tauV_f;
+            out_img_k2.get().reference(row, col, chan)   = k2_f;
+        }
+        return;
+    };
+
+    //Voxels awaiting batched fitting.
+    struct pending_voxel {
+        long int row;
+        long int col;
+        long int chan;
+        std::shared_ptr<samples_1D<double>> cROI;
+    };
+    std::vector<pending_voxel> pending;
+
 
     //Loop over the cc_ROIs, rois, rows, columns, channels, and finally any selected images (if applicable).
     //for(const auto &roi : rois){
@@ -296,7 +373,7 @@ KineticModel_Liver_1C2I_5Param_LinearInterp(planar_image_collection<float,double
                         for(auto chan = 0; chan < first_img_it->channels; ++chan){
 
                             //Provide a prediction time.
-                            if(Actual_Operation_Count > 0.5){
+                            if(!user_data_s->UseBatchedFitting && (Actual_Operation_Count > 0.5)){
                                 boost::posix_time::ptime current_t = boost::posix_time::microsec_clock::local_time();
                                 auto elapsed_dt = (current_t - start_t).total_milliseconds();
                                 auto expected_dt_f = static_cast<double>(elapsed_dt) * (Expected_Operation_Count/Actual_Operation_Count);
@@ -367,6 +444,13 @@ KineticModel_Liver_1C2I_5Param_LinearInterp(planar_image_collection<float,double
                             //==============================================================================
                             //Fit the model.
 
+                            // When fitting in batches, the time course is only collected here. All collected voxels are fitted
+                            // together after every voxel has been visited.
+                            if(user_data_s->UseBatchedFitting){
+                                pending.push_back({ row, col, chan, channel_time_course });
+                                continue;
+                            }
+
                             // This routine fits a pharmacokinetic model to the observed liver perfusion data using a 
                             // direct linear interpolation approach.
 
@@ -380,67 +464,7 @@ KineticModel_Liver_1C2I_5Param_LinearInterp(planar_image_collection<float,double
 
                             //KineticModel_1Compartment2Input_5Param_LinearInterp_Parameters after_state = Optimize_LevenbergMarquardt_3Param(model_state);
                             KineticModel_1Compartment2Input_5Param_LinearInterp_Parameters after_state = Optimize_LevenbergMarquardt_5Param(model_state);
-
-                            if(!after_state.FittingSuccess) ++Minimization_Failure_Count;
-
-                            const double RSS  = after_state.RSS;
-                            const double k1A  = after_state.k1A;
-                            const double tauA = after_state.tauA;
-                            const double k1V  = after_state.k1V;
-                            const double tauV = after_state.tauV;
-                            const double k2   = after_state.k2;
-                            if(true) YLOGINFO("k1A,tauA,k1V,tauV,k2,RSS = " << k1A << ", " << tauA << ", " 
-                                              << k1V << ", " << tauV << ", " << k2 << ", " << RSS);
-
-                            //const auto LiverPerfusion = (k1A + k1V);
-                            //const auto MeanTransitTime = 1.0 / k2;
-                            //const auto ArterialFraction = 100.0 * k1A / LiverPerfusion;
-                            //const auto DistributionVolume = 100.0 * LiverPerfusion * MeanTransitTime;
-
-                            //==============================================================================
-                            // Plot the fitted model with the ROI time course.
-                            if(PixelsToPlot.count( {row, col}) != 0){ 
-                                std::map<std::string, samples_1D<double>> time_courses;
-                                std::string title;
-                                //Add the ROI.
-                                title = "Linear Interpolation: ROI time course: row = " + std::to_string(row) + ", col = " + std::to_string(col);
-                                time_courses[title] = *(after_state.cROI);
-                                samples_1D<double> fitted_model;
-                                KineticModel_1Compartment2Input_5Param_LinearInterp_Results eval_res;
-                                for(const auto &P : after_state.cROI->samples){
-                                    const double t = P[0];
-                                    Evaluate_Model(after_state,t,eval_res);
-                                    fitted_model.push_back(t, 0.0, eval_res.I, 0.0);
-                                }
-                                title = "Fitted model";
-                                time_courses[title] = fitted_model;
-
-                                PlotTimeCourses("Raw ROI and Fitted Model", time_courses, {});
-                            }
-                            
-                            //==============================================================================
- 
-                            //Update pixel values.
-                            const auto k1A_f  = static_cast<float>(k1A);
-                            const auto tauA_f = static_cast<float>(tauA);
-                            const auto k1V_f  = static_cast<float>(k1V);
-                            const auto tauV_f = static_cast<float>(tauV);
-                            const auto k2_f   = static_cast<float>(k2);
-
-                            minmax_k1A.Digest(k1A_f);
-                            minmax_tauA.Digest(tauA_f);
-                            minmax_k1V.Digest(k1V_f);
-                            minmax_tauV.Digest(tauV_f);
-                            minmax_k2.Digest(k2_f);
-
-                            {
-                                out_img_k1A.get().reference(row, col, chan)  = k1A_f;
-                                out_img_tauA.get().reference(row, col, chan) = tauA_f;
-                                out_img_k1V.get().reference(row, col, chan)  = k1V_f;
-                                out_img_tauV.get().reference(row, col, chan) = tauV_f;
-                                out_img_k2.get().reference(row, col, chan)   = k2_f;
-                            }
-                            // ----------------------------------------------------------------------------
+                            record_fit(row, col, chan, after_state);
     
                         }//Loop over channels.
     
@@ -458,6 +482,55 @@ KineticModel_Liver_1C2I_5Param_LinearInterp(planar_image_collection<float,double
         } //Loop over ROIs.
     } //Loop over contour_collections.
 
+    //Fit the collected voxels in batches. Voxels with identical sample times are fitted together, and each voxel is
+    // warm-started from the first voxel in its 2x2 block of voxels, which is fitted first.
+    if(!pending.empty()){
+        std::map<std::vector<double>, std::vector<size_t>> groups;
+        for(size_t i = 0; i < pending.size(); ++i){
+            std::vector<double> times;
+            for(const auto &P : pending[i].cROI->samples) times.push_back(P[0]);
+            groups[times].push_back(i);
+        }
+
+        for(const auto &group : groups){
+            KineticModel_1Compartment2Input_5Param_LinearInterp_Batch batch;
+            batch.cAIF = Carterial;
+            batch.cVIF = Cvenous;
+            batch.times = group.first;
+
+            std::map<std::array<long int, 3>, int64_t> index;
+            for(const auto &i : group.second){
+                const auto &p = pending[i];
+                std::vector<double> obs;
+                for(const auto &P : p.cROI->samples) obs.push_back(P[2]);
+                const auto n = batch.add_voxel(obs);
+                index.emplace( std::array<long int, 3>{{ p.row, p.col, p.chan }}, n );
+            }
+            for(int64_t n = 0; n < batch.size(); ++n){
+                const auto &p = pending[group.second[n]];
+                const auto it = index.find( std::array<long int, 3>{{ p.row - (p.row % 2), p.col - (p.col % 2), p.chan }} );
+                if( (it != index.end()) && (it->second != n) ) batch.seeds[n] = it->second;
+            }
+
+            Optimize_LevenbergMarquardt_5Param_Batched(batch);
+
+            for(int64_t n = 0; n < batch.size(); ++n){
+                const auto &p = pending[group.second[n]];
+                KineticModel_1Compartment2Input_5Param_LinearInterp_Parameters after_state = model_state;
+                after_state.cROI = p.cROI;
+                after_state.FittingPerformed = true;
+                after_state.FittingSuccess = (batch.FittingSuccess[n] != 0);
+                after_state.RSS  = batch.RSS[n];
+                after_state.k1A  = batch.k1A[n];
+                after_state.tauA = batch.tauA[n];
+                after_state.k1V  = batch.k1V[n];
+                after_state.tauV = batch.tauV[n];
+                after_state.k2   = batch.k2[n];
+                record_fit(p.row, p.col, p.chan, after_state);
+            }
+        }
+    }
+
     YLOGWARN("Minimization failure count: " << Minimization_Failure_Count);
 
 
@@ -5,6 +5,7 @@
 #include <stdexcept>
 
 #include "../ConvenienceRoutines.h"
+#include "../Contour_Voxel_Index.h"
 #include "Partitioned_Image_Voxel_Visitor_Mutator.h"
 #include "YgorImages.h"
 #include "YgorMisc.h"
@@ -48,13 +49,59 @@ bool PartitionedImageVoxelVisitorMutator(planar_image_collection<float,double>::
     std::list<std::reference_wrapper<planar_image<float,double>>> selected_imgs;
     for(auto &img_it : selected_img_its) selected_imgs.push_back( std::ref(*img_it) );
 
-    Mutate_Voxels<float,double>( std::ref(*first_img_it),
-                                 selected_imgs, 
-                                 ccsl, 
-                                 user_data_s->mutation_opts, 
-                                 user_data_s->f_bounded,
-                                 user_data_s->f_unbounded,
-                                 user_data_s->f_visitor );
+    // When each voxel is only affected by itself, voxels can be visited directly using a cached, scanline-rasterized
+    // mask. This avoids testing every voxel against every contour, which is costly for large RTSTRUCTs. Other
+    // options are handled generically.
+    const auto &opts = user_data_s->mutation_opts;
+    const bool use_cached_mask = (user_data_s->mask_cache != nullptr)
+                              && (opts.editstyle == Mutate_Voxels_Opts::EditStyle::InPlace)
+                              && (opts.aggregate == Mutate_Voxels_Opts::Aggregate::First)
+                              && (opts.adjacency == Mutate_Voxels_Opts::Adjacency::SingleVoxel)
+                              && (opts.maskmod == Mutate_Voxels_Opts::MaskMod::Noop)
+                              && !selected_imgs.empty()
+                              && (&(selected_imgs.front().get()) == &(*first_img_it));
+    if(use_cached_mask){
+        auto &img = *first_img_it;
+        const auto mask = user_data_s->mask_cache->get(img, ccsl, opts.inclusivity, opts.contouroverlap);
+
+        planar_image<float,double> mask_img;
+        mask_img.init_orientation(img.row_unit, img.col_unit);
+        mask_img.init_buffer(img.rows, img.columns, 1);
+        mask_img.init_spatial(img.pxl_dx, img.pxl_dy, img.pxl_dz, img.anchor, img.offset);
+
+        auto img_refw = std::ref(img);
+        auto mask_img_refw = std::ref(mask_img);
+        for(long int row = 0; row < img.rows; ++row){
+            for(long int col = 0; col < img.columns; ++col){
+                const auto m = (*mask)[row * img.columns + col];
+                mask_img.reference(row, col, 0) = static_cast<float>(m);
+            }
+        }
+        for(long int row = 0; row < img.rows; ++row){
+            for(long int col = 0; col < img.columns; ++col){
+                const bool is_bounded = ((*mask)[row * img.columns + col] != 0);
+                for(long int chan = 0; chan < img.channels; ++chan){
+                    float val = img.value(row, col, chan);
+                    if(is_bounded){
+                        if(user_data_s->f_bounded) user_data_s->f_bounded(row, col, chan, img_refw, mask_img_refw, val);
+                    }else{
+                        if(user_data_s->f_unbounded) user_data_s->f_unbounded(row, col, chan, img_refw, mask_img_refw, val);
+                    }
+                    if(user_data_s->f_visitor) user_data_s->f_visitor(row, col, chan, img_refw, mask_img_refw, val);
+                    img.reference(row, col, chan) = val;
+                }
+            }
+        }
+
+    }else{
+        Mutate_Voxels<float,double>( std::ref(*first_img_it),
+                                     selected_imgs, 
+                                     ccsl, 
+                                     user_data_s->mutation_opts, 
+                                     user_data_s->f_bounded,
+                                     user_data_s->f_unbounded,
+                                     user_data_s->f_visitor );
+    }
 
 
     //Alter the first image's metadata to reflect that averaging has occurred. You might want to consider
@@ -8,6 +8,7 @@
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 
 #include "YgorImages.h"
@@ -15,6 +16,8 @@
 #include "YgorMisc.h"
 #include "YgorLog.h"
 
+#include "../Contour_Voxel_Index.h"
+
 template <class T> class contour_collection;
 
 
@@ -28,6 +31,9 @@ struct PartitionedImageVoxelVisitorMutatorUserData {
     Mutate_Voxels_Functor<float,double> f_visitor;   // Applied to all voxels.
     
     std::string description; // If non-empty, used to update image metadata.
+
+    // Voxel masks shared by all images processed with this struct, and released along with it.
+    std::shared_ptr<contour_voxel_mask_cache> mask_cache = std::make_shared<contour_voxel_mask_cache>();
 };
 
 
@@ -0,0 +1,367 @@
+//Separable_Convolution.cc - A part of DICOMautomaton 2024. Written by hal clark.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+#include "YgorImages.h"
+#include "YgorMath.h"
+#include "YgorMisc.h"
+#include "YgorLog.h"
+
+#include "../Thread_Pool.h"
+#include "Contour_Voxel_Index.h"
+#include "Separable_Convolution.h"
+
+
+namespace {
+
+// dst[i] += w * src[i] for i in [0, n).
+inline void accumulate_weighted(float w, const float *src, float *dst, int64_t n){
+    int64_t i = 0;
+#if defined(__AVX__)
+    const __m256 vw = _mm256_set1_ps(w);
+    for(; (i + 8) <= n; i += 8){
+        const __m256 s = _mm256_loadu_ps(src + i);
+        const __m256 d = _mm256_loadu_ps(dst + i);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(d, _mm256_mul_ps(vw, s)));
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t vw = vdupq_n_f32(w);
+    for(; (i + 4) <= n; i += 4){
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vw, vld1q_f32(src + i)));
+    }
+#endif
+    for(; i < n; ++i){
+        dst[i] += w * src[i];
+    }
+    return;
+}
+
+// Converts accumulated sums for a single row into output voxels, honouring the mask.
+inline void finalize_row(const float *num,
+                         const float *den,
+                         const float *in,
+                         const uint8_t *mask,
+                         float *out,
+                         int64_t n,
+                         separable_edge edge,
+                         float min_weight){
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    if(edge == separable_edge::renormalize){
+        for(int64_t i = 0; i < n; ++i){
+            const float v = (min_weight <= den[i]) ? (num[i] / den[i]) : nan;
+            out[i] = ((mask == nullptr) || (mask[i] != 0)) ? v : in[i];
+        }
+    }else{
+        for(int64_t i = 0; i < n; ++i){
+            out[i] = ((mask == nullptr) || (mask[i] != 0)) ? num[i] : in[i];
+        }
+    }
+    return;
+}
+
+} // namespace
+
+
+separable_img_refws_t Order_Images_For_Separable_Convolution(planar_image_collection<float,double> &imagecoll,
+                                                             const vec3<double> &orientation_normal){
+    separable_img_refws_t out;
+    if(imagecoll.images.empty()) return out;
+
+    std::list<std::reference_wrapper<planar_image<float,double>>> selected_imgs;
+    for(auto &img : imagecoll.images){
+        selected_imgs.push_back( std::ref(img) );
+    }
+    if(!Images_Form_Rectilinear_Grid(selected_imgs)) return out;
+
+    const auto &first = imagecoll.images.front();
+    for(const auto &img : imagecoll.images){
+        if( (img.rows != first.rows)
+        ||  (img.columns != first.columns)
+        ||  (img.channels != first.channels)
+        ||  (static_cast<int64_t>(img.data.size()) != (static_cast<int64_t>(img.rows) * img.columns * img.channels)) ){
+            return out;
+        }
+    }
+
+    planar_image_adjacency<float,double> img_adj( {}, { { std::ref(imagecoll) } }, orientation_normal );
+    const auto N_imgs = static_cast<int64_t>(img_adj.int_to_img.size());
+    if(N_imgs != static_cast<int64_t>(imagecoll.images.size())) return out;
+
+    for(int64_t i = 0; i < N_imgs; ++i){
+        if(!img_adj.index_present(i)) return separable_img_refws_t();
+        out.push_back( img_adj.index_to_image(i) );
+    }
+    return out;
+}
+
+
+dense_voxel_volume Extract_Dense_Voxel_Volume(const separable_img_refws_t &imgs, int64_t channel){
+    dense_voxel_volume vol;
+    if(imgs.empty()) return vol;
+    vol.rows = imgs.front().get().rows;
+    vol.columns = imgs.front().get().columns;
+    vol.images = static_cast<int64_t>(imgs.size());
+    vol.voxels.resize(static_cast<size_t>(vol.rows * vol.columns * vol.images));
+
+    parallel_for(0, vol.images, [&](int64_t z){
+        const auto &img = imgs[z].get();
+        for(int64_t r = 0; r < vol.rows; ++r){
+            for(int64_t c = 0; c < vol.columns; ++c){
+                vol.voxels[vol.index(z, r, c)] = img.value(r, c, channel);
+            }
+        }
+    }, 1);
+    return vol;
+}
+
+
+void Insert_Dense_Voxel_Volume(const dense_voxel_volume &vol,
+                               const std::vector<uint8_t> &mask,
+                               separable_img_refws_t &imgs,
+                               int64_t channel){
+    if(static_cast<int64_t>(imgs.size()) != vol.images){
+        throw std::invalid_argument("Voxel volume does not match the images");
+    }
+    parallel_for(0, vol.images, [&](int64_t z){
+        auto &img = imgs[z].get();
+        for(int64_t r = 0; r < vol.rows; ++r){
+            for(int64_t c = 0; c < vol.columns; ++c){
+                const auto i = vol.index(z, r, c);
+                if(mask.empty() || (mask[i] != 0)){
+                    img.reference(r, c, channel) = vol.voxels[i];
+                }
+            }
+        }
+    }, 1);
+    return;
+}
+
+
+std::vector<uint8_t> Contour_Voxel_Mask(const separable_img_refws_t &imgs,
+                                        std::list<std::reference_wrapper<contour_collection<double>>> ccsl){
+    if(imgs.empty()) return {};
+    const int64_t rows = imgs.front().get().rows;
+    const int64_t columns = imgs.front().get().columns;
+    std::vector<uint8_t> mask(static_cast<size_t>(rows * columns * static_cast<int64_t>(imgs.size())), 0);
+
+    contour_voxel_mask_cache cache;
+    parallel_for(0, static_cast<int64_t>(imgs.size()), [&](int64_t z){
+        const auto img_mask = cache.get(imgs[z].get(), ccsl,
+                                        Mutate_Voxels_Opts::Inclusivity::Centre,
+                                        Mutate_Voxels_Opts::ContourOverlap::Ignore);
+        const auto N = rows * columns;
+        for(int64_t i = 0; i < N; ++i){
+            mask[static_cast<size_t>(z * N + i)] = ((*img_mask)[i] != 0) ? 1 : 0;
+        }
+    }, 1);
+    return mask;
+}
+
+
+dense_voxel_volume Separable_Convolve_Axis(const dense_voxel_volume &in,
+                                           separable_axis axis,
+                                           const separable_kernel_1d &kernel,
+                                           separable_edge edge,
+                                           const std::vector<uint8_t> &mask,
+                                           float min_weight){
+    const auto rows = in.rows;
+    const auto columns = in.columns;
+    const auto images = in.images;
+    const auto N_taps = static_cast<int64_t>(kernel.weights.size());
+    if( !mask.empty()
+    &&  (mask.size() != in.voxels.size()) ){
+        throw std::invalid_argument("Voxel mask does not match the volume");
+    }
+    if(N_taps == 0){
+        throw std::invalid_argument("Kernel contains no weights");
+    }
+
+    dense_voxel_volume out;
+    out.rows = rows;
+    out.columns = columns;
+    out.images = images;
+    out.voxels.resize(in.voxels.size());
+    if(in.voxels.empty()) return out;
+
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    const bool renorm = (edge == separable_edge::renormalize);
+
+    // When renormalizing, non-finite voxels are replaced with zero-valued, zero-weight samples so the accumulation
+    // loops need not inspect samples.
+    std::vector<float> vals;
+    std::vector<float> wts;
+    const float *p_vals = in.voxels.data();
+    const float *p_wts = nullptr;
+    if(renorm){
+        vals.resize(in.voxels.size());
+        wts.resize(in.voxels.size());
+        parallel_for(0, images, [&](int64_t z){
+            const auto b = in.index(z, 0, 0);
+            const auto e = b + rows * columns;
+            for(auto i = b; i < e; ++i){
+                const auto v = in.voxels[i];
+                const bool finite = std::isfinite(v);
+                vals[i] = finite ? v : 0.0f;
+                wts[i] = finite ? 1.0f : 0.0f;
+            }
+        }, 1);
+        p_vals = vals.data();
+        p_wts = wts.data();
+    }
+
+    // Each task handles one row, identified by (image, row).
+    const auto N_lines = images * rows;
+    const auto grain = std::max<int64_t>(1, 4096 / std::max<int64_t>(1, columns));
+
+    if(axis == separable_axis::column){
+        // Samples along the row are contiguous, so each row is padded to avoid branching at the edges.
+        const auto N_padded = columns + N_taps - 1;
+        const float pad_val = renorm ? 0.0f : nan;
+
+        parallel_for(0, N_lines, [&](int64_t line){
+            thread_local std::vector<float> padded_vals;
+            thread_local std::vector<float> padded_wts;
+            thread_local std::vector<float> num;
+            thread_local std::vector<float> den;
+            padded_vals.assign(static_cast<size_t>(N_padded), pad_val);
+            num.assign(static_cast<size_t>(columns), 0.0f);
+            if(renorm){
+                padded_wts.assign(static_cast<size_t>(N_padded), 0.0f);
+                den.assign(static_cast<size_t>(columns), 0.0f);
+            }
+
+            // padded[t] holds the sample at column (t + first_offset).
+            const auto base = line * columns;
+            const auto t_begin = std::clamp<int64_t>(-kernel.first_offset, 0, N_padded);
+            const auto t_end = std::clamp<int64_t>(columns - kernel.first_offset, 0, N_padded);
+            if(t_begin < t_end){
+                std::copy( p_vals + base + t_begin + kernel.first_offset,
+                           p_vals + base + t_end + kernel.first_offset,
+                           padded_vals.data() + t_begin );
+                if(renorm){
+                    std::copy( p_wts + base + t_begin + kernel.first_offset,
+                               p_wts + base + t_end + kernel.first_offset,
+                               padded_wts.data() + t_begin );
+                }
+            }
+
+            for(int64_t j = 0; j < N_taps; ++j){
+                const auto w = kernel.weights[j];
+                accumulate_weighted(w, padded_vals.data() + j, num.data(), columns);
+                if(renorm) accumulate_weighted(w, padded_wts.data() + j, den.data(), columns);
+            }
+            finalize_row(num.data(), den.data(), in.voxels.data() + base,
+                         (mask.empty() ? nullptr : mask.data() + base),
+                         out.voxels.data() + base, columns, edge, min_weight);
+        }, grain);
+
+    }else if( (axis == separable_axis::row)
+          ||  (axis == separable_axis::image) ){
+        // Neighbouring samples are whole rows, either within the same image or in adjacent images.
+        const bool along_rows = (axis == separable_axis::row);
+        const auto extent = along_rows ? rows : images;
+        const auto stride = along_rows ? columns : (rows * columns);
+
+        parallel_for(0, N_lines, [&](int64_t line){
+            thread_local std::vector<float> num;
+            thread_local std::vector<float> den;
+            num.assign(static_cast<size_t>(columns), 0.0f);
+            den.assign(static_cast<size_t>(columns), 0.0f);
+
+            const auto z = line / rows;
+            const auto r = line % rows;
+            const auto pos = along_rows ? r : z;
+            const auto base = line * columns;
+
+            bool inaccessible = false;
+            for(int64_t j = 0; j < N_taps; ++j){
+                const auto d = kernel.first_offset + j;
+                if( ((pos + d) < 0) || (extent <= (pos + d)) ){
+                    inaccessible = true;
+                    continue;
+                }
+                const auto w = kernel.weights[j];
+                const auto n_base = base + d * stride;
+                accumulate_weighted(w, p_vals + n_base, num.data(), columns);
+                if(renorm) accumulate_weighted(w, p_wts + n_base, den.data(), columns);
+            }
+            if(!renorm && inaccessible){
+                std::fill(std::begin(num), std::end(num), nan);
+            }
+            finalize_row(num.data(), den.data(), in.voxels.data() + base,
+                         (mask.empty() ? nullptr : mask.data() + base),
+                         out.voxels.data() + base, columns, edge, min_weight);
+        }, grain);
+
+    }else{
+        throw std::invalid_argument("Axis not understood");
+    }
+    return out;
+}
+
+
+bool Factor_Separable_Kernel(const std::vector<float> &k_values,
+                             int64_t k_rows,
+                             int64_t k_columns,
+                             int64_t k_imgs,
+                             std::array<std::vector<float>, 3> &factors,
+                             double rel_tol){
+    if( (k_rows <= 0) || (k_columns <= 0) || (k_imgs <= 0)
+    ||  (static_cast<int64_t>(k_values.size()) != (k_rows * k_columns * k_imgs)) ){
+        return false;
+    }
+    const auto index = [=](int64_t r, int64_t c, int64_t i) -> int64_t {
+        return (r * k_columns + c) * k_imgs + i;
+    };
+
+    // Pivot on the largest-magnitude element so the factors are well-conditioned.
+    int64_t pivot = 0;
+    for(int64_t n = 0; n < static_cast<int64_t>(k_values.size()); ++n){
+        if(!std::isfinite(k_values[n])) return false;
+        if(std::abs(k_values[pivot]) < std::abs(k_values[n])) pivot = n;
+    }
+    const auto r0 = pivot / (k_columns * k_imgs);
+    const auto c0 = (pivot / k_imgs) % k_columns;
+    const auto i0 = pivot % k_imgs;
+    const double k0 = k_values[pivot];
+
+    std::array<std::vector<double>, 3> f;
+    f[0].resize(k_rows);
+    f[1].resize(k_columns, 1.0);
+    f[2].resize(k_imgs, 1.0);
+    for(int64_t r = 0; r < k_rows; ++r) f[0][r] = k_values[index(r, c0, i0)];
+    if(k0 != 0.0){
+        for(int64_t c = 0; c < k_columns; ++c) f[1][c] = k_values[index(r0, c, i0)] / k0;
+        for(int64_t i = 0; i < k_imgs; ++i) f[2][i] = k_values[index(r0, c0, i)] / k0;
+    }
+
+    const auto tol = rel_tol * std::abs(k0);
+    for(int64_t r = 0; r < k_rows; ++r){
+        for(int64_t c = 0; c < k_columns; ++c){
+            for(int64_t i = 0; i < k_imgs; ++i){
+                const auto predicted = f[0][r] * f[1][c] * f[2][i];
+                if(tol < std::abs(predicted - static_cast<double>(k_values[index(r, c, i)]))) return false;
+            }
+        }
+    }
+
+    for(size_t n = 0; n < 3; ++n){
+        factors[n].assign( std::begin(f[n]), std::end(f[n]) );
+    }
+    return true;
+}
+
@@ -0,0 +1,90 @@
+//Separable_Convolution.h.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <vector>
+
+#include "YgorImages.h"
+#include "YgorMath.h"
+
+// This file provides a fast path for volumetric convolution with separable kernels. Voxels are copied into a dense,
+// single-channel buffer and the kernel is applied as a sequence of 1D passes. Every pass is expressed as weighted sums
+// of whole contiguous rows, so the inner loops are branch-free and are vectorized with AVX or NEON when available
+// (e.g., when compiling with '-march=native'), falling back to plain loops the compiler can auto-vectorize.
+//
+// Voxel offsets use the same (row, column, image) convention as the volumetric neighbourhood sampler, where the image
+// number is the position along the orientation normal.
+
+enum class separable_axis {
+    row,
+    column,
+    image,
+};
+
+// Controls how inaccessible (i.e., out-of-bounds) and non-finite voxels are treated.
+enum class separable_edge {
+    renormalize, // Such voxels are excluded and the remaining weights are renormalized. Voxels with insufficient
+                 // remaining weight become NaN.
+    propagate,   // Inaccessible voxels are NaN and, like non-finite voxels, propagate into the result.
+};
+
+// A 1D kernel. The weight weights[j] is applied to the voxel at (p + first_offset + j) when computing voxel p.
+struct separable_kernel_1d {
+    std::vector<float> weights;
+    int64_t first_offset = 0;
+};
+
+// A dense copy of a single channel of an ordered stack of equally-sized images. Rows are contiguous.
+struct dense_voxel_volume {
+    int64_t rows = 0;
+    int64_t columns = 0;
+    int64_t images = 0;
+    std::vector<float> voxels;
+
+    int64_t index(int64_t img, int64_t row, int64_t col) const {
+        return (img * this->rows + row) * this->columns + col;
+    }
+};
+
+using separable_img_refws_t = std::vector<std::reference_wrapper<planar_image<float,double>>>;
+
+// Orders the images along the orientation normal. An empty list is returned if the images do not form a rectilinear
+// grid of equally-sized images with one image per position, or if any image lacks pixel data.
+separable_img_refws_t Order_Images_For_Separable_Convolution(planar_image_collection<float,double> &imagecoll,
+                                                             const vec3<double> &orientation_normal);
+
+dense_voxel_volume Extract_Dense_Voxel_Volume(const separable_img_refws_t &imgs, int64_t channel);
+
+// Writes voxels back into the images. If the mask is non-empty, only voxels with a non-zero mask are written.
+void Insert_Dense_Voxel_Volume(const dense_voxel_volume &vol,
+                               const std::vector<uint8_t> &mask,
+                               separable_img_refws_t &imgs,
+                               int64_t channel);
+
+// Identifies voxels bounded by the contours, using the same criteria as the volumetric neighbourhood sampler (i.e.,
+// voxel centres within any contour).
+std::vector<uint8_t> Contour_Voxel_Mask(const separable_img_refws_t &imgs,
+                                        std::list<std::reference_wrapper<contour_collection<double>>> ccsl);
+
+// Convolves the volume along one axis. If the mask is non-empty, voxels with a zero mask are copied unaltered.
+dense_voxel_volume Separable_Convolve_Axis(const dense_voxel_volume &in,
+                                           separable_axis axis,
+                                           const separable_kernel_1d &kernel,
+                                           separable_edge edge,
+                                           const std::vector<uint8_t> &mask,
+                                           float min_weight = 1.0E-3f);
+
+// Attempts to factor a 3D kernel, ordered by row, then column, then image (i.e., the image number varies fastest),
+// into a product of three 1D kernels (row, column, image). Returns false if the kernel is not separable within the
+// given tolerance, which is relative to the largest-magnitude kernel element.
+bool Factor_Separable_Kernel(const std::vector<float> &k_values,
+                             int64_t k_rows,
+                             int64_t k_columns,
+                             int64_t k_imgs,
+                             std::array<std::vector<float>, 3> &factors,
+                             double rel_tol = 1.0E-5);
+
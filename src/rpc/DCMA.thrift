@@ -51,8 +51,13 @@ struct fv_surface_mesh_double_int64 { // NOTE: uint64_t not supported, so using
 // --------------------------------------------------------------------
 // Ygor classes -- YgorImages.h.
 // --------------------------------------------------------------------
+enum PayloadCompression {
+    NONE = 0,
+    ZLIB = 1,
+    ZSTD = 2,
+}
 struct planar_image_double_double {
-    1: required list<double> data;  // NOTE: float not supported, so using double here.
+    1: required list<double> data;  // NOTE: float not supported, so using double here. Empty if raw_data is set.
     2: required i64 rows;
     3: required i64 columns;
     4: required i64 channels;
@@ -64,6 +69,11 @@ struct planar_image_double_double {
     10: required vec3_double row_unit;
     11: required vec3_double col_unit;
     12: required metadata_t metadata;
+
+    // Pixel data packed as little-endian IEEE-754 binary32 values in the same order as 'data'. This halves the payload
+    // size and avoids per-element encoding. The payload may also be compressed.
+    13: optional binary raw_data;
+    14: optional PayloadCompression raw_data_compression;
 }
 struct planar_image_collection_double_double {
     1: required list<planar_image_double_double> images; // NOTE: for <float,double>, but float not available.
@@ -198,6 +208,17 @@ struct LoadFilesResponse {
     2: optional Drover drover;
 }
 
+
+struct ExecuteScriptQuery {
+    1: required string script;
+    2: optional Drover drover;        // Data to merge into the resident Drover before the script is executed.
+    3: required bool return_drover;   // Whether the resident Drover should be returned after the script is executed.
+}
+struct ExecuteScriptResponse {
+    1: required bool success;
+    2: optional Drover drover;
+}
+
 service Receiver {
     // Level 1 interface: high-level 'config-query' interface.
     //
@@ -215,6 +236,9 @@ service Receiver {
 
     // Level 3 interface: Drover operations.
     //
-    // ...
+    // Execute a script of operations on the server's resident Drover. The resident Drover persists between calls,
+    // so data only needs to be transferred when it is explicitly provided or requested.
+    ExecuteScriptResponse
+    ExecuteScript(1: ExecuteScriptQuery query);
 }
 
@@ -10,7 +10,7 @@
 #include "../Structs.h"
 
 #include <thrift/protocol/TBinaryProtocol.h>
-#include <thrift/server/TSimpleServer.h>
+#include <thrift/server/TThreadedServer.h>
 #include <thrift/transport/TServerSocket.h>
 #include <thrift/transport/TBufferTransports.h>
 
@@ -24,6 +24,8 @@ using namespace ::apache::thrift::server;
 
 using namespace ::dcma::rpc;
 
+// This is an example skeleton server, derived from the thrift-generated skeleton in gen-cpp/, that is useful for
+// testing the RPC interface in isolation. It is not part of DICOMautomaton; the full server is the RPCReceive operation.
 class ReceiverHandler : virtual public ReceiverIf {
   public:
     ReceiverHandler() {
@@ -70,6 +72,20 @@ class ReceiverHandler : virtual public ReceiverIf {
     void LoadFiles(LoadFilesResponse& _return, const std::vector<LoadFilesQuery> & server_filenames) {
         YLOGINFO("LoadFiles implementation goes here");
     }
+
+    // This example server does not execute scripts; the full implementation is provided by the RPCReceive operation.
+    // The provided data is unpacked and, if requested, returned so the wire format can be exercised.
+    void ExecuteScript(ExecuteScriptResponse& _return, const ExecuteScriptQuery& query) {
+        YLOGWARN("Script execution is not supported by the example server. Use the RPCReceive operation instead");
+        _return.success = false;
+
+        ::Drover a;
+        if(query.__isset.drover) Deserialize(query.drover, a);
+        if(query.return_drover){
+            Serialize(a, _return.drover);
+            _return.__isset.drover = true;
+        }
+    }
 };
 
 // Example of how to use this class:
@@ -80,11 +96,11 @@ class ReceiverHandler : virtual public ReceiverIf {
 //    auto handler = std::make_shared<ReceiverHandler>();
 //    auto processor = std::make_shared<ReceiverProcessor>(handler);
 //
-//    auto transport_server = std::make_shared<TServerSocket>( port );
+//    auto transport_server = std::make_shared<TServerSocket>( "localhost", port );
 //    auto transport_factory = std::make_shared<TBufferedTransportFactory>();
 //    auto protocol_factory = std::make_shared<TBinaryProtocolFactory>();
 //
-//    TSimpleServer server(processor, transport_server, transport_factory, protocol_factory);
+//    TThreadedServer server(processor, transport_server, transport_factory, protocol_factory);
 //    server.serve();
 //
 //    return 0;
@@ -17,11 +17,25 @@
 #include <vector>
 #include <variant>
 #include <any>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#ifdef DCMA_USE_ZSTD
+    #include <zstd.h>
+#endif
 
 #include "YgorMisc.h"
 #include "YgorLog.h"
 #include "YgorMath.h"
 #include "YgorImages.h"
+#include "YgorString.h"       //Needed for the _s string literal.
 
 #include "../Structs.h"
 #include "../Tables.h"
@@ -29,6 +43,7 @@
 #include "../Alignment_Rigid.h"
 #include "../Alignment_TPSRPM.h"
 #include "../Alignment_Field.h"
+#include "../Thread_Pool.h"
 
 #include "gen-cpp/DCMA_constants.h"
 #include "gen-cpp/DCMA_types.h"
@@ -127,15 +142,226 @@ void Deserialize( const dcma::rpc::contour_collection_double &in, contour_collec
 //void Serialize( const fv_surface_mesh<double,uint64_t> &in, dcma::rpc::fv_surface_mesh_double_int64 &out );
 //void Deserialize( const dcma::rpc::fv_surface_mesh_double_int64 &in, fv_surface_mesh<double,uint64_t> &out );
 //
-//// --------------------------------------------------------------------
-//// Ygor classes -- YgorImages.h.
-//// --------------------------------------------------------------------
-//void Serialize( const planar_image<float,double> &in, dcma::rpc::planar_image_double_double &out );
-//void Deserialize( const dcma::rpc::planar_image_double_double &in, planar_image<float,double> &out );
-//
-//void Serialize( const planar_image_collection<float,double> &in, dcma::rpc::planar_image_collection_double_double &out );
-//void Deserialize( const dcma::rpc::planar_image_collection_double_double &in, planar_image_collection<float,double> &out );
-//
+
+// --------------------------------------------------------------------
+// Ygor classes -- YgorImages.h.
+// --------------------------------------------------------------------
+static_assert(std::numeric_limits<float>::is_iec559 && (sizeof(float) == 4),
+              "Binary pixel payloads require IEEE-754 binary32 floats");
+
+void Validate_Payload_Compression( dcma::rpc::PayloadCompression::type c ){
+    if( (c != dcma::rpc::PayloadCompression::NONE)
+    &&  (c != dcma::rpc::PayloadCompression::ZLIB)
+    &&  (c != dcma::rpc::PayloadCompression::ZSTD) ){
+        throw std::invalid_argument("Payload compression method not understood");
+    }
+#ifndef DCMA_USE_ZSTD
+    if(c == dcma::rpc::PayloadCompression::ZSTD){
+        throw std::invalid_argument("zstd payload compression requested, but zstd support is not available");
+    }
+#endif
+    return;
+}
+
+static bool host_is_little_endian(){
+    const uint32_t x = 1;
+    unsigned char b = 0;
+    std::memcpy(&b, &x, 1);
+    return (b == 1);
+}
+
+// Packs pixels as little-endian binary32 values.
+static std::string pack_pixels(const std::vector<float> &in){
+    std::string out(in.size() * sizeof(float), '\0');
+    if(host_is_little_endian()){
+        if(!in.empty()) std::memcpy(out.data(), in.data(), out.size());
+    }else{
+        for(size_t i = 0; i < in.size(); ++i){
+            uint32_t u;
+            std::memcpy(&u, &(in[i]), sizeof(float));
+            for(size_t j = 0; j < 4; ++j) out[i * 4 + j] = static_cast<char>((u >> (8 * j)) & 0xFF);
+        }
+    }
+    return out;
+}
+
+static void unpack_pixels(const std::string &in, std::vector<float> &out){
+    out.resize(in.size() / sizeof(float));
+    if(host_is_little_endian()){
+        if(!out.empty()) std::memcpy(out.data(), in.data(), out.size() * sizeof(float));
+    }else{
+        for(size_t i = 0; i < out.size(); ++i){
+            uint32_t u = 0;
+            for(size_t j = 0; j < 4; ++j) u |= static_cast<uint32_t>(static_cast<unsigned char>(in[i * 4 + j])) << (8 * j);
+            std::memcpy(&(out[i]), &u, sizeof(float));
+        }
+    }
+    return;
+}
+
+static std::string compress_payload(const std::string &in, dcma::rpc::PayloadCompression::type c){
+    std::string out;
+    if(c == dcma::rpc::PayloadCompression::NONE){
+        out = in;
+
+    }else if(c == dcma::rpc::PayloadCompression::ZLIB){
+        boost::iostreams::filtering_ostream os;
+        os.push(boost::iostreams::zlib_compressor(boost::iostreams::zlib::best_speed));
+        os.push(boost::iostreams::back_inserter(out));
+        os.write(in.data(), static_cast<std::streamsize>(in.size()));
+        boost::iostreams::close(os);
+
+    }else if(c == dcma::rpc::PayloadCompression::ZSTD){
+#ifdef DCMA_USE_ZSTD
+        out.resize(ZSTD_compressBound(in.size()));
+        const auto n = ZSTD_compress(out.data(), out.size(), in.data(), in.size(), 3);
+        if(ZSTD_isError(n)){
+            throw std::runtime_error("Unable to compress payload: "_s + ZSTD_getErrorName(n));
+        }
+        out.resize(n);
+#else
+        throw std::runtime_error("Payload compression with zstd requested, but zstd support is not available");
+#endif
+    }else{
+        throw std::invalid_argument("Payload compression method not understood");
+    }
+    return out;
+}
+
+// Returns the size, in bytes, of a packed pixel payload, guarding against overflow from hostile dimensions.
+static size_t pixel_payload_size(int64_t rows, int64_t columns, int64_t channels){
+    if( (rows < 0) || (columns < 0) || (channels < 0) ){
+        throw std::invalid_argument("Image dimensions are invalid");
+    }
+    size_t out = sizeof(float);
+    for(const auto d : { rows, columns, channels }){
+        const auto u = static_cast<uint64_t>(d);
+        if( (u != 0) && ((std::numeric_limits<size_t>::max() / u) < out) ){
+            throw std::invalid_argument("Image dimensions are too large");
+        }
+        out *= static_cast<size_t>(u);
+    }
+    return out;
+}
+
+// Decompression never produces more than one byte beyond the expected size, so a malicious payload that inflates to
+// an enormous size is rejected without being fully decompressed.
+static std::string decompress_payload(const std::string &in, dcma::rpc::PayloadCompression::type c, size_t expected_size){
+    std::string out;
+    if(c == dcma::rpc::PayloadCompression::NONE){
+        out = in;
+
+    }else if(c == dcma::rpc::PayloadCompression::ZLIB){
+        if(expected_size == std::numeric_limits<size_t>::max()){
+            throw std::invalid_argument("Expected payload size is too large");
+        }
+        out.resize(expected_size + 1);
+        boost::iostreams::filtering_istream is;
+        is.push(boost::iostreams::zlib_decompressor());
+        is.push(boost::iostreams::array_source(in.data(), in.size()));
+        is.read(out.data(), static_cast<std::streamsize>(out.size()));
+        if(is.bad()){
+            throw std::runtime_error("Unable to decompress payload");
+        }
+        out.resize(static_cast<size_t>(is.gcount()));
+
+    }else if(c == dcma::rpc::PayloadCompression::ZSTD){
+#ifdef DCMA_USE_ZSTD
+        out.resize(expected_size);
+        const auto n = ZSTD_decompress(out.data(), out.size(), in.data(), in.size());
+        if(ZSTD_isError(n)){
+            throw std::runtime_error("Unable to decompress payload: "_s + ZSTD_getErrorName(n));
+        }
+        out.resize(n);
+#else
+        throw std::runtime_error("Payload is compressed with zstd, but zstd support is not available");
+#endif
+    }else{
+        throw std::invalid_argument("Payload compression method not understood");
+    }
+    if(out.size() != expected_size){
+        throw std::runtime_error("Pixel payload size does not match image dimensions");
+    }
+    return out;
+}
+
+void Serialize( const planar_image<float,double> &in, dcma::rpc::planar_image_double_double &out,
+                dcma::rpc::PayloadCompression::type c ){
+    // The (legacy) list of doubles is left empty in favour of the binary payload.
+    out.data.clear();
+    out.rows = in.rows;
+    out.columns = in.columns;
+    out.channels = in.channels;
+    out.pxl_dx = in.pxl_dx;
+    out.pxl_dy = in.pxl_dy;
+    out.pxl_dz = in.pxl_dz;
+    Serialize(in.anchor, out.anchor);
+    Serialize(in.offset, out.offset);
+    Serialize(in.row_unit, out.row_unit);
+    Serialize(in.col_unit, out.col_unit);
+    Serialize(in.metadata, out.metadata);
+
+    out.raw_data = compress_payload(pack_pixels(in.data), c);
+    out.__isset.raw_data = true;
+    out.__set_raw_data_compression(c);
+}
+void Deserialize( const dcma::rpc::planar_image_double_double &in, planar_image<float,double> &out ){
+    const auto N_bytes = pixel_payload_size(in.rows, in.columns, in.channels);
+    const auto N = N_bytes / sizeof(float);
+
+    if(in.__isset.raw_data){
+        const auto c = in.__isset.raw_data_compression ? in.raw_data_compression
+                                                       : dcma::rpc::PayloadCompression::NONE;
+        if(c == dcma::rpc::PayloadCompression::NONE){
+            if(in.raw_data.size() != N_bytes){
+                throw std::runtime_error("Pixel payload size does not match image dimensions");
+            }
+            unpack_pixels(in.raw_data, out.data);
+        }else{
+            unpack_pixels(decompress_payload(in.raw_data, c, N_bytes), out.data);
+        }
+    }else{
+        if(in.data.size() != N){
+            throw std::runtime_error("Pixel list size does not match image dimensions");
+        }
+        out.data.assign(std::begin(in.data), std::end(in.data));
+    }
+    out.rows = in.rows;
+    out.columns = in.columns;
+    out.channels = in.channels;
+    out.pxl_dx = in.pxl_dx;
+    out.pxl_dy = in.pxl_dy;
+    out.pxl_dz = in.pxl_dz;
+    Deserialize(in.anchor, out.anchor);
+    Deserialize(in.offset, out.offset);
+    Deserialize(in.row_unit, out.row_unit);
+    Deserialize(in.col_unit, out.col_unit);
+    Deserialize(in.metadata, out.metadata);
+}
+
+// Images are packed (and possibly compressed) independently, so they are processed concurrently.
+void Serialize( const planar_image_collection<float,double> &in, dcma::rpc::planar_image_collection_double_double &out,
+                dcma::rpc::PayloadCompression::type c ){
+    std::vector<const planar_image<float,double>*> imgs;
+    for(const auto &img : in.images) imgs.push_back(&img);
+
+    out.images.clear();
+    out.images.resize(imgs.size());
+    parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(imgs.size()), [&](int64_t i){
+        Serialize(*(imgs[i]), out.images[i], c);
+    });
+}
+void Deserialize( const dcma::rpc::planar_image_collection_double_double &in, planar_image_collection<float,double> &out ){
+    std::vector<planar_image<float,double>*> imgs;
+    for(size_t i = 0; i < in.images.size(); ++i){
+        out.images.emplace_back();
+        imgs.push_back(&(out.images.back()));
+    }
+    parallel_for(static_cast<int64_t>(0), static_cast<int64_t>(imgs.size()), [&](int64_t i){
+        Deserialize(in.images[i], *(imgs[i]));
+    });
+}
+
 //// --------------------------------------------------------------------
 //// DICOMautomaton classes -- Tables.h.
 //// --------------------------------------------------------------------
@@ -161,9 +387,16 @@ void Deserialize( const dcma::rpc::Contour_Data &in, Contour_Data &out ){
     }
 }
 
-//void Serialize( const Image_Array &in, dcma::rpc::Image_Array &out );
-//void Deserialize( const dcma::rpc::Image_Array &in, Image_Array &out );
-//
+void Serialize( const Image_Array &in, dcma::rpc::Image_Array &out,
+                dcma::rpc::PayloadCompression::type c ){
+    Serialize(in.imagecoll, out.imagecoll, c);
+    out.filename = in.filename;
+}
+void Deserialize( const dcma::rpc::Image_Array &in, Image_Array &out ){
+    Deserialize(in.imagecoll, out.imagecoll);
+    out.filename = in.filename;
+}
+
 //void Serialize( const Point_Cloud &in, dcma::rpc::Point_Cloud &out );
 //void Deserialize( const dcma::rpc::Point_Cloud &in, Point_Cloud &out );
 //
@@ -188,13 +421,23 @@ void Deserialize( const dcma::rpc::Contour_Data &in, Contour_Data &out ){
 //void Serialize( const Sparse_Table &in, dcma::rpc::Sparse_Table &out );
 //void Deserialize( const dcma::rpc::Sparse_Table &in, Sparse_Table &out );
 
-void Serialize( const Drover &in, dcma::rpc::Drover &out ){
+void Serialize( const Drover &in, dcma::rpc::Drover &out,
+                dcma::rpc::PayloadCompression::type c ){
     // For a pointer contour_data member.
     if(in.Has_Contour_Data() && !in.contour_data->ccs.empty()){
         out.__set_contour_data( {} ); // Field is optional, so ensure it is marked as set.
         out.contour_data.emplace_back();
         Serialize(*(in.contour_data), out.contour_data.back());
     }
+
+    if(in.Has_Image_Data()){
+        out.__set_image_data( {} );
+        for(const auto &ia_ptr : in.image_data){
+            if(ia_ptr == nullptr) continue;
+            out.image_data.emplace_back();
+            Serialize(*ia_ptr, out.image_data.back(), c);
+        }
+    }
     
     // For a list-of-pointers contour_data member.
     //if(in.Has_Contour_Data() && !in.contour_data->ccs.empty()){
@@ -243,6 +486,14 @@ void Deserialize( const dcma::rpc::Drover &in, Drover &out ){
             out.contour_data->ccs.splice( std::end(out.contour_data->ccs), shtl.ccs);
         }
     }
+
+    if(in.__isset.image_data){
+        for(const auto &rpc_ia : in.image_data){
+            auto ia = std::make_shared<Image_Array>();
+            Deserialize(rpc_ia, *ia);
+            out.image_data.emplace_back(ia);
+        }
+    }
     //if(in.Has_Contour_Data() && !in.contour_data->ccs.empty()){
     //    out.__set_contour_data( {} ); // Field is optional, so ensure it is marked as set.
     //    out.contour_data.emplace_back();
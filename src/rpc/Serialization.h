@@ -70,10 +70,19 @@ void Deserialize( const dcma::rpc::fv_surface_mesh_double_int64 &in, fv_surface_
 // --------------------------------------------------------------------
 // Ygor classes -- YgorImages.h.
 // --------------------------------------------------------------------
-void Serialize( const planar_image<float,double> &in, dcma::rpc::planar_image_double_double &out );
+// Image pixels are serialized as a packed binary payload rather than a list of doubles. The payload can optionally be
+// compressed, which is worthwhile for slow networks. The compression method is passed through the serialization of
+// any object containing images. Deserialization honours whichever method the payload was compressed with.
+//
+// Throws if the compression method is not available in this build.
+void Validate_Payload_Compression( dcma::rpc::PayloadCompression::type c );
+
+void Serialize( const planar_image<float,double> &in, dcma::rpc::planar_image_double_double &out,
+                dcma::rpc::PayloadCompression::type c = dcma::rpc::PayloadCompression::NONE );
 void Deserialize( const dcma::rpc::planar_image_double_double &in, planar_image<float,double> &out );
 
-void Serialize( const planar_image_collection<float,double> &in, dcma::rpc::planar_image_collection_double_double &out );
+void Serialize( const planar_image_collection<float,double> &in, dcma::rpc::planar_image_collection_double_double &out,
+                dcma::rpc::PayloadCompression::type c = dcma::rpc::PayloadCompression::NONE );
 void Deserialize( const dcma::rpc::planar_image_collection_double_double &in, planar_image_collection<float,double> &out );
 
 // --------------------------------------------------------------------
@@ -91,7 +100,8 @@ void Deserialize( const dcma::rpc::table2 &in, tables::table2 &out );
 void Serialize( const Contour_Data &in, dcma::rpc::Contour_Data &out );
 void Deserialize( const dcma::rpc::Contour_Data &in, Contour_Data &out );
 
-void Serialize( const Image_Array &in, dcma::rpc::Image_Array &out );
+void Serialize( const Image_Array &in, dcma::rpc::Image_Array &out,
+                dcma::rpc::PayloadCompression::type c = dcma::rpc::PayloadCompression::NONE );
 void Deserialize( const dcma::rpc::Image_Array &in, Image_Array &out );
 
 void Serialize( const Point_Cloud &in, dcma::rpc::Point_Cloud &out );
@@ -118,7 +128,8 @@ void Deserialize( const dcma::rpc::Transform3 &in, Transform3 &out );
 void Serialize( const Sparse_Table &in, dcma::rpc::Sparse_Table &out );
 void Deserialize( const dcma::rpc::Sparse_Table &in, Sparse_Table &out );
 
-void Serialize( const Drover &in, dcma::rpc::Drover &out ); 
+void Serialize( const Drover &in, dcma::rpc::Drover &out,
+                dcma::rpc::PayloadCompression::type c = dcma::rpc::PayloadCompression::NONE );
 void Deserialize( const dcma::rpc::Drover &in, Drover &out ); 
 
 // --------------------------------------------------------------------
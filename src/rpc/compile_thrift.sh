@@ -8,19 +8,14 @@ sleep 3
 
 rm -rf gen-*/
 
+# Only the C++ bindings are maintained in-tree. Bindings for other languages (e.g., '--gen py') can be generated from
+# DCMA.thrift as needed, but must be regenerated whenever the IDL changes to remain compatible with the wire format.
 printf 'Compiling IDL now...\n'
 thrift \
   -strict \
   -recurse \
   -verbose \
   --gen cpp \
-  --gen py \
-  --gen lua \
-  --gen json \
-  --gen gv \
-  --gen html \
-  --gen markdown \
-  --gen xml \
   DCMA.thrift
 
 # Rename file extensions for consistency.
@@ -13,6 +13,37 @@
 
 namespace dcma { namespace rpc {
 
+int _kPayloadCompressionValues[] = {
+  PayloadCompression::NONE,
+  PayloadCompression::ZLIB,
+  PayloadCompression::ZSTD
+};
+const char* _kPayloadCompressionNames[] = {
+  "NONE",
+  "ZLIB",
+  "ZSTD"
+};
+const std::map<int, const char*> _PayloadCompression_VALUES_TO_NAMES(::apache::thrift::TEnumIterator(3, _kPayloadCompressionValues, _kPayloadCompressionNames), ::apache::thrift::TEnumIterator(-1, nullptr, nullptr));
+
+std::ostream& operator<<(std::ostream& out, const PayloadCompression::type& val) {
+  std::map<int, const char*>::const_iterator it = _PayloadCompression_VALUES_TO_NAMES.find(val);
+  if (it != _PayloadCompression_VALUES_TO_NAMES.end()) {
+    out << it->second;
+  } else {
+    out << static_cast<int>(val);
+  }
+  return out;
+}
+
+std::string to_string(const PayloadCompression::type& val) {
+  std::map<int, const char*>::const_iterator it = _PayloadCompression_VALUES_TO_NAMES.find(val);
+  if (it != _PayloadCompression_VALUES_TO_NAMES.end()) {
+    return std::string(it->second);
+  } else {
+    return std::to_string(static_cast<int>(val));
+  }
+}
+
 
 vec3_double::~vec3_double() noexcept {
 }
@@ -1456,6 +1487,16 @@ void planar_image_double_double::__set_col_unit(const vec3_double& val) {
 void planar_image_double_double::__set_metadata(const metadata_t& val) {
   this->metadata = val;
 }
+
+void planar_image_double_double::__set_raw_data(const std::string& val) {
+  this->raw_data = val;
+__isset.raw_data = true;
+}
+
+void planar_image_double_double::__set_raw_data_compression(const PayloadCompression::type val) {
+  this->raw_data_compression = val;
+__isset.raw_data_compression = true;
+}
 std::ostream& operator<<(std::ostream& out, const planar_image_double_double& obj)
 {
   obj.printTo(out);
@@ -1619,6 +1660,24 @@ uint32_t planar_image_double_double::read(::apache::thrift::protocol::TProtocol*
           xfer += iprot->skip(ftype);
         }
         break;
+      case 13:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->raw_data);
+          this->__isset.raw_data = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 14:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          int32_t ecast290;
+          xfer += iprot->readI32(ecast290);
+          this->raw_data_compression = static_cast<PayloadCompression::type>(ecast290);
+          this->__isset.raw_data_compression = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
       default:
         xfer += iprot->skip(ftype);
         break;
@@ -1725,6 +1784,16 @@ uint32_t planar_image_double_double::write(::apache::thrift::protocol::TProtocol
   }
   xfer += oprot->writeFieldEnd();
 
+  if (this->__isset.raw_data) {
+    xfer += oprot->writeFieldBegin("raw_data", ::apache::thrift::protocol::T_STRING, 13);
+    xfer += oprot->writeBinary(this->raw_data);
+    xfer += oprot->writeFieldEnd();
+  }
+  if (this->__isset.raw_data_compression) {
+    xfer += oprot->writeFieldBegin("raw_data_compression", ::apache::thrift::protocol::T_I32, 14);
+    xfer += oprot->writeI32(static_cast<int32_t>(this->raw_data_compression));
+    xfer += oprot->writeFieldEnd();
+  }
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
@@ -1744,6 +1813,9 @@ void swap(planar_image_double_double &a, planar_image_double_double &b) {
   swap(a.row_unit, b.row_unit);
   swap(a.col_unit, b.col_unit);
   swap(a.metadata, b.metadata);
+  swap(a.raw_data, b.raw_data);
+  swap(a.raw_data_compression, b.raw_data_compression);
+  swap(a.__isset, b.__isset);
 }
 
 planar_image_double_double::planar_image_double_double(const planar_image_double_double& other138) {
@@ -1759,6 +1831,9 @@ planar_image_double_double::planar_image_double_double(const planar_image_double
   row_unit = other138.row_unit;
   col_unit = other138.col_unit;
   metadata = other138.metadata;
+  raw_data = other138.raw_data;
+  raw_data_compression = other138.raw_data_compression;
+  __isset = other138.__isset;
 }
 planar_image_double_double& planar_image_double_double::operator=(const planar_image_double_double& other139) {
   data = other139.data;
@@ -1773,6 +1848,9 @@ planar_image_double_double& planar_image_double_double::operator=(const planar_i
   row_unit = other139.row_unit;
   col_unit = other139.col_unit;
   metadata = other139.metadata;
+  raw_data = other139.raw_data;
+  raw_data_compression = other139.raw_data_compression;
+  __isset = other139.__isset;
   return *this;
 }
 void planar_image_double_double::printTo(std::ostream& out) const {
@@ -1790,6 +1868,8 @@ void planar_image_double_double::printTo(std::ostream& out) const {
   out << ", " << "row_unit=" << to_string(row_unit);
   out << ", " << "col_unit=" << to_string(col_unit);
   out << ", " << "metadata=" << to_string(metadata);
+  out << ", " << "raw_data="; (__isset.raw_data ? (out << to_string(raw_data)) : (out << "<null>"));
+  out << ", " << "raw_data_compression="; (__isset.raw_data_compression ? (out << to_string(raw_data_compression)) : (out << "<null>"));
   out << ")";
 }
 
@@ -4504,4 +4584,261 @@ void LoadFilesResponse::printTo(std::ostream& out) const {
   out << ")";
 }
 
+
+ExecuteScriptQuery::~ExecuteScriptQuery() noexcept {
+}
+
+
+void ExecuteScriptQuery::__set_script(const std::string& val) {
+  this->script = val;
+}
+
+void ExecuteScriptQuery::__set_drover(const Drover& val) {
+  this->drover = val;
+__isset.drover = true;
+}
+
+void ExecuteScriptQuery::__set_return_drover(const bool val) {
+  this->return_drover = val;
+}
+std::ostream& operator<<(std::ostream& out, const ExecuteScriptQuery& obj)
+{
+  obj.printTo(out);
+  return out;
+}
+
+
+uint32_t ExecuteScriptQuery::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+  bool isset_script = false;
+  bool isset_return_drover = false;
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readString(this->script);
+          isset_script = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->drover.read(iprot);
+          this->__isset.drover = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_BOOL) {
+          xfer += iprot->readBool(this->return_drover);
+          isset_return_drover = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  if (!isset_script)
+    throw TProtocolException(TProtocolException::INVALID_DATA);
+  if (!isset_return_drover)
+    throw TProtocolException(TProtocolException::INVALID_DATA);
+  return xfer;
+}
+
+uint32_t ExecuteScriptQuery::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("ExecuteScriptQuery");
+
+  xfer += oprot->writeFieldBegin("script", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeString(this->script);
+  xfer += oprot->writeFieldEnd();
+
+  if (this->__isset.drover) {
+    xfer += oprot->writeFieldBegin("drover", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->drover.write(oprot);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldBegin("return_drover", ::apache::thrift::protocol::T_BOOL, 3);
+  xfer += oprot->writeBool(this->return_drover);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+void swap(ExecuteScriptQuery &a, ExecuteScriptQuery &b) {
+  using ::std::swap;
+  swap(a.script, b.script);
+  swap(a.drover, b.drover);
+  swap(a.return_drover, b.return_drover);
+  swap(a.__isset, b.__isset);
+}
+
+ExecuteScriptQuery::ExecuteScriptQuery(const ExecuteScriptQuery& other291) {
+  script = other291.script;
+  drover = other291.drover;
+  return_drover = other291.return_drover;
+  __isset = other291.__isset;
+}
+ExecuteScriptQuery& ExecuteScriptQuery::operator=(const ExecuteScriptQuery& other292) {
+  script = other292.script;
+  drover = other292.drover;
+  return_drover = other292.return_drover;
+  __isset = other292.__isset;
+  return *this;
+}
+void ExecuteScriptQuery::printTo(std::ostream& out) const {
+  using ::apache::thrift::to_string;
+  out << "ExecuteScriptQuery(";
+  out << "script=" << to_string(script);
+  out << ", " << "drover="; (__isset.drover ? (out << to_string(drover)) : (out << "<null>"));
+  out << ", " << "return_drover=" << to_string(return_drover);
+  out << ")";
+}
+
+
+ExecuteScriptResponse::~ExecuteScriptResponse() noexcept {
+}
+
+
+void ExecuteScriptResponse::__set_success(const bool val) {
+  this->success = val;
+}
+
+void ExecuteScriptResponse::__set_drover(const Drover& val) {
+  this->drover = val;
+__isset.drover = true;
+}
+std::ostream& operator<<(std::ostream& out, const ExecuteScriptResponse& obj)
+{
+  obj.printTo(out);
+  return out;
+}
+
+
+uint32_t ExecuteScriptResponse::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+  bool isset_success = false;
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_BOOL) {
+          xfer += iprot->readBool(this->success);
+          isset_success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->drover.read(iprot);
+          this->__isset.drover = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  if (!isset_success)
+    throw TProtocolException(TProtocolException::INVALID_DATA);
+  return xfer;
+}
+
+uint32_t ExecuteScriptResponse::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("ExecuteScriptResponse");
+
+  xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_BOOL, 1);
+  xfer += oprot->writeBool(this->success);
+  xfer += oprot->writeFieldEnd();
+
+  if (this->__isset.drover) {
+    xfer += oprot->writeFieldBegin("drover", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->drover.write(oprot);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+void swap(ExecuteScriptResponse &a, ExecuteScriptResponse &b) {
+  using ::std::swap;
+  swap(a.success, b.success);
+  swap(a.drover, b.drover);
+  swap(a.__isset, b.__isset);
+}
+
+ExecuteScriptResponse::ExecuteScriptResponse(const ExecuteScriptResponse& other293) {
+  success = other293.success;
+  drover = other293.drover;
+  __isset = other293.__isset;
+}
+ExecuteScriptResponse& ExecuteScriptResponse::operator=(const ExecuteScriptResponse& other294) {
+  success = other294.success;
+  drover = other294.drover;
+  __isset = other294.__isset;
+  return *this;
+}
+void ExecuteScriptResponse::printTo(std::ostream& out) const {
+  using ::apache::thrift::to_string;
+  out << "ExecuteScriptResponse(";
+  out << "success=" << to_string(success);
+  out << ", " << "drover="; (__isset.drover ? (out << to_string(drover)) : (out << "<null>"));
+  out << ")";
+}
+
 }} // namespace
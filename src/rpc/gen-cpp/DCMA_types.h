@@ -21,6 +21,20 @@
 
 namespace dcma { namespace rpc {
 
+struct PayloadCompression {
+  enum type {
+    NONE = 0,
+    ZLIB = 1,
+    ZSTD = 2
+  };
+};
+
+extern const std::map<int, const char*> _PayloadCompression_VALUES_TO_NAMES;
+
+std::ostream& operator<<(std::ostream& out, const PayloadCompression::type& val);
+
+std::string to_string(const PayloadCompression::type& val);
+
 typedef std::map<std::string, std::string>  metadata_t;
 
 class vec3_double;
@@ -75,6 +89,10 @@ class LoadFilesQuery;
 
 class LoadFilesResponse;
 
+class ExecuteScriptQuery;
+
+class ExecuteScriptResponse;
+
 
 class vec3_double : public virtual ::apache::thrift::TBase {
  public:
@@ -421,6 +439,11 @@ void swap(fv_surface_mesh_double_int64 &a, fv_surface_mesh_double_int64 &b);
 
 std::ostream& operator<<(std::ostream& out, const fv_surface_mesh_double_int64& obj);
 
+typedef struct _planar_image_double_double__isset {
+  _planar_image_double_double__isset() : raw_data(false), raw_data_compression(false) {}
+  bool raw_data :1;
+  bool raw_data_compression :1;
+} _planar_image_double_double__isset;
 
 class planar_image_double_double : public virtual ::apache::thrift::TBase {
  public:
@@ -433,7 +456,9 @@ class planar_image_double_double : public virtual ::apache::thrift::TBase {
                                channels(0),
                                pxl_dx(0),
                                pxl_dy(0),
-                               pxl_dz(0) {
+                               pxl_dz(0),
+                               raw_data(),
+                               raw_data_compression(static_cast<PayloadCompression::type>(0)) {
   }
 
   virtual ~planar_image_double_double() noexcept;
@@ -449,6 +474,14 @@ class planar_image_double_double : public virtual ::apache::thrift::TBase {
   vec3_double row_unit;
   vec3_double col_unit;
   metadata_t metadata;
+  std::string raw_data;
+  /**
+   * 
+   * @see PayloadCompression
+   */
+  PayloadCompression::type raw_data_compression;
+
+  _planar_image_double_double__isset __isset;
 
   void __set_data(const std::vector<double> & val);
 
@@ -474,6 +507,10 @@ class planar_image_double_double : public virtual ::apache::thrift::TBase {
 
   void __set_metadata(const metadata_t& val);
 
+  void __set_raw_data(const std::string& val);
+
+  void __set_raw_data_compression(const PayloadCompression::type val);
+
   bool operator == (const planar_image_double_double & rhs) const
   {
     if (!(data == rhs.data))
@@ -500,6 +537,14 @@ class planar_image_double_double : public virtual ::apache::thrift::TBase {
       return false;
     if (!(metadata == rhs.metadata))
       return false;
+    if (__isset.raw_data != rhs.__isset.raw_data)
+      return false;
+    else if (__isset.raw_data && !(raw_data == rhs.raw_data))
+      return false;
+    if (__isset.raw_data_compression != rhs.__isset.raw_data_compression)
+      return false;
+    else if (__isset.raw_data_compression && !(raw_data_compression == rhs.raw_data_compression))
+      return false;
     return true;
   }
   bool operator != (const planar_image_double_double &rhs) const {
@@ -1376,6 +1421,112 @@ void swap(LoadFilesResponse &a, LoadFilesResponse &b);
 
 std::ostream& operator<<(std::ostream& out, const LoadFilesResponse& obj);
 
+typedef struct _ExecuteScriptQuery__isset {
+  _ExecuteScriptQuery__isset() : drover(false) {}
+  bool drover :1;
+} _ExecuteScriptQuery__isset;
+
+class ExecuteScriptQuery : public virtual ::apache::thrift::TBase {
+ public:
+
+  ExecuteScriptQuery(const ExecuteScriptQuery&);
+  ExecuteScriptQuery& operator=(const ExecuteScriptQuery&);
+  ExecuteScriptQuery() noexcept
+                     : script(),
+                       return_drover(0) {
+  }
+
+  virtual ~ExecuteScriptQuery() noexcept;
+  std::string script;
+  Drover drover;
+  bool return_drover;
+
+  _ExecuteScriptQuery__isset __isset;
+
+  void __set_script(const std::string& val);
+
+  void __set_drover(const Drover& val);
+
+  void __set_return_drover(const bool val);
+
+  bool operator == (const ExecuteScriptQuery & rhs) const
+  {
+    if (!(script == rhs.script))
+      return false;
+    if (__isset.drover != rhs.__isset.drover)
+      return false;
+    else if (__isset.drover && !(drover == rhs.drover))
+      return false;
+    if (!(return_drover == rhs.return_drover))
+      return false;
+    return true;
+  }
+  bool operator != (const ExecuteScriptQuery &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const ExecuteScriptQuery & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot) override;
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const override;
+
+  virtual void printTo(std::ostream& out) const;
+};
+
+void swap(ExecuteScriptQuery &a, ExecuteScriptQuery &b);
+
+std::ostream& operator<<(std::ostream& out, const ExecuteScriptQuery& obj);
+
+typedef struct _ExecuteScriptResponse__isset {
+  _ExecuteScriptResponse__isset() : drover(false) {}
+  bool drover :1;
+} _ExecuteScriptResponse__isset;
+
+class ExecuteScriptResponse : public virtual ::apache::thrift::TBase {
+ public:
+
+  ExecuteScriptResponse(const ExecuteScriptResponse&);
+  ExecuteScriptResponse& operator=(const ExecuteScriptResponse&);
+  ExecuteScriptResponse() noexcept
+                        : success(0) {
+  }
+
+  virtual ~ExecuteScriptResponse() noexcept;
+  bool success;
+  Drover drover;
+
+  _ExecuteScriptResponse__isset __isset;
+
+  void __set_success(const bool val);
+
+  void __set_drover(const Drover& val);
+
+  bool operator == (const ExecuteScriptResponse & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    if (__isset.drover != rhs.__isset.drover)
+      return false;
+    else if (__isset.drover && !(drover == rhs.drover))
+      return false;
+    return true;
+  }
+  bool operator != (const ExecuteScriptResponse &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const ExecuteScriptResponse & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot) override;
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const override;
+
+  virtual void printTo(std::ostream& out) const;
+};
+
+void swap(ExecuteScriptResponse &a, ExecuteScriptResponse &b);
+
+std::ostream& operator<<(std::ostream& out, const ExecuteScriptResponse& obj);
+
 }} // namespace
 
 #endif
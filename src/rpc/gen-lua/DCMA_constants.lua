@@ -1,9 +0,0 @@
---
--- Autogenerated by Thrift
---
--- DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
--- @generated
---
-
-
-require 'Thrift'
\ No newline at end of file
@@ -1 +0,0 @@
-__all__ = ['ttypes', 'constants', 'Receiver']
@@ -0,0 +1,138 @@
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "YgorMath.h"
+
+#include "doctest/doctest.h"
+
+#include "KineticModel_1Compartment2Input_5Param_LinearInterp_Common.h"
+#include "KineticModel_1Compartment2Input_5Param_LinearInterp_Batched.h"
+
+
+TEST_CASE( "batched 5-parameter linear interpolation fitting" ){
+    // Synthetic input time courses with a sharp bolus followed by a slow washout, including virtual samples before
+    // t = 0 like the liver perfusion operation adds.
+    auto cAIF = std::make_shared<samples_1D<double>>();
+    auto cVIF = std::make_shared<samples_1D<double>>();
+    for(double t = -25.0; t <= 200.0; t += 3.7){
+        const double a = (t < 5.0)  ? 0.0 : 300.0 * (t - 5.0) * std::exp(-(t - 5.0) / 8.0) / 8.0
+                                           + 40.0 * (1.0 - std::exp(-(t - 5.0) / 30.0));
+        const double v = (t < 10.0) ? 0.0 : 150.0 * (t - 10.0) * std::exp(-(t - 10.0) / 15.0) / 15.0
+                                           + 60.0 * (1.0 - std::exp(-(t - 10.0) / 40.0));
+        cAIF->push_back(t, 0.0, a, 0.0);
+        cVIF->push_back(t, 0.0, v, 0.0);
+    }
+
+    std::vector<double> times;
+    for(double t = 0.0; t <= 180.0; t += 4.5) times.push_back(t);
+
+    // Generate noise-free voxel time courses from the per-voxel model.
+    const int64_t N_voxels = 200;
+    std::mt19937 re(1317);
+    std::uniform_real_distribution<double> rd(0.0, 1.0);
+
+    KineticModel_1Compartment2Input_5Param_LinearInterp_Batch batch;
+    batch.cAIF = cAIF;
+    batch.cVIF = cVIF;
+    batch.times = times;
+
+    // Tight tolerances so that fits which find the global minimum settle on it.
+    batch.paramtol_rel = 1.0E-8;
+    batch.gtol_rel = 1.0E-8;
+
+    std::vector<std::shared_ptr<samples_1D<double>>> cROIs;
+    std::vector<KineticModel_1Compartment2Input_5Param_LinearInterp_Parameters> truths;
+    std::vector<double> obs_sq_sums;
+    for(int64_t v = 0; v < N_voxels; ++v){
+        KineticModel_1Compartment2Input_5Param_LinearInterp_Parameters state;
+        state.cAIF = cAIF;
+        state.cVIF = cVIF;
+        state.k1A  = 0.02 + 0.06 * rd(re);
+        state.tauA = 0.5 + 3.0 * rd(re);
+        state.k1V  = 0.03 + 0.08 * rd(re);
+        state.tauV = 0.5 + 3.0 * rd(re);
+        state.k2   = 0.02 + 0.05 * rd(re);
+
+        auto cROI = std::make_shared<samples_1D<double>>();
+        std::vector<double> obs;
+        KineticModel_1Compartment2Input_5Param_LinearInterp_Results res;
+        for(const auto &t : times){
+            Evaluate_Model(state, t, res);
+            cROI->push_back(t, 0.0, res.I, 0.0);
+            obs.push_back(res.I);
+        }
+        cROIs.push_back(cROI);
+        truths.push_back(state);
+        double obs_sq_sum = 0.0;
+        for(const auto &o : obs) obs_sq_sum += o * o;
+        obs_sq_sums.push_back(obs_sq_sum);
+
+        // Warm-start every voxel from the first voxel in its group of four.
+        batch.add_voxel(obs, ((v % 4) == 0) ? -1 : (v - (v % 4)));
+    }
+
+    const auto N_success = Optimize_LevenbergMarquardt_5Param_Batched(batch);
+
+    // Batched fits should be reported consistently.
+    {
+        REQUIRE( batch.size() == N_voxels );
+        REQUIRE( static_cast<int64_t>(batch.FittingSuccess.size()) == N_voxels );
+        REQUIRE( 0 < N_success );
+        for(int64_t v = 0; v < N_voxels; ++v){
+            if(batch.FittingSuccess[v] == 0){
+                REQUIRE( std::isnan(batch.k1A[v]) );
+                continue;
+            }
+
+            // The reported RSS should agree with the per-voxel model evaluated at the fitted parameters.
+            KineticModel_1Compartment2Input_5Param_LinearInterp_Parameters state;
+            state.cAIF = cAIF;
+            state.cVIF = cVIF;
+            state.k1A  = batch.k1A[v];
+            state.tauA = batch.tauA[v];
+            state.k1V  = batch.k1V[v];
+            state.tauV = batch.tauV[v];
+            state.k2   = batch.k2[v];
+            double RSS = 0.0;
+            KineticModel_1Compartment2Input_5Param_LinearInterp_Results res;
+            for(const auto &P : cROIs[v]->samples){
+                Evaluate_Model(state, P[0], res);
+                RSS += std::pow(res.I - P[2], 2.0);
+            }
+            REQUIRE( RSS == doctest::Approx(batch.RSS[v]).epsilon(1.0E-6).scale(1.0) );
+        }
+    }
+
+    // The observations are noise-free, so fits that reach the global minimum (RSS ~ 0) should recover the true rate
+    // constants. The model has local minima (especially in tauA and tauV), so fits that settle elsewhere are skipped.
+    {
+        int64_t N_recovered = 0;
+        for(int64_t v = 0; v < N_voxels; ++v){
+            if(batch.FittingSuccess[v] == 0) continue;
+            if(1.0E-10 * obs_sq_sums[v] < batch.RSS[v]) continue;
+            ++N_recovered;
+
+            REQUIRE( batch.k1A[v] == doctest::Approx(truths[v].k1A).epsilon(1.0E-3) );
+            REQUIRE( batch.k1V[v] == doctest::Approx(truths[v].k1V).epsilon(1.0E-3) );
+            REQUIRE( batch.k2[v]  == doctest::Approx(truths[v].k2).epsilon(1.0E-3) );
+        }
+        REQUIRE( 0 < N_recovered );
+    }
+
+    // Invalid warm-start seeds should be rejected.
+    {
+        auto bad = batch;
+        bad.seeds[0] = 1;
+        bad.seeds[1] = 0;
+        REQUIRE_THROWS( Optimize_LevenbergMarquardt_5Param_Batched(bad) );
+
+        bad.seeds[0] = N_voxels;
+        REQUIRE_THROWS( Optimize_LevenbergMarquardt_5Param_Batched(bad) );
+    }
+}
+
@@ -25,13 +25,33 @@ if [ ! -f doctest/doctest.h ] ; then
     wget -q 'https://raw.githubusercontent.com/onqtam/doctest/master/doctest/doctest.h' -O doctest/doctest.h
 fi
 
+EXTRA_SOURCES=()
+EXTRA_FLAGS=()
+
+# The RPC serialization tests require Apache Thrift. Payload compression with zstd is tested when zstd is available.
+if pkg-config --exists thrift 2>/dev/null ; then
+    EXTRA_SOURCES+=( {"rpc/","${REPOROOT}/src/rpc/"}Serialization.cc )
+    EXTRA_SOURCES+=( "${REPOROOT}/src/rpc/gen-cpp/"{DCMA_constants,DCMA_types,Receiver}.cc )
+    EXTRA_SOURCES+=( "${REPOROOT}/src/"{Structs,Alignment_CPD,Alignment_Field,Alignment_Rigid,Tables,Metadata,Dose_Meld,Regex_Selectors}.cc )
+    EXTRA_FLAGS+=( -DDCMA_USE_THRIFT $(pkg-config --cflags --libs thrift) -lboost_iostreams -lz )
+    if pkg-config --exists libzstd 2>/dev/null ; then
+        EXTRA_FLAGS+=( -DDCMA_USE_ZSTD=1 $(pkg-config --cflags --libs libzstd) )
+    fi
+else
+    printf "Apache Thrift not found. Skipping RPC serialization tests.\n" 1>&2
+fi
+
 g++ -std=c++17 -Wall -I. -I"${REPOROOT}/src" \
   Main.cc \
   {,"${REPOROOT}/src/"}Alignment_TPSRPM.cc \
+  {,"${REPOROOT}/src/"}KineticModel_1Compartment2Input_5Param_LinearInterp_Batched.cc \
+  "${REPOROOT}/src/"KineticModel_1Compartment2Input_5Param_LinearInterp_Common.cc \
+  ${EXTRA_SOURCES[@]+"${EXTRA_SOURCES[@]}"} \
   -o run_tests \
   -pthread \
   -lboost_system \
-  -lygor
+  -lygor \
+  ${EXTRA_FLAGS[@]+"${EXTRA_FLAGS[@]}"}
 
 ./run_tests #--success
 
@@ -0,0 +1,137 @@
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "YgorMath.h"
+#include "YgorImages.h"
+
+#include "doctest/doctest.h"
+
+#include "Structs.h"
+#include "rpc/Serialization.h"
+
+
+static Drover make_test_drover(){
+    Drover d;
+
+    d.Ensure_Contour_Data_Allocated();
+    d.contour_data->ccs.emplace_back();
+    d.contour_data->ccs.back().contours.emplace_back();
+    d.contour_data->ccs.back().contours.back().closed = true;
+    d.contour_data->ccs.back().contours.back().points.emplace_back( vec3<double>(0.0, 0.0, 0.0) );
+    d.contour_data->ccs.back().contours.back().points.emplace_back( vec3<double>(1.0, 0.0, 0.0) );
+    d.contour_data->ccs.back().contours.back().points.emplace_back( vec3<double>(0.0, 1.0, 0.0) );
+    d.contour_data->ccs.back().contours.back().metadata["ROIName"] = "test";
+
+    d.image_data.emplace_back( std::make_shared<Image_Array>() );
+    for(int64_t n = 0; n < 2; ++n){
+        d.image_data.back()->imagecoll.images.emplace_back();
+        auto &img = d.image_data.back()->imagecoll.images.back();
+        img.init_orientation( vec3<double>(1.0, 0.0, 0.0), vec3<double>(0.0, 1.0, 0.0) );
+        img.init_buffer(5, 7, 2);
+        img.init_spatial(1.0, 1.5, 2.0, vec3<double>(0.0, 0.0, 0.0), vec3<double>(0.0, 0.0, 2.0 * n));
+        img.metadata["Modality"] = "CT";
+        for(int64_t r = 0; r < img.rows; ++r){
+            for(int64_t c = 0; c < img.columns; ++c){
+                for(int64_t h = 0; h < img.channels; ++h){
+                    img.reference(r, c, h) = static_cast<float>(r * 100 + c * 10 + h) - 0.25f * static_cast<float>(n);
+                }
+            }
+        }
+    }
+    d.image_data.back()->imagecoll.images.back().reference(0, 0, 0) = std::numeric_limits<float>::infinity();
+    d.image_data.back()->imagecoll.images.back().reference(0, 1, 0) = std::numeric_limits<float>::denorm_min();
+    return d;
+}
+
+
+TEST_CASE( "Drover serialization with pixel payloads" ){
+    std::vector<dcma::rpc::PayloadCompression::type> methods = { dcma::rpc::PayloadCompression::NONE,
+                                                                 dcma::rpc::PayloadCompression::ZLIB };
+#ifdef DCMA_USE_ZSTD
+    methods.push_back( dcma::rpc::PayloadCompression::ZSTD );
+#else
+    REQUIRE_THROWS( Validate_Payload_Compression(dcma::rpc::PayloadCompression::ZSTD) );
+#endif
+
+    const auto d = make_test_drover();
+    const auto &ref_imgs = d.image_data.front()->imagecoll.images;
+
+    for(const auto c : methods){
+        CAPTURE( c );
+        REQUIRE_NOTHROW( Validate_Payload_Compression(c) );
+
+        // Check that the round-trip is lossless.
+        {
+            dcma::rpc::Drover rpc_d;
+            Serialize(d, rpc_d, c);
+            REQUIRE( rpc_d.image_data.size() == 1 );
+            for(const auto &rpc_img : rpc_d.image_data.front().imagecoll.images){
+                REQUIRE( rpc_img.data.empty() );
+                REQUIRE( rpc_img.__isset.raw_data );
+                REQUIRE( rpc_img.raw_data_compression == c );
+            }
+
+            Drover out;
+            Deserialize(rpc_d, out);
+
+            REQUIRE( out.Has_Contour_Data() );
+            REQUIRE( out.contour_data->ccs.size() == 1 );
+            REQUIRE( out.contour_data->ccs.front().contours.size() == 1 );
+            REQUIRE( out.contour_data->ccs.front().contours.front().points.size() == 3 );
+            REQUIRE( out.contour_data->ccs.front().contours.front().metadata["ROIName"] == "test" );
+
+            REQUIRE( out.image_data.size() == 1 );
+            const auto &out_imgs = out.image_data.front()->imagecoll.images;
+            REQUIRE( out_imgs.size() == ref_imgs.size() );
+            auto ref_it = std::begin(ref_imgs);
+            for(const auto &img : out_imgs){
+                REQUIRE( img.rows == ref_it->rows );
+                REQUIRE( img.columns == ref_it->columns );
+                REQUIRE( img.channels == ref_it->channels );
+                REQUIRE( img.pxl_dz == ref_it->pxl_dz );
+                REQUIRE( img.offset == ref_it->offset );
+                REQUIRE( img.metadata == ref_it->metadata );
+                REQUIRE( img.data == ref_it->data ); // Bitwise, since the payload is binary.
+                ++ref_it;
+            }
+        }
+
+        // Check that truncated payloads are rejected.
+        {
+            dcma::rpc::planar_image_double_double rpc_img;
+            Serialize(ref_imgs.front(), rpc_img, c);
+            rpc_img.raw_data.resize(rpc_img.raw_data.size() / 2);
+
+            planar_image<float,double> out;
+            REQUIRE_THROWS( Deserialize(rpc_img, out) );
+        }
+
+        // Check that oversized payloads are rejected.
+        {
+            // The payload holds more pixels than the image dimensions claim.
+            dcma::rpc::planar_image_double_double rpc_img;
+            Serialize(ref_imgs.front(), rpc_img, c);
+            rpc_img.rows -= 1;
+
+            planar_image<float,double> out;
+            REQUIRE_THROWS( Deserialize(rpc_img, out) );
+        }
+
+        // Check that overflowing dimensions are rejected.
+        {
+            dcma::rpc::planar_image_double_double rpc_img;
+            Serialize(ref_imgs.front(), rpc_img, c);
+            rpc_img.rows = std::numeric_limits<int64_t>::max() / 2;
+            rpc_img.columns = std::numeric_limits<int64_t>::max() / 2;
+
+            planar_image<float,double> out;
+            REQUIRE_THROWS( Deserialize(rpc_img, out) );
+        }
+    }
+}
+